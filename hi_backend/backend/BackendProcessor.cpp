@@ -64,6 +64,10 @@ scriptUnlocker(this)
 
 	dllManager = new BackendDllManager(this);
 
+#if SNEX_ENABLE_CODE_CACHE
+	workbenches.setCodeCacheDirectory(ProjectHandler::getAppDataDirectory().getChildFile("SnexCodeCache"));
+#endif
+
 	if(getCurrentFileHandler().getRootFolder().isDirectory())
 		refreshExpansionType();
 
@@ -989,6 +989,8 @@ void PresetBrowser::loadPresetDatabase(const File& rootDirectory)
 		presetDatabase = d;
 	else
 		presetDatabase = new DynamicObject();
+
+	getMainController()->getUserPresetHandler().getTagDataBase().setFavoriteDataBase(presetDatabase);
 }
 
 
@@ -178,7 +178,9 @@ void TagList::toggleTag(Tag* n)
 
 		PresetBrowser::DataBaseHelpers::writeTagsInXml(currentFile, currentlyActiveTags);
 
-		parent->getMainController()->getUserPresetHandler().getTagDataBase().buildDataBase(true);
+		auto& db = parent->getMainController()->getUserPresetHandler().getTagDataBase();
+		db.invalidateFile(currentFile);
+		db.buildDataBase();
 
 		for (auto l : listeners)
 		{
@@ -251,34 +253,57 @@ int PresetBrowserColumn::ColumnListModel::getNumRows()
 	else
 	{
 		jassert(index == 2);
-		Array<File> allFiles;
-		totalRoot.findChildFiles(allFiles, File::findFiles, true);
 		entries.clear();
 
-		for (int i = 0; i < allFiles.size(); i++)
+		auto& tagDataBase = parent->getMainController()->getUserPresetHandler().getTagDataBase();
+
+		if (tagDataBase.getRootDirectory() == totalRoot)
 		{
-			const bool matchesWildcard = wildcard.isEmpty() || allFiles[i].getFullPathName().containsIgnoreCase(wildcard);
+			// The preset index already contains all presets with their tags, so we don't need to search the directory again
+			tagDataBase.buildDataBase();
+
+			for (const auto& t : tagDataBase.getCachedTags())
+			{
+				const bool matchesWildcard = wildcard.isEmpty() || t.file.getFullPathName().containsIgnoreCase(wildcard);
+				bool matchesTags = true;
 
-			bool matchesTags = currentlyActiveTags.size() == 0;
+				for (const auto& st : currentlyActiveTags)
+					matchesTags &= t.tags.contains(st);
 
-			auto hash = allFiles[i].hashCode64();
+				if (matchesWildcard && matchesTags)
+					entries.add(t.file);
+			}
+		}
+		else
+		{
+			Array<File> allFiles;
+			totalRoot.findChildFiles(allFiles, File::findFiles, true);
 
-			if (currentlyActiveTags.size() > 0)
+			for (int i = 0; i < allFiles.size(); i++)
 			{
-				const auto& cachedTags = getCachedTags();
+				const bool matchesWildcard = wildcard.isEmpty() || allFiles[i].getFullPathName().containsIgnoreCase(wildcard);
 
-				for (auto& t : cachedTags)
+				bool matchesTags = currentlyActiveTags.size() == 0;
+
+				auto hash = allFiles[i].hashCode64();
+
+				if (currentlyActiveTags.size() > 0)
 				{
-					if (t.hashCode == hash)
+					const auto& cachedTags = getCachedTags();
+
+					for (auto& t : cachedTags)
 					{
-						matchesTags = t.shown;
-						break;
+						if (t.hashCode == hash)
+						{
+							matchesTags = t.shown;
+							break;
+						}
 					}
 				}
-			}
 
-			if (matchesWildcard && matchesTags)
-				entries.add(allFiles[i]);
+				if (matchesWildcard && matchesTags)
+					entries.add(allFiles[i]);
+			}
 		}
 
 		for (int i = 0; i < entries.size(); i++)
@@ -475,6 +500,9 @@ void PresetBrowserColumn::ColumnListModel::FavoriteOverlay::buttonClicked(Button
 
 	PresetBrowser::DataBaseHelpers::setFavorite(parent.database, f, newValue);
 
+	if (auto pb = findParentComponentOfClass<PresetBrowser>())
+		pb->getMainController()->getUserPresetHandler().getTagDataBase().setFavorite(f, newValue);
+
 
 	refreshShape();
 
@@ -90,6 +90,31 @@
 #endif
 
 
+/** The number of threads that are used to preload the samples of a sample map. 
+
+	If this is zero, the samples will be preloaded on the sample loading thread only.
+*/
+#ifndef HISE_NUM_PRELOAD_THREADS
+#define HISE_NUM_PRELOAD_THREADS 0
+#endif
+
+/** The number of worker threads that render the child synths of the master container in parallel.
+
+	The audio thread will also take part in the rendering. If this is zero, the child synths will be rendered serially on the audio thread.
+*/
+#ifndef HISE_NUM_PARALLEL_SYNTH_THREADS
+#define HISE_NUM_PARALLEL_SYNTH_THREADS 0
+#endif
+
+/** Set this to 1 to compile the HiseScript callbacks into a register based bytecode after the optimisation passes.
+
+	This resolves the local variables, `reg` and `const var` references at compile time and removes the tree walking
+	overhead for the control flow and the operators. Function and API calls are still evaluated by the interpreter.
+*/
+#ifndef HISE_USE_SCRIPT_BYTECODE
+#define HISE_USE_SCRIPT_BYTECODE 0
+#endif
+
 #ifndef HISE_AUV3_MAX_INSTANCE_COUNT
 #define HISE_AUV3_MAX_INSTANCE_COUNT 2
 #endif
@@ -393,6 +393,16 @@ some weird side effects in the streaming engine).
 #define HISE_MAX_PROCESSING_BLOCKSIZE 512
 #endif
 
+/** Config: HISE_BATCH_VOICE_MODULATION
+
+If this is enabled, the sound generators calculate the envelopes of all active voices at once before rendering the voices.
+This is faster with many voices, but needs a buffer for the envelope values of each voice in every modulation chain of a sound generator.
+The result should be identical to the per-voice calculation (the ModulationTests compare both modes).
+*/
+#ifndef HISE_BATCH_VOICE_MODULATION
+#define HISE_BATCH_VOICE_MODULATION 0
+#endif
+
 /** Config: ENABLE_CPU_MEASUREMENT
 
 Set this to 0 to deactivate the CPU peak meter.
@@ -538,6 +538,30 @@ void DebugLogger::checkAssertion(Processor* p, Location location, bool result, d
 }
 
 
+void DebugLogger::checkEventBuffer(const Processor* p, Location location, HiseEventBuffer& b)
+{
+	auto numOverflowed = b.getNumOverflowedEvents();
+	auto numDropped = b.getNumDroppedEvents();
+
+	if (numOverflowed == 0 && numDropped == 0)
+		return;
+
+	b.resetOverflowCounters();
+
+	if (!isLogging()) return;
+
+	if (numDropped > 0)
+	{
+		Failure f(messageIndex++, callbackIndex, location, FailureType::EventsDropped, p, getCurrentTimeStamp(), (double)numDropped);
+		addFailure(f);
+	}
+	else
+	{
+		Failure f(messageIndex++, callbackIndex, location, FailureType::EventBufferOverflow, p, getCurrentTimeStamp(), (double)numOverflowed);
+		addFailure(f);
+	}
+}
+
 bool DebugLogger::checkIsSoftBypassed(const ModulatorSynth* synth, Location location)
 {
 	auto silence = synth->getMainController()->getMainSynthChain()->areVoicesActive();
@@ -920,6 +944,8 @@ String DebugLogger::getNameForFailure(FailureType f)
 		RETURN_CASE_STRING_FAILURE(SampleLoadingError);
 		RETURN_CASE_STRING_FAILURE(StreamingFailure);
 		RETURN_CASE_STRING_FAILURE(SoftBypassFailure);
+		RETURN_CASE_STRING_FAILURE(EventBufferOverflow);
+		RETURN_CASE_STRING_FAILURE(EventsDropped);
         RETURN_CASE_STRING_FAILURE(numFailureTypes);
 	}
 
@@ -70,6 +70,8 @@ public:
 		SampleLoadingError,
 		StreamingFailure,
 		SoftBypassFailure,
+		EventBufferOverflow, ///< a HiseEventBuffer had to use its overflow area
+		EventsDropped, ///< a HiseEventBuffer was full and events were dropped
 		numFailureTypes
 	};
 
@@ -196,6 +198,9 @@ public:
 
 	bool checkIsSoftBypassed(const ModulatorSynth* synth, Location location);
 
+	/** Reports overflowed or dropped events of the buffer and resets its counters. */
+	void checkEventBuffer(const Processor* p, Location location, HiseEventBuffer& b);
+
 	void checkPriorityInversion(const CriticalSection& lockToCheck);
 
 	void checkPriorityInversion(const SpinLock& spinLockToCheck, Location l, Processor* p, const Identifier& id);
@@ -609,50 +609,119 @@ public:
 };
 
 
+// The memory budget (in megabytes) of each shared cache. If the data exceeds this limit, the least recently used entries
+// that are not referenced anymore will be removed from the cache.
+#ifndef HISE_SHARED_POOL_CACHE_SIZE_MB
+#define HISE_SHARED_POOL_CACHE_SIZE_MB 512
+#endif
+
 /** This class extends the pool to a global data storage used across all instances of the plugin.
 *
 *	This is useful if you have a lot of read-only data (like images), which would increase the memory
-*	usage when multiple instances of your plugin are used. */
+*	usage when multiple instances of your plugin are used. 
+*
+*	The entries are indexed by the hash code of their reference and the cache is guarded by a lock so
+*	that multiple instances can load data on different threads. If the memory usage exceeds the budget,
+*	the least recently used entries that are not referenced by any pool will be evicted.
+*/
 template <class DataType> class SharedCache
 {
 
 public:
 
-	SharedCache()
+	using EntryPtr = ReferenceCountedObjectPtr<PoolEntry<DataType>>;
+
+	struct Statistics
+	{
+		String toString() const
+		{
+			String s;
+
+			s << "Shared: " << numEntries << " (" << String(numBytes / 1024.0f / 1024.0f, 2) << " MB / ";
+			s << String(memoryBudget / 1024.0f / 1024.0f, 0) << " MB), ";
+			s << "Hits: " << numHits << ", Misses: " << numMisses << ", Evicted: " << numEvictions;
+
+			return s;
+		}
+
+		int numEntries = 0;
+		int64 numHits = 0;
+		int64 numMisses = 0;
+		int64 numEvictions = 0;
+		size_t numBytes = 0;
+		size_t memoryBudget = 0;
+	};
+
+	SharedCache():
+		memoryBudget((size_t)HISE_SHARED_POOL_CACHE_SIZE_MB * 1024 * 1024)
 	{
 		DataType* unused = nullptr;
 		ignoreUnused(unused);
 	}
 
-	bool contains(int64 hashCode)
+	bool contains(int64 hashCode) const
 	{
-		for (const auto& i : sharedItems)
-		{
-			if (i->ref.getHashCode() == hashCode)
-				return true;
-		}
-
-		return false;
+		ScopedLock sl(lock);
+		return sharedItems.contains(hashCode);
 	}
 
-	PoolEntry<DataType>* getSharedData(int64 hashCode)
+	/** Returns the entry for the given hash code or nullptr if it's not in the cache. */
+	EntryPtr getSharedData(int64 hashCode)
 	{
-		for (const auto& i: sharedItems)
+		ScopedLock sl(lock);
+
+		if (sharedItems.contains(hashCode))
 		{
-			if (i->ref.getHashCode() == hashCode)
-				return i;
+			auto& item = sharedItems.getReference(hashCode);
+			item.lastAccess = ++accessCounter;
+			++numHits;
+			return item.entry;
 		}
 
-		jassertfalse;
-		return {};
+		++numMisses;
+		return nullptr;
 	}
 
 	void store(PoolEntry<DataType>* newEntry)
 	{
-		if (contains(newEntry->ref.getHashCode()))
+		ScopedLock sl(lock);
+
+		auto hashCode = newEntry->ref.getHashCode();
+
+		if (sharedItems.contains(hashCode))
 			return;
 
-		sharedItems.add(newEntry);
+		Item newItem;
+		newItem.entry = newEntry;
+		newItem.numBytes = PoolHelpers::getDataSize(&newEntry->data);
+		newItem.lastAccess = ++accessCounter;
+
+		sharedItems.set(hashCode, newItem);
+		numBytes += newItem.numBytes;
+
+		evictUnusedItems();
+	}
+
+	/** Sets the memory limit for this cache. Unused entries will be evicted until the cache fits into this budget. */
+	void setMemoryBudget(size_t newBudgetInBytes)
+	{
+		ScopedLock sl(lock);
+		memoryBudget = newBudgetInBytes;
+		evictUnusedItems();
+	}
+
+	Statistics getStatistics() const
+	{
+		ScopedLock sl(lock);
+
+		Statistics s;
+		s.numEntries = sharedItems.size();
+		s.numHits = numHits;
+		s.numMisses = numMisses;
+		s.numEvictions = numEvictions;
+		s.numBytes = numBytes;
+		s.memoryBudget = memoryBudget;
+		return s;
 	}
 
 	~SharedCache()
@@ -663,9 +732,55 @@ public:
 
 private:
 
-	
+	struct Item
+	{
+		EntryPtr entry;
+		size_t numBytes = 0;
+		uint64 lastAccess = 0;
+	};
+
+	/** Removes the least recently used entries that are only referenced by this cache until it fits the budget. */
+	void evictUnusedItems()
+	{
+		while (numBytes > memoryBudget)
+		{
+			int64 oldestHash = 0;
+			uint64 oldestAccess = std::numeric_limits<uint64>::max();
+			bool found = false;
+
+			for (typename HashMap<int64, Item>::Iterator i(sharedItems); i.next();)
+			{
+				const auto& item = i.getValue();
 
-	ReferenceCountedArray<PoolEntry<DataType>> sharedItems;
+				if (item.entry->getReferenceCount() == 1 && item.lastAccess < oldestAccess)
+				{
+					oldestAccess = item.lastAccess;
+					oldestHash = i.getKey();
+					found = true;
+				}
+			}
+
+			// Everything that is left is still in use...
+			if (!found)
+				break;
+
+			numBytes -= sharedItems[oldestHash].numBytes;
+			sharedItems.remove(oldestHash);
+			++numEvictions;
+		}
+	}
+
+	CriticalSection lock;
+
+	HashMap<int64, Item> sharedItems;
+
+	size_t memoryBudget;
+	size_t numBytes = 0;
+	uint64 accessCounter = 0;
+
+	int64 numHits = 0;
+	int64 numMisses = 0;
+	int64 numEvictions = 0;
 };
 
 
@@ -973,6 +1088,9 @@ public:
 
 		s << " (" << String(dataSize / 1024.0f / 1024.0f, 2) << " MB)";
 
+		if (useSharedCache)
+			s << ", " << sharedCache->getStatistics().toString();
+
 		return s;
 	}
 
@@ -1053,9 +1171,10 @@ public:
 		if (getDataProvider()->isEmbeddedResource(r))
 			r = getDataProvider()->getEmbeddedReference(r);
 
-		if (useSharedCache && sharedCache->contains(r.getHashCode()))
+		if (useSharedCache)
 		{
-			return ManagedPtr(this, sharedCache->getSharedData(r.getHashCode()), true);
+			if (auto sharedEntry = sharedCache->getSharedData(r.getHashCode()))
+				return ManagedPtr(this, sharedEntry.get(), true);
 		}
 
 		if (PoolHelpers::shouldSearchInPool(loadingType))
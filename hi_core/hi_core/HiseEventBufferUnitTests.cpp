@@ -61,6 +61,9 @@ public:
 		testMidiBufferCopyMethods();
 		testMidiBufferIterators();
 		testEventBufferMoveOperations();
+		testEventBufferOverflow();
+		testEventBufferMerge();
+		testEventBufferInsertionBenchmark();
 		testEventHandler();
 		testEventBufferStack();
 		testStartOffset();
@@ -379,6 +382,171 @@ private:
 
 	}
 
+	void testEventBufferOverflow()
+	{
+		beginTest("Testing HiseEventBuffer overflow");
+
+		HiseEventBuffer b;
+
+		const int capacity = HISE_EVENT_BUFFER_SIZE + HISE_EVENT_BUFFER_OVERFLOW_SIZE;
+
+		for (int i = 0; i < HISE_EVENT_BUFFER_SIZE + 10; i++)
+			b.addEvent(generateRandomHiseEvent());
+
+		expectEquals<int>(b.getNumUsed(), HISE_EVENT_BUFFER_SIZE + 10, "Events in overflow area");
+		expectEquals<int>(b.getNumOverflowedEvents(), 10, "Overflow counter");
+		expectEquals<int>(b.getNumDroppedEvents(), 0, "Dropped counter");
+		expect(b.timeStampsAreSorted(), "Sorted with overflow");
+
+		for (int i = b.getNumUsed(); i < capacity + 5; i++)
+			b.addEvent(generateRandomHiseEvent());
+
+		expectEquals<int>(b.getNumUsed(), capacity, "Full buffer");
+		expectEquals<int>(b.getNumDroppedEvents(), 5, "Dropped counter when full");
+
+		b.clear();
+
+		expectEquals<int>(b.getNumDroppedEvents(), 5, "clear() keeps the counters");
+
+		b.resetOverflowCounters();
+
+		expectEquals<int>(b.getNumOverflowedEvents(), 0, "Reset overflow counter");
+		expectEquals<int>(b.getNumDroppedEvents(), 0, "Reset dropped counter");
+
+		HiseEventBuffer b1, b2;
+
+		for (int i = 0; i < HISE_EVENT_BUFFER_SIZE; i++)
+		{
+			b1.addEvent(generateRandomHiseEvent());
+			b2.addEvent(generateRandomHiseEvent());
+		}
+
+		b1.addEvents(b2);
+
+		expectEquals<int>(b1.getNumUsed(), capacity, "Merged into overflow area");
+		expectEquals<int>(b1.getNumOverflowedEvents(), HISE_EVENT_BUFFER_OVERFLOW_SIZE, "Overflow counter after merging");
+		expect(b1.timeStampsAreSorted(), "Sorted after merging");
+	}
+
+	void testEventBufferMerge()
+	{
+		beginTest("Testing HiseEventBuffer merging");
+
+		for (int iteration = 0; iteration < 20; iteration++)
+		{
+			HiseEventBuffer b1, b2, expected;
+
+			const int num1 = r.nextInt(HISE_EVENT_BUFFER_SIZE / 2);
+			const int num2 = r.nextInt(HISE_EVENT_BUFFER_SIZE / 2);
+
+			// Use a small range of timestamps to check the order of equal timestamps
+			for (int i = 0; i < num1; i++)
+			{
+				auto e = generateRandomHiseEvent();
+				e.setTimeStamp(r.nextInt(32));
+				b1.addEvent(e);
+			}
+
+			for (int i = 0; i < num2; i++)
+			{
+				auto e = generateRandomHiseEvent();
+				e.setTimeStamp(r.nextInt(32));
+				b2.addEvent(e);
+			}
+
+			expected.copyFrom(b1);
+
+			for (const auto& e : b2)
+				expected.addEvent(e);
+
+			b1.addEvents(b2);
+
+			expect(b1 == expected, "Merging equals adding one by one");
+		}
+	}
+
+	static void addEventLinear(HiseEvent* data, int& numUsed, const HiseEvent& e)
+	{
+		int position = numUsed;
+
+		for (int i = 0; i < numUsed; i++)
+		{
+			if (data[i].getTimeStamp() > e.getTimeStamp())
+			{
+				position = i;
+				break;
+			}
+		}
+
+		for (int i = numUsed - 1; i >= position; i--)
+			data[i + 1] = data[i];
+
+		data[position] = e;
+		numUsed++;
+	}
+
+	void testEventBufferInsertionBenchmark()
+	{
+		beginTest("Benchmarking HiseEventBuffer insertion of dense unsorted events");
+
+		const int numEvents = HISE_EVENT_BUFFER_SIZE + HISE_EVENT_BUFFER_OVERFLOW_SIZE - 12;
+		const int numIterations = 2000;
+
+		Array<HiseEvent> events;
+
+		for (int i = 0; i < numEvents; i++)
+		{
+			auto e = generateRandomHiseEvent();
+			e.setTimeStamp(r.nextInt(4096));
+			events.add(e);
+		}
+
+		HiseEventBuffer b;
+		HeapBlock<HiseEvent> linearData(numEvents);
+		int numLinear = 0;
+
+		double linearSeconds = 0.0;
+		double bufferSeconds = 0.0;
+
+		for (int i = 0; i < numIterations; i++)
+		{
+			auto start = Time::getHighResolutionTicks();
+
+			numLinear = 0;
+
+			for (const auto& e : events)
+				addEventLinear(linearData, numLinear, e);
+
+			auto mid = Time::getHighResolutionTicks();
+
+			b.clear();
+
+			for (const auto& e : events)
+				b.addEvent(e);
+
+			auto end = Time::getHighResolutionTicks();
+
+			linearSeconds += Time::highResolutionTicksToSeconds(mid - start);
+			bufferSeconds += Time::highResolutionTicksToSeconds(end - mid);
+		}
+
+		expectEquals<int>(b.getNumUsed(), numEvents, "No dropped events");
+		expectEquals<int>(b.getNumDroppedEvents(), 0, "Dropped counter");
+		expect(b.timeStampsAreSorted(), "Sorted after stress test");
+
+		for (int i = 0; i < numEvents; i++)
+		{
+			if (!(b.getEvent(i) == linearData[i]))
+			{
+				expect(false, "Order mismatch at " + String(i));
+				break;
+			}
+		}
+
+		logMessage("Linear insertion: " + String(linearSeconds * 1000000.0 / numIterations, 2) + "us per block, " +
+				   "HiseEventBuffer: " + String(bufferSeconds * 1000000.0 / numIterations, 2) + "us per block (" + String(numEvents) + " events)");
+	}
+
 	void testFadeEvent()
 	{
 		beginTest("Testing Fade events");
@@ -42,6 +42,7 @@ MainController::KillStateHandler::KillStateHandler(MainController* mc_) :
 	threadIds[TargetThread::AudioThread] = nullptr;
 	threadIds[TargetThread::SampleLoadingThread] = mc->getSampleManager().getGlobalSampleThreadPool()->getThreadId();
 	threadIds[TargetThread::ScriptingThread] = mc->javascriptThreadPool->getThreadId();
+	scriptingWorkerThreads = mc->javascriptThreadPool->getWorkerThreadIds();
 	threadIds[TargetThread::MessageThread] = nullptr;
 
 	setAudioExportThread(nullptr);
@@ -294,13 +295,13 @@ bool MainController::KillStateHandler::isAudioRunning() const noexcept
 
 void MainController::KillStateHandler::setLockForCurrentThread(LockHelpers::Type t, bool lock) const
 {
-	auto id = lock ? getCurrentThread() : TargetThread::Free;
+	auto id = lock ? Thread::getCurrentThreadId() : nullptr;
 	lockStates.threadsForLock[t].store(id);
 }
 
 bool MainController::KillStateHandler::currentThreadHoldsLock(LockHelpers::Type t) const noexcept
 {
-	return getCurrentThread() == lockStates.threadsForLock[t];
+	return Thread::getCurrentThreadId() == lockStates.threadsForLock[t].load();
 }
 
 bool MainController::KillStateHandler::initialised() const noexcept
@@ -554,6 +555,7 @@ juce::Array<MultithreadedQueueHelpers::PublicToken> MainController::KillStateHan
 	MultithreadedQueueHelpers::PublicToken scriptThreadToken;
 	scriptThreadToken.canBeProducer = producerFlags & QueueProducerFlags::ScriptThreadIsProducer;
 	scriptThreadToken.threadIds.insert(-1, mc->javascriptThreadPool->getThreadId());
+	scriptThreadToken.threadIds.addArray(scriptingWorkerThreads);
 	scriptThreadToken.threadName = "Scripting Thread";
 
 	return { audioThreadToken, messageThreadToken, sampleLoadingThreadToken, scriptThreadToken };
@@ -591,7 +593,7 @@ MainController::KillStateHandler::TargetThread MainController::KillStateHandler:
 		return TargetThread::AudioThread;
 	else if (threadId == threadIds[(int)TargetThread::SampleLoadingThread])
 		return TargetThread::SampleLoadingThread;
-	else if (threadId == threadIds[(int)TargetThread::ScriptingThread])
+	else if (threadId == threadIds[(int)TargetThread::ScriptingThread] || scriptingWorkerThreads.contains(threadId))
 		return TargetThread::ScriptingThread;
 
 	if (auto mm = MessageManager::getInstanceWithoutCreating())
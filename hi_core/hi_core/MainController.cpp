@@ -864,6 +864,7 @@ void MainController::processBlockCommon(AudioSampleBuffer &buffer, MidiBuffer &m
 	eventIdHandler.handleEventIds();
 
 	getDebugLogger().logEvents(masterEventBuffer);
+	getDebugLogger().checkEventBuffer(getMainSynthChain(), DebugLogger::Location::MainRenderCallback, masterEventBuffer);
 
 #else
 	ignoreUnused(midiMessages);
@@ -1307,6 +1308,18 @@ void MainController::prepareToPlay(double sampleRate_, int samplesPerBlock)
 
 	getMainSynthChain()->setIsOnAir(true);
 
+	{
+		int numVoices = 0;
+
+		Processor::Iterator<ModulatorSynth> iter(getMainSynthChain());
+
+		while (auto synth = iter.getNextProcessor())
+			numVoices += synth->getNumVoices();
+
+		// Multimic samplers queue one streaming job per channel, so leave some headroom
+		getSampleManager().getGlobalSampleThreadPool()->prepareToPlay(numVoices * 4);
+	}
+
 	if (oversampler != nullptr)
 		oversampler->initProcessing(getOriginalBufferSize());
 
@@ -192,6 +192,9 @@ public:
 		/** returns a pointer to the thread pool that streams the samples from disk. */
 		SampleThreadPool *getGlobalSampleThreadPool() { return samplerLoaderThreadPool; }
 
+		/** Returns the thread pool that preloads the samples in parallel (or nullptr if HISE_NUM_PRELOAD_THREADS is zero). */
+		ThreadPool* getPreloadThreadPool() { return preloadThreadPool; }
+
 		/** returns a pointer to the global sample pool */
 		ModulatorSamplerSoundPool *getModulatorSamplerSoundPool2() const;
 
@@ -357,6 +360,7 @@ public:
 		ValueTree sampleMaps;
 
 		ScopedPointer<SampleThreadPool> samplerLoaderThreadPool;
+		ScopedPointer<ThreadPool> preloadThreadPool;
 
 		bool hddMode = false;
 		bool skipPreloading = false;
@@ -740,6 +744,12 @@ public:
 			ValueTree newPreset;
 		};
 
+		/** A database of all user presets and their tags.
+
+			The information is stored in an index file in the preset root directory (path, modification time,
+			file size, tags and favorite state) and on each rebuild only the presets that were added or modified
+			since the last scan will be parsed again.
+		*/
 		struct TagDataBase
 		{
 			struct CachedTag
@@ -747,12 +757,38 @@ public:
 				int64 hashCode;
 				Array<Identifier> tags;
 				bool shown = false;
+
+				File file;
+				int64 modificationTime = 0;
+				int64 fileSize = 0;
+				bool favorite = false;
 			};
 
 			void setRootDirectory(const File& newRoot);;
 
+			const File& getRootDirectory() const { return root; }
+
+			/** Rebuilds the database if it's dirty (or force is true).
+			
+				This scans the preset directory for changes and only parses the presets that were added or modified. 
+			*/
 			void buildDataBase(bool force = false);
 
+			/** Removes the cached entry of the preset so that it will be parsed again with the next rebuild. */
+			void invalidateFile(const File& presetFile);
+
+			/** Sets the database that holds the favorite states (the db.json file of the preset browser). */
+			void setFavoriteDataBase(const var& newFavoriteDataBase);
+
+			/** Updates the favorite state of the preset in the index. */
+			void setFavorite(const File& presetFile, bool isFavorite);
+
+			/** Deletes the index file and clears all cached information. */
+			void clearIndex();
+
+			/** Returns the file that stores the index. */
+			File getIndexFile() const { return root.getChildFile(".presetindex"); }
+
 			/** If you want to use the tag system, supply a list of Strings and it will
 			create the tags automatically.
 			*/
@@ -775,9 +811,16 @@ public:
 
 			Array<CachedTag> cachedTags;
 
+			var favoriteDataBase;
+
 			void buildInternal();
 
+			void loadIndex();
+			void saveIndex() const;
+
 			bool dirty = true;
+			bool indexLoaded = false;
+			bool favoritesDirty = false;
 		};
 
 		/** A class that will be notified about user preset changes. */
@@ -1265,14 +1308,15 @@ public:
 		{
 			LockStates()
 			{
-				threadsForLock[LockHelpers::MessageLock] = TargetThread::Free;
-				threadsForLock[LockHelpers::AudioLock] = TargetThread::Free;
-				threadsForLock[LockHelpers::SampleLock] = TargetThread::Free;
-				threadsForLock[LockHelpers::IteratorLock] = TargetThread::Free;
-				threadsForLock[LockHelpers::ScriptLock] = TargetThread::Free;
+				threadsForLock[LockHelpers::MessageLock] = nullptr;
+				threadsForLock[LockHelpers::AudioLock] = nullptr;
+				threadsForLock[LockHelpers::SampleLock] = nullptr;
+				threadsForLock[LockHelpers::IteratorLock] = nullptr;
+				threadsForLock[LockHelpers::ScriptLock] = nullptr;
 			}
 
-			std::atomic<TargetThread> threadsForLock[LockHelpers::Type::numLockTypes];
+			// The actual thread IDs (there might be multiple threads that count as the same target thread)
+			std::atomic<Thread::ThreadID> threadsForLock[LockHelpers::Type::numLockTypes];
 		};
 
 		mutable LockStates lockStates;
@@ -1319,6 +1363,7 @@ public:
 		MainController* mc;
 		void* threadIds[(int)TargetThread::numTargetThreads];
 		Array<void*> audioThreads;
+		Array<void*> scriptingWorkerThreads;
 	};
 
 	MainController();
@@ -1348,6 +1393,12 @@ public:
 	ProcessorChangeHandler& getProcessorChangeHandler() noexcept { return processorChangeHandler; }
 	const ProcessorChangeHandler& getProcessorChangeHandler() const noexcept { return processorChangeHandler; }
 
+	/** Returns a counter that changes whenever a processor is added to or removed from the signal chain. */
+	int getProcessorTreeVersion() const noexcept { return processorTreeVersion.load(); }
+
+	/** Increases the processor tree version. This is called by Processor::setIsOnAir(). */
+	void bumpProcessorTreeVersion() noexcept { ++processorTreeVersion; }
+
 	GlobalAsyncModuleHandler& getGlobalAsyncModuleHandler() { return globalAsyncModuleHandler; }
 	const GlobalAsyncModuleHandler& getGlobalAsyncModuleHandler() const { return globalAsyncModuleHandler; }
 
@@ -2063,6 +2114,8 @@ private:
 
 	Atomic<int> voiceAmount;
 	bool allNotesOffFlag;
+
+	std::atomic<int> processorTreeVersion { 0 };
     
     bool changed;
     
@@ -803,7 +803,8 @@ void BorderPanel::paint(Graphics &g)
 
 		DrawActions::Handler::Iterator it(drawHandler.get());
 
-		it.render(g, this);
+		if (!it.renderRasterised(g, this))
+			it.render(g, this);
 		
 	}
 	else
@@ -1115,44 +1116,354 @@ void DrawActions::Handler::Iterator::render(Graphics& g, Component* c)
 			cachedImg = Image(Image::ARGB, c->getWidth() * sf, c->getHeight() * sf, true);
 		}
 
-		Graphics g2(cachedImg);
-		g2.addTransform(st);
+		renderToImage(actionsInIterator, cachedImg, sf);
+		index = actionsInIterator.size();
 
+		g.drawImageTransformed(cachedImg, st.inverted());
+	}
+	else
+	{
 		while (auto action = getNextAction())
+			action->perform(g);
+	}
+}
+
+void DrawActions::Handler::Iterator::renderToImage(const ReferenceCountedArray<ActionBase>& actions, Image& cachedImg, float sf)
+{
+	auto st = AffineTransform::scale(jmin<double>(4.0, sf));
+
+	Graphics g2(cachedImg);
+	g2.addTransform(st);
+
+	for (auto action : actions)
+	{
+		if (action->wantsCachedImage())
 		{
-			if (action->wantsCachedImage())
+			Image actionImage;
+
+			if (action->wantsToDrawOnParent())
+				actionImage = cachedImg; // just use the cached image
+			else
 			{
-				Image actionImage;
+				actionImage = Image(cachedImg.getFormat(), cachedImg.getWidth(), cachedImg.getHeight(), true);
+			}
 
-				if (action->wantsToDrawOnParent())
-					actionImage = cachedImg; // just use the cached image
-				else
-				{
-					actionImage = Image(cachedImg.getFormat(), cachedImg.getWidth(), cachedImg.getHeight(), true);
-				}
+			Graphics g3(actionImage);
+			g3.addTransform(st);
+			action->setScaleFactor(sf);
+			action->setCachedImage(actionImage, cachedImg);
+			action->perform(g3);
+
+			if (!action->wantsToDrawOnParent())
+				GraphicHelpers::quickDraw(cachedImg, actionImage);
+		}
+		else
+			action->perform(g2);
+	}
+}
+
+struct DrawActions::Handler::RenderJob : public ThreadPoolJob
+{
+	RenderJob(Handler* h, Rasteriser::Key k_, const ReferenceCountedArray<ActionBase>& actions_) :
+		ThreadPoolJob("Rasterise panel"),
+		handler(h),
+		rasteriser(h->rasteriser),
+		k(k_),
+		actions(actions_)
+	{}
+
+	JobStatus runJob() override
+	{
+		auto start = Time::getMillisecondCounterHiRes();
+
+		Image img(Image::ARGB, k.width, k.height, true);
+		Iterator::renderToImage(actions, img, k.scaleFactor);
+
+		{
+			ScopedLock sl(rasteriser->lock);
+
+			rasteriser->image = img;
+			rasteriser->imageKey = k;
+			rasteriser->imageActions.swapWith(actions);
+			rasteriser->jobPending = false;
+			rasteriser->stats.numRendered++;
+			rasteriser->stats.addRenderTime(Time::getMillisecondCounterHiRes() - start);
+		}
+
+		auto h = handler;
+
+		MessageManager::callAsync([h]()
+		{
+			if (h != nullptr)
+				h.get()->triggerAsyncUpdate();
+		});
+
+		return jobHasFinished;
+	}
+
+	WeakReference<Handler> handler;
+	Rasteriser::Ptr rasteriser;
+	Rasteriser::Key k;
+	ReferenceCountedArray<ActionBase> actions;
+};
+
+bool DrawActions::Handler::Iterator::renderRasterised(Graphics& g, Component* c)
+{
+	if (handler == nullptr)
+		return false;
+
+	auto& r = *handler->rasteriser;
+
+	// Layers that draw on the parent need a snapshot of the parent component
+	if (handler->recursion || !handler->isRenderingOffThread() || !hash.valid || wantsToDrawOnParent())
+	{
+		Image lastImage;
+
+		{
+			ScopedLock sl(r.lock);
+
+			if (!r.jobPending)
+				return false;
+
+			lastImage = r.image;
+		}
+
+		// The pending job modifies the actions (cached images, scale factor and post actions), so they
+		// must not be rendered on this thread until it's finished and triggers another repaint.
+		index = actionsInIterator.size();
+
+		if (lastImage.isValid())
+			g.drawImage(lastImage, c->getLocalBounds().toFloat(), RectanglePlacement::stretchToFit);
+
+		return true;
+	}
+
+	auto start = Time::getMillisecondCounterHiRes();
+
+	UnblurryGraphics ug(g, *c);
+
+	auto sf = ug.getTotalScaleFactor();
+	auto st = AffineTransform::scale(jmin<double>(4.0, sf));
+
+	Rasteriser::Key k;
+	k.hash = hash.value;
+	k.width = (int)(c->getWidth() * sf);
+	k.height = (int)(c->getHeight() * sf);
+	k.scaleFactor = sf;
+
+	if (k.width <= 0 || k.height <= 0)
+		return true;
+
+	Image img;
+
+	{
+		ScopedLock sl(r.lock);
 
-				Graphics g3(actionImage);
-				g3.addTransform(st);
-				action->setScaleFactor(sf);
-				action->setCachedImage(actionImage, cachedImg);
-				action->perform(g3);
+		if (r.imageKey == k)
+		{
+			img = r.image;
+			r.stats.numReused++;
+		}
+		else if (r.jobPending || r.image.getBounds() == Rectangle<int>(k.width, k.height))
+		{
+			// Show the last image until the new one is ready
+			img = r.image;
 
-				if (!action->wantsToDrawOnParent())
-					GraphicHelpers::quickDraw(cachedImg, actionImage);
+			if (!r.jobPending)
+			{
+				r.jobPending = true;
+				handler->rasteriserPool->getObject().pool.addJob(new RenderJob(handler, k, actionsInIterator), true);
 			}
-			else
-				action->perform(g2);
 		}
+	}
 
-		g.drawImageTransformed(cachedImg, st.inverted());
+	if (!img.isValid())
+	{
+		// Nothing to show yet (or the size has changed), so render it here
+		// to avoid an empty panel
+		auto renderStart = Time::getMillisecondCounterHiRes();
+
+		img = Image(Image::ARGB, k.width, k.height, true);
+		renderToImage(actionsInIterator, img, sf);
+
+		ScopedLock sl(r.lock);
+		r.image = img;
+		r.imageKey = k;
+		r.imageActions.clearQuick();
+		r.imageActions.addArray(actionsInIterator);
+		r.stats.numRenderedSynchronously++;
+		r.stats.addRenderTime(Time::getMillisecondCounterHiRes() - renderStart);
+	}
+
+	index = actionsInIterator.size();
+
+	if (img.getBounds() == Rectangle<int>(k.width, k.height))
+		g.drawImageTransformed(img, st.inverted());
+	else
+		g.drawImage(img, c->getLocalBounds().toFloat(), RectanglePlacement::stretchToFit);
+
+	ScopedLock sl(r.lock);
+	r.stats.lastCompositeMs = Time::getMillisecondCounterHiRes() - start;
+
+	return true;
+}
+
+void DrawActions::Handler::setRenderOffThread(bool shouldRenderOffThread)
+{
+	if (shouldRenderOffThread && rasteriserPool == nullptr)
+		rasteriserPool = new SharedResourcePointer<RasteriserPool>();
+
+	renderOffThread = shouldRenderOffThread;
+}
+
+DrawActions::Handler::RenderStatistics DrawActions::Handler::getRenderStatistics() const
+{
+	ScopedLock sl(rasteriser->lock);
+	return rasteriser->stats;
+}
+
+void DrawActions::Handler::RenderStatistics::addRenderTime(double ms)
+{
+	auto numRenders = numRendered + numRenderedSynchronously;
+
+	lastRenderMs = ms;
+	maxRenderMs = jmax(maxRenderMs, ms);
+	averageRenderMs += (ms - averageRenderMs) / (double)jmax(1, numRenders);
+}
+
+var DrawActions::Handler::RenderStatistics::toJSON() const
+{
+	DynamicObject::Ptr obj = new DynamicObject();
+
+	obj->setProperty("NumRendered", numRendered);
+	obj->setProperty("NumRenderedSynchronously", numRenderedSynchronously);
+	obj->setProperty("NumReused", numReused);
+	obj->setProperty("LastRenderTime", lastRenderMs);
+	obj->setProperty("AverageRenderTime", averageRenderMs);
+	obj->setProperty("MaxRenderTime", maxRenderMs);
+	obj->setProperty("LastCompositeTime", lastCompositeMs);
+
+	return var(obj.get());
+}
+
+void DrawActions::HashBuilder::add(const void* data, size_t numBytes)
+{
+	// FNV-1a
+	auto d = static_cast<const uint8*>(data);
+
+	for (size_t i = 0; i < numBytes; i++)
+	{
+		value ^= (uint64)d[i];
+		value *= 1099511628211ull;
+	}
+}
+
+void DrawActions::HashBuilder::add(Rectangle<float> r)
+{
+	float d[4] = { r.getX(), r.getY(), r.getWidth(), r.getHeight() };
+	add(d, sizeof(d));
+}
+
+void DrawActions::HashBuilder::add(Rectangle<int> r)
+{
+	int d[4] = { r.getX(), r.getY(), r.getWidth(), r.getHeight() };
+	add(d, sizeof(d));
+}
+
+void DrawActions::HashBuilder::add(const AffineTransform& t)
+{
+	float d[6] = { t.mat00, t.mat01, t.mat02, t.mat10, t.mat11, t.mat12 };
+	add(d, sizeof(d));
+}
+
+void DrawActions::HashBuilder::add(const var& v)
+{
+	if (auto ar = v.getArray())
+	{
+		add(ar->size());
+
+		for (const auto& e : *ar)
+			add(e);
 	}
+	else if (v.isObject())
+		invalidate();
 	else
+		add(v.toString());
+}
+
+void DrawActions::HashBuilder::add(const Path& p)
+{
+	add(p.isUsingNonZeroWinding());
+
+	Path::Iterator it(p);
+
+	while (it.next())
 	{
-		while (auto action = getNextAction())
-			action->perform(g);
+		float d[7] = { (float)it.elementType, it.x1, it.y1, it.x2, it.y2, it.x3, it.y3 };
+		add(d, sizeof(d));
+	}
+}
+
+void DrawActions::HashBuilder::add(const PathStrokeType& s)
+{
+	add(s.getStrokeThickness());
+	add((int)s.getJointStyle());
+	add((int)s.getEndStyle());
+}
+
+void DrawActions::HashBuilder::add(const Font& f)
+{
+	add(f.toString());
+	add(f.getTypefaceName());
+	add(f.getHorizontalScale());
+	add(f.getExtraKerningFactor());
+}
+
+void DrawActions::HashBuilder::add(const ColourGradient& g)
+{
+	add(g.point1.x);
+	add(g.point1.y);
+	add(g.point2.x);
+	add(g.point2.y);
+	add(g.isRadial);
+	add(g.getNumColours());
+
+	for (int i = 0; i < g.getNumColours(); i++)
+	{
+		add(g.getColour(i));
+		add((float)g.getColourPosition(i));
 	}
 }
 
+void DrawActions::HashBuilder::add(const Image& img)
+{
+	// Script images are not modified after loading, so the pixel data identifies them. The rasteriser
+	// keeps the actions of its image alive, so a new image can't reuse the address of a freed one.
+	auto ptr = (int64)(pointer_sized_int)img.getPixelData();
+	add(ptr);
+	add(img.getBounds());
+}
+
+void DrawActions::HashBuilder::add(const DropShadow& s)
+{
+	add(s.colour);
+	add(s.radius);
+	add(s.offset.x);
+	add(s.offset.y);
+}
+
+void DrawActions::HashBuilder::addAction(const ActionBase& a)
+{
+	add((int64)typeid(a).hash_code());
+	a.addToHash(*this);
+}
+
+void DrawActions::HashBuilder::addAction(const PostActionBase& a)
+{
+	add((int64)typeid(a).hash_code());
+	a.addToHash(*this);
+}
+
 DrawActions::NoiseMapManager::NoiseMap::NoiseMap(Rectangle<int> a, bool monochrom_) :
 	width(a.getWidth()),
 	height(a.getHeight()),
@@ -263,12 +263,57 @@ private:
 
 struct DrawActions
 {
+	class ActionBase;
+	class PostActionBase;
+
+	/** Creates a hash from the parameters of the draw actions so that a rasterised panel image can be reused if nothing has changed. 
+	
+		If one of the actions can't be hashed, the hash will be invalid and the panel will be rendered on the message thread.
+	*/
+	struct HashBuilder
+	{
+		void add(const void* data, size_t numBytes);
+
+		void add(int v) { add(&v, sizeof(v)); }
+		void add(int64 v) { add(&v, sizeof(v)); }
+		void add(float v) { add(&v, sizeof(v)); }
+		void add(bool v) { add(v ? 1 : 0); }
+		void add(Colour c) { add((int)c.getARGB()); }
+		void add(Justification j) { add(j.getFlags()); }
+		void add(Rectangle<float> r);
+		void add(Rectangle<int> r);
+		void add(const AffineTransform& t);
+		void add(const String& s) { add(s.hashCode64()); }
+		void add(const var& v);
+		void add(const Path& p);
+		void add(const PathStrokeType& s);
+		void add(const Font& f);
+		void add(const ColourGradient& g);
+		void add(const Image& img);
+		void add(const DropShadow& s);
+
+		/** Adds the type and the parameters of the action. */
+		void addAction(const ActionBase& a);
+
+		/** Adds the type and the parameters of the post action. */
+		void addAction(const PostActionBase& a);
+
+		/** Call this if the action can't be hashed (or must be rendered on the message thread). */
+		void invalidate() { valid = false; }
+
+		uint64 value = 14695981039346656037ull;
+		bool valid = true;
+	};
+
 	class PostActionBase : public ReferenceCountedObject
 	{
 	public:
 
 		virtual void perform(PostGraphicsRenderer& r) = 0;
 		virtual bool needsStackData() const { return false; }
+
+		/** Adds the parameters to the hash. The default invalidates it, so the panel will be rendered on the message thread. */
+		virtual void addToHash(HashBuilder& h) const { h.invalidate(); }
 	};
 
 	class ActionBase: public ReferenceCountedObject
@@ -286,6 +331,9 @@ struct DrawActions
 		virtual void setCachedImage(Image& actionImage_, Image& mainImage_) { actionImage = actionImage_; mainImage = mainImage_; }
 		virtual void setScaleFactor(float sf) { scaleFactor = sf; }
 
+		/** Adds the parameters to the hash. The default invalidates it, so the panel will be rendered on the message thread. */
+		virtual void addToHash(HashBuilder& h) const { h.invalidate(); }
+
 	protected:
 
 		Image actionImage;
@@ -395,6 +443,17 @@ struct DrawActions
 			postActions.add(a);
 		}
 
+		void addToHash(HashBuilder& h) const override
+		{
+			h.add(drawOnParent);
+
+			for (auto a : internalActions)
+				h.addAction(*a);
+
+			for (auto p : postActions)
+				h.addAction(*p);
+		}
+
 	protected:
 
 		bool drawOnParent = false;
@@ -420,6 +479,17 @@ struct DrawActions
 
 		void perform(Graphics& g) override;
 
+		void addToHash(HashBuilder& h) const override
+		{
+			h.add((int)blendMode);
+			h.add(alpha);
+
+			for (auto a : actions)
+				h.addAction(*a);
+
+			ActionLayer::addToHash(h);
+		}
+
 		float alpha;
 		ReferenceCountedArray<ActionBase> actions;
 		Image blendSource;
@@ -459,6 +529,9 @@ struct DrawActions
 
 		NoiseMap& getNoiseMap(Rectangle<int> area, bool monochrom)
 		{
+			// Panels might be rasterised on a background thread
+			SimpleReadWriteLock::ScopedWriteLock sl(lock);
+
 			for (auto m : maps)
 			{
 
@@ -481,6 +554,62 @@ struct DrawActions
 
 	struct Handler: private AsyncUpdater
 	{
+		/** The timing statistics of a panel that is rendered off the message thread. */
+		struct RenderStatistics
+		{
+			void addRenderTime(double ms);
+
+			var toJSON() const;
+
+			int numRendered = 0;
+			int numRenderedSynchronously = 0;
+			int numReused = 0;
+			double lastRenderMs = 0.0;
+			double averageRenderMs = 0.0;
+			double maxRenderMs = 0.0;
+			double lastCompositeMs = 0.0;
+		};
+
+		/** Holds the last rasterised image of the panel. This is shared with the background jobs, so it will outlive the handler if a job is still running. */
+		struct Rasteriser : public ReferenceCountedObject
+		{
+			using Ptr = ReferenceCountedObjectPtr<Rasteriser>;
+
+			struct Key
+			{
+				bool operator==(const Key& other) const
+				{
+					return hash == other.hash && width == other.width && height == other.height && scaleFactor == other.scaleFactor;
+				}
+
+				uint64 hash = 0;
+				int width = 0;
+				int height = 0;
+				float scaleFactor = 0.0f;
+			};
+
+			CriticalSection lock;
+			Image image;
+			Key imageKey;
+
+			// The images are hashed by their pixel data, so the actions of the current image are kept
+			// alive to make sure that the pixel data can't be reallocated at the same address.
+			ReferenceCountedArray<ActionBase> imageActions;
+
+			bool jobPending = false;
+			RenderStatistics stats;
+		};
+
+		/** The thread pool that is shared between all panels that are rendered off the message thread. */
+		struct RasteriserPool
+		{
+			RasteriserPool() :
+				pool(jmax(1, SystemStats::getNumCpus() / 2))
+			{}
+
+			ThreadPool pool;
+		};
+
 		struct Iterator
 		{
 			Iterator(Handler* handler_):
@@ -492,6 +621,7 @@ struct DrawActions
 					SpinLock::ScopedLockType sl(handler->lock);
 
 					actionsInIterator.addArray(handler->nextActions);
+					hash = handler->nextHash;
 				}
 			}
 
@@ -523,8 +653,21 @@ struct DrawActions
 
 			void render(Graphics& g, Component* c);
 
+			/** Draws the rasterised image of the actions if the handler renders off the message thread.
+
+				If the actions have changed, it will draw the last image and start a background job that
+				triggers a repaint when it's done. While a job is pending, this will always draw the last
+				image because the job modifies the actions. Returns false if the actions must be rendered
+				with render().
+			*/
+			bool renderRasterised(Graphics& g, Component* c);
+
+			/** Renders the actions into the (cached) image with the given scale factor. */
+			static void renderToImage(const ReferenceCountedArray<ActionBase>& actions, Image& cachedImg, float sf);
+
 			int index = 0;
 			ReferenceCountedArray<ActionBase> actionsInIterator;
+			HashBuilder hash;
 			Handler* handler;
 		};
 
@@ -576,9 +719,20 @@ struct DrawActions
 
 		void flush()
 		{
+			HashBuilder h;
+
+			if (renderOffThread)
+			{
+				for (auto a : currentActions)
+					h.addAction(*a);
+			}
+			else
+				h.invalidate();
+
 			{
 				SpinLock::ScopedLockType sl(lock);
 
+				nextHash = h;
 				nextActions.swapWith(currentActions);
 				currentActions.clear();
 				layerStack.clear();
@@ -614,10 +768,25 @@ struct DrawActions
 
 		NoiseMapManager* getNoiseMapManager() { return &noiseManager.getObject(); }
 
+		/** Enables the rasterisation of the draw actions on a background thread. Call this on the message thread. */
+		void setRenderOffThread(bool shouldRenderOffThread);
+
+		bool isRenderingOffThread() const noexcept { return renderOffThread; }
+
+		/** Returns the timing statistics of the off-thread rendering. */
+		RenderStatistics getRenderStatistics() const;
+
 	private:
 
+		struct RenderJob;
+
 		SharedResourcePointer<NoiseMapManager> noiseManager;
 
+		std::atomic<bool> renderOffThread { false };
+		Rasteriser::Ptr rasteriser = new Rasteriser();
+		ScopedPointer<SharedResourcePointer<RasteriserPool>> rasteriserPool;
+		HashBuilder nextHash;
+
 		Rectangle<int> globalBounds;
 		Rectangle<int> topLevelBounds;
 		float scaleFactor = 1.0f;
@@ -708,10 +877,27 @@ public:
 #if HISE_INCLUDE_RLOTTIE
 	void setAnimation(RLottieAnimation::Ptr newAnimation)
 	{
+		if (animation != nullptr)
+			animation->removeListener(&animationRepainter);
+
 		animation = newAnimation;
+
+		if (animation != nullptr)
+			animation->addListener(&animationRepainter);
 	}
 
+	/** Repaints the panel when a frame of the animation was rendered on the background thread. */
+	struct AnimationRepainter : public RLottieAnimation::Listener
+	{
+		AnimationRepainter(Component& c_) : c(c_) {};
+
+		void animationFrameRendered(RLottieAnimation*) override { c.repaint(); }
+
+		Component& c;
+	};
+
 	RLottieAnimation::Ptr animation;
+	AnimationRepainter animationRepainter{ *this };
 #endif
 
 	// ================================================================================================================
@@ -52,7 +52,9 @@ MainController::SampleManager::SampleManager(MainController *mc_) :
 	preloadFlag(false),
 	pendingFunctions(8192)
 {
-	
+#if HISE_NUM_PRELOAD_THREADS > 0
+	preloadThreadPool = new ThreadPool(HISE_NUM_PRELOAD_THREADS);
+#endif
 }
 
 
@@ -64,6 +66,8 @@ MainController::SampleManager::~SampleManager()
 	internalPreloadJob.signalJobShouldExit();
 	samplerLoaderThreadPool->stopThread(2000);
 
+	preloadThreadPool = nullptr;
+
 	pendingFunctions.clear();
 
 	jassert(pendingFunctions.isEmpty());
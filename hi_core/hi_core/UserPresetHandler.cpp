@@ -40,37 +40,224 @@ void MainController::UserPresetHandler::TagDataBase::buildDataBase(bool force /*
 	}
 }
 
+static bool isFavoriteInDataBase(const var& favoriteDataBase, const File& presetFile)
+{
+	if (auto data = favoriteDataBase.getDynamicObject())
+	{
+		auto id = PresetBrowser::DataBaseHelpers::getIdForFile(presetFile);
+
+		if (!id.isNull())
+		{
+			if (auto entry = data->getProperty(id).getDynamicObject())
+				return (bool)entry->getProperty("Favorite");
+		}
+	}
+
+	return false;
+}
+
 void MainController::UserPresetHandler::TagDataBase::buildInternal()
 {
-	cachedTags.clear();
+	if (!indexLoaded)
+		loadIndex();
 
-	Array<File> allPresets;
+	HashMap<int64, int> previousIndexes;
 
-	root.findChildFiles(allPresets, File::findFiles, true, "*.preset");
+	for (int i = 0; i < cachedTags.size(); i++)
+		previousIndexes.set(cachedTags[i].hashCode, i);
 
-	PresetBrowser::DataBaseHelpers::cleanFileList(nullptr, allPresets);
+	Array<CachedTag> newTags;
+	newTags.ensureStorageAllocated(cachedTags.size());
 
-	for (auto f : allPresets)
+	bool indexChanged = false;
+
+	if (root.isDirectory())
 	{
-		auto sa = PresetBrowser::DataBaseHelpers::getTagsFromXml(f);
+		for (const auto& entry : RangedDirectoryIterator(root, true, "*.preset", File::findFiles))
+		{
+			auto f = entry.getFile();
+
+			if (entry.isHidden() || f.getFileName().startsWith("."))
+				continue;
+
+			auto hash = f.hashCode64();
+			auto modificationTime = entry.getModificationTime().toMilliseconds();
+			auto fileSize = entry.getFileSize();
+
+			CachedTag* previous = nullptr;
+
+			if (previousIndexes.contains(hash))
+				previous = &cachedTags.getReference(previousIndexes[hash]);
 
-		CachedTag newTag;
-		newTag.hashCode = f.hashCode64();
-		for (auto t : sa)
-			newTag.tags.add(Identifier(t));
+			if (previous != nullptr && previous->modificationTime == modificationTime && previous->fileSize == fileSize)
+			{
+				newTags.add(std::move(*previous));
+				continue;
+			}
+
+			CachedTag newTag;
+			newTag.hashCode = hash;
+			newTag.file = f;
+			newTag.modificationTime = modificationTime;
+			newTag.fileSize = fileSize;
+
+			if (favoriteDataBase.isObject())
+				newTag.favorite = isFavoriteInDataBase(favoriteDataBase, f);
+			else if (previous != nullptr)
+				newTag.favorite = previous->favorite;
+
+			for (auto t : PresetBrowser::DataBaseHelpers::getTagsFromXml(f))
+				newTag.tags.add(Identifier(t));
+
+			newTags.add(std::move(newTag));
+			indexChanged = true;
+		}
+	}
+
+	indexChanged |= newTags.size() != cachedTags.size();
 
-		cachedTags.add(std::move(newTag));
+	if (favoritesDirty)
+	{
+		for (auto& t : newTags)
+		{
+			auto isFavorite = isFavoriteInDataBase(favoriteDataBase, t.file);
+			indexChanged |= isFavorite != t.favorite;
+			t.favorite = isFavorite;
+		}
+
+		favoritesDirty = false;
 	}
 
+	cachedTags.swapWith(newTags);
+
+	if (indexChanged)
+		saveIndex();
+
 	dirty = false;
 }
 
+void MainController::UserPresetHandler::TagDataBase::loadIndex()
+{
+	indexLoaded = true;
+	cachedTags.clear();
+
+	FileInputStream fis(getIndexFile());
+
+	if (!fis.openedOk())
+		return;
+
+	auto v = ValueTree::readFromStream(fis);
+
+	if (!v.hasType("PresetIndex") || (int)v.getProperty("Version", 0) != 1)
+		return;
+
+	cachedTags.ensureStorageAllocated(v.getNumChildren());
+
+	for (auto c : v)
+	{
+		CachedTag t;
+		t.file = root.getChildFile(c["File"].toString());
+		t.hashCode = t.file.hashCode64();
+		t.modificationTime = (int64)c["ModificationTime"];
+		t.fileSize = (int64)c["Size"];
+		t.favorite = (bool)c["Favorite"];
+
+		for (auto tag : StringArray::fromTokens(c["Tags"].toString(), ";", ""))
+		{
+			if (tag.isNotEmpty())
+				t.tags.add(Identifier(tag));
+		}
+
+		cachedTags.add(std::move(t));
+	}
+}
+
+void MainController::UserPresetHandler::TagDataBase::saveIndex() const
+{
+	if (!root.isDirectory())
+		return;
+
+	ValueTree v("PresetIndex");
+	v.setProperty("Version", 1, nullptr);
+
+	for (const auto& t : cachedTags)
+	{
+		StringArray sa;
+
+		for (const auto& tag : t.tags)
+			sa.add(tag.toString());
+
+		ValueTree c("Preset");
+		c.setProperty("File", t.file.getRelativePathFrom(root), nullptr);
+		c.setProperty("ModificationTime", t.modificationTime, nullptr);
+		c.setProperty("Size", t.fileSize, nullptr);
+		c.setProperty("Tags", sa.joinIntoString(";"), nullptr);
+		c.setProperty("Favorite", t.favorite, nullptr);
+		v.addChild(c, -1, nullptr);
+	}
+
+	FileOutputStream fos(getIndexFile());
+
+	if (fos.openedOk())
+	{
+		fos.setPosition(0);
+		fos.truncate();
+		v.writeToStream(fos);
+	}
+}
+
+void MainController::UserPresetHandler::TagDataBase::invalidateFile(const File& presetFile)
+{
+	auto hash = presetFile.hashCode64();
+
+	for (int i = 0; i < cachedTags.size(); i++)
+	{
+		if (cachedTags[i].hashCode == hash)
+		{
+			cachedTags.remove(i);
+			break;
+		}
+	}
+
+	dirty = true;
+}
+
+void MainController::UserPresetHandler::TagDataBase::setFavoriteDataBase(const var& newFavoriteDataBase)
+{
+	favoriteDataBase = newFavoriteDataBase;
+	favoritesDirty = true;
+}
+
+void MainController::UserPresetHandler::TagDataBase::setFavorite(const File& presetFile, bool isFavorite)
+{
+	auto hash = presetFile.hashCode64();
+
+	for (auto& t : cachedTags)
+	{
+		if (t.hashCode == hash && t.favorite != isFavorite)
+		{
+			t.favorite = isFavorite;
+			saveIndex();
+			break;
+		}
+	}
+}
+
+void MainController::UserPresetHandler::TagDataBase::clearIndex()
+{
+	getIndexFile().deleteFile();
+	cachedTags.clear();
+	indexLoaded = true;
+	dirty = true;
+}
+
 void MainController::UserPresetHandler::TagDataBase::setRootDirectory(const File& newRoot)
 {
 
 	if (root != newRoot)
 	{
 		root = newRoot;
+		indexLoaded = false;
 		dirty = true;
 	}
 }
@@ -885,4 +1072,118 @@ void MainController::UserPresetHandler::FactoryPaths::addRecursive(const ValueTr
 
 
 
+#if HI_RUN_UNIT_TESTS
+
+class PresetIndexTest : public UnitTest
+{
+public:
+
+	using TagDataBase = MainController::UserPresetHandler::TagDataBase;
+
+	PresetIndexTest() : UnitTest("Testing preset index", "presets") {}
+
+	void runTest() override
+	{
+		auto root = File::getSpecialLocation(File::tempDirectory).getChildFile("PresetIndexTest");
+		root.deleteRecursively();
+
+		const int numPresets = 2000;
+
+		for (int i = 0; i < numPresets; i++)
+			writePreset(getPresetFile(root, i), i % 2 == 0 ? "Bass;Dark" : "Lead");
+
+		double fullTime = 0.0;
+		double incrementalTime = 0.0;
+
+		{
+			beginTest("Full rescan");
+
+			TagDataBase db;
+			db.setRootDirectory(root);
+			db.clearIndex();
+
+			auto start = Time::getMillisecondCounterHiRes();
+			db.buildDataBase(true);
+			fullTime = Time::getMillisecondCounterHiRes() - start;
+
+			expectEquals(db.getCachedTags().size(), numPresets, "all presets found");
+			expect(db.getIndexFile().existsAsFile(), "index file written");
+		}
+
+		TagDataBase db;
+		db.setRootDirectory(root);
+
+		{
+			beginTest("Incremental rescan from the index");
+
+			auto start = Time::getMillisecondCounterHiRes();
+			db.buildDataBase(true);
+			incrementalTime = Time::getMillisecondCounterHiRes() - start;
+
+			expectEquals(db.getCachedTags().size(), numPresets, "all presets restored");
+			expect(getTags(db, getPresetFile(root, 2)).contains(Identifier("Dark")), "tags restored");
+			expect(getTags(db, getPresetFile(root, 3)).contains(Identifier("Lead")), "tags restored");
+
+			logMessage("Full rescan: " + String(fullTime, 1) + "ms, incremental rescan: " + String(incrementalTime, 1) + "ms");
+		}
+
+		{
+			beginTest("Modified presets are parsed again");
+
+			auto f = getPresetFile(root, 0);
+			writePreset(f, "Pad");
+			f.setLastModificationTime(Time::getCurrentTime() + RelativeTime::seconds(10.0));
+
+			db.buildDataBase(true);
+
+			auto tags = getTags(db, f);
+			expect(tags.contains(Identifier("Pad")), "new tag found");
+			expect(!tags.contains(Identifier("Bass")), "old tag removed");
+		}
+
+		{
+			beginTest("Removed presets");
+
+			getPresetFile(root, 1).deleteFile();
+			db.buildDataBase(true);
+
+			expectEquals(db.getCachedTags().size(), numPresets - 1, "preset removed from index");
+		}
+
+		root.deleteRecursively();
+	}
+
+private:
+
+	static File getPresetFile(const File& root, int index)
+	{
+		return root.getChildFile("Bank" + String(index / 200))
+				   .getChildFile("Category" + String(index % 10))
+				   .getChildFile("Preset" + String(index) + ".preset");
+	}
+
+	static void writePreset(const File& f, const String& tags)
+	{
+		f.getParentDirectory().createDirectory();
+		f.replaceWithText("<Preset Version=\"1.0.0\" Tags=\"" + tags + "\"/>");
+	}
+
+	static Array<Identifier> getTags(const TagDataBase& db, const File& f)
+	{
+		auto hash = f.hashCode64();
+
+		for (const auto& t : db.getCachedTags())
+		{
+			if (t.hashCode == hash)
+				return t.tags;
+		}
+
+		return {};
+	}
+};
+
+static PresetIndexTest presetIndexTest;
+
+#endif
+
 } // namespace hise
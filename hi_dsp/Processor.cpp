@@ -233,6 +233,8 @@ void Processor::setIsOnAir(bool shouldBeOnAir)
 
 	onAir = shouldBeOnAir;
 
+	getMainController()->bumpProcessorTreeVersion();
+
 	for (int i = 0; i < getNumChildProcessors(); i++)
 	{
 		getChildProcessor(i)->setIsOnAir(shouldBeOnAir);
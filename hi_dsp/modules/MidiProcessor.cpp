@@ -698,6 +698,10 @@ void MidiProcessorChain::renderNextHiseEventBuffer(HiseEventBuffer &buffer, int
 	artificialEvents.subtractFromTimeStamps(numSamples);
 
 	logEvents(buffer, false);
+
+	auto& logger = getMainController()->getDebugLogger();
+	logger.checkEventBuffer(this, DebugLogger::Location::ScriptMidiEventCallback, buffer);
+	logger.checkEventBuffer(this, DebugLogger::Location::ScriptMidiEventCallback, artificialEvents);
 }
 
 void MidiProcessorChain::logEvents(HiseEventBuffer& buffer, bool isBefore)
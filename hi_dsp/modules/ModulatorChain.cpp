@@ -195,6 +195,7 @@ ModulatorChain::ModChainWithBuffer::ModChainWithBuffer(ConstructionData data) :
 {
 	FloatVectorOperations::fill(currentConstantVoiceValues, c->getInitialValue(), NUM_POLYPHONIC_VOICES);
 	FloatVectorOperations::fill(currentRampValues, c->getInitialValue(), NUM_POLYPHONIC_VOICES);
+	memset(voiceIsBatched, 0, sizeof(voiceIsBatched));
 
 	if (data.t == Type::VoiceStartOnly)
 		c->setIsVoiceStartChain(true);
@@ -214,7 +215,28 @@ void ModulatorChain::ModChainWithBuffer::prepareToPlay(double sampleRate, int sa
 	c->prepareToPlay(sampleRate, samplesPerBlock);
 
 	if (type == Type::Normal)
+	{
 		modBuffer.setMaxSize(samplesPerBlock);
+
+		if (options.useVoiceBatch)
+		{
+			const int numRows = jmin(NUM_POLYPHONIC_VOICES, c->polyManager.getVoiceAmount());
+			const int rowSize = getVoiceBatchRowSize(samplesPerBlock);
+
+			if (numRows != numBatchRows || rowSize > batchRowSize)
+			{
+				batchData.calloc(numRows * rowSize + dsp::SIMDRegister<float>::SIMDNumElements);
+				batchVoicePointers.calloc(numRows);
+				batchModulatorPointers.calloc(numRows);
+
+				batchRowSize = rowSize;
+				numBatchRows = numRows;
+			}
+
+			numBatchVoices = 0;
+			memset(voiceIsBatched, 0, sizeof(voiceIsBatched));
+		}
+	}
 }
 
 void ModulatorChain::ModChainWithBuffer::handleHiseEvent(const HiseEvent& m)
@@ -321,6 +343,27 @@ void ModulatorChain::ModChainWithBuffer::setExpandToAudioRate(bool shouldExpandA
 	options.expandToAudioRate = shouldExpandAfterRendering;
 }
 
+void ModulatorChain::ModChainWithBuffer::setUseVoiceBatch(bool shouldUseVoiceBatch)
+{
+	options.useVoiceBatch = shouldUseVoiceBatch;
+}
+
+void ModulatorChain::ModChainWithBuffer::setVoiceBatchScratchBuffer(float* newScratchBuffer, int numFloats) noexcept
+{
+	batchScratchData = newScratchBuffer;
+	batchScratchSize = newScratchBuffer != nullptr ? numFloats : 0;
+}
+
+int ModulatorChain::ModChainWithBuffer::getVoiceBatchScratchSize(int numVoices, int samplesPerBlock)
+{
+	return jmin(NUM_POLYPHONIC_VOICES, numVoices) * getVoiceBatchRowSize(samplesPerBlock) + dsp::SIMDRegister<float>::SIMDNumElements;
+}
+
+int ModulatorChain::ModChainWithBuffer::getVoiceBatchRowSize(int samplesPerBlock)
+{
+	return roundToInt(std::ceil((double)samplesPerBlock / (double)HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR / 16.0)) * 16;
+}
+
 
 void ModulatorChain::ModChainWithBuffer::calculateMonophonicModulationValues(int startSample, int numSamples)
 {
@@ -360,6 +403,100 @@ void ModulatorChain::ModChainWithBuffer::calculateMonophonicModulationValues(int
 
 
 
+void ModulatorChain::ModChainWithBuffer::calculateConstantVoiceValues(int voiceIndex, float* voiceData, int numSamples)
+{
+	const float thisConstantValue = c->getConstantVoiceValue(voiceIndex);
+	const float previousConstantValue = currentConstantVoiceValues[voiceIndex];
+
+	const bool smoothConstantValue = (std::abs(previousConstantValue - thisConstantValue) > 0.01f);
+
+	if (smoothConstantValue)
+	{
+		const float start = previousConstantValue;
+		const float delta = (thisConstantValue - start) / (float)numSamples;
+		int numLoop = numSamples;
+		float value = start;
+		float* loop_ptr = voiceData;
+
+		while (--numLoop >= 0)
+		{
+			*loop_ptr++ = value;
+			value += delta;
+		}
+	}
+	else
+	{
+		FloatVectorOperations::fill(voiceData, thisConstantValue, numSamples);
+	}
+
+	setConstantVoiceValueInternal(voiceIndex, thisConstantValue);
+}
+
+void ModulatorChain::ModChainWithBuffer::calculateModulationValuesForVoices(const int* voiceIndexes, int numVoices, int startSample, int numSamples)
+{
+	// Discard the values of the last batch that weren't picked up
+	for (int i = 0; i < numBatchVoices; i++)
+		voiceIsBatched[batchVoiceIndexes[i]] = false;
+
+	numBatchVoices = 0;
+
+	if (!options.useVoiceBatch || c->isVoiceStartChain || batchData == nullptr)
+		return;
+
+	if (batchScratchSize < numBatchRows * batchRowSize)
+		return;
+
+	if (!c->hasActivePolyMods() || !c->hasActivePolyEnvelopes())
+		return;
+
+	jassert(startSample % HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR == 0);
+
+	const int startSample_cr = startSample / HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR;
+	const int numSamples_cr = numSamples / HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR;
+
+	if (startSample_cr + numSamples_cr > batchRowSize)
+	{
+		jassertfalse;
+		return;
+	}
+
+	for (int i = 0; i < numVoices; i++)
+	{
+		const int voiceIndex = voiceIndexes[i];
+
+		// Voices outside the buffer will be calculated one by one
+		if (!isPositiveAndBelow(voiceIndex, numBatchRows))
+			continue;
+
+		auto voiceData = getBatchValues(voiceIndex);
+
+		calculateConstantVoiceValues(voiceIndex, voiceData + startSample_cr, numSamples_cr);
+
+		batchVoiceIndexes[numBatchVoices] = voiceIndex;
+		batchVoicePointers[numBatchVoices] = voiceData;
+		batchModulatorPointers[numBatchVoices] = batchScratchData + numBatchVoices * batchRowSize;
+		numBatchVoices++;
+	}
+
+	EnvelopeModulator::VoiceBatch batch;
+	batch.voiceIndexes = batchVoiceIndexes;
+	batch.values = batchModulatorPointers.get();
+	batch.numVoices = numBatchVoices;
+
+	ModIterator<EnvelopeModulator> iter(c);
+
+	while (auto mod = iter.next())
+	{
+		mod->renderVoiceBatch(batch, batchVoicePointers.get(), startSample_cr, numSamples_cr);
+	}
+
+	for (int i = 0; i < numBatchVoices; i++)
+		voiceIsBatched[batchVoiceIndexes[i]] = true;
+
+	batchStartSample = startSample_cr;
+	batchNumSamples = numSamples_cr;
+}
+
 void ModulatorChain::ModChainWithBuffer::calculateModulationValuesForCurrentVoice(int voiceIndex, int startSample, int numSamples)
 {
 	if (c->isVoiceStartChain)
@@ -382,45 +519,37 @@ void ModulatorChain::ModChainWithBuffer::calculateModulationValuesForCurrentVoic
 	int startSample_cr = startSample / HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR;
 	int numSamples_cr = numSamples / HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR;
 
-	bool constantValuesAreSmoothed = false;
-
 	if (c->hasActivePolyMods())
 	{
-		const float thisConstantValue = c->getConstantVoiceValue(voiceIndex);
-		const float previousConstantValue = currentConstantVoiceValues[voiceIndex];
+		const bool useBatchValues = voiceIsBatched[voiceIndex] && 
+									batchStartSample == startSample_cr && 
+									batchNumSamples == numSamples_cr;
 
-		const bool smoothConstantValue = (std::abs(previousConstantValue - thisConstantValue) > 0.01f);
+		jassert(!voiceIsBatched[voiceIndex] || useBatchValues);
 
-		if (smoothConstantValue)
+		if (useBatchValues)
 		{
-			constantValuesAreSmoothed = true;
+			// The values were already calculated by calculateModulationValuesForVoices()
+			voiceIsBatched[voiceIndex] = false;
 
-			const float start = previousConstantValue;
-			const float delta = (thisConstantValue - start) / (float)numSamples_cr;
-			int numLoop = numSamples_cr;
-			float value = start;
-			float* loop_ptr = voiceData + startSample_cr;
-
-			while (--numLoop >= 0)
-			{
-				*loop_ptr++ = value;
-				value += delta;
-			}
+			FloatVectorOperations::copy(voiceData + startSample_cr, getBatchValues(voiceIndex) + startSample_cr, numSamples_cr);
+			setConstantVoiceValueInternal(voiceIndex, currentConstantVoiceValues[voiceIndex]);
 		}
 		else
 		{
-			FloatVectorOperations::fill(voiceData + startSample_cr, thisConstantValue, numSamples_cr);
+			calculateConstantVoiceValues(voiceIndex, voiceData + startSample_cr, numSamples_cr);
 		}
 
-		setConstantVoiceValueInternal(voiceIndex, thisConstantValue);
-
 		if (c->hasActivePolyEnvelopes())
 		{
-			ModIterator<EnvelopeModulator> iter(c);
-
-			while (auto mod = iter.next())
+			if (!useBatchValues)
 			{
-				mod->render(voiceIndex, voiceData, modBuffer.scratchBuffer, startSample_cr, numSamples_cr);
+				ModIterator<EnvelopeModulator> iter(c);
+
+				while (auto mod = iter.next())
+				{
+					mod->render(voiceIndex, voiceData, modBuffer.scratchBuffer, startSample_cr, numSamples_cr);
+				}
 			}
 
 			if (useMonophonicData)
@@ -171,6 +171,16 @@ public:
 		*/
 		void calculateModulationValuesForCurrentVoice(int voiceIndex, int startSample, int numSamples);
 
+		/** Calculates the polyphonic modulation values of all given voices at once.
+		*
+		*	Each envelope will calculate all voices with a single call to EnvelopeModulator::calculateVoiceBatch(). The
+		*	values are stored for each voice and picked up by the next call to calculateModulationValuesForCurrentVoice()
+		*	with the same range, so you still need to call that method for every voice.
+		*
+		*	This does nothing if the batch mode is disabled (see setUseVoiceBatch()) or there are no active polyphonic envelopes.
+		*/
+		void calculateModulationValuesForVoices(const int* voiceIndexes, int numVoices, int startSample, int numSamples);
+
 		/** This multiplies the modulation values with the given AudioSampleBuffer. 
 		*
 		*	Make sure you've expanded the values before using this.
@@ -258,6 +268,22 @@ public:
 		*/
 		void setExpandToAudioRate(bool shouldExpandAfterRendering);
 
+		/** Enables the batched calculation of the voice modulation values. Default is disabled.
+		*
+		*	This allocates a buffer for each voice in prepareToPlay(), so call it before the chain is prepared.
+		*/
+		void setUseVoiceBatch(bool shouldUseVoiceBatch);
+
+		/** Sets the buffer that the envelopes write their values into during calculateModulationValuesForVoices().
+		*
+		*	The values are only needed during this call, so all chains of a synth can share one buffer. If it's smaller
+		*	than getVoiceBatchScratchSize(), the voices will be calculated one by one.
+		*/
+		void setVoiceBatchScratchBuffer(float* newScratchBuffer, int numFloats) noexcept;
+
+		/** Returns the number of floats that the scratch buffer of the voice batch needs. */
+		static int getVoiceBatchScratchSize(int numVoices, int samplesPerBlock);
+
 		void expandVoiceValuesToAudioRate(int voiceIndex, int startSample, int numSamples);
 
 		void expandMonophonicValuesToAudioRate(int startSample, int numSamples);
@@ -272,6 +298,7 @@ public:
 			bool expandToAudioRate = false;
 			bool includeMonophonicValues = true;
 			bool voiceValuesReadOnly = true;
+			bool useVoiceBatch = false;
 		};
 
 		void setDisplayValue(float v);
@@ -282,6 +309,15 @@ public:
 
 		void setDisplayValueInternal(int voiceIndex, int startSample, int numSamples);
 
+		void calculateConstantVoiceValues(int voiceIndex, float* voiceData, int numSamples);
+
+		static int getVoiceBatchRowSize(int samplesPerBlock);
+
+		float* getBatchValues(int voiceIndex) const noexcept
+		{
+			return batchData.get() + voiceIndex * batchRowSize;
+		}
+
 		void setConstantVoiceValueInternal(int voiceIndex, float newValue)
 		{
 			lastConstantVoiceValue = newValue;
@@ -314,6 +350,23 @@ public:
 		float currentMonophonicRampValue;
 		float const* currentVoiceData = nullptr;
 
+		// The voice values of each voice for the batched calculation
+		HeapBlock<float> batchData;
+		HeapBlock<float*> batchVoicePointers;
+		HeapBlock<float*> batchModulatorPointers;
+		int batchRowSize = 0;
+		int numBatchRows = 0;
+
+		// The envelope values of the batched voices (owned by the synth)
+		float* batchScratchData = nullptr;
+		int batchScratchSize = 0;
+
+		int batchVoiceIndexes[NUM_POLYPHONIC_VOICES];
+		bool voiceIsBatched[NUM_POLYPHONIC_VOICES];
+		int numBatchVoices = 0;
+		int batchStartSample = 0;
+		int batchNumSamples = 0;
+
 		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ModChainWithBuffer);
 	};
 
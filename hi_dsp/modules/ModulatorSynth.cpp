@@ -382,12 +382,15 @@ void ModulatorSynth::renderNextBlockWithModulators(AudioSampleBuffer& outputBuff
 
 	int startSample = 0;
 
-	
-	initRenderCallback();
-
-	processHiseEventBuffer(inputMidiBuffer, numSamplesFixed);
-
-	
+	if (eventBufferIsPreprocessed)
+	{
+		eventBufferIsPreprocessed = false;
+	}
+	else
+	{
+		initRenderCallback();
+		processHiseEventBuffer(inputMidiBuffer, numSamplesFixed);
+	}
 
 	HiseEventBuffer::Iterator eventIterator(eventBuffer);
 
@@ -458,6 +461,14 @@ void ModulatorSynth::renderNextBlockWithModulators(AudioSampleBuffer& outputBuff
 	handlePeakDisplay(numSamplesFixed);
 }
 
+void ModulatorSynth::preprocessHiseEventBuffer(const HiseEventBuffer& inputMidi, int numSamples)
+{
+	initRenderCallback();
+	processHiseEventBuffer(inputMidi, numSamples);
+
+	eventBufferIsPreprocessed = true;
+}
+
 void ModulatorSynth::preVoiceRendering(int startSample, int numThisTime)
 {
 	for (auto& mb : modChains)
@@ -472,6 +483,8 @@ void ModulatorSynth::renderVoice(int startSample, int numThisTime)
     
 	clearPendingRemoveVoices();
 
+	calculateModulationValuesForActiveVoices(startSample, numThisTime);
+
 	for (auto v : activeVoices)
 	{
 		jassert(!v->isInactive());
@@ -485,6 +498,21 @@ void ModulatorSynth::renderVoice(int startSample, int numThisTime)
 };
 
 	
+void ModulatorSynth::calculateModulationValuesForActiveVoices(int startSample, int numThisTime)
+{
+	int numVoices = 0;
+
+	// Only batch the voices that are rendered, otherwise their envelopes would advance without being used
+	for (auto v : activeVoices)
+	{
+		if (!v->isInactive())
+			activeVoiceIndexes[numVoices++] = v->getVoiceIndex();
+	}
+
+	for (auto& mb : modChains)
+		mb.calculateModulationValuesForVoices(activeVoiceIndexes, numVoices, startSample, numThisTime);
+}
+
 void ModulatorSynth::calculateModulationValuesForVoice(ModulatorSynthVoice * v, int startSample, int numThisTime)
 {
 	auto index = v->getVoiceIndex();
@@ -517,6 +545,14 @@ void ModulatorSynth::calculateModulationValuesForVoice(ModulatorSynthVoice * v,
 	}
 }
 
+void ModulatorSynth::setUseVoiceBatch(bool shouldUseVoiceBatch)
+{
+	useVoiceBatch = shouldUseVoiceBatch;
+
+	for (auto& mb : modChains)
+		mb.setUseVoiceBatch(shouldUseVoiceBatch);
+}
+
 void ModulatorSynth::clearPendingRemoveVoices()
 {
 	for (auto v : pendingRemoveVoices)
@@ -829,6 +865,20 @@ void ModulatorSynth::prepareToPlay(double newSampleRate, int samplesPerBlock)
 		
 		midiProcessorChain->prepareToPlay(newSampleRate, samplesPerBlock);
 
+		if (useVoiceBatch)
+		{
+			const int numFloats = ModulatorChain::ModChainWithBuffer::getVoiceBatchScratchSize(getNumVoices(), samplesPerBlock);
+
+			if (numFloats > voiceBatchScratchSize)
+			{
+				voiceBatchScratch.calloc(numFloats);
+				voiceBatchScratchSize = numFloats;
+			}
+
+			for (auto& mb : modChains)
+				mb.setVoiceBatchScratchBuffer(voiceBatchScratch.get(), voiceBatchScratchSize);
+		}
+
 		for (auto& mb : modChains)
 			mb.prepareToPlay(newSampleRate, samplesPerBlock);
 
@@ -941,6 +991,10 @@ void ModulatorSynth::finaliseModChains()
 	modChains[BasicChains::GainChain].setExpandToAudioRate(true);
 	modChains[BasicChains::PitchChain].setExpandToAudioRate(true);
 
+#if HISE_BATCH_VOICE_MODULATION
+	setUseVoiceBatch(true);
+#endif
+
 	pitchChain->getFactoryType()->setConstrainer(new NoGlobalEnvelopeConstrainer());
 
 	gainChain->setTableValueConverter(Modulation::getValueAsDecibel);
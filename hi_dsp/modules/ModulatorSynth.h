@@ -163,6 +163,13 @@ public:
 	*/
 	virtual void renderNextBlockWithModulators(AudioSampleBuffer& outputAudio, const HiseEventBuffer& inputMidi);
 
+	/** Copies the incoming events and runs the MidiProcessorChain without rendering the voices.
+	*
+	*	The next call to renderNextBlockWithModulators() will skip this step. The ModulatorSynthChain uses this in order
+	*	to run the MIDI processors on the audio thread before the voices are rendered on another thread.
+	*/
+	virtual void preprocessHiseEventBuffer(const HiseEventBuffer& inputMidi, int numSamples);
+
 	/** This method is called to handle all modulatorchains just before the voice rendering. */
 	virtual void preVoiceRendering(int startSample, int numThisTime);;
 
@@ -171,6 +178,12 @@ public:
 
 	void calculateModulationValuesForVoice(ModulatorSynthVoice * v, int startSample, int numThisTime);;
 
+	/** Calculates the envelopes of all active voices at once before the voices are rendered. */
+	void calculateModulationValuesForActiveVoices(int startSample, int numThisTime);
+
+	/** Enables the batched calculation of the voice modulation (see HISE_BATCH_VOICE_MODULATION). Call this before prepareToPlay(). */
+	void setUseVoiceBatch(bool shouldUseVoiceBatch);
+
 	void clearPendingRemoveVoices();
 
 	/** This method is called to handle all modulatorchains after the voice rendering and handles the GUI metering. It assumes stereo mode.
@@ -488,6 +501,13 @@ private:
 
 	VoiceStack pendingRemoveVoices;
 
+	int activeVoiceIndexes[NUM_POLYPHONIC_VOICES];
+
+	// The envelope values of the voice batch, shared by all modulation chains
+	HeapBlock<float> voiceBatchScratch;
+	int voiceBatchScratchSize = 0;
+	bool useVoiceBatch = false;
+
 protected:
 
 	virtual bool synthNeedsEnvelope() const { return true; };
@@ -497,6 +517,8 @@ protected:
 
 	bool finalised = false;
 
+	bool eventBufferIsPreprocessed = false;
+
 	bool checkTimerCallback(int timerIndex, int numSamplesThisBlock) const noexcept
 	{
         if(!anyTimerActive)
@@ -32,6 +32,266 @@
 
 namespace hise { using namespace juce;
 
+struct ModulatorSynthChain::ParallelRenderer
+{
+	struct Slot
+	{
+		ModulatorSynth* synth = nullptr;
+		bool canRenderInParallel = false;
+		AudioSampleBuffer buffer;
+	};
+
+	struct Worker : public Thread
+	{
+		Worker(ParallelRenderer& parent_, int index) :
+			Thread("Synth Rendering Thread " + String(index)),
+			parent(parent_)
+		{};
+
+		void run() override
+		{
+			auto& ksh = parent.chain.getMainController()->getKillStateHandler();
+
+			ksh.addThreadIdToAudioThreadList();
+
+			while (!threadShouldExit())
+			{
+				wait(100);
+				parent.renderPendingJobs();
+			}
+
+			ksh.removeThreadIdFromAudioThreadList();
+		}
+
+		ParallelRenderer& parent;
+	};
+
+	ParallelRenderer(ModulatorSynthChain& chain_, int numThreads) :
+		chain(chain_)
+	{
+		for (int i = 0; i < numThreads; i++)
+		{
+			auto w = workers.add(new Worker(*this, i + 1));
+			w->startThread(10);
+		}
+	}
+
+	~ParallelRenderer()
+	{
+		for (auto w : workers)
+			w->signalThreadShouldExit();
+
+		for (auto w : workers)
+		{
+			w->notify();
+			w->stopThread(1000);
+		}
+	}
+
+	/** Resizes the buffers. Call this whenever the channel amount, the block size or the child synth list changes. */
+	void prepare()
+	{
+		const int numChannels = chain.getMatrix().getNumSourceChannels();
+		const int numSamples = jmax(0, chain.getLargestBlockSize());
+
+		while (slots.size() < chain.synths.size())
+			slots.add(new Slot());
+
+		for (auto s : slots)
+			s->buffer.setSize(numChannels, numSamples);
+
+		jobs.clearQuick();
+		jobs.insertMultiple(0, nullptr, slots.size());
+
+		slotsToAdd.clearQuick();
+		slotsToAdd.insertMultiple(0, nullptr, slots.size());
+
+		treeVersion = -1;
+	}
+
+	static bool hasCrossSynthDependency(const Processor* p)
+	{
+		if (dynamic_cast<const JavascriptProcessor*>(p) != nullptr ||
+			dynamic_cast<const GlobalModulator*>(p) != nullptr ||
+			dynamic_cast<const SendEffect*>(p) != nullptr ||
+			dynamic_cast<const HotswappableProcessor*>(p) != nullptr)
+			return true;
+
+		for (int i = 0; i < p->getNumChildProcessors(); i++)
+		{
+			if (hasCrossSynthDependency(p->getChildProcessor(i)))
+				return true;
+		}
+
+		return false;
+	}
+
+	static bool canRenderInParallel(const ModulatorSynth* s)
+	{
+		if (dynamic_cast<const ModulatorSynthChain*>(s) != nullptr ||
+			dynamic_cast<const SendContainer*>(s) != nullptr ||
+			dynamic_cast<const GlobalModulatorContainer*>(s) != nullptr ||
+			dynamic_cast<const MacroModulationSource*>(s) != nullptr ||
+			dynamic_cast<const JavascriptProcessor*>(s) != nullptr)
+			return false;
+
+		// The MIDI processors are processed serially so we can skip the MIDI chain here...
+		for (int i = ModulatorSynth::MidiProcessor + 1; i < s->getNumChildProcessors(); i++)
+		{
+			if (hasCrossSynthDependency(s->getChildProcessor(i)))
+				return false;
+		}
+
+		return true;
+	}
+
+	/** Checks which child synths can be rendered in parallel. This walks the processor tree without allocating, so it can be called on the audio thread. */
+	void updateDependencies()
+	{
+		treeVersion = chain.getMainController()->getProcessorTreeVersion();
+		forceSerialRendering = false;
+
+		for (int i = 0; i < slots.size(); i++)
+		{
+			auto s = chain.synths[i];
+
+			slots[i]->synth = s;
+			slots[i]->canRenderInParallel = s != nullptr && canRenderInParallel(s);
+
+			// A macro modulation source can change any parameter, so we need to render everything serially.
+			if (dynamic_cast<MacroModulationSource*>(s) != nullptr)
+				forceSerialRendering = true;
+		}
+	}
+
+	/** Renders the child synths into the given buffer.
+	*
+	*	The synths that depend on other synths are rendered in the original order on the audio thread, all other synths
+	*	are rendered on the worker threads. As soon as one synth was handed over to the workers, every following synth
+	*	renders into its own buffer, which is added to the output in the order of the child synth list (so the result is
+	*	the same as with serial rendering).
+	*/
+	void renderSynths(AudioSampleBuffer& output, const HiseEventBuffer& eventBuffer, int numSamples)
+	{
+		if (treeVersion != chain.getMainController()->getProcessorTreeVersion())
+			updateDependencies();
+
+		int numJobs = 0;
+		int numSlotsToAdd = 0;
+
+		for (int i = 0; i < chain.synths.size(); i++)
+		{
+			auto s = chain.synths[i];
+
+			if (s->isSoftBypassed())
+				continue;
+
+			auto slot = slots[i];
+
+			const bool hasBuffer = slot != nullptr &&
+								   slot->synth == s &&
+								   slot->buffer.getNumChannels() == output.getNumChannels() &&
+								   slot->buffer.getNumSamples() >= numSamples;
+
+			if (hasBuffer && !forceSerialRendering && slot->canRenderInParallel)
+			{
+				s->preprocessHiseEventBuffer(eventBuffer, numSamples);
+				jobs.setUnchecked(numJobs++, slot);
+				slotsToAdd.setUnchecked(numSlotsToAdd++, slot);
+			}
+			else if (hasBuffer && numSlotsToAdd > 0)
+			{
+				AudioSampleBuffer b(slot->buffer.getArrayOfWritePointers(), slot->buffer.getNumChannels(), numSamples);
+				b.clear();
+
+				s->renderNextBlockWithModulators(b, eventBuffer);
+				slotsToAdd.setUnchecked(numSlotsToAdd++, slot);
+			}
+			else
+			{
+				jassert(numSlotsToAdd == 0);
+				s->renderNextBlockWithModulators(output, eventBuffer);
+			}
+		}
+
+		if (numJobs == 0)
+			return;
+
+		currentEventBuffer = &eventBuffer;
+		currentNumSamples = numSamples;
+		numFinishedJobs.store(0);
+		jobState.store((int64)numJobs << 32);
+
+		for (auto w : workers)
+			w->notify();
+
+		// The audio thread renders jobs until the queue is empty and then waits for the jobs that the workers are still rendering
+		renderPendingJobs();
+
+		for (int i = 0; numFinishedJobs.load() < numJobs; i++)
+		{
+			if (i < NumSpinIterations)
+				_mm_pause();
+			else
+				allJobsFinished.wait(1);
+		}
+
+		for (int i = 0; i < numSlotsToAdd; i++)
+		{
+			auto& b = slotsToAdd[i]->buffer;
+
+			for (int c = 0; c < output.getNumChannels(); c++)
+				FloatVectorOperations::add(output.getWritePointer(c, 0), b.getReadPointer(c, 0), numSamples);
+		}
+	}
+
+	/** Renders jobs until there are no more jobs left. This is called by the audio thread and the worker threads. */
+	void renderPendingJobs()
+	{
+		while (true)
+		{
+			// The upper 32 bits contain the number of jobs, the lower 32 bits the next job index.
+			// This makes sure that a late worker can't pick up a job index from the last block.
+			const auto state = jobState.fetch_add(1);
+			const int numJobs = (int)(state >> 32);
+			const int jobIndex = (int)(state & 0xFFFFFFFF);
+
+			if (jobIndex >= numJobs)
+				return;
+
+			auto slot = jobs[jobIndex];
+
+			AudioSampleBuffer b(slot->buffer.getArrayOfWritePointers(), slot->buffer.getNumChannels(), currentNumSamples);
+			b.clear();
+
+			slot->synth->renderNextBlockWithModulators(b, *currentEventBuffer);
+
+			if (numFinishedJobs.fetch_add(1) + 1 == numJobs)
+				allJobsFinished.signal();
+		}
+	}
+
+	/** The number of iterations the audio thread spins before it blocks until the last job has finished. */
+	static constexpr int NumSpinIterations = 4096;
+
+	ModulatorSynthChain& chain;
+
+	OwnedArray<Worker> workers;
+	OwnedArray<Slot> slots;
+	Array<Slot*> jobs;
+	Array<Slot*> slotsToAdd;
+
+	int treeVersion = -1;
+	bool forceSerialRendering = false;
+
+	const HiseEventBuffer* currentEventBuffer = nullptr;
+	int currentNumSamples = 0;
+
+	std::atomic<int64> jobState { 0 };
+	std::atomic<int> numFinishedJobs { 0 };
+	WaitableEvent allJobsFinished;
+};
+
 ModulatorSynthChain::ModulatorSynthChain(MainController *mc, const String &id, int numVoices_) :
 	MacroControlBroadcaster(this),
 	ModulatorSynth(mc, id, numVoices_),
@@ -70,6 +330,8 @@ ModulatorSynthChain::ModulatorSynthChain(MainController *mc, const String &id, i
 
 ModulatorSynthChain::~ModulatorSynthChain()
 {
+	parallelRenderer = nullptr;
+
 	modChains.clear();
 
 	getHandler()->clear();
@@ -120,6 +382,16 @@ void ModulatorSynthChain::prepareToPlay(double newSampleRate, int samplesPerBloc
 
 	for (auto s: synths)
 		s->prepareToPlay(newSampleRate, samplesPerBlock);
+
+	if (HISE_NUM_PARALLEL_SYNTH_THREADS > 0 && getMainController()->getMainSynthChain() == this)
+	{
+		ScopedLock sl(getMainController()->getLock());
+
+		if (parallelRenderer == nullptr)
+			parallelRenderer = new ParallelRenderer(*this, HISE_NUM_PARALLEL_SYNTH_THREADS);
+
+		parallelRenderer->prepare();
+	}
 }
 
 void ModulatorSynthChain::numSourceChannelsChanged()
@@ -138,7 +410,11 @@ void ModulatorSynthChain::numSourceChannelsChanged()
 
 	ModulatorSynth::numSourceChannelsChanged();
 
-	
+	if (parallelRenderer != nullptr)
+	{
+		ScopedLock sl(getMainController()->getLock());
+		parallelRenderer->prepare();
+	}
 }
 
 void ModulatorSynthChain::numDestinationChannelsChanged()
@@ -251,11 +527,18 @@ void ModulatorSynthChain::renderNextBlockWithModulators(AudioSampleBuffer &buffe
 #endif
 
 	// Process the Synths and add store their output in the internal buffer
-	for (int i = 0; i < synths.size(); i++)
-    {
-        if (!synths[i]->isSoftBypassed())
-            synths[i]->renderNextBlockWithModulators(internalBuffer, eventBuffer);
-    }
+	if (parallelRenderer != nullptr)
+	{
+		parallelRenderer->renderSynths(internalBuffer, eventBuffer, numSamples);
+	}
+	else
+	{
+		for (int i = 0; i < synths.size(); i++)
+		{
+			if (!synths[i]->isSoftBypassed())
+				synths[i]->renderNextBlockWithModulators(internalBuffer, eventBuffer);
+		}
+	}
 
 	HiseEventBuffer::Iterator eventIterator(eventBuffer);
 
@@ -544,6 +827,9 @@ void ModulatorSynthChain::ModulatorSynthChainHandler::add(Processor *newProcesso
 		LOCK_PROCESSING_CHAIN(synth);
 		ms->setIsOnAir(synth->isOnAir());
 		synth->synths.insert(index, ms);
+
+		if (synth->parallelRenderer != nullptr)
+			synth->parallelRenderer->prepare();
 	}
 
 	notifyListeners(Listener::ProcessorAdded, newProcessor);
@@ -96,6 +96,10 @@ private:
 *
 *	If you want to create a group of ModulatorSynths that share common Modulators / MidiProcessors, use a ModulatorSynthGroup instead.
 *
+*	If HISE_NUM_PARALLEL_SYNTH_THREADS is bigger than zero, the master container renders the child synths that do not depend on other
+*	synths (no scripts outside the MIDI processor chain, no global modulators, no send effects) on multiple threads. The MIDI processors of
+*	all child synths are still processed serially on the audio thread and the signals are summed in a deterministic order.
+*
 *	A ModulatorSynthChain also allows macro controls which can control any Parameter of every sub processor.
 *	
 */
@@ -231,6 +235,10 @@ public:
 
 private:
 
+	struct ParallelRenderer;
+
+	ScopedPointer<ParallelRenderer> parallelRenderer;
+
 	HiseEvent::ChannelFilterData activeChannels;
 	ModulatorSynthChainHandler handler;
 	int numVoices;
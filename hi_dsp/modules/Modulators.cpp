@@ -589,6 +589,42 @@ EnvelopeModulator::EnvelopeModulator(MainController *mc, const String &id, int v
 	parameterNames.add("Retrigger");
 };
 
+void EnvelopeModulator::calculateVoiceBatch(const VoiceBatch& batch, int startSample, int numSamples)
+{
+	for (int i = 0; i < batch.numVoices; i++)
+	{
+		polyManager.setCurrentVoice(batch.voiceIndexes[i]);
+		setScratchBuffer(batch.values[i], startSample + numSamples);
+		calculateBlock(startSample, numSamples);
+		polyManager.clearCurrentVoice();
+	}
+}
+
+void EnvelopeModulator::renderVoiceBatch(const VoiceBatch& batch, float* const* voiceBuffers, int startSample, int numSamples)
+{
+	calculateVoiceBatch(batch, startSample, numSamples);
+
+	for (int i = 0; i < batch.numVoices; i++)
+	{
+		const int voiceIndex = batch.voiceIndexes[i];
+		auto values = batch.values[i];
+
+		polyManager.setCurrentVoice(voiceIndex);
+		setScratchBuffer(values, startSample + numSamples);
+		applyTimeModulation(voiceBuffers[i], startSample, numSamples);
+
+#if ENABLE_ALL_PEAK_METERS
+		if (isMonophonic || polyManager.getLastStartedVoice() == voiceIndex)
+		{
+			setOutputValue(values[startSample]);
+			pushPlotterValues(values, startSample, numSamples);
+		}
+#endif
+
+		polyManager.clearCurrentVoice();
+	}
+}
+
 #pragma warning( pop )
 
 Processor *VoiceStartModulatorFactoryType::createProcessor(int typeIndex, const String &id)
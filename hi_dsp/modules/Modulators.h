@@ -914,6 +914,29 @@ public:
 		polyManager.clearCurrentVoice();
 	}
 
+	/** A list of voices that are calculated with one call to calculateVoiceBatch(). */
+	struct VoiceBatch
+	{
+		/** The indexes of the voices. */
+		const int* voiceIndexes = nullptr;
+
+		/** The buffer for each voice that receives the calculated values (the same data as the internal buffer in calculateBlock()). */
+		float* const* values = nullptr;
+
+		int numVoices = 0;
+	};
+
+	/** Calculates the values of all voices in the batch.
+	*
+	*	The default implementation calls calculateBlock() for each voice. Override this if your envelope can calculate
+	*	multiple voices at once (eg. by running a SIMD loop across the voice states). The values must be written
+	*	to batch.values[i] + startSample.
+	*/
+	virtual void calculateVoiceBatch(const VoiceBatch& batch, int startSample, int numSamples);
+
+	/** This is the batched version of render(). It calculates all voices and applies the values to the given voice buffers. */
+	void renderVoiceBatch(const VoiceBatch& batch, float* const* voiceBuffers, int startSample, int numSamples);
+
 protected:
 
 	int getNumPressedKeys() const
@@ -161,9 +161,278 @@ double MultithreadedConvolver::getResampleFactor(double sampleRate, double impul
 	}
 }
 
-MultithreadedConvolver* ConvolutionEffectBase::createNewEngine(audiofft::ImplementationType fftType)
+NonUniformConvolver::Stage::Stage(audiofft::ImplementationType fftType, size_t blockSize_, const fftconvolver::Sample* ir, size_t irLen) :
+	blockSize(blockSize_),
+	convolver(fftType),
+	input(blockSize_),
+	output(blockSize_),
+	precalculated(blockSize_),
+	state((int)Idle)
 {
-	auto newConvolver = new MultithreadedConvolver(fftType);
+	convolver.init(blockSize, ir, irLen);
+}
+
+void NonUniformConvolver::Stage::finish()
+{
+	if (tryToClaim())
+	{
+		render();
+		state.store((int)Idle);
+		return;
+	}
+
+	while (state.load() != (int)Idle)
+		Thread::yield();
+}
+
+NonUniformConvolver::WorkerPool::WorkerPool()
+{
+	auto numWorkers = jlimit(1, 4, SystemStats::getNumCpus() - 1);
+
+	for (int i = 0; i < numWorkers; i++)
+	{
+		auto w = workers.add(new Worker(*this, i));
+		w->startThread(9);
+	}
+}
+
+NonUniformConvolver::WorkerPool::~WorkerPool()
+{
+	for (auto w : workers)
+		w->signalThreadShouldExit();
+
+	for (auto w : workers)
+		w->stopThread(1000);
+}
+
+void NonUniformConvolver::WorkerPool::addStage(Stage* s)
+{
+	ScopedWriteLock sl(stageLock);
+	stages.addIfNotAlreadyThere(s);
+}
+
+void NonUniformConvolver::WorkerPool::removeStage(Stage* s)
+{
+	// The write lock waits until no worker is rendering anymore...
+	ScopedWriteLock sl(stageLock);
+	stages.removeAllInstancesOf(s);
+}
+
+void NonUniformConvolver::WorkerPool::notify()
+{
+	for (auto w : workers)
+		w->notify();
+}
+
+bool NonUniformConvolver::WorkerPool::renderNextStage()
+{
+	ScopedReadLock sl(stageLock);
+
+	while (true)
+	{
+		Stage* nextStage = nullptr;
+
+		for (auto s : stages)
+		{
+			if (s->state.load() == (int)Stage::Pending && (nextStage == nullptr || s->blockSize < nextStage->blockSize))
+				nextStage = s;
+		}
+
+		if (nextStage == nullptr)
+			return false;
+
+		// Another worker or the audio thread might have been faster...
+		if (nextStage->tryToClaim())
+		{
+			nextStage->render();
+			nextStage->state.store((int)Stage::Idle);
+			return true;
+		}
+	}
+}
+
+void NonUniformConvolver::WorkerPool::Worker::run()
+{
+	while (!threadShouldExit())
+	{
+		if (!parent.renderNextStage())
+			wait(500);
+	}
+}
+
+NonUniformConvolver::NonUniformConvolver(audiofft::ImplementationType fftType_) :
+	fftType(fftType_),
+	headConvolver(fftType_),
+	useBackgroundThread(true)
+{
+}
+
+NonUniformConvolver::~NonUniformConvolver()
+{
+	reset();
+}
+
+bool NonUniformConvolver::init(size_t headBlockSize_, size_t maxBlockSize, const fftconvolver::Sample* ir, size_t irLen)
+{
+	reset();
+
+	if (headBlockSize_ == 0 || maxBlockSize == 0)
+		return false;
+
+	// Ignore zeros at the end of the impulse response because they only waste computation time
+	while (irLen > 0 && std::abs(ir[irLen - 1]) < 0.000001f)
+		--irLen;
+
+	if (irLen == 0)
+		return true;
+
+	headBlockSize = fftconvolver::NextPowerOf2(headBlockSize_);
+	maxBlockSize = jmax(headBlockSize, fftconvolver::NextPowerOf2(maxBlockSize));
+
+	// A stage with block size B starts at 2 * B and ends where the next stage begins
+	Array<size_t> blockSizes;
+	auto blockSize = headBlockSize;
+
+	while (blockSize * GrowthFactor <= maxBlockSize && 2 * blockSize * GrowthFactor < irLen)
+	{
+		blockSize *= GrowthFactor;
+		blockSizes.add(blockSize);
+	}
+
+	auto headLength = blockSizes.isEmpty() ? irLen : 2 * blockSizes.getFirst();
+	headConvolver.init(headBlockSize, ir, headLength);
+
+	for (int i = 0; i < blockSizes.size(); i++)
+	{
+		auto offset = 2 * blockSizes[i];
+		auto end = (i == blockSizes.size() - 1) ? irLen : 2 * blockSizes[i + 1];
+
+		stages.add(new Stage(fftType, blockSizes[i], ir + offset, end - offset));
+	}
+
+	if (!stages.isEmpty())
+	{
+		tailInput.resize(blockSizes.getLast());
+
+		for (auto s : stages)
+			pool->addStage(s);
+	}
+
+	tailInputFill = 0;
+
+	return true;
+}
+
+void NonUniformConvolver::process(const fftconvolver::Sample* input, fftconvolver::Sample* output, size_t len)
+{
+	headConvolver.process(input, output, len);
+
+	if (stages.isEmpty())
+		return;
+
+	// All bigger block sizes are a multiple of the first stage's block size
+	const auto minBlockSize = stages.getFirst()->blockSize;
+	size_t processed = 0;
+
+	while (processed < len)
+	{
+		const auto numThisTime = jmin(len - processed, minBlockSize - (tailInputFill % minBlockSize));
+
+		for (auto s : stages)
+		{
+			auto readPos = tailInputFill % s->blockSize;
+			FloatVectorOperations::add(output + processed, s->precalculated.data() + readPos, (int)numThisTime);
+		}
+
+		memcpy(tailInput.data() + tailInputFill, input + processed, numThisTime * sizeof(fftconvolver::Sample));
+		tailInputFill += numThisTime;
+
+		const bool useWorkers = useBackgroundThread.load();
+		bool somethingToDo = false;
+
+		for (auto s : stages)
+		{
+			if (tailInputFill % s->blockSize == 0)
+			{
+				// The result of the last block is needed from now on
+				s->finish();
+				fftconvolver::SampleBuffer::Swap(s->precalculated, s->output);
+				memcpy(s->input.data(), tailInput.data() + tailInputFill - s->blockSize, s->blockSize * sizeof(fftconvolver::Sample));
+
+				if (useWorkers)
+				{
+					s->state.store((int)Stage::Pending);
+					somethingToDo = true;
+				}
+				else
+				{
+					s->render();
+				}
+			}
+		}
+
+		if (somethingToDo)
+			pool->notify();
+
+		if (tailInputFill == tailInput.size())
+			tailInputFill = 0;
+
+		processed += numThisTime;
+	}
+}
+
+void NonUniformConvolver::reset()
+{
+	for (auto s : stages)
+		pool->removeStage(s);
+
+	// Now that no worker can pick them up anymore we can delete them
+	stages.clear();
+
+	headConvolver.reset();
+	headBlockSize = 0;
+	tailInput.clear();
+	tailInputFill = 0;
+}
+
+void NonUniformConvolver::cleanPipeline()
+{
+	for (auto s : stages)
+	{
+		s->finish();
+		s->convolver.resetInput();
+		s->input.setZero();
+		s->output.setZero();
+		s->precalculated.setZero();
+	}
+
+	headConvolver.resetInput();
+	tailInput.setZero();
+	tailInputFill = 0;
+}
+
+Array<int> NonUniformConvolver::getPartitionSizes() const
+{
+	Array<int> sizes;
+
+	if (headBlockSize != 0)
+		sizes.add((int)headBlockSize);
+
+	for (auto s : stages)
+		sizes.add((int)s->blockSize);
+
+	return sizes;
+}
+
+ConvolutionEngine* ConvolutionEffectBase::createNewEngine(audiofft::ImplementationType fftType)
+{
+	ConvolutionEngine* newConvolver;
+
+	if (useNonUniformPartitioning)
+		newConvolver = new NonUniformConvolver(fftType);
+	else
+		newConvolver = new MultithreadedConvolver(fftType);
+
 	newConvolver->reset();
 	newConvolver->setUseBackgroundThread(useBackgroundThread, true);
 
@@ -222,6 +491,15 @@ void ConvolutionEffectBase::setImpulse(NotificationType sync)
 	}
 }
 
+void ConvolutionEffectBase::setUseNonUniformPartitioning(bool shouldBeUsed)
+{
+	if (useNonUniformPartitioning != shouldBeUsed)
+	{
+		useNonUniformPartitioning = shouldBeUsed;
+		setImpulse(sendNotificationAsync);
+	}
+}
+
 void ConvolutionEffectBase::enableProcessing(bool shouldBeProcessed)
 {
 	if (processFlag != shouldBeProcessed)
@@ -537,7 +815,7 @@ bool ConvolutionEffectBase::reloadInternal()
 	headSize = nextPowerOfTwo(headSize);
 	const auto fullTailLength = jmax(headSize, nextPowerOfTwo(resampledLength - headSize));
 
-	ScopedPointer<MultithreadedConvolver> s1, s2;
+	ScopedPointer<ConvolutionEngine> s1, s2;
 
 	for (int c = 0; c < scratchBuffer.getNumChannels(); c++)
 	{
@@ -553,8 +831,10 @@ bool ConvolutionEffectBase::reloadInternal()
 
 	s1 = createNewEngine(currentType);
 	s2 = createNewEngine(currentType);
-	s1->init(headSize, jmin<int>(8192, fullTailLength), scratchBuffer.getReadPointer(0), resampledLength);
-	s2->init(headSize, jmin<int>(8192, fullTailLength), scratchBuffer.getReadPointer(1), resampledLength);
+	const auto tailSize = useNonUniformPartitioning ? NonUniformConvolver::MaxBlockSize : jmin<int>(8192, fullTailLength);
+
+	s1->init(headSize, tailSize, scratchBuffer.getReadPointer(0), resampledLength);
+	s2->init(headSize, tailSize, scratchBuffer.getReadPointer(1), resampledLength);
 
 	{
 		SimpleReadWriteLock::ScopedWriteLock sl(swapLock);
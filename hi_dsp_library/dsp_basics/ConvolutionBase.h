@@ -106,7 +106,32 @@ private:
 	Smoother smoother;
 };
 
-class MultithreadedConvolver : public fftconvolver::TwoStageFFTConvolver
+/** The interface for the convolution engines that can be used by the ConvolutionEffectBase. */
+class ConvolutionEngine
+{
+public:
+
+	virtual ~ConvolutionEngine() {};
+
+	/** Initialises the engine with the impulse response. The tail block size is the (maximum) partition size of the tail. */
+	virtual bool init(size_t headBlockSize, size_t tailBlockSize, const fftconvolver::Sample* ir, size_t irLen) = 0;
+
+	/** Convolves the input samples and writes the result to the output without latency. */
+	virtual void process(const fftconvolver::Sample* input, fftconvolver::Sample* output, size_t len) = 0;
+
+	/** Discards the impulse response. */
+	virtual void reset() = 0;
+
+	/** Clears the internal buffers so that it resets the convolution pipeline. */
+	virtual void cleanPipeline() = 0;
+
+	virtual void setUseBackgroundThread(bool shouldBeUsingBackgroundThread, bool forceUpdate = false) = 0;
+
+	virtual bool isUsingBackgroundThread() const = 0;
+};
+
+class MultithreadedConvolver : public fftconvolver::TwoStageFFTConvolver,
+							   public ConvolutionEngine
 {
 	class BackgroundThread : public Thread
 	{
@@ -164,6 +189,26 @@ public:
 		backgroundThread.stopThread(1000);
 	};
 
+	bool init(size_t headBlockSize, size_t tailBlockSize, const fftconvolver::Sample* ir, size_t irLen) override
+	{
+		return TwoStageFFTConvolver::init(headBlockSize, tailBlockSize, ir, irLen);
+	}
+
+	void process(const fftconvolver::Sample* input, fftconvolver::Sample* output, size_t len) override
+	{
+		TwoStageFFTConvolver::process(input, output, len);
+	}
+
+	void reset() override
+	{
+		TwoStageFFTConvolver::reset();
+	}
+
+	void cleanPipeline() override
+	{
+		TwoStageFFTConvolver::cleanPipeline();
+	}
+
 	void startBackgroundProcessing() override
 	{
 		if (useBackgroundThread)
@@ -194,7 +239,7 @@ public:
 
 
 
-	void setUseBackgroundThread(bool shouldBeUsingBackgroundThread, bool forceUpdate = false)
+	void setUseBackgroundThread(bool shouldBeUsingBackgroundThread, bool forceUpdate = false) override
 	{
 		if (useBackgroundThread != shouldBeUsingBackgroundThread || forceUpdate)
 		{
@@ -211,7 +256,7 @@ public:
 		}
 	}
 
-	bool isUsingBackgroundThread() const
+	bool isUsingBackgroundThread() const override
 	{
 		return useBackgroundThread;
 	}
@@ -224,6 +269,143 @@ private:
 	bool useBackgroundThread = true;
 };
 
+/** A convolution engine that splits the impulse response into partitions with growing sizes.
+
+	The beginning of the impulse response is processed by a zero-latency head convolver with the
+	block size of the audio callback. The rest is divided into stages where each stage uses a
+	partition size that is four times bigger than the previous one. Every stage keeps the spectra
+	of its past input blocks in a frequency-domain delay line and starts at twice its block size 
+	in the impulse response, so it has the duration of a whole block to calculate its result.
+
+	If the background processing is enabled, the stages are rendered by a worker pool that is
+	shared between all instances, otherwise they will be processed on the audio thread as soon as
+	their input block is complete.
+*/
+class NonUniformConvolver : public ConvolutionEngine
+{
+public:
+
+	/** Every stage uses a partition size that is this factor bigger than the previous one. */
+	static constexpr int GrowthFactor = 4;
+
+	/** The biggest partition size that will be used for the last stage. */
+	static constexpr int MaxBlockSize = 16384;
+
+	NonUniformConvolver(audiofft::ImplementationType fftType_);
+	~NonUniformConvolver();
+
+	bool init(size_t headBlockSize, size_t maxBlockSize, const fftconvolver::Sample* ir, size_t irLen) override;
+	void process(const fftconvolver::Sample* input, fftconvolver::Sample* output, size_t len) override;
+	void reset() override;
+	void cleanPipeline() override;
+
+	void setUseBackgroundThread(bool shouldBeUsingBackgroundThread, bool /*forceUpdate*/ = false) override
+	{
+		useBackgroundThread.store(shouldBeUsingBackgroundThread);
+	}
+
+	bool isUsingBackgroundThread() const override
+	{
+		return useBackgroundThread.load();
+	}
+
+	/** Returns the partition sizes of the head and all tail stages. */
+	Array<int> getPartitionSizes() const;
+
+private:
+
+	struct Stage
+	{
+		enum State
+		{
+			Idle,
+			Pending,
+			Running
+		};
+
+		Stage(audiofft::ImplementationType fftType, size_t blockSize, const fftconvolver::Sample* ir, size_t irLen);
+
+		/** Claims the pending job so that no other thread will render it. */
+		bool tryToClaim()
+		{
+			auto expected = (int)Pending;
+			return state.compare_exchange_strong(expected, (int)Running);
+		}
+
+		void render()
+		{
+			convolver.process(input.data(), output.data(), blockSize);
+		}
+
+		/** Makes sure that the last job is finished. If no worker picked it up yet, it will be rendered on the calling thread. */
+		void finish();
+
+		const size_t blockSize;
+		fftconvolver::FFTConvolver convolver;
+		fftconvolver::SampleBuffer input;
+		fftconvolver::SampleBuffer output;
+		fftconvolver::SampleBuffer precalculated;
+		std::atomic<int> state;
+	};
+
+	/** A pool of worker threads shared between all convolution instances.
+
+		The audio thread marks a stage as pending and wakes up the workers which then render
+		the pending stages with the smallest block size (and therefore the nearest deadline) first.
+	*/
+	class WorkerPool
+	{
+	public:
+
+		WorkerPool();
+		~WorkerPool();
+
+		void addStage(Stage* s);
+		void removeStage(Stage* s);
+
+		/** Wakes up the workers. This is called from the audio thread. */
+		void notify();
+
+	private:
+
+		struct Worker : public Thread
+		{
+			Worker(WorkerPool& parent_, int index) :
+				Thread("Convolution Worker " + String(index + 1)),
+				parent(parent_)
+			{}
+
+			void run() override;
+
+			WorkerPool& parent;
+		};
+
+		bool renderNextStage();
+
+		ReadWriteLock stageLock;
+		Array<Stage*> stages;
+		OwnedArray<Worker> workers;
+
+		JUCE_DECLARE_NON_COPYABLE(WorkerPool);
+	};
+
+	const audiofft::ImplementationType fftType;
+
+	SharedResourcePointer<WorkerPool> pool;
+
+	fftconvolver::FFTConvolver headConvolver;
+	size_t headBlockSize = 0;
+
+	OwnedArray<Stage> stages;
+
+	fftconvolver::SampleBuffer tailInput;
+	size_t tailInputFill = 0;
+
+	std::atomic<bool> useBackgroundThread;
+
+	JUCE_DECLARE_NON_COPYABLE(NonUniformConvolver);
+};
+
 struct ConvolutionEffectBase : public AsyncUpdater,
 							   public NonRealtimeProcessor
 {
@@ -246,6 +428,9 @@ struct ConvolutionEffectBase : public AsyncUpdater,
 		convolverR->setUseBackgroundThread(!nonRealtime && useBackgroundThread);
 	}
 
+	/** Switches between the two-stage engine and the non-uniformly partitioned engine. */
+	void setUseNonUniformPartitioning(bool shouldBeUsed);
+
 	virtual MultiChannelAudioBuffer& getImpulseBufferBase() = 0;
 	virtual const MultiChannelAudioBuffer& getImpulseBufferBase() const = 0;
 
@@ -264,10 +449,11 @@ protected:
 	bool useBackgroundThread = false;
 	bool nonRealtime = false;
 	bool processingEnabled = true;
+	bool useNonUniformPartitioning = false;
 
 	audiofft::ImplementationType currentType = audiofft::ImplementationType::numImplementationTypes;
 
-	MultithreadedConvolver* createNewEngine(audiofft::ImplementationType fftType);
+	ConvolutionEngine* createNewEngine(audiofft::ImplementationType fftType);
 
 	double getResampleFactor() const
 	{
@@ -305,8 +491,8 @@ protected:
 
 	float predelayMs = 0.0f;
 
-	ScopedPointer<MultithreadedConvolver> convolverL;
-	ScopedPointer<MultithreadedConvolver> convolverR;
+	ScopedPointer<ConvolutionEngine> convolverL;
+	ScopedPointer<ConvolutionEngine> convolverR;
 
 	double cutoffFrequency = 20000.0;
 
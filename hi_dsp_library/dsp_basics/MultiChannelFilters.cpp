@@ -636,6 +636,17 @@ Array<hise::FilterHelpers::CoefficientType> StaticBiquadSubType::getCoefficientT
 			 FilterHelpers::Peak, FilterHelpers::LowPassReso };
 }
 
+StaticBiquadSubType::StaticBiquadSubType()
+{
+	for (auto& c : coefficients)
+		c = FilterLanes::Type::expand(0.0f);
+
+	// Passes the signal through until the coefficients are set
+	coefficients[0] = FilterLanes::Type::expand(1.0f);
+
+	reset(NUM_MAX_CHANNELS);
+}
+
 void StaticBiquadSubType::updateCoefficients(double sampleRate, double frequency, double q, double gain)
 {
 	switch (biquadType)
@@ -649,10 +660,8 @@ void StaticBiquadSubType::updateCoefficients(double sampleRate, double frequency
 	default:							jassertfalse; break;
 	}
 
-	for (int i = 0; i < numChannels; i++)
-	{
-		filters[i].setCoefficients(currentCoefficients);
-	}
+	for (int i = 0; i < 5; i++)
+		coefficients[i] = FilterLanes::Type::expand(currentCoefficients.coefficients[i]);
 }
 
 void StaticBiquadSubType::setType(int newType)
@@ -665,28 +674,58 @@ void StaticBiquadSubType::reset(int numNewChannels)
 {
 	numChannels = numNewChannels;
 
-	for (int i = 0; i < numChannels; i++)
+	for (int g = 0; g < FilterLanes::NumGroups; g++)
 	{
-		filters[i].reset();
+		v1[g] = FilterLanes::Type::expand(0.0f);
+		v2[g] = FilterLanes::Type::expand(0.0f);
 	}
 }
 
 void StaticBiquadSubType::processSamples(AudioSampleBuffer& b, int startSample, int numSamples)
 {
-	int channelAmount = b.getNumChannels();
+	float* d[NUM_MAX_CHANNELS];
+	auto channelAmount = FilterLanes::getWritePointers(b, startSample, d);
+
+	const auto c0 = coefficients[0];
+	const auto c1 = coefficients[1];
+	const auto c2 = coefficients[2];
+	const auto c3 = coefficients[3];
+	const auto c4 = coefficients[4];
 
-	for (int i = 0; i < channelAmount; i++)
+	for (int g = 0; g < FilterLanes::getNumGroups(channelAmount); g++)
 	{
-		float* d = b.getWritePointer(i, startSample);
-		filters[i].processSamples(d, numSamples);
+		auto lv1 = v1[g];
+		auto lv2 = v2[g];
+
+		FilterLanes::processGroup(d, channelAmount, g, numSamples, [&](FilterLanes::Type in)
+		{
+			auto out = c0 * in + lv1;
+			lv1 = c1 * in - c3 * out + lv2;
+			lv2 = c2 * in - c4 * out;
+			return out;
+		});
+
+		v1[g] = FilterLanes::snapToZero(lv1);
+		v2[g] = FilterLanes::snapToZero(lv2);
 	}
 }
 
 void StaticBiquadSubType::processFrame(float* d, int channels)
 {
+	auto c = currentCoefficients.coefficients;
+	auto fv1 = FilterLanes::getChannelData(v1);
+	auto fv2 = FilterLanes::getChannelData(v2);
+
 	for (int i = 0; i < channels; i++)
 	{
-		d[i] = filters[i].processSingleSampleRaw(d[i]);
+		auto in = d[i];
+		auto out = c[0] * in + fv1[i];
+
+		JUCE_SNAP_TO_ZERO(out);
+
+		fv1[i] = c[1] * in - c[3] * out + fv2[i];
+		fv2[i] = c[2] * in - c[4] * out;
+		d[i] = out;
 	}
 }
 
@@ -814,7 +853,11 @@ juce::StringArray LadderSubType::getModes() const
 
 void LadderSubType::reset(int newNumChannels)
 {
-	memset(buf, 0, sizeof(float) * newNumChannels * 4);
+	for (auto& stage : buf)
+	{
+		for (int g = 0; g < FilterLanes::getNumGroups(newNumChannels); g++)
+			stage[g] = FilterLanes::Type::expand(0.0f);
+	}
 }
 
 void LadderSubType::setType(int /*t*/)
@@ -824,13 +867,33 @@ void LadderSubType::setType(int /*t*/)
 
 void LadderSubType::processSamples(AudioSampleBuffer& b, int startSample, int numSamples)
 {
-	for (int c = 0; c < b.getNumChannels(); c++)
+	float* d[NUM_MAX_CHANNELS];
+	auto numChannels = FilterLanes::getWritePointers(b, startSample, d);
+
+	const auto lCut = FilterLanes::Type::expand(cut);
+	const auto lRes = FilterLanes::Type::expand(res);
+
+	for (int g = 0; g < FilterLanes::getNumGroups(numChannels); g++)
 	{
-		for (int i = 0; i < numSamples; i++)
+		auto b0 = buf[0][g];
+		auto b1 = buf[1][g];
+		auto b2 = buf[2][g];
+		auto b3 = buf[3][g];
+
+		FilterLanes::processGroup(d, numChannels, g, numSamples, [&](FilterLanes::Type input)
 		{
-			float* d = b.getWritePointer(c, i + startSample);
-			*d = processSample(*d, c);
-		}
+			const auto in = input - (b3 * lRes);
+			b0 = ((in - b0) * lCut) + b0;
+			b1 = ((b0 - b1) * lCut) + b1;
+			b2 = ((b1 - b2) * lCut) + b2;
+			b3 = ((b2 - b3) * lCut) + b3;
+			return b3 * 2.0f;
+		});
+
+		buf[0][g] = b0;
+		buf[1][g] = b1;
+		buf[2][g] = b2;
+		buf[3][g] = b3;
 	}
 }
 
@@ -854,16 +917,19 @@ void LadderSubType::updateCoefficients(double sampleRate, double frequency, doub
 
 float LadderSubType::processSample(float input, int channel)
 {
-	float* buffer = buf[channel];
+	float& b0 = FilterLanes::getChannelData(buf[0])[channel];
+	float& b1 = FilterLanes::getChannelData(buf[1])[channel];
+	float& b2 = FilterLanes::getChannelData(buf[2])[channel];
+	float& b3 = FilterLanes::getChannelData(buf[3])[channel];
 
-	float resoclip = buffer[3];
+	float resoclip = b3;
 
 	const float in = input - (resoclip * res);
-	buffer[0] = ((in - buffer[0]) * cut) + buffer[0];
-	buffer[1] = ((buffer[0] - buffer[1]) * cut) + buffer[1];
-	buffer[2] = ((buffer[1] - buffer[2]) * cut) + buffer[2];
-	buffer[3] = ((buffer[2] - buffer[3]) * cut) + buffer[3];
-	return 2.0f * buffer[3];
+	b0 = ((in - b0) * cut) + b0;
+	b1 = ((b0 - b1) * cut) + b1;
+	b2 = ((b1 - b2) * cut) + b2;
+	b3 = ((b2 - b3) * cut) + b3;
+	return 2.0f * b3;
 }
 
 DEFINE_MULTI_CHANNEL_FILTER(LadderSubType);
@@ -892,16 +958,18 @@ Array<hise::FilterHelpers::CoefficientType> StateVariableFilterSubType::getCoeff
 
 StateVariableFilterSubType::StateVariableFilterSubType()
 {
-	memset(v0z, 0, sizeof(float)*NUM_MAX_CHANNELS);
-	memset(z1_A, 0, sizeof(float)*NUM_MAX_CHANNELS);
-	memset(v2, 0, sizeof(float)*NUM_MAX_CHANNELS);
+	laneCoefficients = {};
+	reset(NUM_MAX_CHANNELS);
 }
 
 void StateVariableFilterSubType::reset(int numChannels)
 {
-	memset(v0z, 0, sizeof(float)*numChannels);
-	memset(z1_A, 0, sizeof(float)*numChannels);
-	memset(v2, 0, sizeof(float)*numChannels);
+	for (int g = 0; g < FilterLanes::getNumGroups(numChannels); g++)
+	{
+		v0zLanes[g] = FilterLanes::Type::expand(0.0f);
+		z1Lanes[g] = FilterLanes::Type::expand(0.0f);
+		v2Lanes[g] = FilterLanes::Type::expand(0.0f);
+	}
 }
 
 void StateVariableFilterSubType::setType(int t)
@@ -928,6 +996,11 @@ void StateVariableFilterSubType::updateCoefficients(double sampleRate, double fr
 
 		x1 = (2.0f * RCoeff + gCoeff);
 		x2 = 1.0f / (1.0f + (2.0f * RCoeff * gCoeff) + gCoeff * gCoeff);
+
+		laneCoefficients.x1 = FilterLanes::Type::expand(x1);
+		laneCoefficients.x2Inv = FilterLanes::Type::expand(1.0f / x2);
+		laneCoefficients.gCoeff = FilterLanes::Type::expand(gCoeff);
+		laneCoefficients.RCoeff4 = FilterLanes::Type::expand(4.0f * RCoeff);
 	}
 	else
 	{
@@ -940,122 +1013,74 @@ void StateVariableFilterSubType::updateCoefficients(double sampleRate, double fr
 		g2 = 2.0f * (g + k) * ginv;
 		g3 = g * ginv;
 		g4 = 2.0f * ginv;
+
+		laneCoefficients.k = FilterLanes::Type::expand(k);
+		laneCoefficients.g1 = FilterLanes::Type::expand(g1);
+		laneCoefficients.g2 = FilterLanes::Type::expand(g2);
+		laneCoefficients.g3 = FilterLanes::Type::expand(g3);
+		laneCoefficients.g4 = FilterLanes::Type::expand(g4);
 	}
 }
 
-void StateVariableFilterSubType::processSamples(AudioSampleBuffer& buffer, int startSample, int numSamples)
+template <int Mode> void StateVariableFilterSubType::processSamplesInternal(float* const* d, int numChannels, int numSamples)
 {
-	auto numChannels = buffer.getNumChannels();
+	const auto c = laneCoefficients;
 
-	switch (type)
+	for (int g = 0; g < FilterLanes::getNumGroups(numChannels); g++)
 	{
-	case LP:
-	{
-		for (int c = 0; c < numChannels; c++)
-		{
-			float* d = buffer.getWritePointer(c, startSample);
+		auto v0z = v0zLanes[g];
+		auto z1_A = z1Lanes[g];
+		auto v2 = v2Lanes[g];
 
-			for (int i = 0; i < numSamples; i++)
+		FilterLanes::processGroup(d, numChannels, g, numSamples, [&](FilterLanes::Type v0)
+		{
+			if (Mode == ALLPASS)
 			{
-				float v0 = d[i];
-				float v1z = z1_A[c];
-				float v2z = v2[c];
-				float v3 = v0 + v0z[c] - 2.0f * v2z;
-				z1_A[c] += g1 * v3 - g2 * v1z;
-				v2[c] += g3 * v3 + g4 * v1z;
-				v0z[c] = v0;
-				d[i] = v2[c];
-			}
-		}
+				const auto HP = (v0 - c.x1 * z1_A - v2) * c.x2Inv;
+				const auto BP = HP * c.gCoeff + z1_A;
+				const auto LP = BP * c.gCoeff + v2;
 
-		break;
-	}
-	case BP:
-	{
-		for (int c = 0; c < numChannels; c++)
-		{
-			float* d = buffer.getWritePointer(c, startSample);
+				z1_A = c.gCoeff * HP + BP;
+				v2 = c.gCoeff * BP + LP;
 
-			for (int i = 0; i < numSamples; i++)
-			{
-				float v0 = d[i];
-				float v1z = z1_A[c];
-				float v2z = v2[c];
-				float v3 = v0 + v0z[c] - 2.0f * v2z;
-				z1_A[c] += g1 * v3 - g2 * v1z;
-				v2[c] += g3 * v3 + g4 * v1z;
-				v0z[c] = v0;
-				d[i] = z1_A[c];
+				return v0 - c.RCoeff4 * BP;
 			}
-		}
 
-		break;
-	}
+			auto v1z = z1_A;
+			auto v2z = v2;
+			auto v3 = v0 + v0z - v2z * 2.0f;
+			z1_A += c.g1 * v3 - c.g2 * v1z;
+			v2 += c.g3 * v3 + c.g4 * v1z;
+			v0z = v0;
 
-	case HP:
-	{
-		for (int c = 0; c < numChannels; c++)
-		{
-			float* d = buffer.getWritePointer(c, startSample);
-
-			for (int i = 0; i < numSamples; i++)
+			switch (Mode)
 			{
-				float v0 = d[i];
-				float v1z = z1_A[c];
-				float v2z = v2[c];
-				float v3 = v0 + v0z[c] - 2.0f * v2z;
-				z1_A[c] += g1 * v3 - g2 * v1z;
-				v2[c] += g3 * v3 + g4 * v1z;
-				v0z[c] = v0;
-				d[i] = v0 - k * z1_A[c] - v2[c];
+			case LP:	return v2;
+			case BP:	return z1_A;
+			case HP:	return v0 - c.k * z1_A - v2;
+			case NOTCH:	return v0 - c.k * z1_A;
+			default:	return v0;
 			}
-		}
+		});
 
-		break;
+		v0zLanes[g] = v0z;
+		z1Lanes[g] = z1_A;
+		v2Lanes[g] = v2;
 	}
-	case FilterType::ALLPASS:
-	{
-		for (int c = 0; c < numChannels; c++)
-		{
-			float* d = buffer.getWritePointer(c, startSample);
-
-			for (int i = 0; i < numSamples; ++i)
-			{
-				const float input = d[i];
-				const float HP = (input - x1 * z1_A[c] - v2[c]) / x2;
-				const float BP = HP * gCoeff + z1_A[c];
-				const float LP = BP * gCoeff + v2[c];
+}
 
-				z1_A[c] = gCoeff * HP + BP;
-				v2[c] = gCoeff * BP + LP;
+void StateVariableFilterSubType::processSamples(AudioSampleBuffer& buffer, int startSample, int numSamples)
+{
+	float* d[NUM_MAX_CHANNELS];
+	auto numChannels = FilterLanes::getWritePointers(buffer, startSample, d);
 
-				const float AP = input - (4.0f * RCoeff * BP);
-				d[i] = AP;
-			}
-		}
-		break;
-	}
-	case NOTCH:
+	switch (type)
 	{
-		for (int c = 0; c < numChannels; c++)
-		{
-			float* d = buffer.getWritePointer(c, startSample);
-
-			for (int i = 0; i < numSamples; i++)
-			{
-				float v0 = d[i];
-				float v1z = z1_A[c];
-				float v2z = v2[c];
-				float v3 = v0 + v0z[c] - 2.0f * v2z;
-				z1_A[c] += g1 * v3 - g2 * v1z;
-				v2[c] += g3 * v3 + g4 * v1z;
-				v0z[c] = v0;
-				d[i] = v0 - k * z1_A[c];
-			}
-		}
-
-		break;
-	}
+	case LP:				processSamplesInternal<LP>(d, numChannels, numSamples); break;
+	case HP:				processSamplesInternal<HP>(d, numChannels, numSamples); break;
+	case BP:				processSamplesInternal<BP>(d, numChannels, numSamples); break;
+	case NOTCH:				processSamplesInternal<NOTCH>(d, numChannels, numSamples); break;
+	case FilterType::ALLPASS:	processSamplesInternal<ALLPASS>(d, numChannels, numSamples); break;
 	default:
 		jassertfalse;
 		break;
@@ -1064,6 +1089,10 @@ void StateVariableFilterSubType::processSamples(AudioSampleBuffer& buffer, int s
 
 void StateVariableFilterSubType::processFrame(float* d, int numChannels)
 {
+	auto v0z = FilterLanes::getChannelData(v0zLanes);
+	auto z1_A = FilterLanes::getChannelData(z1Lanes);
+	auto v2 = FilterLanes::getChannelData(v2Lanes);
+
 	switch (type)
 	{
 	case LP:
@@ -60,6 +60,95 @@ struct FilterLimits
 	static double limitGain(double gain);
 };
 
+/** Packs the channels of a multichannel filter into SIMD lanes.
+
+	The filter subtypes that use this store their state as structure-of-arrays with one
+	lane per channel, so the recursion of all channels in a lane group is computed with
+	a single register operation per state variable. The block processing transposes the
+	channels into a lane-interleaved scratch buffer first, unused lanes are fed with silence.
+
+	The per-frame processing works on a float view of the same state (one float per channel).
+
+	The lanes hold the channels of a single voice and not multiple voices, because the voices
+	of a polyphonic filter are rendered one after another with their own modulation values.
+	This means that a stereo signal only uses half of the lanes of a SSE register.
+*/
+struct FilterLanes
+{
+	using Type = dsp::SIMDRegister<float>;
+
+	static constexpr int NumLanes = (int)Type::SIMDNumElements;
+	static constexpr int NumGroups = (NUM_MAX_CHANNELS + NumLanes - 1) / NumLanes;
+	static constexpr int BlockSize = 64;
+
+	static int getNumGroups(int numChannels) noexcept
+	{
+		return jmin(NumGroups, (numChannels + NumLanes - 1) / NumLanes);
+	}
+
+	/** Returns the per-channel view of a lane state array. */
+	static float* getChannelData(Type* lanes) noexcept
+	{
+		return reinterpret_cast<float*>(lanes);
+	}
+
+	/** Fills the channel pointer array with the write pointers of the buffer and returns the number of channels. */
+	static int getWritePointers(AudioSampleBuffer& b, int startSample, float** channels) noexcept
+	{
+		auto numChannels = jmin(NUM_MAX_CHANNELS, b.getNumChannels());
+
+		for (int c = 0; c < numChannels; c++)
+			channels[c] = b.getWritePointer(c, startSample);
+
+		return numChannels;
+	}
+
+	/** Calls f(Type input) -> Type for every sample of the channels in the given lane group. */
+	template <typename LaneFunction> static forcedinline void processGroup(float* const* channels, int numChannels, int group, int numSamples, const LaneFunction& f)
+	{
+		alignas(sizeof(Type)) float block[BlockSize * NumLanes];
+
+		auto offset = group * NumLanes;
+		auto numUsed = jmin(NumLanes, numChannels - offset);
+
+		if (numUsed < NumLanes)
+			FloatVectorOperations::clear(block, BlockSize * NumLanes);
+
+		for (int pos = 0; pos < numSamples; pos += BlockSize)
+		{
+			auto numThisTime = jmin(BlockSize, numSamples - pos);
+
+			for (int l = 0; l < numUsed; l++)
+			{
+				auto src = channels[offset + l] + pos;
+
+				for (int i = 0; i < numThisTime; i++)
+					block[i * NumLanes + l] = src[i];
+			}
+
+			for (int i = 0; i < numThisTime; i++)
+			{
+				auto p = block + i * NumLanes;
+				f(Type::fromRawArray(p)).copyToRawArray(p);
+			}
+
+			for (int l = 0; l < numUsed; l++)
+			{
+				auto dst = channels[offset + l] + pos;
+
+				for (int i = 0; i < numThisTime; i++)
+					dst[i] = block[i * NumLanes + l];
+			}
+		}
+	}
+
+	/** The lane-wise equivalent of JUCE_SNAP_TO_ZERO. */
+	static forcedinline Type snapToZero(Type v) noexcept
+	{
+		return v & Type::greaterThan(Type::abs(v), Type::expand(1.0e-8f));
+	}
+};
+
 
 class FilterHelpers
 {
@@ -413,6 +502,8 @@ public:
 
 	Array<FilterHelpers::CoefficientType> getCoefficientTypeList() const;
 
+	StaticBiquadSubType();
+
 	void setType(int newType);
 	void reset(int numNewChannels);
 	void processSamples(AudioSampleBuffer& b, int startSample, int numSamples);
@@ -424,8 +515,12 @@ private:
 	int numChannels = NUM_MAX_CHANNELS;
 
 	IIRCoefficients currentCoefficients;
-	IIRFilter filters[NUM_MAX_CHANNELS];
 	FilterType biquadType;
+
+	// The transposed direct form II of juce::IIRFilter, with one lane per channel
+	FilterLanes::Type coefficients[5];
+	FilterLanes::Type v1[FilterLanes::NumGroups];
+	FilterLanes::Type v2[FilterLanes::NumGroups];
 };
 
 FORWARD_DECLARE_MULTI_CHANNEL_FILTER(StaticBiquadSubType);
@@ -515,7 +610,9 @@ public:
 private:
 
 	float processSample(float input, int channel);
-	float buf[NUM_MAX_CHANNELS][4];
+
+	// One lane array per stage, so that buf[stage] can be viewed as one float per channel
+	FilterLanes::Type buf[4][FilterLanes::NumGroups];
 
 	float cut;
 	float res;
@@ -632,11 +729,22 @@ public:
 
 private:
 
+	struct LaneCoefficients
+	{
+		using Type = FilterLanes::Type;
+
+		Type k, g1, g2, g3, g4, x1, x2Inv, gCoeff, RCoeff4;
+	};
+
+	template <int Mode> void processSamplesInternal(float* const* d, int numChannels, int numSamples);
+
 	FilterType type;
 
-	float v0z[NUM_MAX_CHANNELS];
-	float z1_A[NUM_MAX_CHANNELS];
-	float v2[NUM_MAX_CHANNELS];
+	FilterLanes::Type v0zLanes[FilterLanes::NumGroups];
+	FilterLanes::Type z1Lanes[FilterLanes::NumGroups];
+	FilterLanes::Type v2Lanes[FilterLanes::NumGroups];
+
+	LaneCoefficients laneCoefficients;
 
 	float k, g1, g2, g3, g4, x1, x2, gCoeff, RCoeff;
 
@@ -76,6 +76,11 @@ void convolution::setMultithread(double shouldBeMultithreaded)
 	}
 }
 
+void convolution::setNonUniform(double shouldUseNonUniformPartitions)
+{
+	setUseNonUniformPartitioning(shouldUseNonUniformPartitions > 0.5);
+}
+
 void convolution::setDamping(double targetSustainDb)
 {
 	if (damping != targetSustainDb)
@@ -146,6 +151,13 @@ void convolution::createParameters(ParameterDataList& data)
 		p.setParameterValueNames({ "Off", "On" });
 		data.add(std::move(p));
 	}
+
+	{
+		DEFINE_PARAMETERDATA(convolution, NonUniform);
+		p.setParameterValueNames({ "Off", "On" });
+		p.setDefaultValue(0.0);
+		data.add(std::move(p));
+	}
 }
 
 const hise::MultiChannelAudioBuffer& filters::convolution::getImpulseBufferBase() const
@@ -50,6 +50,7 @@ struct convolution : public data::base,
 		Damping,
 		HiCut,
 		Multithread,
+		NonUniform,
 		numParameters
 	};
 
@@ -60,6 +61,7 @@ struct convolution : public data::base,
 		DEF_PARAMETER(HiCut, convolution);
 		DEF_PARAMETER(Predelay, convolution);
 		DEF_PARAMETER(Multithread, convolution);
+		DEF_PARAMETER(NonUniform, convolution);
 	};
 	SN_PARAMETER_MEMBER_FUNCTION;
 
@@ -96,6 +98,7 @@ struct convolution : public data::base,
 	}
 
 	void setMultithread(double shouldBeMultithreaded);
+	void setNonUniform(double shouldUseNonUniformPartitions);
 	void setDamping(double targetSustainDb);
 	void setHiCut(double targetFreq);
 	void setPredelay(double newDelay);
@@ -431,6 +431,130 @@ float ahdsr_base::state_base::tick()
 	return state->current_value;
 }
 
+void ahdsr_base::state_base::tickBlock(float* data, int numSamples)
+{
+	while (numSamples > 0)
+	{
+		const float thisSustain = envelope->sustain * modValues[3];
+
+		active = current_state != state_base::IDLE;
+
+		int numDone = 0;
+
+		switch (current_state)
+		{
+		case state_base::IDLE:
+			FloatSanitizers::sanitizeFloatNumber(current_value);
+			FloatVectorOperations::fill(data, current_value, numSamples);
+			numDone = numSamples;
+			break;
+		case state_base::ATTACK:
+		{
+			if (envelope->attack != 0.0f)
+			{
+				const float target = attackLevel > thisSustain ? attackLevel : thisSustain;
+				numDone = renderRamp(data, numSamples, attackBase, attackCoef, [target](float v) { return v >= target; });
+			}
+
+			break;
+		}
+		case state_base::HOLD:
+			numDone = renderHold(data, numSamples);
+			break;
+		case state_base::DECAY:
+		{
+			if (envelope->decay != 0.0f)
+				numDone = renderRamp(data, numSamples, decayBase, decayCoef, [thisSustain](float v) { return (v - thisSustain) < 0.001f; });
+
+			break;
+		}
+		case state_base::SUSTAIN:
+			current_value = thisSustain;
+			FloatVectorOperations::fill(data, current_value, numSamples);
+			numDone = numSamples;
+			break;
+		case state_base::RELEASE:
+		{
+			if (envelope->release != 0.0f)
+				numDone = renderRamp(data, numSamples, releaseBase, releaseCoef, [](float v) { return v <= 0.001f; });
+
+			break;
+		}
+		default:
+			break;
+		}
+
+		// The sample that reaches the end of a segment (and the leftover samples
+		// that don't fill up a lane) go through tick() for the state change
+		if (numDone == 0)
+		{
+			*data = tick();
+			numDone = 1;
+		}
+
+		data += numDone;
+		numSamples -= numDone;
+	}
+}
+
+template <typename F> int ahdsr_base::state_base::renderRamp(float* data, int numSamples, float base, float coef, const F& hasReachedTarget)
+{
+	// x[n + k] = coef^k * x[n] + base * (coef^(k-1) + ... + coef + 1), so each
+	// lane can be calculated from the last value of the previous lanes
+	float laneCoef[RampLanes];
+	float laneBase[RampLanes];
+
+	laneCoef[0] = coef;
+	laneBase[0] = base;
+
+	for (int i = 1; i < RampLanes; i++)
+	{
+		laneCoef[i] = laneCoef[i - 1] * coef;
+		laneBase[i] = laneBase[i - 1] * coef + base;
+	}
+
+	auto v = current_value;
+	int numDone = 0;
+
+	while (numDone + RampLanes <= numSamples)
+	{
+		float values[RampLanes];
+		bool reachedTarget = false;
+
+		for (int i = 0; i < RampLanes; i++)
+		{
+			values[i] = laneBase[i] + laneCoef[i] * v;
+			reachedTarget |= hasReachedTarget(values[i]);
+		}
+
+		if (reachedTarget)
+			break;
+
+		memcpy(data + numDone, values, sizeof(float) * RampLanes);
+		v = values[RampLanes - 1];
+		numDone += RampLanes;
+	}
+
+	current_value = v;
+	return numDone;
+}
+
+int ahdsr_base::state_base::renderHold(float* data, int numSamples)
+{
+	// tick() stays in the hold phase as long as holdCounter + 1 < holdTimeSamples
+	const int numLeft = (int)std::ceil(envelope->holdTimeSamples - (float)holdCounter) - 1;
+	const int numDone = jlimit(0, numSamples, numLeft);
+
+	if (numDone > 0)
+	{
+		holdCounter += numDone;
+		current_value = attackLevel;
+		FloatVectorOperations::fill(data, current_value, numDone);
+	}
+
+	return numDone;
+}
+
 static float ratioOrZero(double nom, double denom) { return denom != 0.0 ? nom / denom : 0.0; }
 
 float ahdsr_base::state_base::getUIPosition(double deltaMs)
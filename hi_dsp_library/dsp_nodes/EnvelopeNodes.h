@@ -246,6 +246,10 @@ struct ahdsr_base: public mothernode,
 
 		float tick();
 
+		/** Renders the envelope into the given buffer. This calculates the same values as calling tick()
+			for each sample, but renders the attack, decay and release curves as blocks. */
+		void tickBlock(float* data, int numSamples);
+
 		float getUIPosition(double delta);
 
 		void refreshAttackTime();
@@ -289,6 +293,14 @@ struct ahdsr_base: public mothernode,
 		bool active = false;
 
 		EnvelopeState current_state;
+
+	private:
+
+		/** The number of samples that are calculated at once by renderRamp(). */
+		static constexpr int RampLanes = 8;
+
+		template <typename F> int renderRamp(float* data, int numSamples, float base, float coef, const F& hasReachedTarget);
+		int renderHold(float* data, int numSamples);
 	};
 
 	void calculateCoefficients(float timeInMilliSeconds, float base, float maximum, float &stateBase, float &stateCoeff) const;
@@ -80,6 +80,9 @@
 #include "unit_test/wrapper_tests.cpp"
 #include "unit_test/node_tests.cpp"
 #include "unit_test/container_tests.cpp"
+#include "unit_test/filter_tests.cpp"
+#include "unit_test/convolution_tests.cpp"
+#include "unit_test/envelope_tests.cpp"
 
 namespace hise
 {
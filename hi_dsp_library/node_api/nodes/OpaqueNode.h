@@ -102,6 +102,9 @@ struct OpaqueNode
 	static constexpr int NumMaxParameters = 16;
 	static constexpr int SmallObjectSize = 128;
 
+	/** The alignment of the node object. Nodes with SIMD register members (eg. the filter lanes) need 32 bytes with AVX. */
+	static constexpr int ObjectAlignment = jmax(16, (int)alignof(dsp::SIMDRegister<float>));
+
 	using MonoFrame = span<float, 1>;
 	using StereoFrame = span<float, 2>;
 
@@ -126,6 +129,8 @@ struct OpaqueNode
 
 	template <typename T> void create()
 	{
+		static_assert(alignof(T) <= ObjectAlignment, "the node needs a bigger alignment than the object storage provides");
+
 		callDestructor();
 		allocateObjectSize(sizeof(T));
 
@@ -277,7 +282,7 @@ private:
 
 	void allocateObjectSize(int numBytes);
 
-	hise::ObjectStorage<SmallObjectSize, 16> object;
+	hise::ObjectStorage<SmallObjectSize, ObjectAlignment> object;
 
 	bool isPoly = false;
 	bool isPolyPossible = false;
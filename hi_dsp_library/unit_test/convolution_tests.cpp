@@ -0,0 +1,242 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+#if HI_RUN_UNIT_TESTS
+
+namespace hise
+{
+
+namespace tests
+{
+
+using namespace juce;
+
+/** Checks the convolution engines against a direct convolution and compares the CPU usage
+	and the worst callback time of the two-stage and the non-uniform engine with a long hall impulse.
+
+	Without background thread the benchmark measures the entire rendering cost, with background
+	threads the blocks are rendered in realtime and it measures the time spent in the audio callback.
+*/
+struct ConvolutionEngineTests : public UnitTest
+{
+	ConvolutionEngineTests() :
+		UnitTest("Testing convolution engines", "dsp")
+	{}
+
+	void runTest() override
+	{
+		for (bool useBackgroundThread : { false, true })
+		{
+			testEngine(false, useBackgroundThread);
+			testEngine(true, useBackgroundThread);
+		}
+
+		testPartitionSizes();
+
+		for (bool useBackgroundThread : { false, true })
+		{
+			runBenchmark(false, useBackgroundThread);
+			runBenchmark(true, useBackgroundThread);
+		}
+	}
+
+	static ConvolutionEngine* createEngine(bool useNonUniform)
+	{
+		if (useNonUniform)
+			return new NonUniformConvolver(audiofft::ImplementationType::BestAvailable);
+		else
+			return new MultithreadedConvolver(audiofft::ImplementationType::BestAvailable);
+	}
+
+	static String getEngineName(bool useNonUniform)
+	{
+		return useNonUniform ? "non-uniform engine" : "two-stage engine";
+	}
+
+	static void fillWithNoise(float* data, int numSamples, Random& r, float gain)
+	{
+		for (int i = 0; i < numSamples; i++)
+			data[i] = gain * (r.nextFloat() * 2.0f - 1.0f);
+	}
+
+	void testEngine(bool useNonUniform, bool useBackgroundThread)
+	{
+		beginTest("Testing " + getEngineName(useNonUniform) + (useBackgroundThread ? " with" : " without") + " background thread");
+
+		Random r(1);
+
+		const int irLength = 6000;
+		const int numSamples = 9000;
+
+		HeapBlock<float> ir(irLength);
+		HeapBlock<float> input(numSamples);
+		HeapBlock<float> output(numSamples);
+		HeapBlock<double> expected(numSamples, true);
+
+		fillWithNoise(ir, irLength, r, 0.1f);
+		fillWithNoise(input, numSamples, r, 1.0f);
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			for (int j = 0; j < jmin(i + 1, irLength); j++)
+				expected[i] += (double)ir[j] * (double)input[i - j];
+		}
+
+		ScopedPointer<ConvolutionEngine> engine = createEngine(useNonUniform);
+		engine->setUseBackgroundThread(useBackgroundThread, true);
+		expect(engine->init(16, 1024, ir, irLength), "init failed");
+
+		// Process with odd buffer sizes to check the partition boundaries
+		for (int pos = 0; pos < numSamples;)
+		{
+			auto numThisTime = jmin(numSamples - pos, r.nextInt({ 1, 24 }));
+			engine->process(input + pos, output + pos, numThisTime);
+			pos += numThisTime;
+		}
+
+		double maxError = 0.0;
+
+		for (int i = 0; i < numSamples; i++)
+			maxError = jmax(maxError, std::abs((double)output[i] - expected[i]));
+
+		expect(maxError < 1e-4, "Deviation from direct convolution: " + String(maxError));
+
+		engine->cleanPipeline();
+
+		// Check that there is no latency after clearing the pipeline
+		input.clear(numSamples);
+		input[0] = 1.0f;
+		engine->process(input, output, numSamples);
+
+		for (int i = 0; i < irLength; i++)
+		{
+			if (std::abs(output[i] - ir[i]) > 1e-5f)
+			{
+				expect(false, "Impulse mismatch at " + String(i));
+				break;
+			}
+		}
+
+		engine = nullptr;
+	}
+
+	void testPartitionSizes()
+	{
+		beginTest("Testing non-uniform partition sizes");
+
+		const int irLength = 44100 * 6;
+		HeapBlock<float> ir(irLength);
+		Random r(2);
+		fillWithNoise(ir, irLength, r, 0.1f);
+
+		NonUniformConvolver c(audiofft::ImplementationType::BestAvailable);
+		c.init(512, NonUniformConvolver::MaxBlockSize, ir, irLength);
+
+		Array<int> expectedSizes = { 512, 2048, 8192 };
+		expect(c.getPartitionSizes() == expectedSizes, "Unexpected partition sizes");
+
+		c.init(256, 256, ir, irLength);
+		expectEquals(c.getPartitionSizes().size(), 1, "Should only use a head convolver");
+	}
+
+	void runBenchmark(bool useNonUniform, bool useBackgroundThread)
+	{
+		beginTest("Benchmarking " + getEngineName(useNonUniform) + " with 4 stereo hall instances" + (useBackgroundThread ? " in realtime" : ""));
+
+		const int numInstances = 4;
+		const int irLength = 44100 * 8;
+		const int blockSize = 512;
+		const int numBlocks = 44100 * 3 / blockSize;
+		const auto blockDuration = (double)blockSize / 44100.0;
+
+		Random r(3);
+		HeapBlock<float> ir(irLength);
+
+		OwnedArray<ConvolutionEngine> engines;
+
+		for (int i = 0; i < numInstances * 2; i++)
+		{
+			fillWithNoise(ir, irLength, r, 0.01f);
+
+			for (int j = 0; j < irLength; j++)
+				ir[j] *= std::exp(-4.0f * (float)j / (float)irLength);
+
+			auto e = engines.add(createEngine(useNonUniform));
+			e->setUseBackgroundThread(useBackgroundThread, true);
+			e->init(blockSize, useNonUniform ? NonUniformConvolver::MaxBlockSize : 8192, ir, irLength);
+		}
+
+		HeapBlock<float> input(blockSize);
+		HeapBlock<float> output(blockSize);
+
+		double totalSeconds = 0.0;
+		double maxBlockSeconds = 0.0;
+
+		auto benchmarkStart = Time::getHighResolutionTicks();
+
+		for (int i = 0; i < numBlocks; i++)
+		{
+			fillWithNoise(input, blockSize, r, 1.0f);
+
+			if (useBackgroundThread)
+			{
+				// Wait for the next callback like a realtime audio device would
+				auto callbackTime = benchmarkStart + Time::secondsToHighResolutionTicks(i * blockDuration);
+
+				while (Time::getHighResolutionTicks() < callbackTime)
+					Thread::sleep(1);
+			}
+
+			auto start = Time::getHighResolutionTicks();
+
+			for (auto e : engines)
+				e->process(input, output, blockSize);
+
+			auto blockSeconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+
+			totalSeconds += blockSeconds;
+			maxBlockSeconds = jmax(maxBlockSeconds, blockSeconds);
+		}
+
+		logMessage(String(useBackgroundThread ? "Audio thread CPU: " : "Total CPU: ") + String(100.0 * totalSeconds / (numBlocks * blockDuration), 2) + "%, " +
+				   "worst callback: " + String(1000.0 * maxBlockSeconds, 3) + "ms (" + String(100.0 * maxBlockSeconds / blockDuration, 1) + "% of the block duration)");
+	}
+};
+
+static ConvolutionEngineTests convolutionEngineTests;
+
+}
+
+}
+
+#endif
@@ -0,0 +1,232 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+
+#if HI_RUN_UNIT_TESTS
+
+namespace hise
+{
+
+namespace tests
+{
+
+using namespace juce;
+
+/** Compares the block rendering of the AHDSR envelope with its per-sample calculation and measures
+	the rendering of 128 voices with both methods.
+*/
+struct AhdsrEnvelopeTests : public UnitTest
+{
+	using ahdsr_base = scriptnode::envelope::pimpl::ahdsr_base;
+	using State = ahdsr_base::state_base;
+
+	AhdsrEnvelopeTests() :
+		UnitTest("Testing AHDSR envelope block rendering", "dsp")
+	{}
+
+	void runTest() override
+	{
+		testBlockRendering();
+		runBenchmark();
+	}
+
+	static void setupEnvelope(ahdsr_base& env, Random& r)
+	{
+		env.setBaseSampleRate(44100.0);
+		env.setAttackRate(r.nextBool() ? 0.0f : r.nextFloat() * 200.0f);
+		env.attackLevel = 0.3f + 0.7f * r.nextFloat();
+		env.setHoldTime(r.nextFloat() * 50.0f);
+		env.setSustainLevel(r.nextInt(4) == 0 ? 0.0f : r.nextFloat());
+		env.setDecayRate(1.0f + r.nextFloat() * 500.0f);
+		env.setReleaseRate(1.0f + r.nextFloat() * 500.0f);
+		env.setAttackCurve(r.nextFloat());
+		env.setDecayCurve(r.nextFloat());
+	}
+
+	static void startVoice(State& s, const ahdsr_base& env)
+	{
+		s.envelope = &env;
+		s.attackLevel = env.attackLevel;
+		s.setAttackRate(env.attack);
+		s.setDecayRate(env.decay);
+		s.setReleaseRate(env.release);
+		s.current_state = State::ATTACK;
+		s.current_value = 0.0f;
+		s.holdCounter = 0;
+		s.lastSustainValue = env.sustain;
+	}
+
+	void testBlockRendering()
+	{
+		beginTest("Testing block rendering against tick()");
+
+		Random r(1);
+
+		const int numSamples = 44100;
+		HeapBlock<float> expected(numSamples);
+		HeapBlock<float> actual(numSamples);
+
+		float maxError = 0.0f;
+
+		for (int i = 0; i < 100; i++)
+		{
+			ahdsr_base env;
+			setupEnvelope(env, r);
+
+			State s1, s2;
+			startVoice(s1, env);
+			startVoice(s2, env);
+
+			const int releasePosition = r.nextInt(numSamples / 2);
+			bool released = false;
+
+			for (int pos = 0; pos < numSamples;)
+			{
+				auto numThisTime = jmin(numSamples - pos, r.nextInt({ 1, 512 }));
+
+				if (!released && pos >= releasePosition)
+				{
+					s1.current_state = State::RELEASE;
+					s2.current_state = State::RELEASE;
+					released = true;
+				}
+
+				for (int j = 0; j < numThisTime; j++)
+					expected[pos + j] = s1.tick();
+
+				s2.tickBlock(actual + pos, numThisTime);
+				pos += numThisTime;
+			}
+
+			// The rounding of the block calculation can move the end of a segment by a few samples
+			// if the curve approaches its target very slowly, so this compares each sample with the
+			// closest value around the same position (the decay also snaps to the sustain level
+			// within 0.001, so the tolerance is slightly above that)
+			const int maxShift = 8;
+
+			for (int j = 0; j < numSamples; j++)
+			{
+				auto error = std::abs(expected[j] - actual[j]);
+
+				for (int k = jmax(0, j - maxShift); k < jmin(numSamples, j + maxShift + 1); k++)
+					error = jmin(error, std::abs(expected[k] - actual[j]));
+
+				maxError = jmax(maxError, error);
+			}
+
+			expectEquals((int)s2.current_state, (int)s1.current_state, "State mismatch");
+		}
+
+		expect(maxError < 0.0011f, "Deviation from tick(): " + String(maxError));
+		logMessage("Maximum deviation from tick(): " + String(maxError));
+	}
+
+	void runBenchmark()
+	{
+		beginTest("Benchmarking 128 voices with 512 samples per block");
+
+		const int numVoices = 128;
+		const int blockSize = 512;
+		const int numBlocks = 44100 * 4 / blockSize;
+
+		ahdsr_base env;
+		env.setBaseSampleRate(44100.0);
+		env.setAttackRate(50.0f);
+		env.setHoldTime(10.0f);
+		env.setSustainLevel(0.5f);
+		env.setDecayRate(2000.0f);
+		env.setReleaseRate(1000.0f);
+		env.setAttackCurve(0.5f);
+		env.setDecayCurve(0.5f);
+
+		HeapBlock<float> output(blockSize);
+
+		double seconds[2] = { 0.0, 0.0 };
+
+		for (int useBlock = 0; useBlock < 2; useBlock++)
+		{
+			Random r(2);
+			HeapBlock<State> states(numVoices);
+			HeapBlock<int> releaseBlocks(numVoices);
+
+			for (int i = 0; i < numVoices; i++)
+			{
+				states[i] = State();
+				startVoice(states[i], env);
+				releaseBlocks[i] = r.nextInt({ 1, 200 });
+			}
+
+			for (int b = 0; b < numBlocks; b++)
+			{
+				for (int i = 0; i < numVoices; i++)
+				{
+					auto& s = states[i];
+
+					if (b == releaseBlocks[i])
+						s.current_state = State::RELEASE;
+
+					if (s.current_state == State::IDLE)
+					{
+						startVoice(s, env);
+						releaseBlocks[i] = b + r.nextInt({ 1, 200 });
+					}
+
+					auto start = Time::getHighResolutionTicks();
+
+					if (useBlock == 1)
+						s.tickBlock(output, blockSize);
+					else
+					{
+						for (int j = 0; j < blockSize; j++)
+							output[j] = s.tick();
+					}
+
+					seconds[useBlock] += Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+				}
+			}
+		}
+
+		auto blockDuration = (double)(blockSize * numBlocks) / 44100.0;
+
+		logMessage("tick(): " + String(100.0 * seconds[0] / blockDuration, 2) + "% CPU, " +
+				   "tickBlock(): " + String(100.0 * seconds[1] / blockDuration, 2) + "% CPU");
+	}
+};
+
+static AhdsrEnvelopeTests ahdsrEnvelopeTests;
+
+}
+
+}
+
+#endif
@@ -0,0 +1,396 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+#if HI_RUN_UNIT_TESTS
+
+namespace hise
+{
+
+namespace tests
+{
+
+using namespace juce;
+
+/** The per-channel implementations that were used before the filters were processed in SIMD lanes.
+
+	They are only used as a reference for the output and the performance of the lane processing.
+*/
+namespace previous_filters
+{
+
+struct Biquad
+{
+	void setType(int newType) { biquadType = (StaticBiquadSubType::FilterType)newType; }
+
+	void reset(int numNewChannels)
+	{
+		numChannels = numNewChannels;
+
+		for (int i = 0; i < numChannels; i++)
+			filters[i].reset();
+	}
+
+	void updateCoefficients(double sampleRate, double frequency, double q, double gain)
+	{
+		IIRCoefficients c;
+
+		switch (biquadType)
+		{
+		case StaticBiquadSubType::LowPass:	 c = IIRCoefficients::makeLowPass(sampleRate, frequency); break;
+		case StaticBiquadSubType::HighPass:	 c = IIRCoefficients::makeHighPass(sampleRate, frequency); break;
+		case StaticBiquadSubType::LowShelf:	 c = IIRCoefficients::makeLowShelf(sampleRate, frequency, q, (float)gain); break;
+		case StaticBiquadSubType::HighShelf: c = IIRCoefficients::makeHighShelf(sampleRate, frequency, q, (float)gain); break;
+		case StaticBiquadSubType::Peak:		 c = IIRCoefficients::makePeakFilter(sampleRate, frequency, q, (float)gain); break;
+		case StaticBiquadSubType::ResoLow:	 c = IIRCoefficients::makeLowPass(sampleRate, frequency, q); break;
+		default: jassertfalse; break;
+		}
+
+		for (int i = 0; i < numChannels; i++)
+			filters[i].setCoefficients(c);
+	}
+
+	void processSamples(AudioSampleBuffer& b, int startSample, int numSamples)
+	{
+		for (int i = 0; i < b.getNumChannels(); i++)
+			filters[i].processSamples(b.getWritePointer(i, startSample), numSamples);
+	}
+
+	int numChannels = NUM_MAX_CHANNELS;
+	IIRFilter filters[NUM_MAX_CHANNELS];
+	StaticBiquadSubType::FilterType biquadType = StaticBiquadSubType::LowPass;
+};
+
+struct StateVariableFilter
+{
+	using FilterType = StateVariableFilterSubType::FilterType;
+
+	void setType(int t) { type = (FilterType)t; }
+
+	void reset(int numChannels)
+	{
+		memset(v0z, 0, sizeof(float) * numChannels);
+		memset(z1_A, 0, sizeof(float) * numChannels);
+		memset(v2, 0, sizeof(float) * numChannels);
+	}
+
+	void updateCoefficients(double sampleRate, double frequency, double q, double /*gain*/)
+	{
+		const float scaledQ = jlimit<float>(0.0f, 9.999f, (float)q * 0.1f);
+
+		if (type == FilterType::ALLPASS)
+		{
+			float wd = static_cast<float>(frequency * 2.0f * float_Pi);
+			float T = 1.0f / (float)sampleRate;
+			float wa = (2.0f / T) * tan(wd * T / 2.0f);
+
+			gCoeff = wa * T / 2.0f;
+			RCoeff = 1.0f / (2.0f * (float)q);
+
+			x1 = (2.0f * RCoeff + gCoeff);
+			x2 = 1.0f / (1.0f + (2.0f * RCoeff * gCoeff) + gCoeff * gCoeff);
+		}
+		else
+		{
+			float g = (float)tan(double_Pi * frequency / sampleRate);
+			k = 1.0f - 0.99f * scaledQ;
+			float ginv = g / (1.0f + g * (g + k));
+			g1 = ginv;
+			g2 = 2.0f * (g + k) * ginv;
+			g3 = g * ginv;
+			g4 = 2.0f * ginv;
+		}
+	}
+
+	void processSamples(AudioSampleBuffer& buffer, int startSample, int numSamples)
+	{
+		for (int c = 0; c < buffer.getNumChannels(); c++)
+		{
+			float* d = buffer.getWritePointer(c, startSample);
+
+			for (int i = 0; i < numSamples; i++)
+			{
+				if (type == FilterType::ALLPASS)
+				{
+					const float input = d[i];
+					const float HP = (input - x1 * z1_A[c] - v2[c]) / x2;
+					const float BP = HP * gCoeff + z1_A[c];
+					const float LP = BP * gCoeff + v2[c];
+
+					z1_A[c] = gCoeff * HP + BP;
+					v2[c] = gCoeff * BP + LP;
+
+					d[i] = input - (4.0f * RCoeff * BP);
+					continue;
+				}
+
+				float v0 = d[i];
+				float v1z = z1_A[c];
+				float v2z = v2[c];
+				float v3 = v0 + v0z[c] - 2.0f * v2z;
+				z1_A[c] += g1 * v3 - g2 * v1z;
+				v2[c] += g3 * v3 + g4 * v1z;
+				v0z[c] = v0;
+
+				switch (type)
+				{
+				case FilterType::LP:	d[i] = v2[c]; break;
+				case FilterType::BP:	d[i] = z1_A[c]; break;
+				case FilterType::HP:	d[i] = v0 - k * z1_A[c] - v2[c]; break;
+				case FilterType::NOTCH: d[i] = v0 - k * z1_A[c]; break;
+				default:				break;
+				}
+			}
+		}
+	}
+
+	FilterType type = FilterType::LP;
+
+	float v0z[NUM_MAX_CHANNELS] = { 0.0f };
+	float z1_A[NUM_MAX_CHANNELS] = { 0.0f };
+	float v2[NUM_MAX_CHANNELS] = { 0.0f };
+
+	float k = 0.0f, g1 = 0.0f, g2 = 0.0f, g3 = 0.0f, g4 = 0.0f;
+	float x1 = 0.0f, x2 = 1.0f, gCoeff = 0.0f, RCoeff = 0.0f;
+};
+
+struct Ladder
+{
+	void setType(int /*t*/) {}
+
+	void reset(int newNumChannels)
+	{
+		memset(buf, 0, sizeof(float) * newNumChannels * 4);
+	}
+
+	void updateCoefficients(double sampleRate, double frequency, double q, double /*gain*/)
+	{
+		float inFreq = (float)FilterLimits::limitFrequency(frequency);
+		const float x = 2.0f * float_Pi * inFreq / (float)sampleRate;
+
+		cut = jlimit<float>(0.0f, 0.8f, x);
+		res = jlimit<float>(0.3f, 4.0f, (float)q / 2.0f);
+	}
+
+	void processSamples(AudioSampleBuffer& b, int startSample, int numSamples)
+	{
+		for (int c = 0; c < b.getNumChannels(); c++)
+		{
+			float* buffer = buf[c];
+			float* d = b.getWritePointer(c, startSample);
+
+			for (int i = 0; i < numSamples; i++)
+			{
+				const float in = d[i] - (buffer[3] * res);
+				buffer[0] = ((in - buffer[0]) * cut) + buffer[0];
+				buffer[1] = ((buffer[0] - buffer[1]) * cut) + buffer[1];
+				buffer[2] = ((buffer[1] - buffer[2]) * cut) + buffer[2];
+				buffer[3] = ((buffer[2] - buffer[3]) * cut) + buffer[3];
+				d[i] = 2.0f * buffer[3];
+			}
+		}
+	}
+
+	float buf[NUM_MAX_CHANNELS][4];
+	float cut = 0.0f;
+	float res = 0.0f;
+};
+
+}
+
+/** Checks the SIMD lane paths of the multichannel filters against their per-frame processing
+	and the previous per-channel implementation and measures the block rendering of a full
+	polyphonic filter bank against the previous implementation.
+*/
+struct FilterLaneTests : public UnitTest
+{
+	FilterLaneTests() :
+		UnitTest("Testing multichannel filter lanes", "dsp")
+	{}
+
+	void runTest() override
+	{
+		for (int numChannels : { 1, 2, 3, 4, 8 })
+		{
+			testSubType<StaticBiquadSubType, previous_filters::Biquad>(StaticBiquadSubType::numFilterTypes, numChannels);
+			testSubType<StateVariableFilterSubType, previous_filters::StateVariableFilter>(StateVariableFilterSubType::numTypes, numChannels);
+			testSubType<LadderSubType, previous_filters::Ladder>(LadderSubType::numTypes, numChannels);
+		}
+
+		runBenchmark<StaticBiquadSubType, previous_filters::Biquad>(StaticBiquadSubType::LowPass);
+		runBenchmark<StateVariableFilterSubType, previous_filters::StateVariableFilter>(StateVariableFilterSubType::LP);
+		runBenchmark<LadderSubType, previous_filters::Ladder>(LadderSubType::LP24);
+	}
+
+	static void fillWithNoise(AudioSampleBuffer& b)
+	{
+		Random r(1);
+
+		for (int c = 0; c < b.getNumChannels(); c++)
+		{
+			for (int i = 0; i < b.getNumSamples(); i++)
+				b.setSample(c, i, r.nextFloat() * 2.0f - 1.0f);
+		}
+	}
+
+	template <class FilterType> static void prepare(FilterType& f, int type, int numChannels, double frequency)
+	{
+		f.setType(type);
+		f.reset(numChannels);
+		f.updateCoefficients(44100.0, frequency, 2.0, 3.0);
+	}
+
+	static float getMaxError(const AudioSampleBuffer& a, const AudioSampleBuffer& b)
+	{
+		float maxError = 0.0f;
+
+		for (int c = 0; c < a.getNumChannels(); c++)
+		{
+			for (int i = 0; i < a.getNumSamples(); i++)
+				maxError = jmax(maxError, std::abs(a.getSample(c, i) - b.getSample(c, i)));
+		}
+
+		return maxError;
+	}
+
+	template <class SubType, class PreviousType> void testSubType(int numTypes, int numChannels)
+	{
+		beginTest("Testing " + SubType::getStaticId().toString() + " with " + String(numChannels) + " channels");
+
+		const int numSamples = 1000;
+
+		for (int type = 0; type < numTypes; type++)
+		{
+			AudioSampleBuffer blockData(numChannels, numSamples);
+			fillWithNoise(blockData);
+
+			AudioSampleBuffer frameData, previousData;
+			frameData.makeCopyOf(blockData);
+			previousData.makeCopyOf(blockData);
+
+			SubType blockFilter, frameFilter;
+			PreviousType previousFilter;
+			prepare(blockFilter, type, numChannels, 1200.0);
+			prepare(frameFilter, type, numChannels, 1200.0);
+			prepare(previousFilter, type, numChannels, 1200.0);
+
+			// Odd block sizes to check the lane scratch buffer boundaries
+			for (int pos = 0; pos < numSamples; pos += 77)
+			{
+				blockFilter.processSamples(blockData, pos, jmin(77, numSamples - pos));
+				previousFilter.processSamples(previousData, pos, jmin(77, numSamples - pos));
+			}
+
+			float frame[NUM_MAX_CHANNELS];
+
+			for (int i = 0; i < numSamples; i++)
+			{
+				for (int c = 0; c < numChannels; c++)
+					frame[c] = frameData.getSample(c, i);
+
+				frameFilter.processFrame(frame, numChannels);
+
+				for (int c = 0; c < numChannels; c++)
+					frameData.setSample(c, i, frame[c]);
+			}
+
+			auto frameError = getMaxError(blockData, frameData);
+			auto previousError = getMaxError(blockData, previousData);
+
+			expect(frameError < 1e-4f, "Mode " + String(type) + " deviates from frame processing: " + String(frameError));
+			expect(previousError < 1e-4f, "Mode " + String(type) + " deviates from previous implementation: " + String(previousError));
+		}
+	}
+
+	/** Renders 64 voices with the given filter type and returns the time in milliseconds per second of audio. */
+	template <class FilterType> static double measure(int type, int numChannels, float& magnitude)
+	{
+		const int numVoices = 64;
+		const int blockSize = 64;
+		const int numBlocks = 689;
+
+		// std::vector uses the aligned operator new for the SIMD register members
+		std::vector<FilterType> voices(numVoices);
+
+		for (int v = 0; v < numVoices; v++)
+			prepare(voices[v], type, numChannels, 800.0 + 37.0 * v);
+
+		AudioSampleBuffer input(numChannels, blockSize);
+		fillWithNoise(input);
+
+		AudioSampleBuffer b(numChannels, blockSize);
+
+		auto start = Time::getHighResolutionTicks();
+
+		for (int i = 0; i < numBlocks; i++)
+		{
+			for (auto& v : voices)
+			{
+				b.makeCopyOf(input, true);
+				v.processSamples(b, 0, blockSize);
+			}
+		}
+
+		magnitude = b.getMagnitude(0, blockSize);
+
+		return Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start) * 1000.0;
+	}
+
+	template <class SubType, class PreviousType> void runBenchmark(int type)
+	{
+		beginTest("Benchmarking " + SubType::getStaticId().toString() + " with 64 voices");
+
+		for (int numChannels : { 2, 4, 8 })
+		{
+			float laneMagnitude = 0.0f, previousMagnitude = 0.0f;
+
+			auto laneMs = measure<SubType>(type, numChannels, laneMagnitude);
+			auto previousMs = measure<PreviousType>(type, numChannels, previousMagnitude);
+
+			logMessage(String(numChannels) + " channels, " + String(FilterLanes::NumLanes) + " lanes: " +
+					   String(laneMs, 1) + "ms per second of audio (lanes), " +
+					   String(previousMs, 1) + "ms (previous implementation), speedup: " +
+					   String(previousMs / jmax(0.001, laneMs), 2) + "x");
+
+			expect(laneMagnitude < 100.0f, "Filter output exploded");
+			expectWithinAbsoluteError(laneMagnitude, previousMagnitude, 1e-4f, "Output differs from previous implementation");
+		}
+	}
+};
+
+static FilterLaneTests filterLaneTests;
+
+}
+
+}
+
+#endif
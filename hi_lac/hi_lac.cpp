@@ -38,5 +38,6 @@
 #include "hlac/HlacEncoder.cpp"
 #include "hlac/HlacDecoder.cpp"
 #include "hlac/HlacAudioFormatWriter.cpp"
+#include "hlac/HlacParallelEncoder.cpp"
 #include "hlac/HlacAudioFormatReader.cpp"
 #include "hlac/HiseLosslessAudioFormat.cpp"
@@ -125,6 +125,7 @@ If enabled, then the unit test suite will be compiled and added to all unit test
 #include "hlac/HlacEncoder.h"
 #include "hlac/HlacDecoder.h"
 #include "hlac/HlacAudioFormatWriter.h"
+#include "hlac/HlacParallelEncoder.h"
 #include "hlac/HlacAudioFormatReader.h"
 #include "hlac/HiseLosslessAudioFormat.h"
 
@@ -147,6 +147,397 @@ void unpackArrayOfInt16(int16* d, int /*numValues*/, uint8 bitDepth)
 
 }
 
+#if JUCE_INTEL && !HI_ENABLE_LEGACY_CPU_SUPPORT
+#define HLAC_X86_SIMD 1
+#include <immintrin.h>
+
+// MSVC allows the intrinsics without any compiler flags, GCC & clang need the target attribute
+#if JUCE_MSVC
+#define HLAC_TARGET(x)
+#else
+#define HLAC_TARGET(x) __attribute__((target(x)))
+#endif
+
+#else
+#define HLAC_X86_SIMD 0
+#endif
+
+#if JUCE_ARM && defined(__aarch64__) && !HI_ENABLE_LEGACY_CPU_SUPPORT
+#define HLAC_NEON_SIMD 1
+#include <arm_neon.h>
+#else
+#define HLAC_NEON_SIMD 0
+#endif
+
+namespace SimdUnpack
+{
+
+/** The 6, 10, 12 and 14 bit compressors write the values as a continuous bitstream of 16 bit words (MSB first).
+
+	This table contains the byte shuffle indexes that build a 32 bit window (word << 16 | nextWord) for each
+	of eight values, and the left shift that moves the value to the top of the window. After this, a right 
+	shift by (32 - bitDepth) leaves the unsigned value in each lane.
+*/
+struct WordUnpackTable
+{
+	WordUnpackTable(int bitDepth)
+	{
+		for (int i = 0; i < 8; i++)
+		{
+			const int bitIndex = i * bitDepth;
+			const int word = bitIndex / 16;
+
+			int8* s = shuffle + 4 * i;
+
+			s[0] = (int8)(2 * word + 2);
+			s[1] = (int8)(2 * word + 3);
+			s[2] = (int8)(2 * word);
+			s[3] = (int8)(2 * word + 1);
+
+			shifts[i] = bitIndex % 16;
+			multipliers[i] = 1 << shifts[i];
+		}
+	}
+
+	alignas(16) int8 shuffle[32];
+	alignas(16) int32 shifts[8];
+	alignas(16) int32 multipliers[8];
+};
+
+constexpr int16 getUnsignedOffset(int bitDepth) { return (int16)((1 << (bitDepth - 1)) - 1); }
+
+/** Checks if a 16 byte load at the current position stays within the packed data. */
+constexpr bool canLoad(int numValues, int bitDepth, int numBytesToLoad)
+{
+	return (numValues / 8) * bitDepth >= numBytesToLoad;
+}
+
+#if HLAC_X86_SIMD
+
+template <int BitDepth> HLAC_TARGET("sse4.1") int unpackWordsSSE41(int16* destination, const uint8* data, int numValues)
+{
+	static const WordUnpackTable table(BitDepth);
+
+	const __m128i s1 = _mm_load_si128((const __m128i*)table.shuffle);
+	const __m128i s2 = _mm_load_si128((const __m128i*)(table.shuffle + 16));
+	const __m128i m1 = _mm_load_si128((const __m128i*)table.multipliers);
+	const __m128i m2 = _mm_load_si128((const __m128i*)(table.multipliers + 4));
+	const __m128i sub = _mm_set1_epi16(getUnsignedOffset(BitDepth));
+
+	int numDone = 0;
+
+	while (numValues - numDone >= 8 && canLoad(numValues - numDone, BitDepth, 16))
+	{
+		const __m128i d = _mm_loadu_si128((const __m128i*)data);
+
+		__m128i a = _mm_shuffle_epi8(d, s1);
+		__m128i b = _mm_shuffle_epi8(d, s2);
+
+		a = _mm_srli_epi32(_mm_mullo_epi32(a, m1), 32 - BitDepth);
+		b = _mm_srli_epi32(_mm_mullo_epi32(b, m2), 32 - BitDepth);
+
+		const __m128i v = _mm_sub_epi16(_mm_packus_epi32(a, b), sub);
+		_mm_storeu_si128((__m128i*)(destination + numDone), v);
+
+		data += BitDepth;
+		numDone += 8;
+	}
+
+	return numDone;
+}
+
+template <int BitDepth> HLAC_TARGET("avx2") int unpackWordsAVX2(int16* destination, const uint8* data, int numValues)
+{
+	static const WordUnpackTable table(BitDepth);
+
+	const __m256i s1 = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)table.shuffle));
+	const __m256i s2 = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)(table.shuffle + 16)));
+	const __m256i sh1 = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)table.shifts));
+	const __m256i sh2 = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)(table.shifts + 4)));
+	const __m256i sub = _mm256_set1_epi16(getUnsignedOffset(BitDepth));
+
+	int numDone = 0;
+
+	// Each 128 bit lane unpacks one group of eight values
+	while (numValues - numDone >= 16 && canLoad(numValues - numDone, BitDepth, 16 + BitDepth))
+	{
+		const __m128i lo = _mm_loadu_si128((const __m128i*)data);
+		const __m128i hi = _mm_loadu_si128((const __m128i*)(data + BitDepth));
+		const __m256i d = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+
+		__m256i a = _mm256_shuffle_epi8(d, s1);
+		__m256i b = _mm256_shuffle_epi8(d, s2);
+
+		a = _mm256_srli_epi32(_mm256_sllv_epi32(a, sh1), 32 - BitDepth);
+		b = _mm256_srli_epi32(_mm256_sllv_epi32(b, sh2), 32 - BitDepth);
+
+		const __m256i v = _mm256_sub_epi16(_mm256_packus_epi32(a, b), sub);
+		_mm256_storeu_si256((__m256i*)(destination + numDone), v);
+
+		data += 2 * BitDepth;
+		numDone += 16;
+	}
+
+	return numDone + unpackWordsSSE41<BitDepth>(destination + numDone, data, numValues - numDone);
+}
+
+HLAC_TARGET("sse4.1") int unpackTwoBitSSE41(int16* destination, const uint8* data, int numValues)
+{
+	// moves the value bit of each 2 bit pair to bit 14 and the sign bit to bit 15
+	const __m128i multipliers = _mm_setr_epi16(1 << 14, 1 << 12, 1 << 10, 1 << 8, 1 << 6, 1 << 4, 1 << 2, 1);
+	const __m128i one = _mm_set1_epi16(1);
+
+	int numDone = 0;
+
+	while (numValues - numDone >= 8)
+	{
+		uint16 word;
+		memcpy(&word, data, sizeof(uint16));
+
+		const __m128i x = _mm_mullo_epi16(_mm_set1_epi16((int16)word), multipliers);
+		const __m128i value = _mm_and_si128(_mm_srli_epi16(x, 14), one);
+
+		_mm_storeu_si128((__m128i*)(destination + numDone), _mm_sign_epi16(value, x));
+
+		data += 2;
+		numDone += 8;
+	}
+
+	return numDone;
+}
+
+HLAC_TARGET("sse4.1") int unpackFourBitSSE41(int16* destination, const uint8* data, int numValues)
+{
+	const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+	const __m128i valueMask = _mm_set1_epi16(0x07);
+
+	int numDone = 0;
+
+	while (numValues - numDone >= 16)
+	{
+		const __m128i bytes = _mm_loadl_epi64((const __m128i*)data);
+		const __m128i lo = _mm_and_si128(bytes, nibbleMask);
+		const __m128i hi = _mm_and_si128(_mm_srli_epi16(bytes, 4), nibbleMask);
+		const __m128i nibbles = _mm_unpacklo_epi8(lo, hi);
+
+		const __m128i n1 = _mm_cvtepu8_epi16(nibbles);
+		const __m128i n2 = _mm_cvtepu8_epi16(_mm_srli_si128(nibbles, 8));
+
+		// bit 3 is the sign bit, so shifting it to bit 15 gives the sign for _mm_sign_epi16
+		const __m128i v1 = _mm_sign_epi16(_mm_and_si128(n1, valueMask), _mm_slli_epi16(n1, 12));
+		const __m128i v2 = _mm_sign_epi16(_mm_and_si128(n2, valueMask), _mm_slli_epi16(n2, 12));
+
+		_mm_storeu_si128((__m128i*)(destination + numDone), v1);
+		_mm_storeu_si128((__m128i*)(destination + numDone + 8), v2);
+
+		data += 8;
+		numDone += 16;
+	}
+
+	return numDone;
+}
+
+#endif
+
+#if HLAC_NEON_SIMD
+
+template <int BitDepth> int unpackWordsNEON(int16* destination, const uint8* data, int numValues)
+{
+	static const WordUnpackTable table(BitDepth);
+
+	const uint8x16_t s1 = vld1q_u8(reinterpret_cast<const uint8*>(table.shuffle));
+	const uint8x16_t s2 = vld1q_u8(reinterpret_cast<const uint8*>(table.shuffle + 16));
+	const int32x4_t sh1 = vld1q_s32(table.shifts);
+	const int32x4_t sh2 = vld1q_s32(table.shifts + 4);
+	const int16x8_t sub = vdupq_n_s16(getUnsignedOffset(BitDepth));
+
+	int numDone = 0;
+
+	while (numValues - numDone >= 8 && canLoad(numValues - numDone, BitDepth, 16))
+	{
+		const uint8x16_t d = vld1q_u8(data);
+
+		uint32x4_t a = vreinterpretq_u32_u8(vqtbl1q_u8(d, s1));
+		uint32x4_t b = vreinterpretq_u32_u8(vqtbl1q_u8(d, s2));
+
+		a = vshrq_n_u32(vshlq_u32(a, sh1), 32 - BitDepth);
+		b = vshrq_n_u32(vshlq_u32(b, sh2), 32 - BitDepth);
+
+		const int16x8_t v = vreinterpretq_s16_u16(vcombine_u16(vmovn_u32(a), vmovn_u32(b)));
+		vst1q_s16(destination + numDone, vsubq_s16(v, sub));
+
+		data += BitDepth;
+		numDone += 8;
+	}
+
+	return numDone;
+}
+
+/** Applies the sign mask (0 or -1) to the value. */
+inline int16x8_t applySign(int16x8_t value, int16x8_t signMask)
+{
+	return vsubq_s16(veorq_s16(value, signMask), signMask);
+}
+
+inline int unpackTwoBitNEON(int16* destination, const uint8* data, int numValues)
+{
+	static const int16 shiftValues[8] = { 14, 12, 10, 8, 6, 4, 2, 0 };
+	const int16x8_t shifts = vld1q_s16(shiftValues);
+	const int16x8_t one = vdupq_n_s16(1);
+
+	int numDone = 0;
+
+	while (numValues - numDone >= 8)
+	{
+		uint16 word;
+		memcpy(&word, data, sizeof(uint16));
+
+		const int16x8_t x = vreinterpretq_s16_u16(vshlq_u16(vdupq_n_u16(word), shifts));
+		const int16x8_t value = vandq_s16(vreinterpretq_s16_u16(vshrq_n_u16(vreinterpretq_u16_s16(x), 14)), one);
+
+		vst1q_s16(destination + numDone, applySign(value, vshrq_n_s16(x, 15)));
+
+		data += 2;
+		numDone += 8;
+	}
+
+	return numDone;
+}
+
+inline int unpackFourBitNEON(int16* destination, const uint8* data, int numValues)
+{
+	const int16x8_t valueMask = vdupq_n_s16(0x07);
+
+	int numDone = 0;
+
+	while (numValues - numDone >= 16)
+	{
+		const uint8x8_t bytes = vld1_u8(data);
+		const uint8x8x2_t nibbles = vzip_u8(vand_u8(bytes, vdup_n_u8(0x0F)), vshr_n_u8(bytes, 4));
+
+		const int16x8_t n1 = vreinterpretq_s16_u16(vmovl_u8(nibbles.val[0]));
+		const int16x8_t n2 = vreinterpretq_s16_u16(vmovl_u8(nibbles.val[1]));
+
+		vst1q_s16(destination + numDone, applySign(vandq_s16(n1, valueMask), vnegq_s16(vshrq_n_s16(n1, 3))));
+		vst1q_s16(destination + numDone + 8, applySign(vandq_s16(n2, valueMask), vnegq_s16(vshrq_n_s16(n2, 3))));
+
+		data += 8;
+		numDone += 16;
+	}
+
+	return numDone;
+}
+
+#endif
+
+/** Unpacks as many values as possible with the current decode mode and returns the number of decompressed values. 
+
+	The remaining values must be decompressed with the scalar code. 
+*/
+template <int BitDepth> int unpackWords(int16* destination, const uint8* data, int numValues)
+{
+	switch (BitCompressors::getDecodeMode())
+	{
+#if HLAC_X86_SIMD
+	case BitCompressors::DecodeMode::AVX2:  return unpackWordsAVX2<BitDepth>(destination, data, numValues);
+	case BitCompressors::DecodeMode::SSE41: return unpackWordsSSE41<BitDepth>(destination, data, numValues);
+#endif
+#if HLAC_NEON_SIMD
+	case BitCompressors::DecodeMode::NEON:  return unpackWordsNEON<BitDepth>(destination, data, numValues);
+#endif
+	default: return 0;
+	}
+}
+
+inline int unpackTwoBit(int16* destination, const uint8* data, int numValues)
+{
+	switch (BitCompressors::getDecodeMode())
+	{
+#if HLAC_X86_SIMD
+	case BitCompressors::DecodeMode::AVX2:
+	case BitCompressors::DecodeMode::SSE41: return unpackTwoBitSSE41(destination, data, numValues);
+#endif
+#if HLAC_NEON_SIMD
+	case BitCompressors::DecodeMode::NEON:  return unpackTwoBitNEON(destination, data, numValues);
+#endif
+	default: return 0;
+	}
+}
+
+inline int unpackFourBit(int16* destination, const uint8* data, int numValues)
+{
+	switch (BitCompressors::getDecodeMode())
+	{
+#if HLAC_X86_SIMD
+	case BitCompressors::DecodeMode::AVX2:
+	case BitCompressors::DecodeMode::SSE41: return unpackFourBitSSE41(destination, data, numValues);
+#endif
+#if HLAC_NEON_SIMD
+	case BitCompressors::DecodeMode::NEON:  return unpackFourBitNEON(destination, data, numValues);
+#endif
+	default: return 0;
+	}
+}
+
+}
+
+static Atomic<int> currentDecodeMode(-1);
+
+bool BitCompressors::isDecodeModeSupported(DecodeMode m)
+{
+	switch (m)
+	{
+	case DecodeMode::Scalar: return true;
+#if HLAC_X86_SIMD
+	case DecodeMode::SSE41:  return SystemStats::hasSSE41();
+	case DecodeMode::AVX2:   return SystemStats::hasAVX2() && SystemStats::hasSSE41();
+#endif
+#if HLAC_NEON_SIMD
+	case DecodeMode::NEON:	 return true;
+#endif
+	default:				 return false;
+	}
+}
+
+BitCompressors::DecodeMode BitCompressors::getDecodeMode()
+{
+	auto m = currentDecodeMode.get();
+
+	if (m == -1)
+	{
+		for (m = (int)DecodeMode::numDecodeModes - 1; m > 0; m--)
+		{
+			if (isDecodeModeSupported((DecodeMode)m))
+				break;
+		}
+
+		currentDecodeMode.set(m);
+	}
+
+	return (DecodeMode)m;
+}
+
+bool BitCompressors::setDecodeMode(DecodeMode newMode)
+{
+	if (!isDecodeModeSupported(newMode))
+		return false;
+
+	currentDecodeMode.set((int)newMode);
+	return true;
+}
+
+String BitCompressors::getDecodeModeName(DecodeMode m)
+{
+	switch (m)
+	{
+	case DecodeMode::Scalar: return "Scalar";
+	case DecodeMode::SSE41:  return "SSE4.1";
+	case DecodeMode::AVX2:   return "AVX2";
+	case DecodeMode::NEON:   return "NEON";
+	default:				 return {};
+	}
+}
+
 
 int BitCompressors::ZeroBit::getAllowedBitRange() const
 {
@@ -318,6 +709,11 @@ bool BitCompressors::TwoBit::compress(uint8* destination, const int16* data, int
 
 bool BitCompressors::TwoBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	const int numSimdValues = SimdUnpack::unpackTwoBit(destination, data, numValuesToDecompress);
+	destination += numSimdValues;
+	data += numSimdValues / 4;
+	numValuesToDecompress -= numSimdValues;
+
 	const uint8 signMasks[4] =  { 0b00000010, 0b00001000, 0b00100000, 0b10000000 };
 	const uint8 valueMasks[4] = { 0b00000001, 0b00000100, 0b00010000, 0b01000000 };
 
@@ -431,7 +827,10 @@ bool BitCompressors::FourBit::compress(uint8* destination, const int16* data, in
 
 bool BitCompressors::FourBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
-	
+	const int numSimdValues = SimdUnpack::unpackFourBit(destination, data, numValuesToDecompress);
+	destination += numSimdValues;
+	data += numSimdValues / 2;
+	numValuesToDecompress -= numSimdValues;
 
 	const uint8 signMasks[2] =  { 0b00001000, 0b10000000 };
 	const uint8 valueMasks[2] = { 0b00000111, 0b01110000 };
@@ -543,6 +942,11 @@ bool BitCompressors::SixBit::compress(uint8* destination, const int16* data, int
 
 bool BitCompressors::SixBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	const int numSimdValues = SimdUnpack::unpackWords<6>(destination, data, numValuesToDecompress);
+	destination += numSimdValues;
+	data += numSimdValues * 6 / 8;
+	numValuesToDecompress -= numSimdValues;
+
 #if JUCE_IOS
 	while (numValuesToDecompress >= 8)
 	{
@@ -790,6 +1194,11 @@ bool BitCompressors::TenBit::compress(uint8* destination, const int16* data, int
 
 bool BitCompressors::TenBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	const int numSimdValues = SimdUnpack::unpackWords<10>(destination, data, numValuesToDecompress);
+	destination += numSimdValues;
+	data += numSimdValues * 10 / 8;
+	numValuesToDecompress -= numSimdValues;
+
 	while (numValuesToDecompress >= 8)
 	{
 		decompress10Bit(reinterpret_cast<uint16*>(destination), (void*)data);
@@ -848,6 +1257,11 @@ bool BitCompressors::TwelveBit::compress(uint8* destination, const int16* data,
 
 bool BitCompressors::TwelveBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	const int numSimdValues = SimdUnpack::unpackWords<12>(destination, data, numValuesToDecompress);
+	destination += numSimdValues;
+	data += numSimdValues * 12 / 8;
+	numValuesToDecompress -= numSimdValues;
+
 #if USE_SSE
 
 	const int numInBlockProcessing = numValuesToDecompress - (numValuesToDecompress % 4);
@@ -1002,6 +1416,11 @@ bool BitCompressors::FourteenBit::compress(uint8* destination, const int16* data
 
 bool BitCompressors::FourteenBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	const int numSimdValues = SimdUnpack::unpackWords<14>(destination, data, numValuesToDecompress);
+	destination += numSimdValues;
+	data += numSimdValues * 14 / 8;
+	numValuesToDecompress -= numSimdValues;
+
 	while (numValuesToDecompress >= 8)
 	{
 		decompress14Bit(destination, data);
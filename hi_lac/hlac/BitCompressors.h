@@ -47,6 +47,27 @@ namespace hlac { using namespace juce;
 
 struct BitCompressors
 {
+	/** The instruction set that is used for unpacking the values in the decompress() methods. */
+	enum class DecodeMode
+	{
+		Scalar = 0,
+		SSE41,
+		AVX2,
+		NEON,
+		numDecodeModes
+	};
+
+	/** Returns the decode mode that is currently used. By default this is the fastest mode that is supported by the CPU. */
+	static DecodeMode getDecodeMode();
+
+	/** Changes the decode mode (this is used for benchmarking). Returns false if the CPU doesn't support the mode. */
+	static bool setDecodeMode(DecodeMode newMode);
+
+	/** Checks whether the given mode was compiled in and is supported by the CPU. */
+	static bool isDecodeModeSupported(DecodeMode m);
+
+	static String getDecodeModeName(DecodeMode m);
+
 	struct Base
 	{
 		virtual ~Base() {};
@@ -1123,6 +1123,29 @@ uint32 CompressionHelpers::Misc::createChecksum()
 	r.setSeedRandomly();
 	r.setSeedRandomly();
 
+	return createChecksum((uint32)r.nextInt());
+}
+
+uint32 CompressionHelpers::Misc::getChecksumSeed(const int16* data, int numSamples)
+{
+	// FNV-1a
+	uint32 hash = 2166136261u;
+
+	auto bytes = reinterpret_cast<const uint8*>(data);
+
+	for (int i = 0; i < numSamples * (int)sizeof(int16); i++)
+	{
+		hash ^= bytes[i];
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+uint32 CompressionHelpers::Misc::createChecksum(uint32 seed)
+{
+	Random r((int64)seed);
+
 	uint16 randomNumber = (uint16)r.nextInt(Range<int>(2, UINT16_MAX));
 
 	uint8* d = reinterpret_cast<uint8*>(&randomNumber);
@@ -1173,6 +1196,257 @@ var HlacArchiver::readMetadataFromArchive(const File& sourceFile)
 	return var();
 }
 
+/** Decodes the extracted FLAC data into HLAC monoliths on a thread pool.
+
+	The archive is still read on the extraction thread, so copying the next monolith out of the archive
+	overlaps with the decoding of the previous ones. The workers never call the listener, they just store
+	their state which is reported by the extraction thread in waitForJobs().
+*/
+class HlacArchiver::DecodeQueue
+{
+public:
+
+	struct Job
+	{
+		String name;
+		File tmpFlacFile;
+		File targetHlacFile;
+		int64 numBytes = 0;
+
+		std::atomic<double> progress = { 0.0 };
+		bool ok = false;
+		String errorMessage;
+		StringArray verboseMessages;
+		WaitableEvent finished;
+	};
+
+	DecodeQueue(HlacArchiver& parent_, const DecompressData& data_) :
+		parent(parent_),
+		data(data_),
+		numThreads(data_.numThreads > 0 ? data_.numThreads : jmax(1, SystemStats::getNumCpus())),
+		pool(numThreads)
+	{}
+
+	~DecodeQueue()
+	{
+		shouldAbort.store(true);
+		pool.removeAllJobs(true, -1);
+
+		for (auto j : pendingJobs)
+			j->tmpFlacFile.deleteFile();
+	}
+
+	/** Starts decoding the given job. Make sure to call waitForJobs() before so that the memory usage is limited. */
+	void addJob(Job* newJob)
+	{
+		pendingJobs.add(newJob);
+
+		pool.addJob([this, newJob]()
+		{
+			if (!shouldAbort.load())
+				decode(*newJob);
+
+			newJob->finished.signal();
+		});
+	}
+
+	/** Waits until there are less than maxNumPending jobs (and enough memory for the next job). 
+	
+		Returns false if a job failed or the thread should exit. 
+	*/
+	bool waitForJobs(int maxNumPending, int64 numBytesForNextJob=0)
+	{
+		while (pendingJobs.size() > 0 && (pendingJobs.size() > maxNumPending || getNumPendingBytes() + numBytesForNextJob > MaxNumPendingBytes))
+		{
+			auto j = pendingJobs.getFirst();
+
+			while (!j->finished.wait(50))
+			{
+				if (parent.thread->threadShouldExit())
+					return false;
+
+				*data.progress = j->progress.load();
+			}
+
+			if (parent.listener != nullptr)
+			{
+				for (const auto& m : j->verboseMessages)
+					parent.listener->logVerboseMessage(m);
+			}
+
+			if (!j->ok)
+			{
+				j->tmpFlacFile.deleteFile();
+
+				if (parent.listener != nullptr)
+					parent.listener->criticalErrorOccured(j->errorMessage);
+
+				return false;
+			}
+
+			pendingJobs.removeObject(j);
+		}
+
+		return !parent.thread->threadShouldExit();
+	}
+
+	int getNumThreads() const { return numThreads; }
+
+private:
+
+	/** The FLAC size is used as estimation for the memory that the HLAC writer allocates. */
+	static constexpr int64 MaxNumPendingBytes = (int64)1024 * 1024 * 1024 * 2;
+
+	int64 getNumPendingBytes() const
+	{
+		int64 numBytes = 0;
+
+		for (auto j : pendingJobs)
+			numBytes += j->numBytes;
+
+		return numBytes;
+	}
+
+	bool shouldExit() const
+	{
+		return shouldAbort.load() || parent.thread->threadShouldExit();
+	}
+
+	void decode(Job& j)
+	{
+		FlacAudioFormat flacFormat;
+		hlac::HiseLosslessAudioFormat hlacFormat;
+
+		ScopedPointer<AudioFormatReader> flacReader = flacFormat.createReaderFor(new FileInputStream(j.tmpFlacFile), true);
+
+		if (flacReader == nullptr)
+		{
+			j.errorMessage = "Read error: Can't decode " + j.name;
+			return;
+		}
+
+		j.verboseMessages.add("    Samplerate: " + String(flacReader->sampleRate, 1));
+		j.verboseMessages.add("    Channels: " + String(flacReader->numChannels));
+		j.verboseMessages.add("    Length: " + String(flacReader->lengthInSamples));
+
+		ScopedPointer<AudioFormatWriter> writer;
+
+		if (!data.debugLogMode)
+		{
+			StringPairArray metadata;
+
+			writer = hlacFormat.createWriterFor(new FileOutputStream(j.targetHlacFile), flacReader->sampleRate, flacReader->numChannels, 5, metadata, 5);
+
+			auto options = hlac::HlacEncoder::CompressorOptions::getPreset(hlac::HlacEncoder::CompressorOptions::Presets::Diff);
+
+			options.applyDithering = false;
+			options.normalisationMode = data.supportFullDynamics ? 2 : 0;
+
+			auto hWriter = dynamic_cast<HiseLosslessAudioFormatWriter*>(writer.get());
+
+			hWriter->preallocateMemory(flacReader->lengthInSamples, flacReader->numChannels);
+			hWriter->setOptions(options);
+		}
+
+		const int bufferSize = 8192 * 32;
+
+		AudioSampleBuffer tempBuffer(flacReader->numChannels, data.debugLogMode ? 0 : bufferSize);
+
+		for (int64 readerOffset = 0; readerOffset < flacReader->lengthInSamples; readerOffset += bufferSize)
+		{
+			if (shouldExit())
+				return;
+
+			const int numToRead = jmin<int>(bufferSize, (int)(flacReader->lengthInSamples - readerOffset));
+
+			if (!data.debugLogMode)
+			{
+				flacReader->read(&tempBuffer, 0, numToRead, readerOffset, true, true);
+				
+				if (!writer->writeFromAudioSampleBuffer(tempBuffer, 0, numToRead))
+				{
+					j.errorMessage = "File write error for " + j.targetHlacFile.getFileName();
+					return;
+				}
+			}
+
+			j.progress.store((double)readerOffset / (double)flacReader->lengthInSamples);
+		}
+
+		if (!data.debugLogMode)
+		{
+			if (!writer->flush())
+			{
+				j.errorMessage = "File write error: Flushing file " + j.targetHlacFile.getFileName();
+				return;
+			}
+
+			writer = nullptr;
+
+			if (data.verifyChecksums && !verifyMonolith(j.targetHlacFile, j.errorMessage))
+				return;
+		}
+
+		flacReader = nullptr;
+		j.tmpFlacFile.deleteFile();
+		j.progress.store(1.0);
+		j.ok = true;
+	}
+
+	HlacArchiver& parent;
+	const DecompressData& data;
+	const int numThreads;
+
+	std::atomic<bool> shouldAbort = { false };
+
+	OwnedArray<Job> pendingJobs;
+	ThreadPool pool;
+};
+
+bool HlacArchiver::verifyMonolith(const File& hlacFile, String& errorMessage)
+{
+	FileInputStream fis(hlacFile);
+
+	if (!fis.openedOk())
+	{
+		errorMessage = "Can't open " + hlacFile.getFileName();
+		return false;
+	}
+
+	HiseLosslessHeader header(&fis);
+
+	if (!header.isValid())
+	{
+		errorMessage = "Invalid header in " + hlacFile.getFileName();
+		return false;
+	}
+
+	const int64 fileLength = fis.getTotalLength();
+
+	for (uint32 i = 0; i < header.getBlockAmount(); i++)
+	{
+		auto offset = (int64)header.getOffsetForReadPosition((int64)i * COMPRESSION_BLOCK_SIZE, true);
+
+		// The normalisation values are stored before the checksum
+		if (header.getVersion() > 2)
+			offset += 4;
+
+		if (offset + 4 > fileLength || !fis.setPosition(offset))
+		{
+			errorMessage = "Truncated block " + String(i) + " in " + hlacFile.getFileName();
+			return false;
+		}
+
+		if (!CompressionHelpers::Misc::validateChecksum((uint32)fis.readInt()))
+		{
+			errorMessage = "Checksum error at block " + String(i) + " in " + hlacFile.getFileName();
+			return false;
+		}
+	}
+
+	return true;
+}
+
 bool HlacArchiver::extractSampleData(const DecompressData& data)
 {
 	jassert(listener != nullptr);
@@ -1200,19 +1474,16 @@ bool HlacArchiver::extractSampleData(const DecompressData& data)
 
 	ScopedPointer<FileInputStream> fis = new FileInputStream(sourceFile);
 
-	FlacAudioFormat flacFormat;
-	hlac::HiseLosslessAudioFormat hlacFormat;
-
 	CHECK_FLAG(Flag::BeginMetadata);
 	auto metadataString = fis->readString();
 	CHECK_FLAG(Flag::EndMetadata);
 
 	VERBOSE_LOG(metadataString);
 
-	StringPairArray metadata;
-
 	int partIndex = 1;
 
+	DecodeQueue decodeQueue(*this, data);
+
 	currentFlag = readFlag(fis);
 
 	if (currentFlag == Flag::BeginHeaderFile)
@@ -1285,8 +1556,6 @@ bool HlacArchiver::extractSampleData(const DecompressData& data)
 		{
 			VERBOSE_LOG("  Overwriting File ");
 
-			bool ok = true;
-
 			File tmpFlacFile = targetHlacFile.getSiblingFile("TmpFlac.flac").getNonexistentSibling();
 
 			if (tmpFlacFile.existsAsFile())
@@ -1302,7 +1571,23 @@ bool HlacArchiver::extractSampleData(const DecompressData& data)
 
 			CHECK_FLAG(Flag::BeginMonolith);
 
-			flacTempWriteStream->writeFromInputStream(*fis, bytesToRead);
+			int64 numBytesInTempFile = 0;
+
+			// Check that every chunk is complete so that a truncated archive fails here and not in the decoder
+			auto copyChunk = [&]()
+			{
+				auto numCopied = flacTempWriteStream->writeFromInputStream(*fis, bytesToRead);
+				numBytesInTempFile += numCopied;
+				return numCopied == bytesToRead;
+			};
+
+			if (!copyChunk())
+			{
+				flacTempWriteStream = nullptr;
+				tmpFlacFile.deleteFile();
+				listener->criticalErrorOccured("Read error: The archive " + fis->getFile().getFileName() + " is truncated");
+				return false;
+			}
 
 			currentFlag = readFlag(fis);
 
@@ -1320,104 +1605,45 @@ bool HlacArchiver::extractSampleData(const DecompressData& data)
 
 				CHECK_FLAG(Flag::ResumeMonolith);
 
-				flacTempWriteStream->writeFromInputStream(*fis, bytesToRead);
+				if (!copyChunk())
+				{
+					flacTempWriteStream = nullptr;
+					tmpFlacFile.deleteFile();
+					listener->criticalErrorOccured("Read error: The archive " + fis->getFile().getFileName() + " is truncated");
+					return false;
+				}
 
 				currentFlag = readFlag(fis);
 			}
 
-			if (thread->threadShouldExit())
-				return false;
-
-			jassert(currentFlag == Flag::EndMonolith);
-
 			flacTempWriteStream->flush();
 			flacTempWriteStream = nullptr;
 
-			FileInputStream* flacTempInputStream = new FileInputStream(tmpFlacFile);
-
-			jassert(flacTempInputStream->openedOk());
-
-			ScopedPointer<AudioFormatReader> flacReader = flacFormat.createReaderFor(flacTempInputStream, true);
-
-			if (flacReader == nullptr)
-				return false;
-
-			VERBOSE_LOG("    Samplerate: " + String(flacReader->sampleRate, 1));
-			VERBOSE_LOG("    Channels: " + String(flacReader->numChannels));
-			VERBOSE_LOG("    Length: " + String(flacReader->lengthInSamples));
-
-			FileOutputStream* monolithOutputStream; 
-			ScopedPointer<AudioFormatWriter> writer;
-
-			if (!data.debugLogMode)
-			{
-				if (targetHlacFile.existsAsFile())
-					targetHlacFile.create();
-
-				monolithOutputStream = new FileOutputStream(targetHlacFile);
-				writer = hlacFormat.createWriterFor(monolithOutputStream, flacReader->sampleRate, flacReader->numChannels, 5, metadata, 5);
-			}
-
-			STATUS_LOG("Decompressing " + name);
-
-			const int bufferSize = 8192 * 32;
-
-			hlac::HlacEncoder::CompressorOptions options = hlac::HlacEncoder::CompressorOptions::getPreset(hlac::HlacEncoder::CompressorOptions::Presets::Diff);
-
 			if (thread->threadShouldExit())
+			{
+				tmpFlacFile.deleteFile();
 				return false;
+			}
 
-			options.applyDithering = false;
-			options.normalisationMode = data.supportFullDynamics ? 2 : 0;
-
-			//dynamic_cast<HiseLosslessAudioFormatWriter*>(writer.get())->setTemporaryBufferType(true);
-
-			dynamic_cast<HiseLosslessAudioFormatWriter*>(writer.get())->preallocateMemory(flacReader->lengthInSamples, flacReader->numChannels);
-
-			if(!data.debugLogMode)
-				dynamic_cast<HiseLosslessAudioFormatWriter*>(writer.get())->setOptions(options);
-
-			AudioSampleBuffer tempBuffer(flacReader->numChannels, data.debugLogMode ? 0 : bufferSize);
+			jassert(currentFlag == Flag::EndMonolith);
 
-			for (int64 readerOffset = 0; readerOffset < flacReader->lengthInSamples; readerOffset += bufferSize)
+			// Limit the amount of decoded data that is kept in memory
+			if (!decodeQueue.waitForJobs(decodeQueue.getNumThreads() - 1, numBytesInTempFile))
 			{
-				if (thread->threadShouldExit())
-					return false;
-
-				const int numToRead = jmin<int>(bufferSize, (int)(flacReader->lengthInSamples - readerOffset));
-
-				if (!data.debugLogMode)
-				{
-					flacReader->read(&tempBuffer, 0, numToRead, readerOffset, true, true);
-					ok = writer->writeFromAudioSampleBuffer(tempBuffer, 0, numToRead);
-					if (!ok)
-					{
-						listener->criticalErrorOccured("File write error for " + targetHlacFile.getFileName());
-						return false;
-					}
-				}
-
-				*data.progress = (double)readerOffset / (double)flacReader->lengthInSamples;
+				tmpFlacFile.deleteFile();
+				return false;
 			}
 
-			
-			if (!data.debugLogMode)
-			{
-				ok = writer->flush();
-				if (!ok)
-				{
-					listener->criticalErrorOccured("File write error: Flushing file " + targetHlacFile.getFileName());
-					return false;
-				}
+			STATUS_LOG("Decompressing " + name);
 
-				if (thread->threadShouldExit())
-					return false;
+			auto job = new DecodeQueue::Job();
+			job->name = name;
+			job->tmpFlacFile = tmpFlacFile;
+			job->targetHlacFile = targetHlacFile;
+			job->numBytes = numBytesInTempFile;
 
-				writer = nullptr;
-			}
+			decodeQueue.addJob(job);
 
-			flacReader = nullptr;
-			tmpFlacFile.deleteFile();
 			currentFlag = readFlag(fis);
 		}
 		else
@@ -1459,7 +1685,7 @@ bool HlacArchiver::extractSampleData(const DecompressData& data)
 
 	jassert(currentFlag == Flag::EndOfArchive);
 
-	return true;
+	return decodeQueue.waitForJobs(0);
 }
 
 #undef CHECK_FLAG
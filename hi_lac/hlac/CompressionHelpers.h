@@ -296,6 +296,12 @@ struct CompressionHelpers
 
 		static uint32 createChecksum();
 
+		/** Creates a valid checksum from the given seed. */
+		static uint32 createChecksum(uint32 seed);
+
+		/** Creates a hash value from the sample data that can be used as deterministic checksum seed. */
+		static uint32 getChecksumSeed(const int16* data, int numSamples);
+
 		static bool validateChecksum(uint32 data);
 	};
 
@@ -406,6 +412,11 @@ struct HlacArchiver
 		double* totalProgress = nullptr;
 		bool debugLogMode = false;
 
+		/** The number of monoliths that are decoded at the same time. If zero, it uses the number of CPU cores. */
+		int numThreads = 0;
+
+		/** Checks the header and the block checksums of every extracted monolith. */
+		bool verifyChecksums = true;
 	};
 
 	HlacArchiver(Thread* threadToUse) :
@@ -431,6 +442,9 @@ struct HlacArchiver
 
 	static String getMetadataJSON(const File& sourceFile);
 
+	/** Checks the header and the checksum of every block in the given HLAC file without decoding it. */
+	static bool verifyMonolith(const File& hlacFile, String& errorMessage);
+
 	var readMetadataFromArchive(const File& archiveFile);
 
 	void setListener(Listener* l)
@@ -440,6 +454,8 @@ struct HlacArchiver
 
 private:
 
+	class DecodeQueue;
+
 	FileInputStream* writeTempFile(AudioFormatReader* reader, int bitDepth=16);
 
 	Listener* listener = nullptr;
@@ -305,7 +305,9 @@ bool HiseLosslessHeader::write(OutputStream* output)
 	if (headerByte1 < 2)
 		return true;
 
-	auto checkSum = CompressionHelpers::Misc::createChecksum();
+	// Derive the checksum from the header so that the same data always creates the same file
+	auto seed = blockAmount ^ ((uint32)headerByte2 << 16) ^ ((uint32)sampleDataByte << 24);
+	auto checkSum = CompressionHelpers::Misc::createChecksum(seed);
 
 	output->writeInt((int)checkSum);
 
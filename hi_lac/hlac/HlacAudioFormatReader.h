@@ -52,6 +52,9 @@ struct HiseLosslessHeader
 	double getSampleRate() const;
 	uint32 getBlockAmount() const;
 
+	/** Returns false if the checksum of the header is wrong. */
+	bool isValid() const { return headerValid; }
+
 	uint32 getOffsetForReadPosition(int64 samplePosition, bool addHeaderOffset);
 
 	uint32 getOffsetForNextBlock(int64 samplePosition, bool addHeaderOffset);
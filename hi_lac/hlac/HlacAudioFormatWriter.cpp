@@ -193,6 +193,45 @@ int64 HiseLosslessAudioFormatWriter::getNumBytesWritten() const
 	return numBytesWritten;
 }
 
+bool HiseLosslessAudioFormatWriter::appendEncodedData(const HlacEncoder::EncodedData& d)
+{
+	// The encoded data contains compressed blocks...
+	jassert(options.useCompression);
+
+	tempWasFlushed = false;
+
+	auto ok = encoder.appendEncodedData(d, *tempOutputStream, blockOffsets);
+
+	numBytesWritten = tempOutputStream->getPosition();
+
+	return ok;
+}
+
+hlac::HlacEncoder::EncodedData HiseLosslessAudioFormatWriter::releaseEncodedData()
+{
+	HlacEncoder::EncodedData d;
+
+	auto mos = dynamic_cast<MemoryOutputStream*>(tempOutputStream.get());
+
+	// You must not use a temporary file for this operation
+	jassert(mos != nullptr);
+
+	if (mos != nullptr)
+	{
+		mos->flush();
+		d.data = mos->getMemoryBlock();
+		mos->reset();
+	}
+
+	encoder.fillEncodedData(d, blockOffsets);
+	encoder.reset();
+
+	numBytesWritten = 0;
+	tempWasFlushed = true;
+
+	return d;
+}
+
 bool HiseLosslessAudioFormatWriter::writeHeader()
 {
 	if (options.useCompression)
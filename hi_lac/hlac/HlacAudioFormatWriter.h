@@ -71,6 +71,18 @@ public:
 	/** Returns the number of written bytes for this reader. */
 	int64 getNumBytesWritten() const;
 
+	/** Appends the data that was encoded by another writer (eg. on a worker thread). 
+	
+		The result is identical to encoding the same source with this writer.
+	*/
+	bool appendEncodedData(const HlacEncoder::EncodedData& d);
+
+	/** Moves the encoded data out of this writer without writing anything to the output stream.
+
+		This is used to encode parts of a monolith on a worker thread and append it to the actual writer with appendEncodedData().
+	*/
+	HlacEncoder::EncodedData releaseEncodedData();
+
 private:
 
 	bool writeHeader();
@@ -119,6 +119,25 @@ void HlacEncoder::compress(AudioSampleBuffer& source, OutputStream& output, uint
 	
 }
 
+bool HlacEncoder::appendEncodedData(const EncodedData& d, OutputStream& output, uint32* blockOffsetData)
+{
+	for (auto offset : d.blockOffsets)
+		blockOffsetData[blockIndex++] = numBytesWritten + offset;
+
+	numBytesWritten += d.numBytesWritten;
+	numBytesUncompressed += d.numBytesUncompressed;
+
+	return output.write(d.data.getData(), d.data.getSize());
+}
+
+void HlacEncoder::fillEncodedData(EncodedData& d, const uint32* blockOffsetData) const
+{
+	d.blockOffsets.clearQuick();
+	d.blockOffsets.addArray(blockOffsetData, (int)blockIndex);
+	d.numBytesWritten = numBytesWritten;
+	d.numBytesUncompressed = numBytesUncompressed;
+}
+
 void HlacEncoder::reset()
 {
 	indexInBlock = 0;
@@ -165,7 +184,7 @@ bool HlacEncoder::encodeBlock(CompressionHelpers::AudioBufferInt16& block16, Out
 	auto compressedBlock = createCompressedBlock(block16);
 	auto thisBlockSize = compressedBlock.getSize();
 
-	writeChecksumBytesForBlock(output);
+	writeChecksumBytesForBlock(block16, output);
 	
 	if (thisBlockSize > 2 * COMPRESSION_BLOCK_SIZE)
 	{
@@ -332,10 +351,12 @@ uint8 HlacEncoder::getBitReductionAmountForMSEncoding(AudioSampleBuffer& block)
 }
 
 
-bool HlacEncoder::writeChecksumBytesForBlock(OutputStream& output)
+bool HlacEncoder::writeChecksumBytesForBlock(const CompressionHelpers::AudioBufferInt16& block, OutputStream& output)
 {
-	
-	auto checkSum = CompressionHelpers::Misc::createChecksum();
+	// The checksum is derived from the block content so that encoding the same data
+	// always creates the same output (no matter which thread or encoder instance wrote it).
+	auto seed = CompressionHelpers::Misc::getChecksumSeed(block.getReadPointer(), block.size);
+	auto checkSum = CompressionHelpers::Misc::createChecksum(seed);
 
 	if (!output.writeInt((int)checkSum))
 		return false;
@@ -445,7 +466,7 @@ bool HlacEncoder::encodeDiff(CompressionHelpers::AudioBufferInt16& cycle, Output
 	if (numBytesForFull > 0)
 	{
 		MemoryBlock mbFull;
-		mbFull.setSize(numBytesForFull);
+		mbFull.setSize(numBytesForFull, true);
 		compressorFull->compress((uint8*)mbFull.getData(), packedBuffer.getReadPointer(), numFullValues);
 
 		if (!output.write(mbFull.getData(), numBytesForFull))
@@ -457,7 +478,7 @@ bool HlacEncoder::encodeDiff(CompressionHelpers::AudioBufferInt16& cycle, Output
 	if (numBytesForError > 0)
 	{
 		MemoryBlock mbError;
-		mbError.setSize(numBytesForError);
+		mbError.setSize(numBytesForError, true);
 		compressorError->compress((uint8*)mbError.getData(), packedErrorBuffer.getReadPointer(), numErrorValues);
 
 		
@@ -538,7 +559,7 @@ void HlacEncoder::encodeLastBlock(AudioSampleBuffer& block, OutputStream& output
 	CompressionHelpers::AudioBufferInt16 a(block, 0, options.normalisationMode, options.normalisationThreshold);
 
 	normaliseBlockAndAddHeader(a, output);
-	writeChecksumBytesForBlock(output);
+	writeChecksumBytesForBlock(a, output);
 	
 	MemoryOutputStream lastTemp;
 
@@ -128,7 +128,25 @@ public:
 	};
 
 
+	/** The encoded data of a sample (or a part of it) that was compressed by another encoder.
+
+		This is used by the HlacParallelEncoder to encode multiple files on different threads and append them to a monolith in the original order.
+	*/
+	struct EncodedData
+	{
+		MemoryBlock data;
+		Array<uint32> blockOffsets;
+		uint32 numBytesWritten = 0;
+		uint32 numBytesUncompressed = 0;
+	};
+
 	void compress(AudioSampleBuffer& source, OutputStream& output, uint32* blockOffsetData);
+
+	/** Appends the data from another encoder. The result is identical to the data this encoder would have created for the same source. */
+	bool appendEncodedData(const EncodedData& d, OutputStream& output, uint32* blockOffsetData);
+
+	/** Copies the block offsets and the counters of this encoder into the given object. */
+	void fillEncodedData(EncodedData& d, const uint32* blockOffsetData) const;
 	
 	void reset();
 
@@ -158,7 +176,7 @@ private:
 		return indexInBlock >= COMPRESSION_BLOCK_SIZE;
 	}
 
-	bool writeChecksumBytesForBlock(OutputStream& output);
+	bool writeChecksumBytesForBlock(const CompressionHelpers::AudioBufferInt16& block, OutputStream& output);
 
 	bool writeNormalisationAmount(OutputStream& output);
 
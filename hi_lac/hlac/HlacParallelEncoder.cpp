@@ -0,0 +1,158 @@
+/*  ===========================================================================
+ *
+ *   This file is part of HISE.
+ *   Copyright 2016 Christoph Hart
+ *
+ *   HISE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   HISE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Commercial licenses for using HISE in an closed source project are
+ *   available on request. Please visit the project's website to get more
+ *   information about commercial licensing:
+ *
+ *   http://www.hise.audio/
+ *
+ *   HISE is based on the JUCE library,
+ *   which must be separately licensed for closed source applications:
+ *
+ *   http://www.juce.com
+ *
+ *   ===========================================================================
+ */
+
+
+namespace hlac { using namespace juce; 
+
+HlacParallelEncoder::HlacParallelEncoder(const Array<File>& filesToEncode, int numChannels_, double sampleRate_, const HlacEncoder::CompressorOptions& options_, int numThreads_):
+	files(filesToEncode),
+	numChannels(numChannels_),
+	sampleRate(sampleRate_),
+	options(options_),
+	numThreads(numThreads_ > 0 ? numThreads_ : jmax(1, SystemStats::getNumCpus())),
+	pool(numThreads)
+{
+	AudioFormatManager afm;
+	afm.registerBasicFormats();
+	afm.registerFormat(new HiseLosslessAudioFormat(), false);
+
+	for (int i = 0; i < files.size(); i++)
+	{
+		ScopedPointer<AudioFormatReader> reader = afm.createReaderFor(files[i]);
+
+		if (reader == nullptr)
+		{
+			// A negative length will be reported as error when the file is appended
+			segments.add(new Segment(i, 0, -1));
+			continue;
+		}
+
+		const int64 length = reader->lengthInSamples;
+
+		totalNumSamples += length;
+
+		for (int64 start = 0; start < length; start += SegmentLength)
+			segments.add(new Segment(i, start, jmin(SegmentLength, length - start)));
+	}
+}
+
+HlacParallelEncoder::~HlacParallelEncoder()
+{
+	shouldAbort.store(true);
+	pool.removeAllJobs(true, 10000);
+}
+
+bool HlacParallelEncoder::appendFile(int fileIndex, HiseLosslessAudioFormatWriter& writer, Thread* threadToCheck)
+{
+	while (isPositiveAndBelow(nextSegmentToAppend, segments.size()))
+	{
+		auto s = segments[nextSegmentToAppend];
+
+		// You need to append the files in ascending order...
+		jassert(s->fileIndex >= fileIndex);
+
+		if (s->fileIndex != fileIndex)
+			break;
+
+		scheduleSegments();
+
+		while (!s->finished.wait(50))
+		{
+			if (threadToCheck != nullptr && threadToCheck->threadShouldExit())
+				return false;
+		}
+
+		if (!s->ok || !writer.appendEncodedData(s->result))
+			return false;
+
+		// Free the memory as soon as possible
+		s->result = {};
+
+		nextSegmentToAppend++;
+	}
+
+	scheduleSegments();
+
+	return true;
+}
+
+void HlacParallelEncoder::scheduleSegments()
+{
+	// Limit the amount of encoded data that waits to be appended
+	const int maxNumPendingSegments = numThreads * 2;
+
+	while (nextSegmentToSchedule < segments.size() && 
+		   nextSegmentToSchedule - nextSegmentToAppend < maxNumPendingSegments)
+	{
+		auto s = segments[nextSegmentToSchedule++];
+
+		pool.addJob([this, s]()
+		{
+			if (!shouldAbort.load())
+				encodeSegment(*s);
+
+			s->finished.signal();
+		});
+	}
+}
+
+void HlacParallelEncoder::encodeSegment(Segment& s)
+{
+	if (s.numSamples < 0)
+		return;
+
+	// Every job uses its own format manager so that no reader state is shared between the threads
+	AudioFormatManager afm;
+	afm.registerBasicFormats();
+	afm.registerFormat(new HiseLosslessAudioFormat(), false);
+
+	ScopedPointer<AudioFormatReader> reader = afm.createReaderFor(files[s.fileIndex]);
+
+	if (reader == nullptr)
+		return;
+
+	HeapBlock<uint32> blockOffsets;
+	blockOffsets.calloc((size_t)(s.numSamples / COMPRESSION_BLOCK_SIZE + 2));
+
+	HiseLosslessAudioFormatWriter writer(HiseLosslessAudioFormatWriter::EncodeMode::Diff, new MemoryOutputStream(), sampleRate, numChannels, blockOffsets);
+	writer.setOptions(options);
+
+	if (!writer.writeFromAudioReader(*reader, s.start, s.numSamples))
+		return;
+
+	s.result = writer.releaseEncodedData();
+	s.ok = true;
+
+	numSamplesEncoded += s.numSamples;
+}
+
+} // namespace hlac
@@ -0,0 +1,125 @@
+/*  ===========================================================================
+ *
+ *   This file is part of HISE.
+ *   Copyright 2016 Christoph Hart
+ *
+ *   HISE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   HISE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Commercial licenses for using HISE in an closed source project are
+ *   available on request. Please visit the project's website to get more
+ *   information about commercial licensing:
+ *
+ *   http://www.hise.audio/
+ *
+ *   HISE is based on the JUCE library,
+ *   which must be separately licensed for closed source applications:
+ *
+ *   http://www.juce.com
+ *
+ *   ===========================================================================
+ */
+
+
+#ifndef HLACPARALLELENCODER_H_INCLUDED
+#define HLACPARALLELENCODER_H_INCLUDED
+
+namespace hlac { using namespace juce; 
+
+/** Encodes a list of audio files on multiple threads and appends them to a HiseLosslessAudioFormatWriter.
+
+	The files are split into segments which are encoded by independent writers on a thread pool. The consumer
+	appends the segments in their original order, so the result is byte-identical to calling writeFromAudioReader()
+	for every file on a single writer.
+
+	This works because the encoder compresses every block without any state from the previous blocks. The segments
+	start at a multiple of the buffer size of AudioFormatWriter::writeFromAudioReader() so that every segment
+	receives exactly the same chunks as the serial encoder (which matters for the static normalisation).
+*/
+class HlacParallelEncoder
+{
+public:
+
+	/** The amount of samples per segment. This must be a multiple of the buffer size in AudioFormatWriter::writeFromAudioReader(). */
+	static constexpr int64 SegmentLength = 16384 * 64;
+
+	/** Creates an encoder for the given files. 
+	
+		You need to pass in the same channel amount, sample rate and options as the writer that you append the data to.
+		If numThreads is zero, it will use all available CPU cores.
+	*/
+	HlacParallelEncoder(const Array<File>& filesToEncode, int numChannels, double sampleRate, const HlacEncoder::CompressorOptions& options, int numThreads=0);
+
+	~HlacParallelEncoder();
+
+	/** Waits until the file with the given index is encoded and appends it to the writer. 
+	
+		You need to call this for every file in ascending order. It returns false if the file couldn't be read
+		or if the thread that is passed in should exit.
+	*/
+	bool appendFile(int fileIndex, HiseLosslessAudioFormatWriter& writer, Thread* threadToCheck=nullptr);
+
+	/** Returns the total length of all files (in samples). */
+	int64 getTotalNumSamples() const noexcept { return totalNumSamples; }
+
+	/** Returns the amount of samples that were encoded by the worker threads. */
+	int64 getNumSamplesEncoded() const noexcept { return numSamplesEncoded.load(); }
+
+	int getNumThreads() const noexcept { return numThreads; }
+
+private:
+
+	struct Segment
+	{
+		Segment(int fileIndex_, int64 start_, int64 numSamples_):
+			fileIndex(fileIndex_),
+			start(start_),
+			numSamples(numSamples_)
+		{}
+
+		const int fileIndex;
+		const int64 start;
+		const int64 numSamples;
+
+		bool ok = false;
+		HlacEncoder::EncodedData result;
+		WaitableEvent finished;
+	};
+
+	void scheduleSegments();
+
+	void encodeSegment(Segment& s);
+
+	const Array<File> files;
+	const int numChannels;
+	const double sampleRate;
+	HlacEncoder::CompressorOptions options;
+	const int numThreads;
+
+	int64 totalNumSamples = 0;
+	std::atomic<int64> numSamplesEncoded = { 0 };
+	std::atomic<bool> shouldAbort = { false };
+
+	OwnedArray<Segment> segments;
+
+	int nextSegmentToSchedule = 0;
+	int nextSegmentToAppend = 0;
+
+	ThreadPool pool;
+
+	JUCE_DECLARE_NON_COPYABLE(HlacParallelEncoder);
+};
+
+} // namespace hlac
+
+#endif  // HLACPARALLELENCODER_H_INCLUDED
@@ -51,6 +51,7 @@ AudioSampleProcessor(mc)
 	parameterNames.add("HiCut");
 	parameterNames.add("Damping");
 	parameterNames.add("FFTType");
+	parameterNames.add("NonUniform");
 
 	
 }
@@ -79,6 +80,7 @@ float ConvolutionEffect::getAttribute(int parameterIndex) const
 	case HiCut:			return (float)cutoffFrequency;
 	case Damping:		return Decibels::gainToDecibels(damping);
 	case FFTType:		return (float)(int)currentType;
+	case NonUniform:	return useNonUniformPartitioning ? 1.0f : 0.0f;
 	default:			jassertfalse; return 1.0f;
 	}
 }
@@ -136,6 +138,8 @@ void ConvolutionEffect::setInternalAttribute(int parameterIndex, float newValue)
 		
 		break;
 	}
+	case NonUniform:	setUseNonUniformPartitioning(newValue > 0.5f);
+						break;
 	default:			jassertfalse; return;
 	}
 }
@@ -154,6 +158,7 @@ float ConvolutionEffect::getDefaultValue(int parameterIndex) const
 	case HiCut:			return 20000.0f;
 	case Damping:		return 0.0f;
 	case FFTType:		return (float)(int)audiofft::ImplementationType::BestAvailable;
+	case NonUniform:	return 0.0f;
 	default:			jassertfalse; return 1.0f;
 	}
 }
@@ -172,6 +177,7 @@ void ConvolutionEffect::restoreFromValueTree(const ValueTree &v)
 	loadAttributeWithDefault(HiCut);
 	loadAttribute(Damping, "Damping");
 	loadAttributeWithDefault(FFTType);
+	loadAttributeWithDefault(NonUniform);
 
 	AudioSampleProcessor::restoreFromValueTree(v);
 }
@@ -190,6 +196,7 @@ ValueTree ConvolutionEffect::exportAsValueTree() const
 	saveAttribute(HiCut, "HiCut");
 	saveAttribute(Damping, "Damping");
 	saveAttribute(FFTType, "FFTType");
+	saveAttribute(NonUniform, "NonUniform");
 
 	AudioSampleProcessor::saveToValueTree(v);
 
@@ -65,6 +65,7 @@ public:
 		HiCut, ///< applies a low pass filter to the impulse response
 		Damping, ///< applies a fade-out to the impulse response
 		FFTType, ///< the FFT implementation. It picks the best available but for some weird use cases you can force to use another one.
+		NonUniform, ///< if true, the impulse response will be split into partitions with growing sizes and the tail stages are rendered by a worker pool shared between all instances (if UseBackgroundThread is enabled).
 		numEffectParameters
 	};
 
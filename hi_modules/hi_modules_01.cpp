@@ -124,6 +124,11 @@
 #include "synthesisers/synths/NoiseSynth.cpp"
 #include "synthesisers/synths/WaveSynth.cpp"
 #include "synthesisers/synths/WavetableTools.cpp"
+
+#if HI_RUN_UNIT_TESTS
+#include "synthesisers/synths/WavetableToolsTests.cpp"
+#endif
+
 #include "synthesisers/editors/WavetableComponents.cpp"
 #include "synthesisers/synths/WavetableSynth.cpp"
 #include "synthesisers/synths/AudioLooper.cpp"
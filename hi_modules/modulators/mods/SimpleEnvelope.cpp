@@ -83,6 +83,8 @@ SimpleEnvelope::SimpleEnvelope(MainController *mc, const String &id, int voiceAm
 
 	monophonicState = createSubclassedState(-1);
 
+	lanes.setSize(polyManager.getVoiceAmount());
+
 	attackChain = new ModulatorChain(mc, "Attack Time Modulation", voiceAmount, ModulatorChain::GainMode, this);
 
 	attackChain->setIsVoiceStartChain(true);
@@ -327,6 +329,111 @@ void SimpleEnvelope::calculateBlock(int startSample, int numSamples)
 	}
 }
 
+void SimpleEnvelope::calculateVoiceBatch(const VoiceBatch& batch, int startSample, int numSamples)
+{
+	if (isMonophonic)
+	{
+		EnvelopeModulator::calculateVoiceBatch(batch, startSample, numSamples);
+		return;
+	}
+
+	const float noLimit = std::numeric_limits<float>::max();
+	int numLanes = 0;
+
+	for (int i = 0; i < batch.numVoices; i++)
+	{
+		auto s = static_cast<SimpleEnvelopeState*>(states[batch.voiceIndexes[i]]);
+
+		switch (s->current_state)
+		{
+		case SimpleEnvelopeState::SUSTAIN:
+			FloatVectorOperations::fill(batch.values[i] + startSample, 1.0f, numSamples);
+			break;
+		case SimpleEnvelopeState::IDLE:
+			FloatVectorOperations::fill(batch.values[i] + startSample, 0.0f, numSamples);
+			break;
+		case SimpleEnvelopeState::ATTACK:
+		case SimpleEnvelopeState::RELEASE:
+		{
+			// Both curves are calculated as value = base + value * coefficient
+			// (with a coefficient of 1 for the linear mode)
+			if (s->current_state == SimpleEnvelopeState::ATTACK)
+			{
+				lanes.bases[numLanes] = linearMode ? s->attackDelta : s->expAttackBase;
+				lanes.coefficients[numLanes] = linearMode ? 1.0f : s->expAttackCoef;
+				lanes.upperLimits[numLanes] = 1.0f;
+				lanes.lowerLimits[numLanes] = -noLimit;
+			}
+			else
+			{
+				lanes.bases[numLanes] = linearMode ? -release_delta : expReleaseBase;
+				lanes.coefficients[numLanes] = linearMode ? 1.0f : expReleaseCoef;
+				lanes.upperLimits[numLanes] = noLimit;
+				lanes.lowerLimits[numLanes] = linearMode ? 0.0f : 0.0001f;
+			}
+
+			lanes.values[numLanes] = s->current_value;
+			lanes.finished[numLanes] = 0;
+			lanes.batchIndexes[numLanes] = i;
+			numLanes++;
+			break;
+		}
+		default:
+		{
+			// The retrigger state is calculated for each voice
+			polyManager.setCurrentVoice(batch.voiceIndexes[i]);
+			setScratchBuffer(batch.values[i], startSample + numSamples);
+			calculateBlock(startSample, numSamples);
+			polyManager.clearCurrentVoice();
+			break;
+		}
+		}
+	}
+
+	if (numLanes == 0)
+		return;
+
+	float* values = lanes.values;
+	float* bases = lanes.bases;
+	float* coefficients = lanes.coefficients;
+	const float* upperLimits = lanes.upperLimits;
+	const float* lowerLimits = lanes.lowerLimits;
+	int* finished = lanes.finished;
+
+	for (int n = startSample; n < startSample + numSamples; n++)
+	{
+		for (int l = 0; l < numLanes; l++)
+		{
+			const float v = bases[l] + values[l] * coefficients[l];
+			const bool reachedUpper = v >= upperLimits[l];
+			const bool reachedLower = v <= lowerLimits[l];
+			const bool isFinished = reachedUpper || reachedLower;
+			const float clipped = reachedUpper ? 1.0f : (reachedLower ? 0.0f : v);
+
+			// After the end of the ramp the lane keeps the end value
+			bases[l] = isFinished ? clipped : bases[l];
+			coefficients[l] = isFinished ? 0.0f : coefficients[l];
+			finished[l] |= (int)reachedUpper | ((int)reachedLower << 1);
+			values[l] = clipped;
+		}
+
+		for (int l = 0; l < numLanes; l++)
+			batch.values[lanes.batchIndexes[l]][n] = values[l];
+	}
+
+	for (int l = 0; l < numLanes; l++)
+	{
+		auto s = static_cast<SimpleEnvelopeState*>(states[batch.voiceIndexes[lanes.batchIndexes[l]]]);
+
+		s->current_value = values[l];
+
+		if (finished[l] & 1)
+			s->current_state = SimpleEnvelopeState::SUSTAIN;
+		else if (finished[l] & 2)
+			s->current_state = SimpleEnvelopeState::IDLE;
+	}
+}
+
 void SimpleEnvelope::handleHiseEvent(const HiseEvent &m)
 {
 	EnvelopeModulator::handleHiseEvent(m);
@@ -101,6 +101,7 @@ public:
 
 	void prepareToPlay(double sampleRate, int samplesPerBlock) override;
 	void calculateBlock(int startSample, int numSamples) override;
+	void calculateVoiceBatch(const VoiceBatch& batch, int startSample, int numSamples) override;
 	void handleHiseEvent(const HiseEvent& m) override;
 	
 	ProcessorEditorBody *createEditor(ProcessorEditor *parentEditor)  override;
@@ -161,6 +162,32 @@ private:
 	float calculateNewValue(int voiceIndex);
 	float calculateNewExpValue();
 
+	/** The states of the voices that are ramping in a batch as structure of arrays, so that the
+	    ramps can be calculated across the voices. */
+	struct VoiceLanes
+	{
+		void setSize(int numVoices)
+		{
+			values.calloc(numVoices);
+			bases.calloc(numVoices);
+			coefficients.calloc(numVoices);
+			upperLimits.calloc(numVoices);
+			lowerLimits.calloc(numVoices);
+			finished.calloc(numVoices);
+			batchIndexes.calloc(numVoices);
+		}
+
+		HeapBlock<float> values;
+		HeapBlock<float> bases;
+		HeapBlock<float> coefficients;
+		HeapBlock<float> upperLimits;
+		HeapBlock<float> lowerLimits;
+		HeapBlock<int> finished;
+		HeapBlock<int> batchIndexes;
+	};
+
+	VoiceLanes lanes;
+
 	float inputValue;
 	float attack;
 	float release;
@@ -130,135 +130,99 @@ void WavetableSynthVoice::calculateBlock(int startSample, int numSamples)
 	const int samplesToCopy = numSamples;
 
 	const float *voicePitchValues = getOwnerSynth()->getPitchValuesForVoice();
-		
-	if (auto tableValues = getTableModulationValues())
-	{
-		while (--numSamples >= 0)
-		{
-			int index = (int)voiceUptime;
-
-			const int i1 = index % (tableSize);
-
-			int i2 = i1 + 1;
-
-			auto numTables = currentSound->getWavetableAmount();
-
-			if (i2 >= tableSize)
-			{
-				const float tableModValue = tableValues[startSample];
-				currentTableIndex = roundToInt(tableModValue * (double)(numTables-1));
-				i2 = 0;
-			}
-			
-			const float tableModValue = tableValues[startSample];
-			const float tableValue = jlimit<float>(0.0f, 1.0f, tableModValue) * (float)(numTables -1);
-
-			const int lowerTableIndex = (int)(tableValue);
-			const int upperTableIndex = jmin(numTables-1, lowerTableIndex + 1);
-			const float tableDelta = tableValue - (float)lowerTableIndex;
-			jassert(0.0f <= tableDelta && tableDelta <= 1.0f);
-
-			lowerTable = currentSound->getWaveTableData(lowerTableIndex);
-			upperTable = currentSound->getWaveTableData(upperTableIndex);
+	const float *tableValues = getTableModulationValues();
+	const float constantTableModValue = tableValues == nullptr ? static_cast<WavetableSynth*>(getOwnerSynth())->getConstantTableModValue() : 0.0f;
 
-			float tableGainValue = tableGainInterpolator.interpolateLinear(currentSound->getUnnormalizedGainValue(lowerTableIndex), currentSound->getUnnormalizedGainValue(upperTableIndex), tableDelta);
+	const int numTables = currentSound->getWavetableAmount();
 
-			tableGainValue *= getGainValue(tableModValue);
+	// Use the mip level for the highest pitch in this block so that the upper harmonics don't alias
+	double maxDelta = uptimeDelta;
 
-			float u1 = upperTable[i1];
-			float u2 = upperTable[i2];
+	if (voicePitchValues != nullptr)
+		maxDelta *= (double)FloatVectorOperations::findMaximum(voicePitchValues + startSample, numSamples);
 
-			float l1 = lowerTable[i1];
-			float l2 = lowerTable[i2];
+	const int mipLevel = currentSound->getMipLevelForDelta(maxDelta);
+	const float normalizeGain = 1.0f / currentSound->getUnnormalizedMaximum();
 
-			const float alpha = float(voiceUptime) - (float)index;
-			//const float invAlpha = 1.0f - alpha;
+	// If the level changes, the block fades from the old level to the new one
+	const int fadeLevel = (lastMipLevel != -1 && lastMipLevel != mipLevel) ? lastMipLevel : -1;
+	const float fadeDelta = 1.0f / (float)jmax(1, numSamples);
+	float fadeValue = 0.0f;
 
-			const float upperSample = tableGainInterpolator.interpolateLinear(u1, u2, alpha);
+	lastMipLevel = mipLevel;
 
-			const float lowerSample = tableGainInterpolator.interpolateLinear(l1, l2, alpha);
+	double tablePos = std::fmod(voiceUptime, (double)tableSize);
 
-			float sample = lowerTableIndex != upperTableIndex ? tableGainInterpolator.interpolateLinear(lowerSample, upperSample, tableDelta) : lowerSample;
+	double positions[RenderBlockSize];
+	int lowerTableIndexes[RenderBlockSize];
+	int upperTableIndexes[RenderBlockSize];
+	float tableDelta[RenderBlockSize];
+	float gain[RenderBlockSize];
+	float fadeBuffer[RenderBlockSize];
+	float fadeRamp[RenderBlockSize];
 
-			sample *= tableGainValue;
-
-			sample *= 1.0f / currentSound->getUnnormalizedMaximum();
-
-			// Stereo mode assumed
-			voiceBuffer.setSample(0, startSample, sample);
-
-			jassert(voicePitchValues == nullptr || voicePitchValues[startSample] > 0.0f);
-
-			const double delta = (uptimeDelta * (voicePitchValues == nullptr ? 1.0 : voicePitchValues[startSample]));
-
-			voiceUptime += delta;
-
-			++startSample;
-		}
-	}
-	else
+	while (numSamples > 0)
 	{
-		const float tableModValue = static_cast<WavetableSynth*>(getOwnerSynth())->getConstantTableModValue();
+		const int numThisTime = jmin(numSamples, RenderBlockSize);
 
-		while (--numSamples >= 0)
+		for (int i = 0; i < numThisTime; i++)
 		{
-			int index = (int)voiceUptime;
-
-			const int i1 = index % (tableSize);
-
-			int i2 = i1 + 1;
-
-			auto numTables = currentSound->getWavetableAmount();
-
-			if (i2 >= tableSize)
-			{
-				i2 = 0;
-			}
-
+			const float tableModValue = tableValues != nullptr ? tableValues[startSample + i] : constantTableModValue;
 			const float tableValue = jlimit<float>(0.0f, 1.0f, tableModValue) * (float)(numTables - 1);
 
 			const int lowerTableIndex = (int)(tableValue);
 			const int upperTableIndex = jmin(numTables - 1, lowerTableIndex + 1);
-			const float tableDelta = tableValue - (float)lowerTableIndex;
-			jassert(0.0f <= tableDelta && tableDelta <= 1.0f);
-
-			lowerTable = currentSound->getWaveTableData(lowerTableIndex);
-			upperTable = currentSound->getWaveTableData(upperTableIndex);
+			tableDelta[i] = tableValue - (float)lowerTableIndex;
+			jassert(0.0f <= tableDelta[i] && tableDelta[i] <= 1.0f);
 
-			float tableGainValue = tableGainInterpolator.interpolateLinear(currentSound->getUnnormalizedGainValue(lowerTableIndex), currentSound->getUnnormalizedGainValue(upperTableIndex), tableDelta);
+			float tableGainValue = tableGainInterpolator.interpolateLinear(currentSound->getUnnormalizedGainValue(lowerTableIndex), currentSound->getUnnormalizedGainValue(upperTableIndex), tableDelta[i]);
 
-			tableGainValue *= getGainValue(tableModValue);
+			gain[i] = tableGainValue * getGainValue(tableModValue) * normalizeGain;
 
-			float u1 = upperTable[i1];
-			float u2 = upperTable[i2];
+			positions[i] = tablePos;
+			lowerTableIndexes[i] = lowerTableIndex;
+			upperTableIndexes[i] = upperTableIndex;
 
-			float l1 = lowerTable[i1];
-			float l2 = lowerTable[i2];
+			jassert(voicePitchValues == nullptr || voicePitchValues[startSample + i] > 0.0f);
 
-			const float alpha = float(voiceUptime) - (float)index;
-			//const float invAlpha = 1.0f - alpha;
+			const double delta = (uptimeDelta * (voicePitchValues == nullptr ? 1.0 : voicePitchValues[startSample + i]));
 
-			const float upperSample = tableGainInterpolator.interpolateLinear(u1, u2, alpha);
+			voiceUptime += delta;
+			tablePos += delta;
 
-			const float lowerSample = tableGainInterpolator.interpolateLinear(l1, l2, alpha);
+			if (tablePos >= (double)tableSize)
+			{
+				tablePos = std::fmod(tablePos, (double)tableSize);
 
-			float sample = lowerTableIndex != upperTableIndex ? tableGainInterpolator.interpolateLinear(lowerSample, upperSample, tableDelta) : lowerSample;
+				if (tableValues != nullptr)
+					currentTableIndex = roundToInt(tableModValue * (double)(numTables - 1));
+			}
+		}
 
-			sample *= tableGainValue;
+		float* output = voiceBuffer.getWritePointer(0, startSample);
 
-			sample *= 1.0f / currentSound->getUnnormalizedMaximum();
+		renderMipLevel(output, mipLevel, positions, lowerTableIndexes, upperTableIndexes, tableDelta, numThisTime);
 
-			// Stereo mode assumed
-			voiceBuffer.setSample(0, startSample, sample);
+		if (fadeLevel != -1)
+		{
+			renderMipLevel(fadeBuffer, fadeLevel, positions, lowerTableIndexes, upperTableIndexes, tableDelta, numThisTime);
 
-			jassert(voicePitchValues == nullptr || voicePitchValues[startSample] > 0.0f);
+			for (int i = 0; i < numThisTime; i++)
+			{
+				fadeValue += fadeDelta;
+				fadeRamp[i] = fadeValue;
+			}
 
-			const double delta = (uptimeDelta * (voicePitchValues == nullptr ? 1.0 : voicePitchValues[startSample]));
+			// output = fade + ramp * (output - fade)
+			FloatVectorOperations::subtract(output, fadeBuffer, numThisTime);
+			FloatVectorOperations::multiply(output, fadeRamp, numThisTime);
+			FloatVectorOperations::add(output, fadeBuffer, numThisTime);
+		}
 
-			voiceUptime += delta;
+		FloatVectorOperations::multiply(output, gain, numThisTime);
 
-			++startSample;
-		}
+		startSample += numThisTime;
+		numSamples -= numThisTime;
 	}
 
 	if (auto modValues = getOwnerSynth()->getVoiceGainValues())
@@ -280,6 +244,48 @@ void WavetableSynthVoice::calculateBlock(int startSample, int numSamples)
 		static_cast<WavetableSynth*>(getOwnerSynth())->triggerWaveformUpdate();
 }
 
+void WavetableSynthVoice::renderMipLevel(float* output, int mipLevel, const double* positions, const int* lowerTableIndexes, const int* upperTableIndexes, const float* tableDelta, int numThisTime)
+{
+	const int levelSize = currentSound->getTableSize(mipLevel);
+	const double levelScale = (double)levelSize / (double)tableSize;
+
+	float alpha[RenderBlockSize];
+	float lower2[RenderBlockSize];
+	float upper1[RenderBlockSize];
+	float upper2[RenderBlockSize];
+
+	// The lower table sample is written directly into the output
+	float* lower1 = output;
+
+	for (int i = 0; i < numThisTime; i++)
+	{
+		const double levelPos = positions[i] * levelScale;
+		const int i1 = jmin(levelSize - 1, (int)levelPos);
+		const int i2 = (i1 + 1 < levelSize) ? i1 + 1 : 0;
+
+		alpha[i] = (float)(levelPos - (double)i1);
+
+		const float* lowerData = currentSound->getWaveTableData(lowerTableIndexes[i], mipLevel);
+		const float* upperData = currentSound->getWaveTableData(upperTableIndexes[i], mipLevel);
+
+		lower1[i] = lowerData[i1];
+		lower2[i] = lowerData[i2];
+		upper1[i] = upperData[i1];
+		upper2[i] = upperData[i2];
+	}
+
+	// lower1 += alpha * (lower2 - lower1), same for the upper table
+	FloatVectorOperations::subtract(lower2, lower1, numThisTime);
+	FloatVectorOperations::addWithMultiply(lower1, lower2, alpha, numThisTime);
+
+	FloatVectorOperations::subtract(upper2, upper1, numThisTime);
+	FloatVectorOperations::addWithMultiply(upper1, upper2, alpha, numThisTime);
+
+	// Crossfade between the two tables
+	FloatVectorOperations::subtract(upper1, lower1, numThisTime);
+	FloatVectorOperations::addWithMultiply(lower1, upper1, tableDelta, numThisTime);
+}
+
 const float * WavetableSynthVoice::getTableModulationValues()
 {
 	return dynamic_cast<WavetableSynth*>(getOwnerSynth())->getTableModValues();
@@ -299,6 +305,7 @@ void WavetableSynthVoice::startNote(int midiNoteNumber, float /*velocity*/, Synt
 	midiNoteNumber += getTransposeAmount();
 	currentSound = static_cast<WavetableSound*>(s);
 	voiceUptime = 0.0;
+	lastMipLevel = -1;
 
 	lowerTable = currentSound->getWaveTableData(0);
 	upperTable = lowerTable;
@@ -316,7 +323,8 @@ void WavetableSynthVoice::startNote(int midiNoteNumber, float /*velocity*/, Synt
 	uptimeDelta *= getOwnerSynth()->getMainController()->getGlobalPitchFactor();
 }
 
-WavetableSound::WavetableSound(const ValueTree &wavetableData)
+WavetableSound::WavetableSound(const ValueTree &wavetableData):
+	mipMapJob(*this)
 {
 	jassert(wavetableData.getType() == Identifier("wavetable"));
 
@@ -349,6 +357,25 @@ WavetableSound::WavetableSound(const ValueTree &wavetableData)
 	pitchRatio = 1.0;
 }
 
+WavetableSound::~WavetableSound()
+{
+	if (mipMapPool != nullptr)
+	{
+		mipMapJob.signalJobShouldExit();
+		mipMapPool->removeJob(&mipMapJob);
+	}
+}
+
+void WavetableSound::createMipLevelsAsync(SampleThreadPool* pool)
+{
+	mipMapPool = pool;
+
+	if (mipMapPool != nullptr)
+		mipMapPool->addJob(&mipMapJob, false);
+	else
+		createMipLevels();
+}
+
 const float * WavetableSound::getWaveTableData(int wavetableIndex) const
 {
 	if (wavetableIndex < wavetableAmount)
@@ -364,6 +391,31 @@ const float * WavetableSound::getWaveTableData(int wavetableIndex) const
 	}
 }
 
+const float * WavetableSound::getWaveTableData(int wavetableIndex, int mipLevel) const
+{
+	if (mipLevel == 0)
+		return getWaveTableData(wavetableIndex);
+
+	auto l = mipLevels[mipLevel - 1];
+
+	if (l != nullptr && wavetableIndex < wavetableAmount)
+		return l->tables.getReadPointer(0, wavetableIndex * l->tableSize);
+
+	return nullptr;
+}
+
+int WavetableSound::getMipLevelForDelta(double delta) const
+{
+	// Every level halves the bandwidth, so a level is used until its highest harmonic
+	// would fold back below 3/4 of the Nyquist frequency.
+	constexpr double maxDelta = 1.25;
+
+	if (delta <= maxDelta || !mipLevelsReady.load())
+		return 0;
+
+	return jmin(mipLevels.size(), (int)std::ceil(std::log2(delta / maxDelta)));
+}
+
 void WavetableSound::calculatePitchRatio(double playBackSampleRate)
 {
 	const double idealCycleLength = playBackSampleRate / MidiMessage::getMidiNoteInHertz(noteNumber);
@@ -395,4 +447,42 @@ void WavetableSound::normalizeTables()
 	maximum = 1.0f;
 }
 
+void WavetableSound::createMipLevels()
+{
+	mipLevels.clear();
+
+	for (int level = 1; level < NumMaxMipLevels; level++)
+	{
+		const int levelSize = (wavetableSize + (1 << level) - 1) >> level;
+		const int maxHarmonic = jmin(wavetableSize >> (level + 1), (levelSize - 1) / 2);
+
+		if (maxHarmonic < 1)
+			break;
+
+		auto l = new MipLevel();
+		l->tableSize = levelSize;
+		l->maxHarmonic = maxHarmonic;
+		l->tables.setSize(1, levelSize * wavetableAmount);
+		mipLevels.add(l);
+	}
+
+	if (mipLevels.isEmpty())
+		return;
+
+	WavetableMipMapper mapper(wavetableSize);
+
+	for (int i = 0; i < wavetableAmount; i++)
+	{
+		if (mipMapJob.shouldExit())
+			return;
+
+		mapper.setSource(getWaveTableData(i));
+
+		for (auto l : mipLevels)
+			mapper.createLevel(l->tables.getWritePointer(0, i * l->tableSize), l->tableSize, l->maxHarmonic);
+	}
+
+	mipLevelsReady.store(true);
+}
+
 } // namespace hise
@@ -57,6 +57,14 @@ public:
 	*/
 	WavetableSound(const ValueTree &wavetableData);;
 
+	~WavetableSound();
+
+	/** Creates the mip levels on the given pool (or synchronously if it's nullptr).
+	*
+	*	Mapping the tables takes a while, so the voices play the original tables until the levels are ready.
+	*/
+	void createMipLevelsAsync(SampleThreadPool* pool);
+
 	bool appliesToNote (int midiNoteNumber) override   { return midiNotes[midiNoteNumber]; }
     bool appliesToChannel (int /*midiChannel*/) override   { return true; }
 	bool appliesToVelocity (int /*midiChannel*/) override  { return true; }
@@ -67,6 +75,26 @@ public:
 	*/
 	const float *getWaveTableData(int wavetableIndex) const;
 
+	/** Returns a read pointer to the wavetable with the given index in the given mip level.
+	*
+	*	The level 0 is the original table, every other level contains half the harmonics of the previous level
+	*	with half the table size. Use getMipLevelForDelta() to pick the level that doesn't alias.
+	*/
+	const float *getWaveTableData(int wavetableIndex, int mipLevel) const;
+
+	/** Returns the mip level for playing back the tables with the given uptime delta. */
+	int getMipLevelForDelta(double delta) const;
+
+	int getNumMipLevels() const
+	{
+		return mipLevelsReady.load() ? mipLevels.size() + 1 : 1;
+	}
+
+	int getTableSize(int mipLevel) const
+	{
+		return mipLevel == 0 ? wavetableSize : mipLevels[mipLevel - 1]->tableSize;
+	}
+
 	float getUnnormalizedMaximum()
 	{
 		return unnormalizedMaximum;
@@ -107,6 +135,39 @@ public:
 
 private:
 
+	static constexpr int NumMaxMipLevels = 10;
+
+	struct MipLevel
+	{
+		AudioSampleBuffer tables;
+		int tableSize = 0;
+		int maxHarmonic = 0;
+	};
+
+	struct MipMapJob : public SampleThreadPoolJob
+	{
+		MipMapJob(WavetableSound& parent_) :
+			SampleThreadPoolJob("Wavetable mip levels"),
+			parent(parent_)
+		{};
+
+		JobStatus runJob() override
+		{
+			parent.createMipLevels();
+			return SampleThreadPoolJob::jobHasFinished;
+		}
+
+		WavetableSound& parent;
+	};
+
+	void createMipLevels();
+
+	MipMapJob mipMapJob;
+	SampleThreadPool* mipMapPool = nullptr;
+
+	// The voices only access the mip levels after this was set
+	std::atomic<bool> mipLevelsReady { false };
+
 	float maximum;
 	float unnormalizedMaximum;
 	float unnormalizedGainValues[64];
@@ -117,6 +178,8 @@ private:
 	AudioSampleBuffer wavetables;
 	AudioSampleBuffer emptyBuffer;
 
+	OwnedArray<MipLevel> mipLevels;
+
 	double sampleRate;
 	double pitchRatio;
 
@@ -170,6 +233,14 @@ public:
 
 private:
 
+	static constexpr int RenderBlockSize = 64;
+
+	/** Interpolates the table samples of the given mip level at the given positions and crossfades between the two tables. */
+	void renderMipLevel(float* output, int mipLevel, const double* positions, const int* lowerTableIndexes, const int* upperTableIndexes, const float* tableDelta, int numThisTime);
+
+	// The mip level of the last block (or -1 after the voice start)
+	int lastMipLevel = -1;
+
 	WavetableSynth *wavetableSynth;
 
 	int octaveTransposeFactor;
@@ -251,6 +322,7 @@ public:
 			auto s = new WavetableSound(v.getChild(i));
 
 			s->calculatePitchRatio(getSampleRate());
+			s->createMipLevelsAsync(getMainController()->getSampleManager().getGlobalSampleThreadPool());
 
 			addSound(s);
 		}
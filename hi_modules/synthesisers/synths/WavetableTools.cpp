@@ -33,6 +33,122 @@
 namespace hise {
 using namespace juce;
 
+WavetableMipMapper::ArbitraryFFT::ArbitraryFFT(int size_) :
+	size(size_),
+	fft(getOrder(size_))
+{
+	const int paddedSize = fft.getSize();
+
+	chirp.calloc(size);
+	kernel.calloc(paddedSize);
+	a.calloc(paddedSize);
+	b.calloc(paddedSize);
+
+	for (int n = 0; n < size; n++)
+	{
+		// exp(-i * pi * n^2 / size), the square is wrapped to keep the precision for long tables
+		const auto phase = double_Pi * (double)(((int64)n * (int64)n) % (2 * (int64)size)) / (double)size;
+		chirp[n] = Complex((float)std::cos(phase), (float)-std::sin(phase));
+	}
+
+	kernel[0] = std::conj(chirp[0]);
+
+	for (int n = 1; n < size; n++)
+	{
+		kernel[n] = std::conj(chirp[n]);
+		kernel[paddedSize - n] = std::conj(chirp[n]);
+	}
+
+	fft.perform(kernel, b, false);
+	memcpy(kernel.get(), b.get(), sizeof(Complex) * paddedSize);
+}
+
+int WavetableMipMapper::ArbitraryFFT::getOrder(int size)
+{
+	int order = 0;
+
+	while ((1 << order) < 2 * size - 1)
+		order++;
+
+	return order;
+}
+
+void WavetableMipMapper::ArbitraryFFT::perform(Complex* data, bool inverse)
+{
+	const int paddedSize = fft.getSize();
+
+	memset(a.get(), 0, sizeof(Complex) * paddedSize);
+
+	// The inverse transform is the conjugate of the forward transform of the conjugated data
+	for (int n = 0; n < size; n++)
+		a[n] = (inverse ? std::conj(data[n]) : data[n]) * chirp[n];
+
+	fft.perform(a, b, false);
+
+	for (int k = 0; k < paddedSize; k++)
+		b[k] *= kernel[k];
+
+	fft.perform(b, a, true);
+
+	for (int k = 0; k < size; k++)
+	{
+		auto v = a[k] * chirp[k];
+		data[k] = inverse ? std::conj(v) : v;
+	}
+}
+
+WavetableMipMapper::WavetableMipMapper(int sourceLength) :
+	sourceFFT(sourceLength)
+{
+	spectrum.calloc(sourceLength);
+	levelData.calloc(sourceLength);
+}
+
+void WavetableMipMapper::setSource(const float* sourceTable)
+{
+	for (int i = 0; i < sourceFFT.size; i++)
+		spectrum[i] = Complex(sourceTable[i], 0.0f);
+
+	sourceFFT.perform(spectrum, false);
+}
+
+void WavetableMipMapper::createLevel(float* destTable, int destLength, int maxHarmonic)
+{
+	jassert(destLength <= sourceFFT.size);
+	jassert(2 * maxHarmonic < destLength);
+
+	auto& fft = getFFT(destLength);
+
+	// The inverse DFT is not normalised, so this scales the amplitude to the source table
+	const float gain = 1.0f / (float)sourceFFT.size;
+
+	memset(levelData.get(), 0, sizeof(Complex) * destLength);
+
+	levelData[0] = spectrum[0] * gain;
+
+	for (int h = 1; h <= maxHarmonic; h++)
+	{
+		levelData[h] = spectrum[h] * gain;
+		levelData[destLength - h] = std::conj(levelData[h]);
+	}
+
+	fft.perform(levelData, true);
+
+	for (int i = 0; i < destLength; i++)
+		destTable[i] = levelData[i].real();
+}
+
+WavetableMipMapper::ArbitraryFFT& WavetableMipMapper::getFFT(int size)
+{
+	for (auto f : levelFFTs)
+	{
+		if (f->size == size)
+			return *f;
+	}
+
+	return *levelFFTs.add(new ArbitraryFFT(size));
+}
+
 #if USE_BACKEND
 
 
@@ -36,6 +36,65 @@
 namespace hise {
 using namespace juce;
 
+/** Creates bandlimited copies of a wavetable with less harmonics and a shorter table size.
+*
+*	This is used by the WavetableSound to create the mip levels for playing back a table above its root pitch.
+*	The tables can have any length, so the spectrum is calculated with Bluestein's algorithm on top of the
+*	power-of-two juce::dsp::FFT.
+*
+*	Create one of these for the source table length, call setSource() for every table and then
+*	createLevel() for every mip level of this table.
+*/
+class WavetableMipMapper
+{
+public:
+
+	using Complex = dsp::Complex<float>;
+
+	WavetableMipMapper(int sourceLength);
+
+	/** Calculates the spectrum of the given table. */
+	void setSource(const float* sourceTable);
+
+	/** Writes a table with destLength samples that contains the harmonics of the source up to maxHarmonic. */
+	void createLevel(float* destTable, int destLength, int maxHarmonic);
+
+private:
+
+	/** A discrete fourier transform for any size using Bluestein's algorithm. */
+	struct ArbitraryFFT
+	{
+		ArbitraryFFT(int size);
+
+		/** Calculates the DFT in place. The inverse transform is not normalised. */
+		void perform(Complex* data, bool inverse);
+
+		const int size;
+
+	private:
+
+		static int getOrder(int size);
+
+		dsp::FFT fft;
+		HeapBlock<Complex> chirp;
+		HeapBlock<Complex> kernel;
+		HeapBlock<Complex> a;
+		HeapBlock<Complex> b;
+	};
+
+	friend class WavetableMipMapperTest;
+
+	ArbitraryFFT& getFFT(int size);
+
+	ArbitraryFFT sourceFFT;
+	OwnedArray<ArbitraryFFT> levelFFTs;
+
+	HeapBlock<Complex> spectrum;
+	HeapBlock<Complex> levelData;
+
+	JUCE_DECLARE_NON_COPYABLE(WavetableMipMapper);
+};
+
 #if USE_BACKEND
 
 /** Converts a directory containing the individual wavetable files into a ValueTree that can be loaded by a WavetableSynth.
@@ -0,0 +1,227 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+namespace hise {
+using namespace juce;
+
+/** Compares the WavetableMipMapper and its FFT against a naive DFT. */
+class WavetableMipMapperTest : public UnitTest
+{
+public:
+
+	WavetableMipMapperTest() :
+		UnitTest("Testing wavetable mip levels")
+	{};
+
+	void runTest() override
+	{
+		testArbitraryFFT();
+		testRoundTrip();
+		testBandLimiting();
+	}
+
+private:
+
+	using Complex = WavetableMipMapper::Complex;
+
+	static Array<int> getTableSizes()
+	{
+		// Converted tables have arbitrary lengths (sampleRate / noteFrequency)
+		return { 11, 64, 367, 1000, 2047 };
+	}
+
+	/** The textbook O(n^2) transform. */
+	static std::vector<std::complex<double>> naiveDFT(const float* data, int size)
+	{
+		std::vector<std::complex<double>> result((size_t)size);
+
+		for (int k = 0; k < size; k++)
+		{
+			std::complex<double> sum;
+
+			for (int n = 0; n < size; n++)
+			{
+				const auto phase = -2.0 * double_Pi * (double)(((int64)k * (int64)n) % size) / (double)size;
+				sum += (double)data[n] * std::complex<double>(std::cos(phase), std::sin(phase));
+			}
+
+			result[k] = sum;
+		}
+
+		return result;
+	}
+
+	/** Creates a table that only contains the harmonics up to maxHarmonic with random amplitudes and phases. */
+	static HeapBlock<float> createTable(Random& r, int size, int maxHarmonic)
+	{
+		HeapBlock<float> table;
+		table.calloc(size);
+
+		for (int h = 1; h <= maxHarmonic; h++)
+		{
+			const float amp = r.nextFloat() / (float)h;
+			const double phase = r.nextDouble() * 2.0 * double_Pi;
+
+			for (int i = 0; i < size; i++)
+				table[i] += amp * (float)std::sin(2.0 * double_Pi * (double)h * (double)i / (double)size + phase);
+		}
+
+		return table;
+	}
+
+	void testArbitraryFFT()
+	{
+		beginTest("Arbitrary size FFT matches the naive DFT");
+
+		Random r;
+
+		for (auto size : getTableSizes())
+		{
+			HeapBlock<float> input;
+			input.calloc(size);
+
+			for (int i = 0; i < size; i++)
+				input[i] = r.nextFloat() * 2.0f - 1.0f;
+
+			WavetableMipMapper::ArbitraryFFT fft(size);
+
+			HeapBlock<Complex> data;
+			data.calloc(size);
+
+			for (int i = 0; i < size; i++)
+				data[i] = Complex(input[i], 0.0f);
+
+			fft.perform(data, false);
+
+			auto expected = naiveDFT(input, size);
+
+			double maxError = 0.0;
+
+			for (int k = 0; k < size; k++)
+				maxError = jmax(maxError, std::abs(std::complex<double>(data[k].real(), data[k].imag()) - expected[k]) / (double)size);
+
+			expect(maxError < 1e-5, "Forward error for size " + String(size) + ": " + String(maxError));
+
+			fft.perform(data, true);
+
+			maxError = 0.0;
+
+			for (int i = 0; i < size; i++)
+				maxError = jmax(maxError, (double)std::abs(data[i].real() / (float)size - input[i]));
+
+			expect(maxError < 1e-5, "Inverse error for size " + String(size) + ": " + String(maxError));
+		}
+	}
+
+	void testRoundTrip()
+	{
+		beginTest("A level with all harmonics reproduces the source table");
+
+		Random r;
+
+		for (auto size : getTableSizes())
+		{
+			const int maxHarmonic = (size - 1) / 2;
+			auto source = createTable(r, size, maxHarmonic);
+
+			HeapBlock<float> dest;
+			dest.calloc(size);
+
+			WavetableMipMapper mapper(size);
+			mapper.setSource(source);
+			mapper.createLevel(dest, size, maxHarmonic);
+
+			float maxError = 0.0f;
+
+			for (int i = 0; i < size; i++)
+				maxError = jmax(maxError, std::abs(dest[i] - source[i]));
+
+			expect(maxError < 1e-5f, "Round trip error for size " + String(size) + ": " + String(maxError));
+		}
+	}
+
+	void testBandLimiting()
+	{
+		beginTest("The mip levels only contain the allowed harmonics with the original amplitude");
+
+		Random r;
+
+		for (auto size : getTableSizes())
+		{
+			auto source = createTable(r, size, (size - 1) / 2);
+			auto sourceSpectrum = naiveDFT(source, size);
+
+			WavetableMipMapper mapper(size);
+			mapper.setSource(source);
+
+			for (int level = 1; level < 4; level++)
+			{
+				const int destSize = (size + (1 << level) - 1) >> level;
+				const int maxHarmonic = jmin(size >> (level + 1), (destSize - 1) / 2);
+
+				if (maxHarmonic < 1)
+					break;
+
+				HeapBlock<float> dest;
+				dest.calloc(destSize);
+
+				mapper.createLevel(dest, destSize, maxHarmonic);
+
+				auto destSpectrum = naiveDFT(dest, destSize);
+
+				double maxHarmonicError = 0.0;
+				double maxAliasMagnitude = 0.0;
+
+				for (int h = 0; h <= destSize / 2; h++)
+				{
+					// Normalise both spectra to the amplitude of the harmonic
+					const auto destValue = destSpectrum[h] / (double)destSize;
+
+					if (h <= maxHarmonic)
+						maxHarmonicError = jmax(maxHarmonicError, std::abs(destValue - sourceSpectrum[h] / (double)size));
+					else
+						maxAliasMagnitude = jmax(maxAliasMagnitude, std::abs(destValue));
+				}
+
+				const String suffix = " (size " + String(size) + ", level " + String(level) + ")";
+
+				expect(maxHarmonicError < 1e-5, "Harmonic error" + suffix + ": " + String(maxHarmonicError));
+				expect(maxAliasMagnitude < 1e-5, "Harmonics above the limit" + suffix + ": " + String(maxAliasMagnitude));
+			}
+		}
+	}
+};
+
+static WavetableMipMapperTest wavetableMipMapperTest;
+
+} // namespace hise
@@ -35,6 +35,7 @@
 #if HISE_INCLUDE_RLOTTIE
 
 #include "wrapper/RLottieManager.cpp"
+#include "wrapper/RLottieFrameCache.cpp"
 #include "wrapper/RLottieAnimation.cpp"
 #include "wrapper/RLottieComponent.cpp"
 #endif
\ No newline at end of file
@@ -76,8 +76,19 @@ END_JUCE_MODULE_DECLARATION
 #define HISE_RLOTTIE_DYNAMIC_LIBRARY 0
 #endif
 
+/** Config: HISE_RLOTTIE_FRAME_CACHE_SIZE
+
+    The memory budget in megabytes for the rendered frames of all animations. The frames will be
+    rendered ahead of time on a background thread, so that painting an animation only has to draw
+    the cached image. Set this to zero in order to render every frame synchronously when it's painted.
+*/
+#ifndef HISE_RLOTTIE_FRAME_CACHE_SIZE
+#define HISE_RLOTTIE_FRAME_CACHE_SIZE 64
+#endif
+
 #if HISE_INCLUDE_RLOTTIE
 #include "include/rlottie_capi.h"
+#include "wrapper/RLottieFrameCache.h"
 #include "wrapper/RLottieManager.h"
 #include "wrapper/RLottieAnimation.h"
 #include "wrapper/RLottieComponent.h"
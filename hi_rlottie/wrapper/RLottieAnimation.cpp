@@ -14,11 +14,12 @@ namespace hise {
 using namespace juce;
 
 
-RLottieAnimation::RLottieAnimation(RLottieManager* manager, const String& data)
+RLottieAnimation::RLottieAnimation(RLottieManager* manager_, const String& data):
+	manager(manager_)
 {
 	animation = manager->createAnimation(RLottieComponent::decompressIfBase64(data));
     
-#if HISE_RLOTTE_DYNAMIC_LIBRARY
+#if HISE_RLOTTIE_DYNAMIC_LIBRARY
 	rf = manager->getRenderFunction();
 #endif
 
@@ -29,7 +30,10 @@ RLottieAnimation::RLottieAnimation(RLottieManager* manager, const String& data)
 RLottieAnimation::~RLottieAnimation()
 {
 	if (manager != nullptr && animation != nullptr)
+	{
+		manager->getFrameCache().removeAnimation(this);
 		manager->destroy(animation);
+	}
 }
 
 void RLottieAnimation::setSize(int width, int height)
@@ -42,7 +46,12 @@ void RLottieAnimation::setSize(int width, int height)
 
 	if (newWidth != canvas.getWidth() || newHeight != canvas.getHeight())
 	{
+		if (auto c = getFrameCache())
+			c->removeAnimation(this);
+
 		canvas = Image(Image::ARGB, newWidth, newHeight, true);
+		frameImage = {};
+		lastFrame = -1;
 	}
 }
 
@@ -60,27 +69,102 @@ void RLottieAnimation::render(Graphics& g, Point<int> topLeft)
 {
 	if (isValid() && isPositiveAndBelow(currentFrame, numFrames+1) && lastFrame != currentFrame)
 	{
-		Image::BitmapData bd(canvas, Image::BitmapData::ReadWriteMode::writeOnly);
-
-#if HISE_RLOTTE_DYNAMIC_LIBRARY
-		rf(animation, (size_t)currentFrame, reinterpret_cast<uint32*>(bd.data), canvas.getWidth(), canvas.getHeight(), canvas.getWidth() * 4);
-#else
-        lottie_animation_render(animation, (size_t)currentFrame, reinterpret_cast<uint32*>(bd.data), canvas.getWidth(), canvas.getHeight(), canvas.getWidth() * 4);
-#endif
-
-		lastFrame = currentFrame;
+		if (auto c = getFrameCache())
+		{
+			RLottieFrameCache::Key k;
+			k.animation = this;
+			k.width = canvas.getWidth();
+			k.height = canvas.getHeight();
+			k.scaleFactor = scaleFactor;
+			k.frame = currentFrame;
+
+			// A jump back to the start is just the playback looping around
+			auto delta = currentFrame - lastFrame;
+			auto direction = (lastFrame != -1 && delta < 0 && -delta < numFrames / 2) ? -1 : 1;
+
+			c->prefetch(k, numFrames, direction);
+
+			// If the frame isn't ready, keep the last frame until the listeners are notified
+			auto img = c->getFrame(k);
+
+			if (img.isValid())
+			{
+				frameImage = img;
+				lastFrame = currentFrame;
+			}
+		}
+		else
+		{
+			renderFrame(canvas, currentFrame);
+			frameImage = canvas;
+			lastFrame = currentFrame;
+		}
 	}
 
+	if (!frameImage.isValid())
+		return;
+
 	if (scaleFactor == 1.0f)
 	{
-		g.drawImageAt(canvas, topLeft.x, topLeft.y);
+		g.drawImageAt(frameImage, topLeft.x, topLeft.y);
 	}
 	else
 	{
-		g.drawImageTransformed(canvas, AffineTransform::scale(1.0f / scaleFactor));
+		g.drawImageTransformed(frameImage, AffineTransform::scale(1.0f / scaleFactor));
 	}
 }
 
+void RLottieAnimation::renderFrame(Image& img, int frameIndex)
+{
+	Image::BitmapData bd(img, Image::BitmapData::ReadWriteMode::writeOnly);
+
+#if HISE_RLOTTIE_DYNAMIC_LIBRARY
+	rf(animation, (size_t)frameIndex, reinterpret_cast<uint32*>(bd.data), img.getWidth(), img.getHeight(), bd.lineStride);
+#else
+	lottie_animation_render(animation, (size_t)frameIndex, reinterpret_cast<uint32*>(bd.data), img.getWidth(), img.getHeight(), bd.lineStride);
+#endif
+}
+
+void RLottieAnimation::frameRendered()
+{
+	triggerAsyncUpdate();
+}
+
+void RLottieAnimation::handleAsyncUpdate()
+{
+	for (auto l : listeners)
+	{
+		if (l != nullptr)
+			l->animationFrameRendered(this);
+	}
+}
+
+void RLottieAnimation::addListener(Listener* l)
+{
+	listeners.addIfNotAlreadyThere(l);
+}
+
+void RLottieAnimation::removeListener(Listener* l)
+{
+	listeners.removeAllInstancesOf(l);
+}
+
+RLottieFrameCache* RLottieAnimation::getFrameCache()
+{
+	if (manager == nullptr)
+		return nullptr;
+
+	auto& c = manager->getFrameCache();
+
+	// A frame that doesn't fit into the budget will be rendered synchronously
+	auto numBytes = (size_t)canvas.getWidth() * (size_t)canvas.getHeight() * 4;
+
+	if (c.getMemoryBudget() > 0 && numBytes <= c.getMemoryBudget())
+		return &c;
+
+	return nullptr;
+}
+
 bool RLottieAnimation::isValid() const
 {
     auto ok = animation != nullptr;
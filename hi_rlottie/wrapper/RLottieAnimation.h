@@ -17,12 +17,25 @@ using namespace juce;
 /** This object encapsulates a Lottie animation. You can create one of these and control them
     directly or use a RLottieComponent, which wraps this into a readymade JUCE component. 
 */
-class RLottieAnimation
+class RLottieAnimation: private AsyncUpdater
 {
 public:
 
 	using Ptr = WeakReference<RLottieAnimation>;
 
+	/** A listener that is notified on the message thread when a frame that wasn't cached was rendered. 
+	
+		Repaint the component that draws the animation in the callback.
+	*/
+	struct Listener
+	{
+		virtual ~Listener() {};
+
+		virtual void animationFrameRendered(RLottieAnimation* a) = 0;
+
+		JUCE_DECLARE_WEAK_REFERENCEABLE(Listener);
+	};
+
 	/** Creates a new RLottieAnimation from the given JSON data string. */
 	RLottieAnimation(RLottieManager* manager, const String& data);
 
@@ -37,9 +50,18 @@ public:
 	/** Returns the framerate of the given animation. */
 	double getFrameRate() const;
 	
-	/** Renders the frame of the animation to the Graphics context. */
+	/** Renders the frame of the animation to the Graphics context. 
+	
+		If the frame was already rendered on the background thread, this will just draw the cached image.
+		Otherwise it draws the last frame and the listeners are notified when the frame is ready.
+		It will also queue the next frames (in the direction of the last frame change) for background rendering.
+	*/
 	void render(Graphics& g, Point<int> topLeft);
 
+	void addListener(Listener* l);
+
+	void removeListener(Listener* l);
+
 	/** Checks whether the animation could be parsed correctly. */
 	bool isValid() const;
 
@@ -54,6 +76,18 @@ public:
 
 private:
 
+	friend class RLottieFrameCache;
+
+	/** Renders the frame into the given image. This must not be called concurrently for the same animation. */
+	void renderFrame(Image& img, int frameIndex);
+
+	/** Called by the frame cache when a frame that wasn't cached is ready. */
+	void frameRendered();
+
+	void handleAsyncUpdate() override;
+
+	RLottieFrameCache* getFrameCache();
+
 	int originalWidth = 0;
 	int originalHeight = 0;
 	float scaleFactor = 1.0f;
@@ -69,9 +103,12 @@ private:
 #endif
     
 	Image canvas;
+	Image frameImage;
 	Lottie_Animation* animation;
 	WeakReference<RLottieManager> manager;
 
+	Array<WeakReference<Listener>> listeners;
+
 	JUCE_DECLARE_WEAK_REFERENCEABLE(RLottieAnimation);
 };
 
@@ -62,6 +62,7 @@ void RLottieComponent::play()
 void RLottieComponent::loadAnimation(const String& jsonCode, bool useOversampling)
 {
 	currentAnimation = new RLottieAnimation(manager, decompressIfBase64(jsonCode));
+	currentAnimation->addListener(this);
 
 	if (useOversampling)
 		currentAnimation->setScaleFactor(2.0f);
@@ -127,6 +128,11 @@ juce::String RLottieComponent::decompressIfBase64(const String& s)
 
 
 
+void RLottieComponent::animationFrameRendered(RLottieAnimation*)
+{
+	repaint();
+}
+
 void RLottieComponent::timerCallback()
 {
 	if (currentAnimation != nullptr && currentAnimation->getNumFrames() > 0)
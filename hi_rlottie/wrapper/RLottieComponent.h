@@ -17,7 +17,8 @@ using namespace juce;
 
 /** A JUCE component that displays a Lottie animation. */
 class RLottieComponent: public Component,
-						private Timer
+						private Timer,
+						private RLottieAnimation::Listener
 {
 public:
 
@@ -62,6 +63,9 @@ private:
 	/** @internal */
 	void timerCallback() override;
 
+	/** @internal */
+	void animationFrameRendered(RLottieAnimation*) override;
+
 	Colour bgColour = Colours::black;
 	int currentFrame = 0;
 	ScopedPointer<RLottieAnimation> currentAnimation;
@@ -0,0 +1,195 @@
+/** Copyright 2019 Christoph Hart
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+	Note: Be aware that the rLottie wrapper files are licensed under a more permissive license than the
+	rest of the HISE codebase. The MIT license only applies where stated in the header.
+*/
+
+namespace hise {
+using namespace juce;
+
+RLottieFrameCache::RLottieFrameCache() :
+	Thread("RLottie Renderer"),
+	memoryBudget((size_t)HISE_RLOTTIE_FRAME_CACHE_SIZE * 1024 * 1024)
+{
+}
+
+RLottieFrameCache::~RLottieFrameCache()
+{
+	stopThread(1000);
+}
+
+Image RLottieFrameCache::getFrame(const Key& k)
+{
+	ScopedLock sl(lock);
+
+	auto it = entryMap.find(k);
+
+	if (it == entryMap.end())
+		return {};
+
+	entries.splice(entries.begin(), entries, it->second);
+	return it->second->image;
+}
+
+void RLottieFrameCache::prefetch(const Key& k, int numFrames, int direction)
+{
+	auto numBytes = k.getNumBytes();
+
+	if (numFrames <= 0 || numBytes == 0)
+		return;
+
+	// Never prefetch more than half of the budget so that the visible frames of other animations stay in the cache
+	auto numToPrefetch = jmin(NumPrefetchFrames, numFrames - 1, (int)(memoryBudget / numBytes / 2));
+
+	{
+		ScopedLock sl(lock);
+
+		pendingJobs.removeIf([&k](const Job& j) { return j.key.animation == k.animation; });
+
+		// The requested frame goes before all other jobs
+		if (!contains(k))
+			pendingJobs.insert(0, { k, true });
+
+		for (int i = 1; i <= numToPrefetch; i++)
+		{
+			auto j = k;
+			j.frame = ((k.frame + direction * i) % numFrames + numFrames) % numFrames;
+
+			if (!contains(j))
+				pendingJobs.add({ j, false });
+		}
+
+		if (pendingJobs.isEmpty())
+			return;
+	}
+
+	if (isThreadRunning())
+		notify();
+	else
+		startThread(4);
+}
+
+void RLottieFrameCache::removeAnimation(RLottieAnimation* a)
+{
+	ScopedLock rl(renderLock);
+	ScopedLock sl(lock);
+
+	pendingJobs.removeIf([a](const Job& j) { return j.key.animation == a; });
+
+	for (auto it = entries.begin(); it != entries.end();)
+	{
+		auto next = std::next(it);
+
+		if (it->key.animation == a)
+			removeEntry(it);
+
+		it = next;
+	}
+}
+
+void RLottieFrameCache::setMemoryBudget(size_t numBytes)
+{
+	memoryBudget = numBytes;
+
+	ScopedLock sl(lock);
+
+	if (numBytes == 0)
+		pendingJobs.clearQuick();
+
+	removeOldestEntries(0);
+}
+
+size_t RLottieFrameCache::getMemoryUsage() const
+{
+	ScopedLock sl(lock);
+	return memoryUsage;
+}
+
+void RLottieFrameCache::run()
+{
+	while (!threadShouldExit())
+	{
+		if (!renderNextJob())
+			wait(-1);
+	}
+}
+
+bool RLottieFrameCache::renderNextJob()
+{
+	// Keep the render lock until the frame is added so that removeAnimation() can't delete the animation in the meantime
+	ScopedLock rl(renderLock);
+
+	Job j;
+
+	{
+		ScopedLock sl(lock);
+
+		if (pendingJobs.isEmpty())
+			return false;
+
+		j = pendingJobs.removeAndReturn(0);
+
+		if (contains(j.key))
+		{
+			if (j.notifyWhenReady)
+				j.key.animation->frameRendered();
+
+			return true;
+		}
+	}
+
+	Image img(Image::ARGB, j.key.width, j.key.height, true);
+	j.key.animation->renderFrame(img, j.key.frame);
+
+	{
+		ScopedLock sl(lock);
+		addEntry(j.key, img);
+	}
+
+	if (j.notifyWhenReady)
+		j.key.animation->frameRendered();
+
+	return true;
+}
+
+bool RLottieFrameCache::contains(const Key& k) const
+{
+	return entryMap.find(k) != entryMap.end();
+}
+
+void RLottieFrameCache::addEntry(const Key& k, const Image& img)
+{
+	auto numBytes = k.getNumBytes();
+
+	if (numBytes > memoryBudget)
+		return;
+
+	removeOldestEntries(numBytes);
+
+	entries.push_front({ k, img });
+	entryMap[k] = entries.begin();
+	memoryUsage += numBytes;
+}
+
+void RLottieFrameCache::removeEntry(EntryList::iterator it)
+{
+	memoryUsage -= it->key.getNumBytes();
+	entryMap.erase(it->key);
+	entries.erase(it);
+}
+
+void RLottieFrameCache::removeOldestEntries(size_t numBytesToAdd)
+{
+	auto budget = memoryBudget.load();
+
+	while (!entries.empty() && memoryUsage + numBytesToAdd > budget)
+		removeEntry(std::prev(entries.end()));
+}
+
+}
@@ -0,0 +1,136 @@
+/** Copyright 2019 Christoph Hart
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+	Note: Be aware that the rLottie wrapper files are licensed under a more permissive license than the
+	rest of the HISE codebase. The MIT license only applies where stated in the header.
+*/
+
+#pragma once
+
+namespace hise {
+using namespace juce;
+
+class RLottieAnimation;
+
+/** A cache for the rendered frames of RLottieAnimation objects.
+
+	Rendering a Lottie frame is expensive, so the animations render the frames that are likely to
+	be shown next on a background thread and the paint routine only has to draw the cached image.
+	A frame is identified by its animation, the canvas size, the scale factor and the frame index.
+	If the memory budget is exceeded, the least recently used frames will be removed.
+
+	A frame that is not in the cache is never rendered on the message thread. Instead it will be
+	queued before the prefetched frames and the animation is notified when it's ready (see
+	RLottieAnimation::Listener).
+
+	There is one instance per RLottieManager that you can get with RLottieManager::getFrameCache().
+*/
+class RLottieFrameCache: private Thread
+{
+public:
+
+	/** The number of frames that are rendered ahead of the current frame. */
+	static constexpr int NumPrefetchFrames = 8;
+
+	/** The identifier of a rendered frame. */
+	struct Key
+	{
+		bool operator==(const Key& other) const
+		{
+			return animation == other.animation && frame == other.frame &&
+				   width == other.width && height == other.height &&
+				   scaleFactor == other.scaleFactor;
+		}
+
+		size_t getNumBytes() const { return (size_t)width * (size_t)height * 4; }
+
+		struct Hash
+		{
+			size_t operator()(const Key& k) const noexcept
+			{
+				auto h = std::hash<RLottieAnimation*>()(k.animation);
+				h = h * 31 + (size_t)k.frame;
+				h = h * 31 + (size_t)k.width;
+				h = h * 31 + (size_t)k.height;
+				return h * 31 + std::hash<float>()(k.scaleFactor);
+			}
+		};
+
+		RLottieAnimation* animation = nullptr;
+		int width = 0;
+		int height = 0;
+		float scaleFactor = 1.0f;
+		int frame = -1;
+	};
+
+	RLottieFrameCache();
+	~RLottieFrameCache();
+
+	/** Returns the cached image of the frame or an invalid image if it hasn't been rendered yet. */
+	Image getFrame(const Key& k);
+
+	/** Queues the given frame and the next frames for rendering on the background thread.
+
+		If the given frame is not cached, it will be rendered first and the animation will be
+		notified when it's ready. This replaces all pending frames of the animation, so if you
+		skip around, the background thread will not waste time with frames that are not needed anymore.
+	*/
+	void prefetch(const Key& k, int numFrames, int direction);
+
+	/** Removes all frames and pending jobs of the animation. If the background thread is currently rendering a frame, it will wait until it's done. */
+	void removeAnimation(RLottieAnimation* a);
+
+	/** Sets the maximum amount of memory in bytes that the cached frames can use. If you set this to zero, the frames will not be cached. */
+	void setMemoryBudget(size_t numBytes);
+
+	/** Returns the memory budget in bytes. */
+	size_t getMemoryBudget() const noexcept { return memoryBudget; }
+
+	/** Returns the amount of memory that is currently used by the cached frames. */
+	size_t getMemoryUsage() const;
+
+private:
+
+	struct Entry
+	{
+		Key key;
+		Image image;
+	};
+
+	struct Job
+	{
+		Key key;
+		bool notifyWhenReady = false;
+	};
+
+	using EntryList = std::list<Entry>;
+
+	void run() override;
+
+	bool renderNextJob();
+	bool contains(const Key& k) const;
+	void addEntry(const Key& k, const Image& img);
+	void removeEntry(EntryList::iterator it);
+	void removeOldestEntries(size_t numBytesToAdd);
+
+	CriticalSection lock;
+	CriticalSection renderLock;
+
+	// The entries sorted by their last usage (the most recent one at the front)
+	EntryList entries;
+	std::unordered_map<Key, EntryList::iterator, Key::Hash> entryMap;
+
+	Array<Job> pendingJobs;
+
+	std::atomic<size_t> memoryBudget;
+	size_t memoryUsage = 0;
+
+	JUCE_DECLARE_NON_COPYABLE(RLottieFrameCache);
+};
+
+}
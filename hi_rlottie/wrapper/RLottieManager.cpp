@@ -16,7 +16,8 @@ using namespace juce;
 
 
 RLottieManager::RLottieManager():
-	lastResult(Result::fail("This Manager is not initialised. Call init() before using it"))
+	lastResult(Result::fail("This Manager is not initialised. Call init() before using it")),
+	frameCache(new RLottieFrameCache())
 {
 	
 }
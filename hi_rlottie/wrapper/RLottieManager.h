@@ -27,6 +27,9 @@ public:
 
 	virtual ~RLottieManager()
     {
+        // Stop the render thread before the library is unloaded
+        frameCache = nullptr;
+
 #if HISE_RLOTTIE_DYNAMIC_LIBRARY
         dynLib = nullptr;
 #endif
@@ -41,6 +44,9 @@ public:
 	/** Returns the result of the initialisation. */
 	Result getInitResult() const { return lastResult; }
 
+	/** Returns the cache for the rendered frames of all animations that were created with this manager. */
+	RLottieFrameCache& getFrameCache() { return *frameCache; }
+
 protected:
 
 	RLottieManager();
@@ -56,6 +62,8 @@ private:
 
 	bool initialised = false;
 
+	ScopedPointer<RLottieFrameCache> frameCache;
+
 	
 
 	/** @internal */
@@ -84,6 +84,9 @@ SET_DOCUMENTATION(ModulatorSampler)
 
     ADD_PARAMETER_DOC(UseStaticMatrix,
         "If this is true, then the routing matrix will not be resized when you load a sample map with another mic position amount.");
+
+	ADD_PARAMETER_DOC(InterpolationMode,
+		"The resampling algorithm: 0 = linear, 1 = linear (SIMD), 2 = 4-point Hermite (SIMD). Changes are applied to new voices.");
     
 	ADD_CHAIN_DOC(SampleStartModulation, "Sample Start", 
 		"Allows modification of the sample start if the sound allows this. The modulation range is depending on the *SampleStartMod* value of each sample.");
@@ -149,6 +152,7 @@ temporaryVoiceBuffer(DEFAULT_BUFFER_TYPE_IS_FLOAT, 2, 0)
 	parameterNames.add("Reversed");
     parameterNames.add("UseStaticMatrix");
 	parameterNames.add("LowPassEnvelopeOrder");
+	parameterNames.add("InterpolationMode");
 
 	editorStateIdentifiers.add("SampleStartChainShown");
 	editorStateIdentifiers.add("SettingsShown");
@@ -176,6 +180,8 @@ temporaryVoiceBuffer(DEFAULT_BUFFER_TYPE_IS_FLOAT, 2, 0)
 		getTable(i)->setYTextConverterRaw(Modulation::getValueAsDecibel);
 
 	getMatrix().setAllowResizing(true);
+
+	soundCollector = new SoundLookupCollector(this);
 }
 
 
@@ -334,6 +340,7 @@ void ModulatorSampler::restoreFromValueTree(const ValueTree &v)
 	setVoiceAmount(v.getProperty("VoiceAmount", voiceAmount));
 	
 	loadAttribute(Reversed, "Reversed");
+	loadAttribute(InterpolationMode, "InterpolationMode");
 
 	loadAttribute(SamplerRepeatMode, "SamplerRepeatMode");
 	loadAttribute(Purged, "Purged");
@@ -377,6 +384,7 @@ ValueTree ModulatorSampler::exportAsValueTree() const
 	saveAttribute(Reversed, "Reversed");
 	v.setProperty("NumChannels", numChannels, nullptr);
     saveAttribute(UseStaticMatrix, "UseStaticMatrix");
+	saveAttribute(InterpolationMode, "InterpolationMode");
 
 	ValueTree channels("channels");
 
@@ -450,6 +458,7 @@ float ModulatorSampler::getAttribute(int parameterIndex) const
 	case Reversed:			return reversed ? 1.0f : 0.0f;
     case UseStaticMatrix:   return useStaticMatrix ? 1.0f : 0.0f;
 	case LowPassEnvelopeOrder: return (float)lowPassOrder * 6.0f;
+	case InterpolationMode: return (float)(int)interpolationMode;
 	default:				jassertfalse; return -1.0f;
 	}
 }
@@ -485,6 +494,9 @@ void ModulatorSampler::setInternalAttribute(int parameterIndex, float newValue)
 		if (envelopeFilter != nullptr)
 			envelopeFilter->setOrder(lowPassOrder);
 		break;
+	case InterpolationMode:
+		interpolationMode = (SampleInterpolationMode)jlimit(0, (int)SampleInterpolationMode::numModes - 1, roundToInt(newValue));
+		break;
 	default:				jassertfalse; break;
 	}
 }
@@ -585,6 +597,8 @@ void ModulatorSampler::deleteSound(int index)
 				static_cast<ModulatorSamplerVoice*>(voices[i])->resetVoice();
 		}
 
+		invalidateSoundLookupTable();
+
 		{
 			LockHelpers::SafeLock sl(getMainController(), LockHelpers::SampleLock);
 			removeSound(index);
@@ -611,6 +625,8 @@ void ModulatorSampler::deleteAllSounds()
 		static_cast<ModulatorSamplerVoice*>(getVoice(i))->resetVoice();
 	}
 
+	invalidateSoundLookupTable();
+
 
 
 	{
@@ -636,6 +652,26 @@ void ModulatorSampler::deleteAllSounds()
 	sendChangeMessage();
 }
 
+void ModulatorSampler::swapSounds(ReferenceCountedArray<SynthesiserSound>& soundsToSwap)
+{
+	jassert(isOnSampleLoadingThread() || !getMainController()->getKillStateHandler().initialised());
+
+	// Use the linear search until the swap is done...
+	invalidateSoundLookupTable();
+
+	{
+		ScopedValueSetter<bool> ia(abortIteration, true);
+		SimpleReadWriteLock::ScopedWriteLock sl(getIteratorLock());
+
+		// This is just a pointer swap so we can safely hold the audio lock here
+		LockHelpers::SafeLock audioLock(getMainController(), LockHelpers::AudioLock);
+		sounds.swapWith(soundsToSwap);
+	}
+
+	// ...and make sure that the table that might have been built in the meantime is not used
+	invalidateSoundLookupTable();
+}
+
 void ModulatorSampler::refreshPreloadSizes()
 {
 	if (getMainController()->getSampleManager().shouldSkipPreloading() && getNumSounds() != 0)
@@ -846,15 +882,14 @@ void ModulatorSampler::setDisplayedGroup(int index, bool shouldBeVisible, Modifi
 
 void ModulatorSampler::setSortByGroup(bool shouldSortByGroup)
 {
-	if (shouldSortByGroup != (soundCollector != nullptr))
-	{
-		LockHelpers::SafeLock sl(getMainController(), LockHelpers::AudioLock);
+	if (auto c = dynamic_cast<SoundLookupCollector*>(soundCollector.get()))
+		c->setOnlyUseCurrentGroup(shouldSortByGroup);
+}
 
-		if (shouldSortByGroup)
-			soundCollector = new GroupedRoundRobinCollector(this);
-		else
-			soundCollector = nullptr;
-	}
+void ModulatorSampler::invalidateSoundLookupTable()
+{
+	if (auto c = dynamic_cast<SoundLookupCollector*>(soundCollector.get()))
+		c->invalidate();
 }
 
 bool ModulatorSampler::hasPendingAsyncJobs() const
@@ -1432,11 +1467,12 @@ bool ModulatorSampler::setMultiGroupState(const int* data128, int numSet)
 	return true;
 }
 
-void ModulatorSampler::setRRGroupAmount(int newGroupLimit)
+void ModulatorSampler::setRRGroupAmount(int newGroupLimit, bool stopPlayingNotes)
 {
 	rrGroupAmount = jmax(1, newGroupLimit);
 
-	allNotesOff(1, true);
+	if (stopPlayingNotes)
+		allNotesOff(1, true);
 
 	ModulatorSampler::SoundIterator sIter(this);
 	jassert(sIter.canIterate());
@@ -1444,6 +1480,8 @@ void ModulatorSampler::setRRGroupAmount(int newGroupLimit)
 	while (auto sound = sIter.getNextSound())
 		sound->setMaxRRGroupIndex(rrGroupAmount);
 
+	invalidateSoundLookupTable();
+
 	rrGroupGains.ensureStorageAllocated(rrGroupAmount);
 
 	for (int i = rrGroupGains.size(); i < rrGroupAmount; i++)
@@ -1524,6 +1562,13 @@ bool ModulatorSampler::preloadAllSamples()
 
 	auto threadPool = getMainController()->getSampleManager().getGlobalSampleThreadPool();
 
+	const bool preloadInParallel = HISE_NUM_PRELOAD_THREADS > 0;
+
+	Array<StreamingSamplerSound*> soundsToPreload;
+	
+	if (preloadInParallel)
+		soundsToPreload.ensureStorageAllocated(numToLoad);
+
 	while (auto sound = sIter.getNextSound())
 	{
 		if (threadPool->threadShouldExit())
@@ -1535,10 +1580,15 @@ bool ModulatorSampler::preloadAllSamples()
 		{
 			auto s = sound->getReferenceToSound().get();
 
-			progress = (double)currentIndex++ / (double)numToLoad;
+			if (preloadInParallel)
+				soundsToPreload.add(s);
+			else
+			{
+				progress = (double)currentIndex++ / (double)numToLoad;
 
-			if (!preloadSample(s, preloadSizeToUse))
-				return false;
+				if (!preloadSample(s, preloadSizeToUse))
+					return false;
+			}
 		}
 		else
 		{
@@ -1546,13 +1596,16 @@ bool ModulatorSampler::preloadAllSamples()
 			{
 				const bool isEnabled = getChannelData(j).enabled;
 
-				progress = (double)currentIndex++ / (double)numToLoad;
+				if (!preloadInParallel)
+					progress = (double)currentIndex++ / (double)numToLoad;
 
 				if (auto s = sound->getReferenceToSound(j))
 				{
 					if (isEnabled)
 					{
-						if (!preloadSample(s.get(), preloadSizeToUse))
+						if (preloadInParallel)
+							soundsToPreload.add(s.get());
+						else if (!preloadSample(s.get(), preloadSizeToUse))
 							return false;
 					}
 					else
@@ -1561,7 +1614,20 @@ bool ModulatorSampler::preloadAllSamples()
 			}
 		}
 
-		sound->setReversed(isReversed);
+		// The reversed flag needs to be applied after the preload buffer was loaded
+		if (!preloadInParallel)
+			sound->setReversed(isReversed);
+	}
+
+	if (preloadInParallel)
+	{
+		if (!preloadSamplesInParallel(soundsToPreload, preloadSizeToUse))
+			return false;
+
+		ModulatorSampler::SoundIterator rIter(this);
+
+		while (auto sound = rIter.getNextSound())
+			sound->setReversed(isReversed);
 	}
 
 	refreshMemoryUsage();
@@ -1577,8 +1643,6 @@ bool ModulatorSampler::preloadSample(StreamingSamplerSound * s, const int preloa
 {
 	jassert(s != nullptr);
 
-	String fileName = s->getFileName(false);
-
 	try
 	{
 		s->setPreloadSize(s->hasActiveState() ? preloadSizeToUse : 0, true);
@@ -1587,18 +1651,137 @@ bool ModulatorSampler::preloadSample(StreamingSamplerSound * s, const int preloa
 	}
 	catch (StreamingSamplerSound::LoadingError l)
 	{
-		String x;
-		x << "Error at preloading sample " << l.fileName << ": " << l.errorDescription;
-		getMainController()->getDebugLogger().logMessage(x);
+		logPreloadError(l);
+		return false;
+	}
+}
+
+bool ModulatorSampler::preloadSamplesInParallel(const Array<StreamingSamplerSound*>& soundsToPreload, const int preloadSizeToUse)
+{
+	auto& progress = getMainController()->getSampleManager().getPreloadProgress();
+	auto loadingThread = getMainController()->getSampleManager().getGlobalSampleThreadPool();
+
+	// Duplicate zones share a single StreamingSamplerSound from the pool so it must only be preloaded once.
+	Array<StreamingSamplerSound*> uniqueSounds;
+	std::unordered_set<StreamingSamplerSound*> visited;
+
+	uniqueSounds.ensureStorageAllocated(soundsToPreload.size());
+
+	for (auto s : soundsToPreload)
+	{
+		if (visited.insert(s).second)
+			uniqueSounds.add(s);
+	}
+
+	if (uniqueSounds.isEmpty())
+		return true;
+
+	auto pool = getMainController()->getSampleManager().getPreloadThreadPool();
+
+	if (pool == nullptr)
+	{
+		for (auto s : uniqueSounds)
+		{
+			if (loadingThread->threadShouldExit() || !preloadSample(s, preloadSizeToUse))
+				return false;
+		}
+
+		return true;
+	}
+
+	// The readers of a monolith share their decoder, so every worker uses its own set of readers
+	Array<HlacMonolithInfo*> monoliths;
+
+	for (auto s : uniqueSounds)
+		monoliths.addIfNotAlreadyThere(s->getMonolithInfo());
+
+	monoliths.removeAllInstancesOf(nullptr);
+
+	const int numToLoad = uniqueSounds.size();
+
+	std::atomic<int> nextSound { 0 };
+	std::atomic<int> numPreloaded { 0 };
+	std::atomic<bool> failed { false };
+	std::atomic<int> numRunning { 0 };
+
+	WaitableEvent finished;
+	SpinLock errorLock;
+	Array<StreamingSamplerSound::LoadingError> errors;
+
+	auto preloadSounds = [&]()
+	{
+		OwnedArray<HlacMonolithInfo::ScopedThreadReaders> threadReaders;
+
+		for (auto m : monoliths)
+			threadReaders.add(new HlacMonolithInfo::ScopedThreadReaders(m));
+
+		for (auto i = nextSound++; i < numToLoad; i = nextSound++)
+		{
+			if (failed || loadingThread->threadShouldExit())
+				return;
+
+			auto s = uniqueSounds[i];
+
+			try
+			{
+				s->setPreloadSize(s->hasActiveState() ? preloadSizeToUse : 0, true);
+				s->closeFileHandle();
+			}
+			catch (StreamingSamplerSound::LoadingError l)
+			{
+				SpinLock::ScopedLockType sl(errorLock);
+				errors.add(l);
+				failed = true;
+				return;
+			}
+
+			++numPreloaded;
+		}
+	};
+
+	const int numThreads = jmin<int>(pool->getNumThreads(), numToLoad);
+
+	for (int i = 0; i < numThreads; i++)
+	{
+		++numRunning;
+
+		pool->addJob([&]()
+		{
+			preloadSounds();
+
+			if (--numRunning == 0)
+				finished.signal();
+		});
+	}
+
+	// The loading thread only updates the progress and checks whether the operation should be aborted.
+	while (numRunning.load() != 0)
+	{
+		progress = (double)numPreloaded.load() / (double)numToLoad;
+
+		if (loadingThread->threadShouldExit())
+			failed = true;
+
+		finished.wait(20);
+	}
+
+	for (const auto& e : errors)
+		logPreloadError(e);
+
+	return !failed && !loadingThread->threadShouldExit();
+}
+
+void ModulatorSampler::logPreloadError(const StreamingSamplerSound::LoadingError& l)
+{
+	String x;
+	x << "Error at preloading sample " << l.fileName << ": " << l.errorDescription;
+	getMainController()->getDebugLogger().logMessage(x);
 
 #if USE_FRONTEND
-		getMainController()->sendOverlayMessage(DeactiveOverlay::State::CustomErrorMessage, x);
+	getMainController()->sendOverlayMessage(DeactiveOverlay::State::CustomErrorMessage, x);
 #else
-		debugError(this, x);
+	debugError(this, x);
 #endif
-
-		return false;
-	}
 }
 
 ModulatorSampler::ScopedUpdateDelayer::ScopedUpdateDelayer(ModulatorSampler* s) :
@@ -1620,77 +1803,194 @@ ModulatorSampler::ScopedUpdateDelayer::~ScopedUpdateDelayer()
 	}
 }
 
-ModulatorSampler::GroupedRoundRobinCollector::GroupedRoundRobinCollector(ModulatorSampler* s):
-	sampler(s),
-	ready(false)
+ModulatorSampler::SoundLookupCollector::SoundLookupCollector(ModulatorSampler* s):
+	sampler(s)
 {
 	sampler->getSampleMap()->addListener(this);
-	triggerAsyncUpdate();
+	invalidate();
 }
 
-ModulatorSampler::GroupedRoundRobinCollector::~GroupedRoundRobinCollector()
+ModulatorSampler::SoundLookupCollector::~SoundLookupCollector()
 {
 	if (sampler != nullptr)
 		sampler->getSampleMap()->removeListener(this);
 }
 
-void ModulatorSampler::GroupedRoundRobinCollector::collectSounds(const HiseEvent& m, UnorderedStack<ModulatorSynthSound *>& soundsAboutToBeStarted)
+void ModulatorSampler::SoundLookupCollector::invalidate()
+{
+	++version;
+	triggerAsyncUpdate();
+}
+
+void ModulatorSampler::SoundLookupCollector::collectSounds(const HiseEvent& m, UnorderedStack<ModulatorSynthSound *>& soundsAboutToBeStarted)
 {
 	SimpleReadWriteLock::ScopedReadLock sl(rebuildLock);
 
-	if (!ready)
-		jassertfalse;
+	if (builtVersion != version.load() || numIndexedSounds != sampler->getNumSounds())
+	{
+		collectAllSounds(m, soundsAboutToBeStarted);
+		return;
+	}
+
+	const int noteNumber = m.getNoteNumber() + m.getTransposeAmount();
 
-	auto currentGroup = sampler->getCurrentRRGroup() - 1;
+	if (!isPositiveAndBelow(noteNumber, NumNotes))
+		return;
+
+	const int currentGroup = sampler->getCurrentRRGroup() - 1;
+	const int unsortedGroup = numGroups - 1;
 
-	if (isPositiveAndBelow(currentGroup, groups.size()))
+	if (onlyCurrentGroup)
 	{
-		auto& refArray = groups.getReference(currentGroup);
+		if (isPositiveAndBelow(currentGroup, unsortedGroup))
+			addSoundsFromCell(currentGroup, m, soundsAboutToBeStarted);
+	}
+	else if (!sampler->multiRRGroupState && !sampler->crossfadeGroups)
+	{
+		if (isPositiveAndBelow(currentGroup, unsortedGroup))
+			addSoundsFromCell(currentGroup, m, soundsAboutToBeStarted);
 
-		for (auto s : refArray)
-		{
-			if (sampler->soundCanBePlayed(s, m.getChannel(), m.getNoteNumber(), m.getFloatVelocity()))
-				soundsAboutToBeStarted.insertWithoutSearch(s);
-		}
+		addSoundsFromCell(unsortedGroup, m, soundsAboutToBeStarted);
+	}
+	else
+	{
+		for (int i = 0; i < numGroups; i++)
+			addSoundsFromCell(i, m, soundsAboutToBeStarted);
+	}
+}
+
+void ModulatorSampler::SoundLookupCollector::collectAllSounds(const HiseEvent& m, UnorderedStack<ModulatorSynthSound *>& soundsAboutToBeStarted)
+{
+	const int noteNumber = m.getNoteNumber() + m.getTransposeAmount();
+	const int currentGroup = sampler->getCurrentRRGroup();
+
+	for (auto s : sampler->sounds)
+	{
+		auto sound = static_cast<ModulatorSamplerSound*>(s);
+
+		if (onlyCurrentGroup && sound->getRRGroup() != currentGroup)
+			continue;
+
+		if (sampler->soundCanBePlayed(sound, m.getChannel(), noteNumber, m.getFloatVelocity()))
+			soundsAboutToBeStarted.insertWithoutSearch(sound);
 	}
 }
 
-void ModulatorSampler::GroupedRoundRobinCollector::handleAsyncUpdate()
+void ModulatorSampler::SoundLookupCollector::addSoundsFromCell(int groupIndex, const HiseEvent& m, UnorderedStack<ModulatorSynthSound *>& soundsAboutToBeStarted)
 {
-	Array<ReferenceCountedArray<ModulatorSynthSound>> newList;
+	const int noteNumber = m.getNoteNumber() + m.getTransposeAmount();
+	const float velocity = m.getFloatVelocity();
+	const int velocityBucket = jlimit(0, 127, (int)(velocity * 127)) / VelocityBucketSize;
 
-	auto numRRGroups = (int)sampler->getAttribute(ModulatorSampler::RRGroupAmount);
+	auto range = cells.getUnchecked(getCellIndex(groupIndex, noteNumber, velocityBucket));
 
-	if (numRRGroups > 0)
+	for (int i = range.getStart(); i < range.getEnd(); i++)
 	{
-		int numToStore = sampler->getNumSounds() / numRRGroups;
+		auto s = entries.getUnchecked(i);
 
-		newList.ensureStorageAllocated(numRRGroups);
+		if (sampler->soundCanBePlayed(s, m.getChannel(), noteNumber, velocity))
+			soundsAboutToBeStarted.insertWithoutSearch(s);
+	}
+}
 
-		for (int i = 0; i < numRRGroups; i++)
-		{
-			ReferenceCountedArray<ModulatorSynthSound> newArray;
-			newArray.ensureStorageAllocated(numToStore);
-			newList.add(newArray);
-		}
+void ModulatorSampler::SoundLookupCollector::handleAsyncUpdate()
+{
+	if (sampler == nullptr)
+		return;
+
+	const int thisVersion = version.load();
+	const int newNumGroups = jmax(1, (int)sampler->getAttribute(ModulatorSampler::RRGroupAmount)) + 1;
+	const int numCells = newNumGroups * NumNotes * NumVelocityBuckets;
 
+	struct SoundArea
+	{
+		int group;
+		Range<int> notes;
+		Range<int> velocityBuckets;
+	};
+
+	Array<ModulatorSynthSound*> newSounds;
+	Array<SoundArea> areas;
+	std::vector<int> numPerCell((size_t)numCells, 0);
+
+	auto forEachCell = [&](const SoundArea& a, const std::function<void(int)>& f)
+	{
+		for (int n = a.notes.getStart(); n < a.notes.getEnd(); n++)
+			for (int v = a.velocityBuckets.getStart(); v < a.velocityBuckets.getEnd(); v++)
+				f((a.group * NumNotes + n) * NumVelocityBuckets + v);
+	};
+
+	{
 		ModulatorSampler::SoundIterator it(sampler);
 		jassert(it.canIterate());
 
-		while (auto s = it.getNextSound())
+		newSounds.ensureStorageAllocated(sampler->getNumSounds());
+		areas.ensureStorageAllocated(sampler->getNumSounds());
+
+		while (auto sound = it.getNextSound())
 		{
-			auto rrIndex = (int)s->getSampleProperty(SampleIds::RRGroup) - 1;
+			SoundArea a;
 
-			if (isPositiveAndBelow(rrIndex, newList.size()))
-			{
-				newList.getReference(rrIndex).add(static_cast<ModulatorSynthSound*>(s));
-			}
+			a.group = sound->getRRGroup() - 1;
+
+			if (!isPositiveAndBelow(a.group, newNumGroups - 1))
+				a.group = newNumGroups - 1;
+
+			const int loKey = jlimit(0, NumNotes - 1, (int)sound->getSampleProperty(SampleIds::LoKey));
+			const int hiKey = jlimit(0, NumNotes - 1, (int)sound->getSampleProperty(SampleIds::HiKey));
+			const int loVel = jlimit(0, 127, (int)sound->getSampleProperty(SampleIds::LoVel));
+			const int hiVel = jlimit(0, 127, (int)sound->getSampleProperty(SampleIds::HiVel));
+
+			a.notes = { loKey, jmax(loKey, hiKey) + 1 };
+			a.velocityBuckets = { loVel / VelocityBucketSize, jmax(loVel, hiVel) / VelocityBucketSize + 1 };
+
+			forEachCell(a, [&](int c) { numPerCell[c]++; });
+
+			newSounds.add(sound.get());
+			areas.add(a);
 		}
 	}
 
-	SimpleReadWriteLock::ScopedWriteLock sl(rebuildLock);
-	std::swap(groups, newList);
-	ready.store(true);
+	Array<Range<int>> newCells;
+	newCells.ensureStorageAllocated(numCells);
+
+	int offset = 0;
+
+	for (auto num : numPerCell)
+	{
+		newCells.add({ offset, offset });
+		offset += num;
+	}
+
+	Array<ModulatorSynthSound*> newEntries;
+	newEntries.insertMultiple(0, nullptr, offset);
+
+	for (int i = 0; i < newSounds.size(); i++)
+	{
+		auto s = newSounds[i];
+
+		forEachCell(areas.getReference(i), [&](int c)
+		{
+			auto& r = newCells.getReference(c);
+			newEntries.set(r.getEnd(), s);
+			r.setEnd(r.getEnd() + 1);
+		});
+	}
+
+	{
+		SimpleReadWriteLock::ScopedWriteLock sl(rebuildLock);
+
+		std::swap(cells, newCells);
+		std::swap(entries, newEntries);
+
+		numGroups = newNumGroups;
+		numIndexedSounds = newSounds.size();
+		builtVersion = thisVersion;
+	}
+
+	// The sample map was changed during the rebuild, so we need to do it again
+	if (version.load() != thisVersion)
+		triggerAsyncUpdate();
 }
 
 } // namespace hise
@@ -82,50 +82,85 @@ public:
 		bool prevValue;
 	};
 
-	class GroupedRoundRobinCollector : public ModulatorSynth::SoundCollectorBase,
-									   public SampleMap::Listener,
-									   public AsyncUpdater
+	/** A sound collector that uses a precomputed note x velocity x RR group table.
+	*
+	*	The table is rebuilt asynchronously whenever the sample map changes. As long as it is outdated,
+	*	the collector falls back to iterating over all sounds, so make sure to call invalidate() before
+	*	the sounds are removed.
+	*/
+	class SoundLookupCollector : public ModulatorSynth::SoundCollectorBase,
+								 public SampleMap::Listener,
+								 public AsyncUpdater
 	{
 	public:
 
-		GroupedRoundRobinCollector(ModulatorSampler* s);
+		static constexpr int NumNotes = 128;
+		static constexpr int NumVelocityBuckets = 8;
+		static constexpr int VelocityBucketSize = 128 / NumVelocityBuckets;
 
-		~GroupedRoundRobinCollector();
+		SoundLookupCollector(ModulatorSampler* s);
+
+		~SoundLookupCollector();
 
 		void collectSounds(const HiseEvent& m, UnorderedStack<ModulatorSynthSound *>& soundsToBeStarted) override;
 
-		void sampleMapWasChanged(PoolReference newSampleMap)
+		/** Marks the table as outdated and triggers a rebuild. */
+		void invalidate();
+
+		/** If enabled, only the sounds of the current RR group will be collected. */
+		void setOnlyUseCurrentGroup(bool shouldOnlyUseCurrentGroup) { onlyCurrentGroup = shouldOnlyUseCurrentGroup; }
+
+		bool isOnlyUsingCurrentGroup() const noexcept { return onlyCurrentGroup; }
+
+		void sampleMapWasChanged(PoolReference newSampleMap) override
 		{
-			triggerAsyncUpdate();
+			invalidate();
 		}
 
-		void samplePropertyWasChanged(ModulatorSamplerSound* , const Identifier& sampleId, const var& )
+		void samplePropertyWasChanged(ModulatorSamplerSound* , const Identifier& sampleId, const var& ) override
 		{
-			if(sampleId == SampleIds::RRGroup)
-				triggerAsyncUpdate();
+			if (sampleId == SampleIds::RRGroup || sampleId == SampleIds::LoKey || sampleId == SampleIds::HiKey ||
+				sampleId == SampleIds::LoVel || sampleId == SampleIds::HiVel)
+				invalidate();
 		};
 
-		virtual void sampleAmountChanged() 
+		void sampleAmountChanged() override
 		{
-			triggerAsyncUpdate();
+			invalidate();
 		};
 
-		virtual void sampleMapCleared()
+		void sampleMapCleared() override
 		{
-			triggerAsyncUpdate();
+			invalidate();
 		};
 
 	private:
 
+		void collectAllSounds(const HiseEvent& m, UnorderedStack<ModulatorSynthSound *>& soundsToBeStarted);
+
+		void addSoundsFromCell(int groupIndex, const HiseEvent& m, UnorderedStack<ModulatorSynthSound *>& soundsToBeStarted);
+
+		int getCellIndex(int groupIndex, int noteNumber, int velocityBucket) const noexcept
+		{
+			return (groupIndex * NumNotes + noteNumber) * NumVelocityBuckets + velocityBucket;
+		}
+
 		SimpleReadWriteLock rebuildLock;
 
 		WeakReference<ModulatorSampler> sampler;
 
 		void handleAsyncUpdate() override;
 
-		std::atomic<bool> ready;
+		std::atomic<bool> onlyCurrentGroup { false };
+		std::atomic<int> version { 0 };
+		int builtVersion = -1;
+
+		// The last group index contains all sounds with a RR group outside the group range
+		int numGroups = 0;
+		int numIndexedSounds = 0;
 
-		Array<ReferenceCountedArray<ModulatorSynthSound>> groups;
+		Array<Range<int>> cells;
+		Array<ModulatorSynthSound*> entries;
 	};
 
 	/** A small helper tool that iterates over the sound array in a thread-safe way.
@@ -219,6 +254,7 @@ public:
 		Reversed,
         UseStaticMatrix,
 		LowPassEnvelopeOrder,
+		InterpolationMode,
 		numModulatorSamplerParameters
 	};
 
@@ -359,6 +395,12 @@ public:
 
 	}
 
+	void preprocessHiseEventBuffer(const HiseEventBuffer& inputMidi, int numSamples) override
+	{
+		if (!purged)
+			ModulatorSynth::preprocessHiseEventBuffer(inputMidi, numSamples);
+	}
+
 	SampleThreadPool *getBackgroundThreadPool();
 	String getMemoryUsage() const;;
 
@@ -415,6 +457,12 @@ public:
 
 	bool preloadSample(StreamingSamplerSound * s, const int preloadSizeToUse);
 
+	/** Preloads the given sounds using the preload thread pool of the sample manager.
+	*
+	*	Every worker uses its own readers for the monolith files, so the sounds of a single monolith are preloaded in parallel too.
+	*/
+	bool preloadSamplesInParallel(const Array<StreamingSamplerSound*>& soundsToPreload, const int preloadSizeToUse);
+
 	bool saveSampleMap() const;
 
 	bool saveSampleMapAsReference() const;
@@ -435,9 +483,14 @@ public:
 	bool setMultiGroupState(const int* data128, int numSet);
 
 	bool isRoundRobinEnabled() const noexcept { return useRoundRobinCycleLogic; };
-	void setRRGroupAmount(int newGroupLimit);
+
+	/** Sets the number of RR groups. If stopPlayingNotes is false, the voices will keep on playing (use this for hot swapping sample maps). */
+	void setRRGroupAmount(int newGroupLimit, bool stopPlayingNotes=true);
 
 	bool isPitchTrackingEnabled() const {return pitchTrackingEnabled; };
+
+	/** Returns the algorithm that the voices use to resample the audio data. */
+	SampleInterpolationMode getInterpolationMode() const noexcept { return interpolationMode; }
 	bool isOneShot() const {return oneShotEnabled; };
 
 	bool isNoteNumberMapped(int noteNumber) const;
@@ -649,10 +702,28 @@ public:
     
     bool isUsingStaticMatrix() const noexcept { return useStaticMatrix; };
 
+	/** If enabled, the scripting API will load new sample maps without killing the voices. 
+	
+		The voices that are playing when the sample map is loaded will keep on playing the sounds of the old sample map.
+	*/
+	void setUseSampleMapHotSwap(bool shouldUseHotSwap) noexcept { useSampleMapHotSwap = shouldUseHotSwap; }
+
+	bool isUsingSampleMapHotSwap() const noexcept { return useSampleMapHotSwap; }
+
+	/** Swaps the sound array with the given sounds without killing the voices.
+	
+		This must be called from the sample loading thread. The voices keep a reference to the sound they are playing,
+		so the old sounds (which will be in the given array after this call) must be kept alive until they are finished.
+	*/
+	void swapSounds(ReferenceCountedArray<SynthesiserSound>& soundsToSwap);
+
 	void setDisplayedGroup(int index, bool shouldBeVisible, ModifierKeys mods);
 	
 	void setSortByGroup(bool shouldSortByGroup);
 
+	/** Call this whenever the mapping of a sound changes to make sure that the sound lookup table is not used until it's rebuilt. */
+	void invalidateSoundLookupTable();
+
 	bool shouldDelayUpdate() const noexcept { return delayUpdate; }
 
 	/** Checks the global queue if there are any jobs that will be executed sometime in the future. 
@@ -723,6 +794,8 @@ private:
 	
     /** Sets the streaming buffer and preload buffer sizes. */
     void setPreloadSize(int newPreloadSize);
+
+	void logPreloadError(const StreamingSamplerSound::LoadingError& l);
     
 	CriticalSection exportLock;
 
@@ -802,6 +875,7 @@ private:
 	int bufferSize;
 
 	bool useStaticMatrix = false;
+	std::atomic<bool> useSampleMapHotSwap { false };
 
 	int64 memoryUsage;
 
@@ -811,6 +885,7 @@ private:
 
 	bool delayUpdate = false;
 	int lowPassOrder = 0;
+	SampleInterpolationMode interpolationMode = SampleInterpolationMode::Linear;
 
 	float groupGainValues[8];
 	float currentCrossfadeValue;
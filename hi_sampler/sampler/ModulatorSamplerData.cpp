@@ -48,6 +48,8 @@ SampleMap::SampleMap(ModulatorSampler *sampler_):
 
 	changeWatcher = new ChangeWatcher(data);
 
+	hotSwapJob = new HotSwapJob(*this);
+
 	// You have to clear the sound array before you set a new SampleMap!
 	jassert(sampler->getNumSounds() == 0);
 }
@@ -108,6 +110,9 @@ SampleMap::FileList SampleMap::createFileList()
 
 SampleMap::~SampleMap()
 {
+	// The retired sounds need this object to be alive
+	hotSwapJob = nullptr;
+
 	getCurrentSamplePool()->clearUnreferencedMonoliths();
 }
 
@@ -177,11 +182,16 @@ void SampleMap::updateCrossfades(Identifier id, var newValue)
 }
 
 hise::FileHandlerBase* SampleMap::getCurrentFileHandler() const
+{
+	return getFileHandlerForPool(currentPool.get());
+}
+
+hise::FileHandlerBase* SampleMap::getFileHandlerForPool(SampleMapPool* p) const
 {
 	FileHandlerBase* handler = &GET_PROJECT_HANDLER(sampler);
 
-	if (handler->getMainController()->getExpansionHandler().isEnabled() && currentPool != nullptr)
-		handler = currentPool->getFileHandler();
+	if (handler->getMainController()->getExpansionHandler().isEnabled() && p != nullptr)
+		handler = p->getFileHandler();
 
 	return handler;
 }
@@ -195,131 +205,90 @@ void SampleMap::setCurrentMonolith()
 {
 	if (isMonolith())
 	{
-		ModulatorSamplerSoundPool* pool = getCurrentFileHandler()->pool->getSamplePool();
+		if (auto m = loadMonolith(data, true))
+			currentMonolith = m;
+	}
+}
 
-		if (auto existingInfo = pool->getMonolith(getMonolithID()))
-		{
-			currentMonolith = existingInfo;
+HlacMonolithInfo::Ptr SampleMap::loadMonolith(const ValueTree& v, bool allowSamplerChanges)
+{
+	ModulatorSamplerSoundPool* pool = getCurrentFileHandler()->pool->getSamplePool();
 
-			jassert(*currentMonolith == getMonolithID());
-		}
-		else
-		{
-			MonolithFileReference info(data);
+	auto monolithId = MonolithFileReference::getIdFromValueTree(v);
 
-			bool added = false;
+	if (auto existingInfo = pool->getMonolith(monolithId))
+	{
+		jassert(*existingInfo == monolithId);
+		return existingInfo;
+	}
 
-			if (FullInstrumentExpansion::isEnabled(sampler->getMainController()))
-			{
-				if (auto exp = sampler->getMainController()->getExpansionHandler().getCurrentExpansion())
-				{
-					info.addSampleDirectory(exp->getSubDirectory(FileHandlerBase::Samples));
-					added = true;
-				}
-			}
+	MonolithFileReference info(v);
 
-			if(!added)
-				info.addSampleDirectory(getCurrentFileHandler()->getSubDirectory(ProjectHandler::SubDirectories::Samples));
+	bool added = false;
 
-			try
-			{
-				auto mainDirectory = sampler->getMainController()->getCurrentFileHandler().getSubDirectory(ProjectHandler::SubDirectories::Samples);
-
-				if (!mainDirectory.isDirectory())
-					throw Result::fail("The sample directory does not exist");
+	if (FullInstrumentExpansion::isEnabled(sampler->getMainController()))
+	{
+		if (auto exp = sampler->getMainController()->getExpansionHandler().getCurrentExpansion())
+		{
+			info.addSampleDirectory(exp->getSubDirectory(FileHandlerBase::Samples));
+			added = true;
+		}
+	}
 
-				info.addSampleDirectory(mainDirectory);
+	if(!added)
+		info.addSampleDirectory(getCurrentFileHandler()->getSubDirectory(ProjectHandler::SubDirectories::Samples));
 
-				auto monolithFiles = info.getAllFiles();
+	try
+	{
+		auto mainDirectory = sampler->getMainController()->getCurrentFileHandler().getSubDirectory(ProjectHandler::SubDirectories::Samples);
 
-				if (!monolithFiles.isEmpty())
-				{
-					if (info.isMultimic())
-					{
-						StringArray micPositions = StringArray::fromTokens(data.getProperty("MicPositions").toString(), ";", "");
+		if (!mainDirectory.isDirectory())
+			throw Result::fail("The sample directory does not exist");
 
-						micPositions.removeEmptyStrings(true);
+		info.addSampleDirectory(mainDirectory);
 
-						if (micPositions.size() == info.getNumMicPositions())
-							sampler->setNumMicPositions(micPositions);
-						else
-							sampler->setNumChannels(1);
-					}
-					else
-					{
-						sampler->setNumChannels(1);
-					}
+		auto monolithFiles = info.getAllFiles();
 
-					currentMonolith = pool->loadMonolithicData(data, monolithFiles);
+		if (monolithFiles.isEmpty())
+			return nullptr;
 
-					if (currentMonolith)
-						jassert(*currentMonolith == getMonolithID());
-				}
-			}
-			catch (Result& r)
+		if (allowSamplerChanges)
+		{
+			if (info.isMultimic())
 			{
-				sampler->getMainController()->sendOverlayMessage(DeactiveOverlay::State::CustomErrorMessage,
-					r.getErrorMessage());
-
-				FRONTEND_ONLY(sampler->deleteAllSounds());
-
-				return;
-			}
-
-#if 0
-
-			int numSingleChannelSplits = (int)data.getProperty("MonolithSplitAmount", 0);
-			int numChannels = jmax<int>(1, data.getChild(0).getNumChildren());
+				StringArray micPositions = StringArray::fromTokens(v.getProperty("MicPositions").toString(), ";", "");
 
-			MonolithFileReference info(numChannels, numSingleChannelSplits);
+				micPositions.removeEmptyStrings(true);
 
-			info.referenceString = getMonolithID();
-
-			// First check in the expansion folder, then in the global sample folder...
-			info.sampleRoots.add(getCurrentFileHandler()->getSubDirectory(ProjectHandler::SubDirectories::Samples));
-			info.sampleRoots.add();
-
-			if (FullInstrumentExpansion::isEnabled(sampler->getMainController()))
-			{
-				if (auto exp = sampler->getMainController()->getExpansionHandler().getCurrentExpansion())
-					info.sampleRoots.set(0, exp->getSubDirectory(FileHandlerBase::Samples));
+				if (micPositions.size() == info.getNumMicPositions())
+					sampler->setNumMicPositions(micPositions);
+				else
+					sampler->setNumChannels(1);
 			}
-
-			if (!info.sampleRoots[1].isDirectory())
+			else
 			{
-				sampler->getMainController()->sendOverlayMessage(DeactiveOverlay::State::CustomErrorMessage,
-					"The sample directory does not exist");
-
-				FRONTEND_ONLY(sampler->deleteAllSounds());
-
-				return;
+				sampler->setNumChannels(1);
 			}
+		}
 
-			Array<File> monolithFiles;
+		auto newMonolith = pool->loadMonolithicData(v, monolithFiles);
 
-			for (int i = 0; i < info.getNumMonolithsToLoad(); i++)
-			{
-				auto f = info.getFile();
-				
-				if (f.existsAsFile())
-				{
-					monolithFiles.add(f);
-					info = info.getNextMonolith();
-				}
-				else
-				{
-					sampler->getMainController()->sendOverlayMessage(DeactiveOverlay::State::CustomErrorMessage,
-						"The sample " + f.getFileName() + " wasn't found");
-
-					FRONTEND_ONLY(sampler->deleteAllSounds());
+		if (newMonolith)
+			jassert(*newMonolith == monolithId);
 
-					return;
-				}
-			}
-#endif
+		return newMonolith;
+	}
+	catch (Result& r)
+	{
+		sampler->getMainController()->sendOverlayMessage(DeactiveOverlay::State::CustomErrorMessage,
+			r.getErrorMessage());
 
-			
+		if (allowSamplerChanges)
+		{
+			FRONTEND_ONLY(sampler->deleteAllSounds());
 		}
+
+		return nullptr;
 	}
 }
 
@@ -529,6 +498,8 @@ void SampleMap::addSampleFromValueTree(ValueTree childWhichHasBeenAdded)
 		sampler->addSound(newSound);
 	}
 
+	sampler->invalidateSoundLookupTable();
+
 	dynamic_cast<ModulatorSamplerSound*>(newSound)->initPreloadBuffer((int)sampler->getAttribute(ModulatorSampler::PreloadSize));
 
 	const bool isReversed = sampler->getAttribute(ModulatorSampler::Reversed) > 0.5f;
@@ -777,11 +748,16 @@ void SampleMap::setNewValueTree(const ValueTree& v)
 {
 	LockHelpers::freeToGo(sampler->getMainController());
 
-	data.removeListener(this);
-
 	sampler->deleteAllSounds();
 	notifier.sendSampleAmountChangeMessage(sendNotificationAsync);
 
+	swapValueTree(v);
+}
+
+void SampleMap::swapValueTree(const ValueTree& v)
+{
+	data.removeListener(this);
+
 	data = v;
 	data.addListener(this);
 
@@ -910,18 +886,38 @@ void SampleMap::load(const PoolReference& reference)
 	SimpleReadWriteLock::ScopedWriteLock sl(sampler->getIteratorLock());
 	clear(dontSendNotification);
 
-	currentPool = getSampler()->getMainController()->getCurrentSampleMapPool();
+	SampleMapPool* newPool = nullptr;
+	sampleMapData = loadFromPool(reference, newPool);
+	currentPool = newPool;
 
-	
+	currentPool->addListener(this);
+
+	if (sampleMapData)
+	{
+		auto v = sampleMapData.getData()->createCopy();
+
+		parseValueTree(v);
+		changeWatcher = new ChangeWatcher(data);
+	}
+	else
+		jassertfalse;
+
+	sendSampleMapChangeMessage();
+
+}
+
+PooledSampleMap SampleMap::loadFromPool(const PoolReference& reference, SampleMapPool*& poolToUse)
+{
+	poolToUse = getSampler()->getMainController()->getCurrentSampleMapPool();
 
 	if (!FullInstrumentExpansion::isEnabled(getSampler()->getMainController()))
 	{
 		if (auto expansion = getSampler()->getMainController()->getExpansionHandler().getExpansionForWildcardReference(reference.getReferenceString()))
 		{
-			currentPool = &expansion->pool->getSampleMapPool();
+			poolToUse = &expansion->pool->getSampleMapPool();
 		}
 
-		sampleMapData = currentPool->loadFromReference(reference, PoolHelpers::LoadAndCacheWeak);
+		return poolToUse->loadFromReference(reference, PoolHelpers::LoadAndCacheWeak);
 	}
 	else
 	{
@@ -930,23 +926,345 @@ void SampleMap::load(const PoolReference& reference)
 							reference.getReferenceString().fromLastOccurrenceOf("{PROJECT_FOLDER}", false, false),
 							FileHandlerBase::SampleMaps);
 
-		sampleMapData = currentPool->loadFromReference(ref, PoolHelpers::LoadAndCacheWeak);
+		return poolToUse->loadFromReference(ref, PoolHelpers::LoadAndCacheWeak);
 	}
+}
 
-	currentPool->addListener(this);
+void SampleMap::loadWithHotSwap(const PoolReference& reference)
+{
+	hotSwapJob->loadSampleMap(reference);
+}
 
-	if (sampleMapData)
+bool SampleMap::isUsedByOutgoingSounds(const StreamingSamplerSound* s) const
+{
+	return hotSwapJob != nullptr && hotSwapJob->isUsedByOutgoingSounds(s);
+}
+
+SampleMap::HotSwapJob::HotSwapJob(SampleMap& parent_) :
+	SampleThreadPool::Job("Sample Map Hot Swap"),
+	parent(parent_)
+{
+
+}
+
+SampleMap::HotSwapJob::~HotSwapJob()
+{
+	stopTimer();
+	signalJobShouldExit();
+
+	// A hot swap that is already running writes into the sample map and the sampler, so we need to wait until it has stopped.
+	parent.getSampler()->getMainController()->getSampleManager().getGlobalSampleThreadPool()->removeJob(this);
+
+	ScopedLock sl(retiredLock);
+	retiredSounds.clear();
+}
+
+void SampleMap::HotSwapJob::loadSampleMap(const PoolReference& ref)
+{
 	{
-		auto v = sampleMapData.getData()->createCopy();
+		SpinLock::ScopedLockType sl(pendingLock);
+		pendingReference = ref;
+	}
 
-		parseValueTree(v);
-		changeWatcher = new ChangeWatcher(data);
+	addToQueue();
+
+	// The timer makes sure that the job will be queued again if the loading queue was cleared
+	startTimer(200);
+}
+
+void SampleMap::HotSwapJob::addToQueue()
+{
+	if (isQueued() || isRunning())
+		return;
+
+	resetJob();
+	parent.getSampler()->getMainController()->getSampleManager().getGlobalSampleThreadPool()->addJob(this, false);
+}
+
+SampleThreadPool::Job::JobStatus SampleMap::HotSwapJob::runJob()
+{
+	PoolReference ref;
+
+	{
+		SpinLock::ScopedLockType sl(pendingLock);
+		ref = pendingReference;
+		pendingReference = PoolReference();
 	}
-	else
+
+	if (ref.isValid() && !(ref == parent.getReference()))
+		loadInBackground(ref);
+
+	releaseRetiredSounds();
+
+	return SampleThreadPool::Job::jobHasFinished;
+}
+
+void SampleMap::HotSwapJob::timerCallback()
+{
+	bool hasPendingReference = false;
+
+	{
+		SpinLock::ScopedLockType sl(pendingLock);
+		hasPendingReference = pendingReference.isValid();
+	}
+
+	if (hasPendingReference || hasReleasableSounds())
+		addToQueue();
+
+	ScopedLock sl(retiredLock);
+
+	if (!hasPendingReference && retiredSounds.isEmpty())
+		stopTimer();
+}
+
+bool SampleMap::HotSwapJob::canHotSwap(const ValueTree& v, SampleMapPool* newPool) const
+{
+	auto sampler = parent.getSampler();
+
+	// The new sounds will be added to the sample pool of the current file handler
+	if (parent.getFileHandlerForPool(newPool) != parent.getCurrentFileHandler())
+		return false;
+
+	if (sampler->getAttribute(ModulatorSampler::Purged) > 0.5f)
+		return false;
+
+	StringArray micPositions = StringArray::fromTokens(v.getProperty("MicPositions").toString(), ";", "");
+	micPositions.removeEmptyStrings(true);
+
+	// The voices can't change their channel amount while they are playing
+	if (micPositions.isEmpty())
+		return sampler->getNumMicPositions() == jmax<int>(1, v.getChild(0).getNumChildren());
+
+	if (micPositions.size() != sampler->getNumMicPositions())
+		return false;
+
+	for (int i = 0; i < micPositions.size(); i++)
+	{
+		if (micPositions[i] != sampler->getChannelData(i).suffix)
+			return false;
+	}
+
+	return true;
+}
+
+void SampleMap::HotSwapJob::loadInBackground(const PoolReference& ref)
+{
+	auto sampler = parent.getSampler();
+	auto mc = sampler->getMainController();
+
+	SampleMapPool* newPool = nullptr;
+	auto newData = parent.loadFromPool(ref, newPool);
+
+	if (!newData)
+	{
 		jassertfalse;
+		return;
+	}
 
-	sendSampleMapChangeMessage();
+	auto v = newData.getData()->createCopy();
+
+	if (!canHotSwap(v, newPool))
+	{
+		auto f = [ref](Processor* p)
+		{
+			static_cast<ModulatorSampler*>(p)->loadSampleMap(ref);
+			return SafeFunctionCall::OK;
+		};
+
+		sampler->killAllVoicesAndCall(f, true);
+		return;
+	}
+
+	auto logError = [sampler](const String& message)
+	{
+#if USE_BACKEND
+		debugToConsole(sampler, message);
+#else
+		ignoreUnused(message);
+		sampler->getMainController()->sendOverlayMessage(OverlayMessageBroadcaster::SamplesNotFound);
+#endif
+	};
+
+	HlacMonolithInfo::Ptr newMonolith;
+
+	if ((int)v.getProperty("SaveMode", 0) == SaveMode::Monolith)
+	{
+		newMonolith = parent.loadMonolith(v, false);
+
+		if (newMonolith == nullptr)
+		{
+			logError("Can't find monolith");
+			return;
+		}
+	}
+
+	if (shouldExit())
+		return;
+
+	// The sounds are only changed on this thread so we can access them directly
+	for (int i = 0; i < sampler->getNumSounds(); i++)
+	{
+		auto sound = static_cast<ModulatorSamplerSound*>(sampler->getSound(i));
+
+		for (int j = 0; j < sound->getNumMultiMicSamples(); j++)
+			outgoingSamples.insert(sound->getReferenceToSound(j).get());
+	}
+
+	{
+		ScopedLock sl(retiredLock);
+
+		for (auto s : retiredSounds)
+		{
+			auto sound = static_cast<ModulatorSamplerSound*>(s);
+
+			for (int j = 0; j < sound->getNumMultiMicSamples(); j++)
+				outgoingSamples.insert(sound->getReferenceToSound(j).get());
+		}
+	}
+
+	ReferenceCountedArray<SynthesiserSound> newSounds;
+	newSounds.ensureStorageAllocated(v.getNumChildren());
+
+	const int preloadSize = (int)sampler->getAttribute(ModulatorSampler::PreloadSize);
+	const bool isReversed = sampler->getAttribute(ModulatorSampler::Reversed) > 0.5f;
+	const float gamma = (float)v.getProperty("CrossfadeGamma", 1.0);
+	const int numMicPositions = sampler->getNumMicPositions();
 
+	auto& progress = mc->getSampleManager().getPreloadProgress();
+	auto numSamples = (double)(jmax<int>(1, v.getNumChildren()));
+
+	int maxGroup = 1;
+
+	try
+	{
+		for (auto c : v)
+		{
+			if (shouldExit())
+			{
+				outgoingSamples.clear();
+				return;
+			}
+
+			progress = (double)newSounds.size() / numSamples;
+
+			auto newSound = new ModulatorSamplerSound(&parent, c, newMonolith.get());
+			newSounds.add(newSound);
+
+			maxGroup = jmax<int>(maxGroup, newSound->getSampleProperty(SampleIds::RRGroup));
+
+			for (int i = 0; i < newSound->getNumMultiMicSamples(); i++)
+			{
+				if (auto s = newSound->getReferenceToSound(i))
+					s->setCrossfadeGammaValue(gamma);
+
+				if (numMicPositions > 1)
+					newSound->setChannelPurged(i, !sampler->getChannelData(i).enabled);
+			}
+
+			newSound->initPreloadBuffer(preloadSize);
+			newSound->setReversed(isReversed);
+		}
+	}
+	catch (String& s)
+	{
+		outgoingSamples.clear();
+		logError(s);
+		return;
+	}
+	catch (StreamingSamplerSound::LoadingError& l)
+	{
+		outgoingSamples.clear();
+		logError("Error at loading sample " + l.fileName + ": " + l.errorDescription);
+		return;
+	}
+
+	outgoingSamples.clear();
+
+	if (shouldExit())
+		return;
+
+	for (auto s : newSounds)
+		static_cast<ModulatorSamplerSound*>(s)->setMaxRRGroupIndex(maxGroup);
+
+	parent.swapValueTree(v);
+	parent.mode.referTo(parent.data, "SaveMode", nullptr);
+
+	const String sampleMapName = v.getProperty("ID");
+	parent.sampleMapId = sampleMapName.isEmpty() ? Identifier::null : Identifier(sampleMapName);
+
+	parent.currentMonolith = newMonolith;
+
+	if (parent.currentPool != nullptr)
+		parent.currentPool->removeListener(&parent);
+
+	parent.currentPool = newPool;
+	parent.sampleMapData = newData;
+	parent.currentPool->addListener(&parent);
+
+	parent.changeWatcher = new ChangeWatcher(parent.data);
+
+	sampler->swapSounds(newSounds);
+
+	{
+		ScopedLock sl(retiredLock);
+
+		for (auto s : newSounds)
+		{
+			static_cast<ModulatorSamplerSound*>(s)->setDeletePending();
+			retiredSounds.add(s);
+		}
+	}
+
+	newSounds.clear();
+
+	sampler->setRRGroupAmount(maxGroup, false);
+	if (!sampler->isRoundRobinEnabled()) sampler->refreshRRMap();
+
+	sampler->refreshMemoryUsage();
+	progress = 0.0;
+
+	parent.notifier.sendSampleAmountChangeMessage(sendNotificationAsync);
+	parent.sendSampleMapChangeMessage();
+	sampler->sendChangeMessage();
+	parent.getCurrentSamplePool()->sendChangeMessage();
+
+	startTimer(200);
+}
+
+bool SampleMap::HotSwapJob::hasReleasableSounds() const
+{
+	ScopedLock sl(retiredLock);
+
+	// If the sound is not referenced by a voice anymore, this array holds the last reference
+	for (auto s : retiredSounds)
+	{
+		if (s->getReferenceCount() == 1)
+			return true;
+	}
+
+	return false;
+}
+
+void SampleMap::HotSwapJob::releaseRetiredSounds()
+{
+	ReferenceCountedArray<SynthesiserSound> soundsToDelete;
+
+	{
+		ScopedLock sl(retiredLock);
+
+		for (int i = retiredSounds.size() - 1; i >= 0; i--)
+		{
+			if (retiredSounds.getObjectPointerUnchecked(i)->getReferenceCount() == 1)
+				soundsToDelete.add(retiredSounds.removeAndReturn(i));
+		}
+	}
+
+	if (!soundsToDelete.isEmpty())
+	{
+		soundsToDelete.clear();
+		parent.getCurrentSamplePool()->clearUnreferencedMonoliths();
+		parent.getSampler()->refreshMemoryUsage();
+	}
 }
 
 void SampleMap::loadUnsavedValueTree(const ValueTree& v)
@@ -1234,10 +1552,7 @@ juce::AudioFormatWriter* MonolithExporter::createWriter(hlac::HiseLosslessAudioF
 
 	FileOutputStream* hlacOutput = new FileOutputStream(outputFile);
 
-	auto options = hlac::HlacEncoder::CompressorOptions::getPreset(hlac::HlacEncoder::CompressorOptions::Presets::Diff);
-
-	options.applyDithering = false;
-	options.normalisationMode = (uint8)getComboBoxComponent("normalise")->getSelectedItemIndex();
+	auto options = getCompressorOptions();
 
 	StringPairArray empty;
 
@@ -1252,6 +1567,16 @@ juce::AudioFormatWriter* MonolithExporter::createWriter(hlac::HiseLosslessAudioF
 	return writer.release();
 }
 
+hlac::HlacEncoder::CompressorOptions MonolithExporter::getCompressorOptions()
+{
+	auto options = hlac::HlacEncoder::CompressorOptions::getPreset(hlac::HlacEncoder::CompressorOptions::Presets::Diff);
+
+	options.applyDithering = false;
+	options.normalisationMode = (uint8)getComboBoxComponent("normalise")->getSelectedItemIndex();
+
+	return options;
+}
+
 int64 MonolithExporter::getNumBytesForSplitSize() const
 {
 	auto mb = getComboBoxComponent("splitsize")->getText().getIntValue();
@@ -1387,6 +1712,10 @@ void MonolithExporter::writeFiles(int channelIndex, bool overwriteExistingData)
 
 		int64 numBytesWritten = 0;
 
+		// The files are encoded on multiple threads and appended in the original order
+		// so the monolith (and the split positions) will be the same as with a single thread.
+		hlac::HlacParallelEncoder parallelEncoder(*channelList, isMono ? 1 : 2, sampleRate, getCompressorOptions());
+
 		for (int i = 0; i < channelList->size(); i++)
 		{
 			auto s = channelList->getUnchecked(i);
@@ -1398,19 +1727,19 @@ void MonolithExporter::writeFiles(int channelIndex, bool overwriteExistingData)
             if(threadShouldExit())
                 return;
             
-			ScopedPointer<AudioFormatReader> reader = afm.createReaderFor(s);
+			auto hWriter = dynamic_cast<hlac::HiseLosslessAudioFormatWriter*>(writer.get());
 
-			if (reader != nullptr)
+			jassert(hWriter != nullptr);
+
+			if (parallelEncoder.appendFile(i, *hWriter, getCurrentThread()))
 			{
-				writer->writeFromAudioReader(*reader, 0, -1);
-				
-				if (auto hWriter = dynamic_cast<hlac::HiseLosslessAudioFormatWriter*>(writer.get()))
-				{
-					numBytesWritten = hWriter->getNumBytesWritten();
-				}
+				numBytesWritten = hWriter->getNumBytesWritten();
 			}
 			else
 			{
+				if (threadShouldExit())
+					return;
+
 				error = "Could not read the source file " + s.getFullPathName();
 				writer->flush();
 				writer = nullptr;
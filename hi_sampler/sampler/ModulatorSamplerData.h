@@ -126,6 +126,21 @@ public:
 
 	void load(const PoolReference& reference);
 
+	/** Loads the sample map in the background without killing the voices.
+	*
+	*	The new sounds are created and preloaded on the sample loading thread and then swapped with the
+	*	current sounds. New notes will use the new sample map, while the voices that are still playing
+	*	keep their old sound until they are finished. If the new sample map needs a different mic position
+	*	layout, it will fall back to the default loading procedure (which kills all voices).
+	*
+	*	You can call this from any thread except the audio thread. If you call it multiple times before
+	*	the sample loading thread picks it up, only the last sample map will be loaded.
+	*/
+	void loadWithHotSwap(const PoolReference& reference);
+
+	/** Returns true if the given sample is used by a sound that is about to be replaced by a hot swap. */
+	bool isUsedByOutgoingSounds(const StreamingSamplerSound* s) const;
+
 	void loadUnsavedValueTree(const ValueTree& v);
 
 	/** Saves all data with the mode depending on the file extension. */
@@ -321,9 +336,72 @@ private:
 		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChangeWatcher);
 	};
 
+	/** Builds and publishes the sounds of a hot swapped sample map on the sample loading thread.
+
+		The sounds of the previous sample map are kept alive until no voice is playing them anymore.
+	*/
+	class HotSwapJob : public SampleThreadPool::Job,
+					   private Timer
+	{
+	public:
+
+		HotSwapJob(SampleMap& parent_);
+
+		~HotSwapJob();
+
+		void loadSampleMap(const PoolReference& ref);
+
+		JobStatus runJob() override;
+
+		bool isUsedByOutgoingSounds(const StreamingSamplerSound* s) const
+		{
+			return outgoingSamples.find(s) != outgoingSamples.end();
+		}
+
+	private:
+
+		void timerCallback() override;
+
+		void addToQueue();
+
+		bool canHotSwap(const ValueTree& v, SampleMapPool* newPool) const;
+
+		void loadInBackground(const PoolReference& ref);
+
+		void releaseRetiredSounds();
+
+		bool hasReleasableSounds() const;
+
+		SampleMap& parent;
+
+		SpinLock pendingLock;
+		PoolReference pendingReference;
+
+		// A hash set because this is checked for every sample of the new sample map
+		std::unordered_set<const StreamingSamplerSound*> outgoingSamples;
+		ReferenceCountedArray<SynthesiserSound> retiredSounds;
+		CriticalSection retiredLock;
+
+		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(HotSwapJob);
+	};
+
 	void setCurrentMonolith();
 
-	
+	/** Returns the monolith for the given sample map data and loads it if necessary.
+
+		If allowSamplerChanges is false, it will not change the mic positions of the sampler or delete the sounds on failure.
+	*/
+	HlacMonolithInfo::Ptr loadMonolith(const ValueTree& v, bool allowSamplerChanges);
+
+	/** Resolves the pool that contains the given reference (respecting expansions) and loads the sample map data from there. */
+	PooledSampleMap loadFromPool(const PoolReference& reference, SampleMapPool*& poolToUse);
+
+	FileHandlerBase* getFileHandlerForPool(SampleMapPool* p) const;
+
+	/** Replaces the data and updates the listeners without touching the sounds. */
+	void swapValueTree(const ValueTree& v);
+
+	ScopedPointer<HotSwapJob> hotSwapJob;
 
 	bool delayNotifications = false;
 	bool notificationPending = false;
@@ -552,6 +630,8 @@ private:
 
 	AudioFormatWriter* createWriter(hlac::HiseLosslessAudioFormat& hlaf, const File& f, bool isMono);
 
+	hlac::HlacEncoder::CompressorOptions getCompressorOptions();
+
 	/** The max monolith size is 2GB - 60MB (to guarantee to stay below 2GB for FAT32. */
 	//constexpr static int maxMonolithSize = 2084569088;
 
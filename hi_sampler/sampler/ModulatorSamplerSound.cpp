@@ -90,7 +90,8 @@ void ModulatorSamplerSound::loadSampleFromValueTree(const ValueTree& sampleData,
 
 	auto existingSample = pool->getSampleFromPool(ref);
 
-	if (existingSample != nullptr && existingSample->isMonolithic() != (hmaf != nullptr))
+	// A hot swap must not change the samples that are still played by the voices of the old sample map
+	if (existingSample != nullptr && (existingSample->isMonolithic() != (hmaf != nullptr) || parentMap->isUsedByOutgoingSounds(existingSample)))
 	{
 		pool->removeFromPool(ref);
 		existingSample = nullptr;
@@ -752,6 +753,15 @@ void ModulatorSamplerSound::updateInternalData(const Identifier& id, const var&
 			}
 		}
 
+		const bool mappingChanged = id == SampleIds::LoKey || id == SampleIds::HiKey || id == SampleIds::LoVel ||
+									id == SampleIds::HiVel || id == SampleIds::RRGroup;
+
+		if (mappingChanged && parentMap != nullptr)
+		{
+			if (auto s = parentMap->getSampler())
+				s->invalidateSoundLookupTable();
+		}
+
 		loadEntireSampleIfMaxPitch();
 	}
 	else
@@ -973,7 +983,9 @@ hise::HlacMonolithInfo* ModulatorSamplerSoundPool::getMonolith(const Identifier&
 
 HlacMonolithInfo::Ptr ModulatorSamplerSoundPool::loadMonolithicData(const ValueTree &sampleMap, const Array<File>& monolithicFiles)
 {
-	jassert(!mc->getMainSynthChain()->areVoicesActive());
+	// A hot swapped sample map loads its monolith while the voices are playing. This is fine because the
+	// monoliths that are still in use are referenced by their sounds and will not be cleared here.
+	jassert(!mc->getMainSynthChain()->areVoicesActive() || mc->getKillStateHandler().getCurrentThread() == MainController::KillStateHandler::SampleLoadingThread);
 
 	clearUnreferencedMonoliths();
 	
@@ -77,6 +77,7 @@ void ModulatorSamplerVoice::startNote(int midiNoteNumber,
 
 	wrappedVoice.setPitchFactor(midiNoteNumber, samePitch ? midiNoteNumber : currentlyPlayingSamplerSound->getRootNote(), sound.get(), getOwnerSynth()->getMainController()->getGlobalPitchFactor());
 	wrappedVoice.setSampleStartModValue(sampleStartModulationDelta);
+	wrappedVoice.setInterpolationMode(sampler->getInterpolationMode());
 	wrappedVoice.startNote(midiNoteNumber, velocity, sound.get(), -1);
 
 	voiceUptime = wrappedVoice.voiceUptime;
@@ -440,6 +441,7 @@ void MultiMicModulatorSamplerVoice::startNote(int midiNoteNumber, float velocity
 
 		voiceToUse->setPitchFactor(midiNoteNumber, rootNote, micSound.get(), globalPitchFactor);
 		voiceToUse->setSampleStartModValue(sampleStartModulationDelta);
+		voiceToUse->setInterpolationMode(sampler->getInterpolationMode());
 		voiceToUse->startNote(midiNoteNumber, velocity, micSound.get(), -1);
 
 		voiceUptime = wrappedVoices[i]->voiceUptime;
@@ -68,6 +68,15 @@ compile / debug cycle and don't need all nodes in scriptnode you might want to t
 #define HISE_SCRIPT_SERVER_TIMEOUT 10000
 #endif
 
+/** The number of worker threads that execute the low priority callbacks (timers and paint routines).
+	If this is zero, they will be executed on the scripting thread together with the high priority callbacks.
+
+	Every callback still acquires the global script lock, so the workers never run script code in parallel.
+	They only schedule the callbacks of different processors in turns and step back for high priority tasks. */
+#ifndef HISE_NUM_SCRIPTING_WORKERS
+#define HISE_NUM_SCRIPTING_WORKERS 2
+#endif
+
 #define MAX_SCRIPT_HEIGHT 700
 
 #include "AppConfig.h"
@@ -97,6 +106,7 @@ compile / debug cycle and don't need all nodes in scriptnode you might want to t
 #include "scripting/scriptnode/api/Properties.h"
 #include "scripting/scriptnode/api/NodeBase.h"
 #include "scripting/scriptnode/api/DspNetwork.h"
+#include "scripting/scriptnode/api/NetworkProfiler.h"
 
 #if USE_BACKEND
 #include "scripting/scriptnode/api/TestClasses.h"
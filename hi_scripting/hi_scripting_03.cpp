@@ -69,6 +69,7 @@
 
 #include "scripting/scriptnode/api/ModulationSourceNode.cpp"
 #include "scripting/scriptnode/api/DspNetwork.cpp"
+#include "scripting/scriptnode/api/NetworkProfiler.cpp"
 
 #if USE_BACKEND
 #include "scripting/scriptnode/api/TestClasses.cpp"
@@ -1746,9 +1746,123 @@ JavascriptThreadPool::JavascriptThreadPool(MainController* mc) :
 #endif
 	globalServer(new GlobalServer(mc))
 {
+	for (int i = 0; i < HISE_NUM_SCRIPTING_WORKERS; i++)
+	{
+		auto w = workers.add(new LowPriorityWorker(*this, i));
+		w->startThread(5);
+	}
+
 	startThread(6);
 }
 
+JavascriptThreadPool::ExecutionState& JavascriptThreadPool::getExecutionState() const noexcept
+{
+	auto threadId = Thread::getCurrentThreadId();
+
+	for (auto w : workers)
+	{
+		if (w->getThreadId() == threadId)
+			return w->state;
+	}
+
+	return mainThreadState;
+}
+
+Array<Thread::ThreadID> JavascriptThreadPool::getWorkerThreadIds() const
+{
+	Array<Thread::ThreadID> ids;
+
+	for (auto w : workers)
+		ids.add(w->getThreadId());
+
+	return ids;
+}
+
+void JavascriptThreadPool::stopWorkers()
+{
+	for (auto w : workers)
+		w->signalThreadShouldExit();
+
+	for (auto w : workers)
+	{
+		w->notify();
+		w->stopThread(1000);
+	}
+}
+
+JavascriptThreadPool::TaskMetrics JavascriptThreadPool::getTaskMetrics(Task::Type t) const
+{
+	TaskMetrics m;
+
+	switch (t)
+	{
+	case Task::Compilation:					 m.queueDepth = compilationQueue.size(); break;
+	case Task::HiPriorityCallbackExecution:  m.queueDepth = highPriorityQueue.size(); break;
+	case Task::LowPriorityCallbackExecution: m.queueDepth = lowPriorityQueue.size() + numStrandTasks.load(); break;
+	case Task::DeferredPanelRepaintJob:		 m.queueDepth = deferredPanels.size(); break;
+#if USE_BACKEND
+	case Task::ReplEvaluation:				 m.queueDepth = replQueue.size(); break;
+#endif
+	default:								 m.queueDepth = 0; break;
+	}
+
+	const auto& s = statistics[t];
+
+	m.numExecuted = s.numExecuted.load();
+
+	if (m.numExecuted > 0)
+	{
+		auto toMs = [](int64 ticks) { return 1000.0 * Time::highResolutionTicksToSeconds(ticks); };
+
+		m.averageLatencyMs = toMs(s.totalLatencyTicks.load()) / (double)m.numExecuted;
+		m.maxLatencyMs = toMs(s.maxLatencyTicks.load());
+		m.averageExecutionMs = toMs(s.totalExecutionTicks.load()) / (double)m.numExecuted;
+		m.maxExecutionMs = toMs(s.maxExecutionTicks.load());
+	}
+
+	return m;
+}
+
+void JavascriptThreadPool::resetTaskMetrics()
+{
+	for (auto& s : statistics)
+		s.reset();
+}
+
+static void updateMaximum(std::atomic<int64>& value, int64 newValue) noexcept
+{
+	auto current = value.load();
+
+	while (newValue > current && !value.compare_exchange_weak(current, newValue))
+		;
+}
+
+void JavascriptThreadPool::TaskStatistics::addExecution(int64 creationTicks, int64 startTicks, int64 endTicks) noexcept
+{
+	auto latency = creationTicks != 0 ? jmax((int64)0, startTicks - creationTicks) : 0;
+	auto duration = endTicks - startTicks;
+
+	numExecuted++;
+	totalLatencyTicks += latency;
+	totalExecutionTicks += duration;
+	updateMaximum(maxLatencyTicks, latency);
+	updateMaximum(maxExecutionTicks, duration);
+}
+
+void JavascriptThreadPool::TaskStatistics::reset() noexcept
+{
+	numExecuted = 0;
+	totalLatencyTicks = 0;
+	maxLatencyTicks = 0;
+	totalExecutionTicks = 0;
+	maxExecutionTicks = 0;
+}
+
+void JavascriptThreadPool::addExecutionTime(const Task& t, int64 startTicks) noexcept
+{
+	statistics[t.getType()].addExecution(t.getCreationTicks(), startTicks, Time::getHighResolutionTicks());
+}
+
 void JavascriptThreadPool::addJob(Task::Type t, JavascriptProcessor* p, const Task::Function& f)
 {
 	WARN_IF_AUDIO_THREAD(true, IllegalAudioThreadOps::StringCreation);
@@ -1786,7 +1900,7 @@ void JavascriptThreadPool::addJob(Task::Type t, JavascriptProcessor* p, const Ta
 	{
 		jassert(isBusy());
 		
-		if (t == currentType)
+		if (t == getCurrentTask())
 		{
 			// Same priority, just run it
 			executeNow(t, p, f);
@@ -1839,8 +1953,10 @@ void JavascriptThreadPool::addJob(Task::Type t, JavascriptProcessor* p, const Ta
 
 void JavascriptThreadPool::addDeferredPaintJob(ScriptingApi::Content::ScriptPanel* sp)
 {
-	WeakReference<ScriptingApi::Content::ScriptPanel> spWeak(sp);
-	deferredPanels.push(std::move(spWeak));
+	DeferredPanel dp;
+	dp.panel = sp;
+	dp.creationTicks = Time::getHighResolutionTicks();
+	deferredPanels.push(std::move(dp));
 }
 
 Result JavascriptThreadPool::executeQueue(const Task::Type& t, PendingCompilationList& pendingCompilations)
@@ -1867,12 +1983,14 @@ Result JavascriptThreadPool::executeQueue(const Task::Type& t, PendingCompilatio
             SimpleReadWriteLock::ScopedWriteLock sl(getLookAndFeelRenderLock());
 			SuspendHelpers::ScopedTicket ticket;
 
-			lowPriorityQueue.clear();
+			clearLowPriorityTasks();
 			highPriorityQueue.clear();
 
 			killVoicesAndExtendTimeOut(ct.getFunction().getProcessor());
 
+			auto start = Time::getHighResolutionTicks();
 			r = ct.call();
+			addExecutionTime(ct.getFunction(), start);
 
 			pendingCompilations.addIfNotAlreadyThere(ct.getFunction().getProcessor());
 		}
@@ -1891,7 +2009,9 @@ Result JavascriptThreadPool::executeQueue(const Task::Type& t, PendingCompilatio
             if (alreadyCompiled(hpt))
                 continue;
 
+            auto start = Time::getHighResolutionTicks();
             r = hpt.call();
+            addExecutionTime(hpt.getFunction(), start);
         }
 #endif
 
@@ -1914,11 +2034,13 @@ Result JavascriptThreadPool::executeQueue(const Task::Type& t, PendingCompilatio
 			if (alreadyCompiled(hpt))
 				continue;
 
+			auto start = Time::getHighResolutionTicks();
 			r = hpt.call();
+			addExecutionTime(hpt.getFunction(), start);
 		}
 
 		if (!r.wasOk())
-			lowPriorityQueue.clear();
+			clearLowPriorityTasks();
 
 		return r;
 	}
@@ -1940,22 +2062,28 @@ Result JavascriptThreadPool::executeQueue(const Task::Type& t, PendingCompilatio
 			if (alreadyCompiled(lpt))
 				continue;
 
+			auto start = Time::getHighResolutionTicks();
 			r = lpt.call();
+			addExecutionTime(lpt.getFunction(), start);
 		}
 
 		if (!r.wasOk())
 			lowPriorityQueue.clear();
 
-		WeakReference<ScriptingApi::Content::ScriptPanel> sp;
+		DeferredPanel dp;
 
 		if (r.wasOk())
 		{
-			while (deferredPanels.pop(sp))
+			while (deferredPanels.pop(dp))
 			{
-				ScopedValueSetter<bool> svs(busy, true);
+				ScopedValueSetter<bool> svs(getExecutionState().busy, true);
+
+				auto start = Time::getHighResolutionTicks();
+
+				if (dp.panel.get() != nullptr)
+					dp.panel->repaint();
 
-				if (sp.get() != nullptr)
-					sp->repaint();
+				statistics[Task::DeferredPanelRepaintJob].addExecution(dp.creationTicks, start, Time::getHighResolutionTicks());
 			}
 		}
 		else
@@ -1979,7 +2107,23 @@ void JavascriptThreadPool::run()
 		Array<WeakReference<JavascriptProcessor>> compiledProcessors;
 		compiledProcessors.ensureStorageAllocated(16);
 
-		auto r = executeQueue(Task::LowPriorityCallbackExecution, compiledProcessors);
+		Result r = Result::ok();
+
+		if (workers.isEmpty())
+		{
+			r = executeQueue(Task::LowPriorityCallbackExecution, compiledProcessors);
+		}
+		else
+		{
+			// The low priority tasks are executed by the workers, which
+			// will step back as long as this thread is active.
+			mainThreadActive = true;
+			r = executeQueue(Task::HiPriorityCallbackExecution, compiledProcessors);
+			mainThreadActive = false;
+
+			for (auto w : workers)
+				w->notify();
+		}
 		
 		if (!r.wasOk() && r.getErrorMessage() != "Engine is dangling")
 		{
@@ -1990,6 +2134,189 @@ void JavascriptThreadPool::run()
 	}
 }
 
+void JavascriptThreadPool::LowPriorityWorker::run()
+{
+	while (!threadShouldExit())
+	{
+		if (!parent.executeNextLowPriorityTask(state))
+			wait(500);
+	}
+}
+
+bool JavascriptThreadPool::hasPendingHiPriorityTasks() const noexcept
+{
+	if (mainThreadActive.load() || !compilationQueue.isEmpty() || !highPriorityQueue.isEmpty())
+		return true;
+
+#if USE_BACKEND
+	if (!replQueue.isEmpty())
+		return true;
+#endif
+
+	return false;
+}
+
+void JavascriptThreadPool::dispatchLowPriorityTasks(ExecutionState& state)
+{
+	{
+		ScopedLock sl(strandLock);
+
+		CallbackTask lpt;
+
+		while (lowPriorityQueue.pop(lpt))
+		{
+			const auto& t = lpt.getFunction();
+
+			jassert(!t.isHiPriority());
+
+			Strand* strand = nullptr;
+
+			for (auto s : strands)
+			{
+				if (s->processor == t.getProcessor())
+				{
+					strand = s;
+					break;
+				}
+			}
+
+			if (strand == nullptr)
+			{
+				strand = strands.add(new Strand());
+				strand->processor = t.getProcessor();
+			}
+
+			strand->tasks.add(t);
+			numStrandTasks++;
+		}
+	}
+
+	// The deferred repaints are only dispatched by the first worker so that a panel
+	// is never repainted by two threads at the same time.
+	if (workers.isEmpty() || &state != &workers.getFirst()->state)
+		return;
+
+	DeferredPanel dp;
+	Array<ScriptingApi::Content::ScriptPanel*> repaintedPanels;
+
+	while (deferredPanels.pop(dp))
+	{
+		auto panel = dp.panel.get();
+
+		if (panel == nullptr || repaintedPanels.contains(panel))
+			continue;
+
+		repaintedPanels.add(panel);
+
+		// The repaint will add a low priority task to the queue
+		ScopedValueSetter<bool> svs(state.busy, true);
+		ScopedValueSetter<Task::Type> svs2(state.currentType, Task::DeferredPanelRepaintJob);
+
+		auto start = Time::getHighResolutionTicks();
+
+		panel->repaint();
+
+		statistics[Task::DeferredPanelRepaintJob].addExecution(dp.creationTicks, start, Time::getHighResolutionTicks());
+	}
+}
+
+bool JavascriptThreadPool::executeNextLowPriorityTask(ExecutionState& state)
+{
+	if (hasPendingHiPriorityTasks())
+		return false;
+
+	dispatchLowPriorityTasks(state);
+
+	Strand* strand = nullptr;
+	Task task;
+	uint32 epoch = 0;
+
+	{
+		ScopedLock sl(strandLock);
+
+		for (int i = 0; i < strands.size(); i++)
+		{
+			auto index = (nextStrandIndex + i) % strands.size();
+			auto s = strands[index];
+
+			if (!s->running && !s->tasks.isEmpty())
+			{
+				strand = s;
+				nextStrandIndex = index + 1;
+				break;
+			}
+		}
+
+		if (strand == nullptr)
+			return false;
+
+		task = strand->tasks.removeAndReturn(0);
+		numStrandTasks--;
+		strand->running = true;
+		epoch = compilationEpoch;
+	}
+
+	Result r = Result::ok();
+
+	{
+		LockHelpers::SafeLock sl(getMainController(), LockHelpers::ScriptLock);
+
+		bool wasCleared;
+
+		{
+			ScopedLock sl2(strandLock);
+			wasCleared = epoch != compilationEpoch;
+		}
+
+		if (!wasCleared)
+		{
+			auto start = Time::getHighResolutionTicks();
+			r = task.callWithResult();
+			addExecutionTime(task, start);
+		}
+	}
+
+	{
+		ScopedLock sl(strandLock);
+
+		strand->running = false;
+
+		// Only discard the pending tasks of the processor that caused the error
+		if (!r.wasOk())
+		{
+			numStrandTasks -= strand->tasks.size();
+			strand->tasks.clearQuick();
+		}
+
+		if (strand->tasks.isEmpty())
+			strands.removeObject(strand);
+	}
+
+	if (!r.wasOk() && r.getErrorMessage() != "Engine is dangling")
+		debugError(getMainController()->getMainSynthChain(), r.getErrorMessage());
+
+	return true;
+}
+
+void JavascriptThreadPool::clearLowPriorityTasks()
+{
+	ScopedLock sl(strandLock);
+
+	lowPriorityQueue.clear();
+
+	// The strands that are currently executed will be removed by their worker
+	for (int i = strands.size() - 1; i >= 0; i--)
+	{
+		strands[i]->tasks.clearQuick();
+
+		if (!strands[i]->running)
+			strands.remove(i);
+	}
+
+	numStrandTasks = 0;
+	compilationEpoch++;
+}
+
 void JavascriptThreadPool::killVoicesAndExtendTimeOut(JavascriptProcessor* jp, int milliseconds)
 {
 	if (!getMainController()->isInitialised())
@@ -2010,6 +2337,10 @@ void JavascriptThreadPool::pushToQueue(const Task::Type& t, JavascriptProcessor*
 	case Task::LowPriorityCallbackExecution:
 	{
 		lowPriorityQueue.push({ Task(t, p, f), getMainController() });
+
+		for (auto w : workers)
+			w->notify();
+
 		break;
 	}
 	case Task::HiPriorityCallbackExecution:
@@ -2055,8 +2386,10 @@ Result JavascriptThreadPool::Task::callWithResult()
 
 		LockHelpers::SafeLock sl(parent.getMainController(), LockHelpers::ScriptLock);
 
-		ScopedValueSetter<bool> svs(parent.busy, true);
-		ScopedValueSetter<Task::Type> svs2(parent.currentType, type);
+		auto& state = parent.getExecutionState();
+
+		ScopedValueSetter<bool> svs(state.busy, true);
+		ScopedValueSetter<Task::Type> svs2(state.currentType, type);
 
 		try
 		{
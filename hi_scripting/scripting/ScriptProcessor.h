@@ -835,16 +835,20 @@ public:
 	~JavascriptThreadPool()
 	{
 		globalServer = nullptr;
+		stopWorkers();
 		stopThread(1000);
 	}
 
 	void cancelAllJobs()
 	{
+		// The workers might wait for the script lock so they need to be stopped first
+		stopWorkers();
+
 		LockHelpers::SafeLock ss(getMainController(), LockHelpers::ScriptLock);
 
 		stopThread(1000);
 		compilationQueue.clear();
-		lowPriorityQueue.clear();
+		clearLowPriorityTasks();
 		highPriorityQueue.clear();
 		deferredPanels.clear();
 	}
@@ -875,7 +879,8 @@ public:
 		Task(Type t, JavascriptProcessor* jp_, const Function& functionToExecute) noexcept:
 			type(t),
 			f(functionToExecute),
-			jp(jp_)
+			jp(jp_),
+			creationTicks(Time::getHighResolutionTicks())
 		{}
 
 		JavascriptProcessor* getProcessor() const noexcept { return jp.get(); };
@@ -888,13 +893,37 @@ public:
 
 		bool isHiPriority() const noexcept { return type == Compilation || type == HiPriorityCallbackExecution; }
 
+		/** The time when the task was added to the queue. */
+		int64 getCreationTicks() const noexcept { return creationTicks; }
+
 	private:
 
 		Type type;
 		WeakReference<JavascriptProcessor> jp;
 		Function f;
+		int64 creationTicks = 0;
+	};
+
+	/** The queue depth and timing information of a task type. */
+	struct TaskMetrics
+	{
+		int queueDepth = 0;
+		int64 numExecuted = 0;
+
+		double averageLatencyMs = 0.0;	///< the time between adding a task and its execution
+		double maxLatencyMs = 0.0;
+		double averageExecutionMs = 0.0;
+		double maxExecutionMs = 0.0;
 	};
 
+	/** Returns the metrics of the given task type since the last call to resetTaskMetrics(). */
+	TaskMetrics getTaskMetrics(Task::Type t) const;
+
+	void resetTaskMetrics();
+
+	/** Returns the thread IDs of the low priority workers. They will be treated as scripting thread. */
+	Array<Thread::ThreadID> getWorkerThreadIds() const;
+
 	void addJob(Task::Type t, JavascriptProcessor* p, const Task::Function& f);
 
 	void addDeferredPaintJob(ScriptingApi::Content::ScriptPanel* sp);
@@ -903,9 +932,11 @@ public:
 
 	const CriticalSection& getLock() const noexcept { return scriptLock; };
 
-	bool isBusy() const noexcept { return busy; }
+	/** Returns true if the calling thread is currently executing a task. */
+	bool isBusy() const noexcept { return getExecutionState().busy; }
 
-	Task::Type getCurrentTask() const noexcept { return currentType; }
+	/** Returns the type of the task that the calling thread is currently executing. */
+	Task::Type getCurrentTask() const noexcept { return getExecutionState().currentType; }
 
 	void killVoicesAndExtendTimeOut(JavascriptProcessor* jp, int milliseconds=1000);
 
@@ -996,7 +1027,7 @@ public:
 		{
 			p.isSleeping = wasSleeping;
 
-			p.lowPriorityQueue.clear();
+			p.clearLowPriorityTasks();
 			p.highPriorityQueue.clear();
 			
 			sendMessage(false);
@@ -1039,9 +1070,87 @@ private:
 	Result executeQueue(const Task::Type& t, PendingCompilationList& pendingCompilations);
 
 	std::atomic<bool> pending;
-	
-	bool busy = false;
-	Task::Type currentType;
+
+	struct ExecutionState
+	{
+		bool busy = false;
+		Task::Type currentType = Task::Free;
+	};
+
+	/** Returns the state of the calling thread (the Javascript thread's state for all non-worker threads). */
+	ExecutionState& getExecutionState() const noexcept;
+
+	mutable ExecutionState mainThreadState;
+
+	/** A low priority worker that executes the tasks of one processor at a time. 
+
+		All tasks still acquire the script lock, so a worker will only run script code when
+		no other thread does. However the low priority tasks of different processors are
+		scheduled in turns instead of being drained in one loop and a worker will step back
+		as long as there are pending compilations or high priority callbacks.
+	*/
+	class LowPriorityWorker : public Thread
+	{
+	public:
+
+		LowPriorityWorker(JavascriptThreadPool& parent_, int index) :
+			Thread("Javascript Worker " + String(index + 1), HISE_DEFAULT_STACK_SIZE),
+			parent(parent_)
+		{}
+
+		void run() override;
+
+		JavascriptThreadPool& parent;
+		ExecutionState state;
+	};
+
+	/** The pending low priority tasks of a single processor. They are executed in the order they were added. */
+	struct Strand
+	{
+		JavascriptProcessor* processor = nullptr;
+		Array<Task> tasks;
+		bool running = false;
+	};
+
+	struct TaskStatistics
+	{
+		void addExecution(int64 creationTicks, int64 startTicks, int64 endTicks) noexcept;
+		void reset() noexcept;
+
+		std::atomic<int64> numExecuted { 0 };
+		std::atomic<int64> totalLatencyTicks { 0 };
+		std::atomic<int64> maxLatencyTicks { 0 };
+		std::atomic<int64> totalExecutionTicks { 0 };
+		std::atomic<int64> maxExecutionTicks { 0 };
+	};
+
+	/** Adds the timing of a task that was started at the given time to the statistics. */
+	void addExecutionTime(const Task& t, int64 startTicks) noexcept;
+
+	/** Moves the queued low priority tasks to their strands. The first worker also dispatches the deferred repaints. */
+	void dispatchLowPriorityTasks(ExecutionState& state);
+
+	bool executeNextLowPriorityTask(ExecutionState& state);
+
+	void clearLowPriorityTasks();
+
+	bool hasPendingHiPriorityTasks() const noexcept;
+
+	void stopWorkers();
+
+	TaskStatistics statistics[Task::numTypes];
+
+	OwnedArray<LowPriorityWorker> workers;
+
+	CriticalSection strandLock;
+	OwnedArray<Strand> strands;
+	int nextStrandIndex = 0;
+	std::atomic<int> numStrandTasks { 0 };
+
+	/** This will be bumped when the low priority tasks are cleared so that workers skip tasks that they claimed before. */
+	uint32 compilationEpoch = 0;
+
+	std::atomic<bool> mainThreadActive { false };
 
 	CriticalSection scriptLock;
 
@@ -1061,7 +1170,13 @@ private:
     MultithreadedLockfreeQueue<CallbackTask, queueConfig> replQueue;
 #endif
 
-	MultithreadedLockfreeQueue<WeakReference<ScriptingApi::Content::ScriptPanel>, queueConfig> deferredPanels;
+	struct DeferredPanel
+	{
+		WeakReference<ScriptingApi::Content::ScriptPanel> panel;
+		int64 creationTicks = 0;
+	};
+
+	MultithreadedLockfreeQueue<DeferredPanel, queueConfig> deferredPanels;
 };
 
 
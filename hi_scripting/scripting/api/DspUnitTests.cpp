@@ -351,6 +351,9 @@ private:
 		testSimpleEnvelopeWithAttack(false);
 		testSimpleEnvelopeWithAttack(true);
 
+		testVoiceBatch(false);
+		testVoiceBatch(true);
+
 		testAhdsrSustain(true);
 		testAhdsrSustain(false);
 
@@ -922,6 +925,55 @@ private:
 		bp = nullptr;
 	}
 
+	void testVoiceBatch(bool useLinearMode)
+	{
+		beginTest("Testing batched voice modulation" + String(useLinearMode ? " in linear mode" : ""));
+
+		Random r;
+
+		const int blockSize = 512;
+		const int numNotes = 12;
+
+		int noteOnOffsets[numNotes];
+		int noteOffOffsets[numNotes];
+
+		for (int i = 0; i < numNotes; i++)
+		{
+			noteOnOffsets[i] = r.nextInt(sampleRate / 2);
+			noteOffOffsets[i] = noteOnOffsets[i] + r.nextInt({ 1000, sampleRate });
+		}
+
+		auto render = [&](bool useBatch)
+		{
+			ScopedProcessor bp = Helpers::createAndInitialiseProcessor(NoiseSynth::DC);
+
+			Helpers::setAttribute<SimpleEnvelope>(bp, SimpleEnvelope::Attack, 30.0f);
+			Helpers::setAttribute<SimpleEnvelope>(bp, SimpleEnvelope::Release, 200.0f);
+			Helpers::setAttribute<SimpleEnvelope>(bp, SimpleEnvelope::LinearMode, useLinearMode ? 1.0f : 0.0f);
+
+			Helpers::get<NoiseSynth>(bp)->setUseVoiceBatch(useBatch);
+
+			auto testData = Helpers::createTestDataWithOneSecondNote();
+
+			for (int i = 0; i < numNotes; i++)
+			{
+				testData.midiBuffer.addEvent(MidiMessage::noteOn(1, 40 + i, 1.0f), noteOnOffsets[i]);
+				testData.midiBuffer.addEvent(MidiMessage::noteOff(1, 40 + i), noteOffOffsets[i]);
+			}
+
+			Helpers::process(bp, testData, blockSize);
+
+			bp = nullptr;
+
+			return testData;
+		};
+
+		auto expected = render(false);
+		auto actual = render(true);
+
+		expectResult(expected.matches(actual, this, -90.0f), "Batched voices don't match");
+	}
+
 	void expectResult(Result r, String errorMessage)
 	{
 		expect(r.wasOk(), errorMessage + " - " + r.getErrorMessage());
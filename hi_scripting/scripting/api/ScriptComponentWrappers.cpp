@@ -1995,6 +1995,14 @@ void ScriptCreatedComponentWrappers::PanelWrapper::updateComponent(int propertyI
 		PROPERTY_CASE::ScriptPanel::stepSize : updateRange(bpc); break;
 		PROPERTY_CASE::ScriptPanel::enabled: break;
 		PROPERTY_CASE::ScriptPanel::allowCallbacks: bpc->setAllowCallback(newValue.toString()); break;
+		PROPERTY_CASE::ScriptPanel::renderOffThread:
+		{
+			if (auto h = sc->getDrawActionHandler())
+				h->setRenderOffThread(newValue);
+
+			sc->repaint();
+			break;
+		}
 	}
 }
 
@@ -2175,6 +2183,9 @@ void ScriptCreatedComponentWrappers::PanelWrapper::initPanel(ScriptingApi::Conte
 	
     bp->setBufferedToImage(panel->getScriptObjectProperty(ScriptingApi::Content::ScriptPanel::bufferToImage));
 
+	if (auto h = panel->getDrawActionHandler())
+		h->setRenderOffThread(panel->getScriptObjectProperty(ScriptingApi::Content::ScriptPanel::renderOffThread));
+
 	component = bp;
 
 
@@ -44,6 +44,11 @@ struct ScriptedPostDrawActions
 			r.gaussianBlur(blurAmount);
 		}
 
+		void addToHash(DrawActions::HashBuilder& h) const override
+		{
+			h.add(blurAmount);
+		}
+
 		int blurAmount;
 	};
 
@@ -57,6 +62,11 @@ struct ScriptedPostDrawActions
 			r.boxBlur(blurAmount);
 		}
 
+		void addToHash(DrawActions::HashBuilder& h) const override
+		{
+			h.add(blurAmount);
+		}
+
 		int blurAmount;
 	};
 
@@ -70,6 +80,8 @@ struct ScriptedPostDrawActions
 			r.desaturate();
 		}
 
+		void addToHash(DrawActions::HashBuilder&) const override {}
+
 		int blurAmount;
 	};
 
@@ -88,6 +100,14 @@ struct ScriptedPostDrawActions
 			m->drawNoiseMap(g, area, noise, monochrom, scale);
 		}
 
+		void addToHash(DrawActions::HashBuilder& h) const override
+		{
+			h.add(noise);
+			h.add(area);
+			h.add(monochrom);
+			h.add(scale);
+		}
+
 		bool wantsCachedImage() const override { return false; };
 		bool wantsToDrawOnParent() const override { return false; }
 
@@ -117,6 +137,13 @@ struct ScriptedPostDrawActions
 
 		}
 
+		void addToHash(DrawActions::HashBuilder& hb) const override
+		{
+			hb.add(h);
+			hb.add(s);
+			hb.add(l);
+		}
+
 		float h, s, l;
 	};
 
@@ -134,6 +161,12 @@ struct ScriptedPostDrawActions
 			r.applyGradientMap(ColourGradient(c1, {}, c2, {}, false));
 		}
 
+		void addToHash(DrawActions::HashBuilder& h) const override
+		{
+			h.add(c1);
+			h.add(c2);
+		}
+
 		Colour c1, c2;
 	};
 
@@ -150,6 +183,11 @@ struct ScriptedPostDrawActions
 			r.applyGamma(gamma);
 		}
 
+		void addToHash(DrawActions::HashBuilder& h) const override
+		{
+			h.add(gamma);
+		}
+
 		float gamma;
 	};
 
@@ -166,6 +204,11 @@ struct ScriptedPostDrawActions
 			r.applySharpness(delta);
 		}
 
+		void addToHash(DrawActions::HashBuilder& h) const override
+		{
+			h.add(delta);
+		}
+
 		int delta;
 	};
 
@@ -184,6 +227,13 @@ struct ScriptedPostDrawActions
 			r.applyVignette(amount, radius, falloff);
 		}
 
+		void addToHash(DrawActions::HashBuilder& h) const override
+		{
+			h.add(amount);
+			h.add(radius);
+			h.add(falloff);
+		}
+
 		float amount, radius, falloff;
 	};
 
@@ -197,6 +247,8 @@ struct ScriptedPostDrawActions
 		{
 			r.applySepia();
 		}
+
+		void addToHash(DrawActions::HashBuilder&) const override {}
 	};
 
 	struct applyMask : public DrawActions::PostActionBase
@@ -211,6 +263,12 @@ struct ScriptedPostDrawActions
 			r.applyMask(path, invert, false);
 		}
 
+		void addToHash(DrawActions::HashBuilder& h) const override
+		{
+			h.add(path);
+			h.add(invert);
+		}
+
 		Path path;
 		bool invert;
 	};
@@ -222,6 +280,7 @@ namespace ScriptedDrawActions
 	{
 		fillAll(Colour c_) : c(c_) {};
 		void perform(Graphics& g) { g.fillAll(c); };
+		void addToHash(DrawActions::HashBuilder& h) const override { h.add(c); }
 		Colour c;
 	};
 
@@ -229,6 +288,7 @@ namespace ScriptedDrawActions
 	{
 		setColour(Colour c_) : c(c_) {};
 		void perform(Graphics& g) { g.setColour(c); };
+		void addToHash(DrawActions::HashBuilder& h) const override { h.add(c); }
 		Colour c;
 	};
 
@@ -236,6 +296,7 @@ namespace ScriptedDrawActions
 	{
 		addTransform(AffineTransform a_) : a(a_) {};
 		void perform(Graphics& g) override { g.addTransform(a); };
+		void addToHash(DrawActions::HashBuilder& h) const override { h.add(a); }
 		AffineTransform a;
 	};
 
@@ -243,6 +304,7 @@ namespace ScriptedDrawActions
 	{
 		fillPath(const Path& p_) : p(p_) {};
 		void perform(Graphics& g) override { g.fillPath(p); };
+		void addToHash(DrawActions::HashBuilder& h) const override { h.add(p); }
 		Path p;
 	};
 
@@ -253,6 +315,13 @@ namespace ScriptedDrawActions
 		{
 			g.strokePath(p, s);
 		}
+
+		void addToHash(DrawActions::HashBuilder& h) const override
+		{
+			h.add(p);
+			h.add(s);
+		}
+
 		Path p;
 		PathStrokeType s;
 	};
@@ -261,6 +330,7 @@ namespace ScriptedDrawActions
 	{
 		fillRect(Rectangle<float> area_) : area(area_) {};
 		void perform(Graphics& g) { g.fillRect(area); };
+		void addToHash(DrawActions::HashBuilder& h) const override { h.add(area); }
 		Rectangle<float> area;
 	};
 
@@ -268,6 +338,7 @@ namespace ScriptedDrawActions
 	{
 		fillEllipse(Rectangle<float> area_) : area(area_) {};
 		void perform(Graphics& g) { g.fillEllipse(area); };
+		void addToHash(DrawActions::HashBuilder& h) const override { h.add(area); }
 		Rectangle<float> area;
 	};
 
@@ -275,6 +346,7 @@ namespace ScriptedDrawActions
 	{
 		drawRect(Rectangle<float> area_, float borderSize_) : area(area_), borderSize(borderSize_) {};
 		void perform(Graphics& g) { g.drawRect(area, borderSize); };
+		void addToHash(DrawActions::HashBuilder& h) const override { h.add(area); h.add(borderSize); }
 		Rectangle<float> area;
 		float borderSize;
 	};
@@ -283,6 +355,7 @@ namespace ScriptedDrawActions
 	{
 		drawEllipse(Rectangle<float> area_, float borderSize_) : area(area_), borderSize(borderSize_) {};
 		void perform(Graphics& g) { g.drawEllipse(area, borderSize); };
+		void addToHash(DrawActions::HashBuilder& h) const override { h.add(area); h.add(borderSize); }
 		Rectangle<float> area;
 		float borderSize;
 	};
@@ -307,6 +380,17 @@ namespace ScriptedDrawActions
 				g.fillPath(p);
 			}
 		};
+
+		void addToHash(DrawActions::HashBuilder& h) const override
+		{
+			h.add(area);
+			h.add(cornerSize);
+			h.add(allRounded);
+
+			for (auto r : rounded)
+				h.add(r);
+		}
+
 		Rectangle<float> area;
 		float cornerSize;
 
@@ -334,6 +418,18 @@ namespace ScriptedDrawActions
 				g.strokePath(p, PathStrokeType(borderSize));
 			}
 		};
+
+		void addToHash(DrawActions::HashBuilder& h) const override
+		{
+			h.add(area);
+			h.add(borderSize);
+			h.add(cornerSize);
+			h.add(allRounded);
+
+			for (auto r : rounded)
+				h.add(r);
+		}
+
 		Rectangle<float> area;
 		float cornerSize, borderSize;
 
@@ -354,6 +450,12 @@ namespace ScriptedDrawActions
 			//			g.drawImage(img, ri.getX(), ri.getY(), (int)(r.getWidth() / scaleFactor), (int)(r.getHeight() / scaleFactor), 0, yOffset, (int)img.getWidth(), (int)((double)img.getHeight()));
 		}
 
+		void addToHash(DrawActions::HashBuilder& h) const override
+		{
+			h.add(img);
+			h.add(r);
+		}
+
 		Image img;
 		Rectangle<float> r;
 	};
@@ -371,6 +473,14 @@ namespace ScriptedDrawActions
 			//			g.drawImage(img, ri.getX(), ri.getY(), (int)(r.getWidth() / scaleFactor), (int)(r.getHeight() / scaleFactor), 0, yOffset, (int)img.getWidth(), (int)((double)img.getHeight()));
 		}
 
+		void addToHash(DrawActions::HashBuilder& h) const override
+		{
+			h.add(img);
+			h.add(r);
+			h.add(scaleFactor);
+			h.add(yOffset);
+		}
+
 		Image img;
 		Rectangle<float> r;
 		float scaleFactor;
@@ -382,6 +492,14 @@ namespace ScriptedDrawActions
 		drawHorizontalLine(int y_, float x1_, float x2_) :
 			y(y_), x1(x1_), x2(x2_) {};
 		void perform(Graphics& g) { g.drawHorizontalLine(y, x1, x2); };
+
+		void addToHash(DrawActions::HashBuilder& h) const override
+		{
+			h.add(y);
+			h.add(x1);
+			h.add(x2);
+		}
+
 		int y; float x1; float x2;
 	};
 
@@ -390,6 +508,14 @@ namespace ScriptedDrawActions
 		drawVerticalLine(int x_, float y1_, float y2_) :
 			x(x_), y1(y1_), y2(y2_) {};
 		void perform(Graphics& g) { g.drawVerticalLine(x, y1, y2); };
+
+		void addToHash(DrawActions::HashBuilder& h) const override
+		{
+			h.add(x);
+			h.add(y1);
+			h.add(y2);
+		}
+
 		int x; float y1; float y2;
 	};
 
@@ -398,6 +524,7 @@ namespace ScriptedDrawActions
 		setOpacity(float alpha_) :
 			alpha(alpha_) {};
 		void perform(Graphics& g) { g.setOpacity(alpha); };
+		void addToHash(DrawActions::HashBuilder& h) const override { h.add(alpha); }
 		float alpha;
 	};
 
@@ -406,6 +533,16 @@ namespace ScriptedDrawActions
 		drawLine(float x1_, float x2_, float y1_, float y2_, float lineThickness_) :
 			x1(x1_), x2(x2_), y1(y1_), y2(y2_), lineThickness(lineThickness_) {};
 		void perform(Graphics& g) { g.drawLine(x1, x2, y1, y2, lineThickness); };
+
+		void addToHash(DrawActions::HashBuilder& h) const override
+		{
+			h.add(x1);
+			h.add(x2);
+			h.add(y1);
+			h.add(y2);
+			h.add(lineThickness);
+		}
+
 		float x1, x2, y1, y2, lineThickness;
 	};
 
@@ -413,6 +550,7 @@ namespace ScriptedDrawActions
 	{
 		setFont(Font f_) : f(f_) {};
 		void perform(Graphics& g) { g.setFont(f); };
+		void addToHash(DrawActions::HashBuilder& h) const override { h.add(f); }
 		Font f;
 	};
 
@@ -420,6 +558,7 @@ namespace ScriptedDrawActions
 	{
 		setGradientFill(ColourGradient grad_) : grad(grad_) {};
 		void perform(Graphics& g) { g.setGradientFill(grad); };
+		void addToHash(DrawActions::HashBuilder& h) const override { h.add(grad); }
 		ColourGradient grad;
 	};
 
@@ -427,6 +566,14 @@ namespace ScriptedDrawActions
 	{
 		drawText(const String& text_, Rectangle<float> area_, Justification j_ = Justification::centred) : text(text_), area(area_), j(j_) {};
 		void perform(Graphics& g) override { g.drawText(text, area, j); };
+
+		void addToHash(DrawActions::HashBuilder& h) const override
+		{
+			h.add(text);
+			h.add(area);
+			h.add(j);
+		}
+
 		String text;
 		Rectangle<float> area;
 		Justification j;
@@ -436,6 +583,16 @@ namespace ScriptedDrawActions
 	{
 		drawFittedText(const String& text_, var area_, Justification j_, int maxLines_, float scale_ = Justification::centred) : text(text_), area(area_), j(j_), maxLines(maxLines_), scale(scale_) {};
 		void perform(Graphics& g) override { g.drawFittedText(text, area[0], area[1], area[2], area[3], j, maxLines, scale); };
+
+		void addToHash(DrawActions::HashBuilder& h) const override
+		{
+			h.add(text);
+			h.add(area);
+			h.add(j);
+			h.add(maxLines);
+			h.add(scale);
+		}
+
 		String text;
 		var area;
 		Justification j;
@@ -447,6 +604,17 @@ namespace ScriptedDrawActions
 	{
 		drawMultiLineText(const String& text_, int startX_, int baseLineY_, int maxWidth_, Justification j_ = Justification::centred, float leading_ = 0.0f) : text(text_), startX(startX_), baseLineY(baseLineY_), maxWidth(maxWidth_), j(j_), leading(leading_) {};
 		void perform(Graphics& g) override { g.drawMultiLineText(text, startX, baseLineY, maxWidth, j, leading); };
+
+		void addToHash(DrawActions::HashBuilder& h) const override
+		{
+			h.add(text);
+			h.add(startX);
+			h.add(baseLineY);
+			h.add(maxWidth);
+			h.add(j);
+			h.add(leading);
+		}
+
 		String text;
         int startX;
         int baseLineY;
@@ -459,6 +627,7 @@ namespace ScriptedDrawActions
 	{
 		drawDropShadow(Rectangle<int> r_, DropShadow& shadow_) : r(r_), shadow(shadow_) {};
 		void perform(Graphics& g) override { shadow.drawForRectangle(g, r); };
+		void addToHash(DrawActions::HashBuilder& h) const override { h.add(r); h.add(shadow); }
 		Rectangle<int> r;
 		DropShadow shadow;
 	};
@@ -496,6 +665,11 @@ namespace ScriptedDrawActions
 			g.restoreState();
 		}
 
+		void addToHash(DrawActions::HashBuilder& h) const override
+		{
+			h.add(shadow);
+		}
+
 		DropShadow shadow;
 	};
 
@@ -529,6 +703,14 @@ namespace ScriptedDrawActions
 			g.drawImageAt(img, drawTargetArea.getX(), drawTargetArea.getY());
 		}
 
+		void addToHash(DrawActions::HashBuilder& h) const override
+		{
+			h.add(p);
+			h.add(c);
+			h.add(area);
+			h.add(radius);
+		}
+
 		Rectangle<float> area;
 		Path p;
 		Colour c;
@@ -3180,6 +3180,7 @@ struct ScriptingApi::Sampler::Wrapper
 	API_METHOD_WRAPPER_1(Sampler, parseSampleFile);
 	API_VOID_METHOD_WRAPPER_2(Sampler, setGUISelection);
 	API_VOID_METHOD_WRAPPER_1(Sampler, setSortByRRGroup);
+	API_VOID_METHOD_WRAPPER_1(Sampler, setUseSampleMapHotSwap);
 };
 
 
@@ -3218,6 +3219,7 @@ sampler(sampler_)
 	ADD_API_METHOD_1(loadSfzFile);
 	ADD_API_METHOD_1(setUseStaticMatrix);
 	ADD_API_METHOD_1(setSortByRRGroup);
+	ADD_API_METHOD_1(setUseSampleMapHotSwap);
 	ADD_API_METHOD_1(createSelection);
 	ADD_API_METHOD_1(createSelectionFromIndexes);
 	ADD_API_METHOD_1(createSelectionWithFilter);
@@ -3924,7 +3926,10 @@ void ScriptingApi::Sampler::loadSampleMap(const String &fileName)
 			return;
 		}
 
-		s->killAllVoicesAndCall([ref](Processor* p) {dynamic_cast<ModulatorSampler*>(p)->loadSampleMap(ref); return SafeFunctionCall::OK; }, true);
+		if (s->isUsingSampleMapHotSwap())
+			s->getSampleMap()->loadWithHotSwap(ref);
+		else
+			s->killAllVoicesAndCall([ref](Processor* p) {dynamic_cast<ModulatorSampler*>(p)->loadSampleMap(ref); return SafeFunctionCall::OK; }, true);
 	}
 }
 
@@ -4365,6 +4370,19 @@ void ScriptingApi::Sampler::setSortByRRGroup(bool shouldSort)
 	s->setSortByGroup(shouldSort);
 }
 
+void ScriptingApi::Sampler::setUseSampleMapHotSwap(bool shouldUseHotSwap)
+{
+	ModulatorSampler *s = static_cast<ModulatorSampler*>(sampler.get());
+
+	if (s == nullptr)
+	{
+		reportScriptError("setUseSampleMapHotSwap() only works with Samplers.");
+		RETURN_VOID_IF_NO_THROW()
+	}
+
+	s->setUseSampleMapHotSwap(shouldUseHotSwap);
+}
+
 bool ScriptingApi::Sampler::saveCurrentSampleMap(String relativePathWithoutXml)
 {
 	ModulatorSampler *s = static_cast<ModulatorSampler*>(sampler.get());
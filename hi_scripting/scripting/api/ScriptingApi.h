@@ -881,9 +881,12 @@ public:
 		/** Disables dynamic resizing when a sample map is loaded. */
 		void setUseStaticMatrix(bool shouldUseStaticMatrix);
 
-		/** Enables a presorting of the sounds into RR groups. This might improve the performance at voice start if you have a lot of samples (> 20.000) in many RR groups. */
+		/** Only starts the sounds of the current RR group (the sounds are always presorted into a note / velocity / RR group lookup table). */
 		void setSortByRRGroup(bool shouldSort);
 
+		/** If enabled, loadSampleMap() will load the new samplemap in the background and let the playing voices finish with the old one. */
+		void setUseSampleMapHotSwap(bool shouldUseHotSwap);
+
 		/** Saves (and loads) the current samplemap to the given path (which should be the same string as the ID). */
 		bool saveCurrentSampleMap(String relativePathWithoutXml);
 
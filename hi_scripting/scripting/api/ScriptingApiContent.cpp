@@ -3282,6 +3282,7 @@ struct ScriptingApi::Content::ScriptPanel::Wrapper
 	API_METHOD_WRAPPER_0(ScriptPanel, removeFromParent);
 	API_METHOD_WRAPPER_0(ScriptPanel, getChildPanelList);
 	API_METHOD_WRAPPER_0(ScriptPanel, getParentPanel);
+	API_METHOD_WRAPPER_0(ScriptPanel, getRenderStatistics);
 	API_VOID_METHOD_WRAPPER_1(ScriptPanel, setAnimation);
 	API_VOID_METHOD_WRAPPER_1(ScriptPanel, setAnimationFrame);
 	API_METHOD_WRAPPER_0(ScriptPanel, getAnimationData);
@@ -3336,6 +3337,7 @@ void ScriptingApi::Content::ScriptPanel::init()
 	ADD_SCRIPT_PROPERTY(i11, "holdIsRightClick");	ADD_TO_TYPE_SELECTOR(SelectorTypes::ToggleSelector);
 	ADD_SCRIPT_PROPERTY(i12, "isPopupPanel");		ADD_TO_TYPE_SELECTOR(SelectorTypes::ToggleSelector);
     ADD_SCRIPT_PROPERTY(i13, "bufferToImage");      ADD_TO_TYPE_SELECTOR(SelectorTypes::ToggleSelector);
+	ADD_SCRIPT_PROPERTY(i14, "renderOffThread");	ADD_TO_TYPE_SELECTOR(SelectorTypes::ToggleSelector);
     
 	setDefaultValue(ScriptComponent::Properties::x, x);
 	setDefaultValue(ScriptComponent::Properties::y, y);
@@ -3360,6 +3362,7 @@ void ScriptingApi::Content::ScriptPanel::init()
 	setDefaultValue(holdIsRightClick, true);
 	setDefaultValue(isPopupPanel, false);
     setDefaultValue(bufferToImage, false);
+	setDefaultValue(renderOffThread, false);
 
 	handleDefaultDeactivatedProperties();
 
@@ -3392,6 +3395,7 @@ void ScriptingApi::Content::ScriptPanel::init()
 	ADD_API_METHOD_0(removeFromParent);
 	ADD_API_METHOD_0(getChildPanelList);
 	ADD_API_METHOD_0(getParentPanel);
+	ADD_API_METHOD_0(getRenderStatistics);
 	ADD_API_METHOD_3(setMouseCursor);
 	ADD_API_METHOD_0(getAnimationData);
 	ADD_API_METHOD_1(setAnimation);
@@ -4140,6 +4144,14 @@ var ScriptingApi::Content::ScriptPanel::getParentPanel()
 	return {};
 }
 
+var ScriptingApi::Content::ScriptPanel::getRenderStatistics()
+{
+	if (auto h = getDrawActionHandler())
+		return h->getRenderStatistics().toJSON();
+
+	return {};
+}
+
 void ScriptingApi::Content::ScriptPanel::addAnimationListener(AnimationListener* l)
 {
 #if HISE_INCLUDE_RLOTTIE
@@ -1725,6 +1725,7 @@ public:
 			holdIsRightClick,
 			isPopupPanel,
             bufferToImage,
+			renderOffThread,
 			numProperties
 		};
 
@@ -1880,6 +1881,9 @@ public:
 		/** Returns the panel that this panel has been added to with addChildPanel. */
 		var getParentPanel();
 
+		/** Returns the timing statistics of the rasterisation if `renderOffThread` is enabled. */
+		var getRenderStatistics();
+
 		int getNumSubPanels() const { return childPanels.size(); }
 
 		ScriptPanel* getSubPanel(int index)
@@ -670,7 +670,7 @@ public:
 		struct GlobalVarStatement;		struct GlobalReference;		struct LocalVarStatement;
 		struct LocalReference;			struct LockStatement;	    struct CallbackParameterReference;
 		struct CallbackLocalStatement;  struct CallbackLocalReference;  struct ExternalCFunction;
-		struct NativeJIT;				struct IsDefinedTest;		
+		struct NativeJIT;				struct IsDefinedTest;		struct CallbackBytecode;
 
 		// Snex stuff
 
@@ -718,10 +718,17 @@ public:
 
 			Callback(const Identifier &id, int numArgs, double bufferTime_);
 
+			~Callback();
+
 			var perform(RootObject *root);
 
 			void setStatements(BlockStatement *s) noexcept;
 
+			/** Lowers the statements into a bytecode program. Returns false if the callback will be interpreted. */
+			bool compileBytecode();
+
+			int getNumBytecodeInstructions() const;
+
 			bool isDefined() const noexcept{ return isCallbackDefined; }
 
 			Identifier getObjectName() const override { return getName(); }
@@ -814,9 +821,13 @@ public:
 
 				for (int i = 0; i < numArgs; i++)
 					parameterValues[i] = var();
+
+				clearBytecodeRegisters();
 #endif
 			}
 
+			void clearBytecodeRegisters();
+
 			Identifier parameters[4];
 			var parameterValues[4];
 
@@ -826,6 +837,8 @@ public:
 
 			ScopedPointer<BlockStatement> statements;
 
+			ScopedPointer<CallbackBytecode> bytecode;
+
 			private:
 
 			double lastExecutionTime;
@@ -1146,6 +1146,7 @@ var HiseJavascriptEngine::executeCallback(int callbackIndex, Result *result)
 
 void HiseJavascriptEngine::RootObject::Callback::setStatements(BlockStatement *s) noexcept
 {
+	bytecode = nullptr;
 	statements = s;
 	isCallbackDefined = s->statements.size() != 0;
 }
@@ -1166,14 +1167,20 @@ var HiseJavascriptEngine::RootObject::Callback::perform(RootObject *root)
 
     LocalScopeCreator::ScopedSetter svs(root, this);
 
-	statements->perform(s, &returnValue);
+	if (bytecode != nullptr)
+		bytecode->execute(s, &returnValue);
+	else
+		statements->perform(s, &returnValue);
 
 	root->removeFromCallStack(callbackName);
 
 	const double post = Time::getMillisecondCounterHiRes();
 	lastExecutionTime = post - pre;
 #else
-	statements->perform(s, &returnValue);
+	if (bytecode != nullptr)
+		bytecode->execute(s, &returnValue);
+	else
+		statements->perform(s, &returnValue);
 #endif
 
 	return returnValue;
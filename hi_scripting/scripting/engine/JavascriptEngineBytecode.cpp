@@ -0,0 +1,834 @@
+namespace hise { using namespace juce;
+
+/** A flat, register based program that replaces the statement tree of a callback.
+
+	The compiler runs after the optimisation passes and lowers the control flow, the operators and
+	the assignments of a callback into a list of instructions. Every operand is a slot that is resolved
+	at compile time: callback parameters and locals, `reg` variables and `const var` references point
+	directly to their storage, literals live in a constant pool and intermediate values are stored in
+	a small register file.
+
+	Everything that can't be lowered (function calls, API calls, object access, switch statements...)
+	is still evaluated by the existing statement tree, so the result is always identical to the
+	interpreted callback.
+*/
+struct HiseJavascriptEngine::RootObject::CallbackBytecode
+{
+	enum class OpCode : uint8
+	{
+		Move,				// dst = a
+		ToBool,				// dst = (bool)a
+		Add,				// dst = a + b with a fast path for numbers
+		Subtract,
+		Multiply,
+		LessThan,
+		LessThanOrEqual,
+		GreaterThan,
+		GreaterThanOrEqual,
+		Equals,
+		NotEquals,
+		Binary,				// dst = node->evaluate(a, b)
+		TypeEquals,
+		TypeNotEquals,
+		Jump,				// goto target
+		JumpIfFalse,		// if(!a) goto target
+		JumpIfTrue,			// if(a) goto target
+		CheckTimeout,
+		Evaluate,			// dst = node->getResult()
+		Assign,				// node->assign(a)
+		Perform,			// node->perform() and handle the result code (break -> target, continue -> target2)
+		Return,				// returnValue = a
+		Exit,
+		numOpCodes
+	};
+
+	struct Instruction
+	{
+		OpCode op;
+		int dst = -1;
+		int a = -1;
+		int b = -1;
+		int target = -1;
+		int target2 = -1;
+		const Statement* node = nullptr;
+	};
+
+	enum class SlotType
+	{
+		Constant,
+		Register,
+		External
+	};
+
+	struct SlotInfo
+	{
+		SlotType type;
+		int index;
+		var* data;
+	};
+
+	struct Compiler;
+
+	CallbackBytecode() = default;
+
+	/** Tries to compile the statements of the given callback. Returns nullptr if the callback can't be compiled. */
+	static CallbackBytecode* compile(Callback& c);
+
+	void execute(const Scope& s, var* returnValue) const
+	{
+		auto ins = instructions.begin();
+		auto slotData = slots.begin();
+		int pc = 0;
+
+		for (;;)
+		{
+			const auto& i = ins[pc++];
+
+			switch (i.op)
+			{
+			case OpCode::Move:
+				*slotData[i.dst] = *slotData[i.a];
+				break;
+			case OpCode::ToBool:
+				*slotData[i.dst] = (bool)*slotData[i.a];
+				break;
+			case OpCode::Add:
+			{
+				const auto& a = *slotData[i.a];
+				const auto& b = *slotData[i.b];
+
+				if (isNumber(a) && isNumber(b))
+					*slotData[i.dst] = (a.isDouble() || b.isDouble()) ? var((double)a + (double)b) : var((int64)a + (int64)b);
+				else
+					*slotData[i.dst] = getOperator(i)->evaluate(a, b);
+
+				break;
+			}
+			case OpCode::Subtract:
+			{
+				const auto& a = *slotData[i.a];
+				const auto& b = *slotData[i.b];
+
+				if (isNumber(a) && isNumber(b))
+					*slotData[i.dst] = (a.isDouble() || b.isDouble()) ? var((double)a - (double)b) : var((int64)a - (int64)b);
+				else
+					*slotData[i.dst] = getOperator(i)->evaluate(a, b);
+
+				break;
+			}
+			case OpCode::Multiply:
+			{
+				const auto& a = *slotData[i.a];
+				const auto& b = *slotData[i.b];
+
+				if (isNumber(a) && isNumber(b))
+					*slotData[i.dst] = (a.isDouble() || b.isDouble()) ? var((double)a * (double)b) : var((int64)a * (int64)b);
+				else
+					*slotData[i.dst] = getOperator(i)->evaluate(a, b);
+
+				break;
+			}
+			case OpCode::LessThan:				*slotData[i.dst] = compare<std::less>(i, *slotData[i.a], *slotData[i.b]); break;
+			case OpCode::LessThanOrEqual:		*slotData[i.dst] = compare<std::less_equal>(i, *slotData[i.a], *slotData[i.b]); break;
+			case OpCode::GreaterThan:			*slotData[i.dst] = compare<std::greater>(i, *slotData[i.a], *slotData[i.b]); break;
+			case OpCode::GreaterThanOrEqual:	*slotData[i.dst] = compare<std::greater_equal>(i, *slotData[i.a], *slotData[i.b]); break;
+			case OpCode::Equals:				*slotData[i.dst] = compare<std::equal_to>(i, *slotData[i.a], *slotData[i.b]); break;
+			case OpCode::NotEquals:				*slotData[i.dst] = compare<std::not_equal_to>(i, *slotData[i.a], *slotData[i.b]); break;
+			case OpCode::Binary:
+				*slotData[i.dst] = getOperator(i)->evaluate(*slotData[i.a], *slotData[i.b]);
+				break;
+			case OpCode::TypeEquals:
+				*slotData[i.dst] = areTypeEqual(*slotData[i.a], *slotData[i.b]);
+				break;
+			case OpCode::TypeNotEquals:
+				*slotData[i.dst] = !areTypeEqual(*slotData[i.a], *slotData[i.b]);
+				break;
+			case OpCode::Jump:
+				pc = i.target;
+				break;
+			case OpCode::JumpIfFalse:
+				if (!(bool)*slotData[i.a])
+					pc = i.target;
+				break;
+			case OpCode::JumpIfTrue:
+				if ((bool)*slotData[i.a])
+					pc = i.target;
+				break;
+			case OpCode::CheckTimeout:
+				s.checkTimeOut(i.node->location);
+				break;
+			case OpCode::Evaluate:
+			{
+				ScriptAudioThreadGuard guard(i.node->location);
+				*slotData[i.dst] = static_cast<const Expression*>(i.node)->getResult(s);
+				break;
+			}
+			case OpCode::Assign:
+			{
+				ScriptAudioThreadGuard guard(i.node->location);
+				static_cast<const Expression*>(i.node)->assign(s, *slotData[i.a]);
+				break;
+			}
+			case OpCode::Perform:
+			{
+				ScriptAudioThreadGuard guard(i.node->location);
+				auto r = i.node->perform(s, returnValue);
+
+				if (r == Statement::returnWasHit)
+					return;
+
+				if (r == Statement::breakWasHit)
+				{
+					if (i.target == -1)
+						return;
+
+					pc = i.target;
+				}
+				else if (r == Statement::continueWasHit)
+				{
+					if (i.target2 == -1)
+						return;
+
+					pc = i.target2;
+				}
+
+				break;
+			}
+			case OpCode::Return:
+				if (returnValue != nullptr)
+					*returnValue = *slotData[i.a];
+				return;
+			case OpCode::Exit:
+				return;
+			case OpCode::numOpCodes:
+			default:
+				jassertfalse;
+				return;
+			}
+		}
+	}
+
+	/** Releases the intermediate values so that they don't keep objects alive between two calls. */
+	void clearRegisters()
+	{
+		for (auto& r : registers)
+			r = var();
+	}
+
+	int getNumInstructions() const { return instructions.size(); }
+
+	int getNumRegisters() const { return numRegisters; }
+
+private:
+
+	static bool isNumber(const var& v) noexcept
+	{
+		return v.isInt() || v.isDouble() || v.isInt64() || v.isBool();
+	}
+
+	static const BinaryOperator* getOperator(const Instruction& i)
+	{
+		return static_cast<const BinaryOperator*>(i.node);
+	}
+
+	template <template <typename> class Op> static var compare(const Instruction& i, const var& a, const var& b)
+	{
+		if (isNumber(a) && isNumber(b))
+		{
+			if (a.isDouble() || b.isDouble())
+				return Op<double>()((double)a, (double)b);
+			else
+				return Op<int64>()((int64)a, (int64)b);
+		}
+
+		return getOperator(i)->evaluate(a, b);
+	}
+
+	Array<Instruction> instructions;
+	Array<var*> slots;
+	Array<var> constants;
+	Array<var> registers;
+	int numRegisters = 0;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CallbackBytecode);
+};
+
+struct HiseJavascriptEngine::RootObject::CallbackBytecode::Compiler
+{
+	Compiler(CallbackBytecode& p, Callback& c) :
+		program(p),
+		callback(c)
+	{}
+
+	struct LoopLabels
+	{
+		Array<int> breakJumps;
+		Array<int> continueJumps;
+		Array<int> performStatements;
+	};
+
+	bool canCompile(Statement* root) const
+	{
+#if ENABLE_SCRIPTING_BREAKPOINTS
+		// Breakpoints are thrown by the block statements so we need to keep the tree
+		return !OptimizationPass::callForEach(root, [](Statement* s)
+		{
+			return s->breakpointReference.index != -1;
+		});
+#else
+		ignoreUnused(root);
+		return true;
+#endif
+	}
+
+	void compileBody(Statement* root)
+	{
+		compileStatement(root);
+		emit(OpCode::Exit);
+
+		program.numRegisters = maxNumTemps;
+		program.registers.resize(program.numRegisters);
+
+		for (auto& si : slotInfos)
+		{
+			switch (si.type)
+			{
+			case SlotType::Constant: program.slots.add(&program.constants.getReference(si.index)); break;
+			case SlotType::Register: program.slots.add(&program.registers.getReference(si.index)); break;
+			case SlotType::External: program.slots.add(si.data); break;
+			}
+		}
+	}
+
+private:
+
+	int emit(OpCode op, int dst = -1, int a = -1, int b = -1, const Statement* node = nullptr)
+	{
+		Instruction i;
+		i.op = op;
+		i.dst = dst;
+		i.a = a;
+		i.b = b;
+		i.node = node;
+
+		program.instructions.add(i);
+		return program.instructions.size() - 1;
+	}
+
+	void emitJump(int target)
+	{
+		program.instructions.getReference(emit(OpCode::Jump)).target = target;
+	}
+
+	int getCurrentPosition() const { return program.instructions.size(); }
+
+	void patchTarget(int instructionIndex)
+	{
+		program.instructions.getReference(instructionIndex).target = getCurrentPosition();
+	}
+
+	int addSlot(SlotType type, int index, var* data)
+	{
+		slotInfos.add({ type, index, data });
+		return slotInfos.size() - 1;
+	}
+
+	int addConstant(const var& v)
+	{
+		program.constants.add(v);
+		return addSlot(SlotType::Constant, program.constants.size() - 1, nullptr);
+	}
+
+	int addExternal(var* data)
+	{
+		for (int i = 0; i < slotInfos.size(); i++)
+		{
+			if (slotInfos[i].type == SlotType::External && slotInfos[i].data == data)
+				return i;
+		}
+
+		return addSlot(SlotType::External, -1, data);
+	}
+
+	int allocateTemp()
+	{
+		auto index = numTemps++;
+		maxNumTemps = jmax(maxNumTemps, numTemps);
+
+		while (tempSlots.size() <= index)
+			tempSlots.add(addSlot(SlotType::Register, tempSlots.size(), nullptr));
+
+		return tempSlots[index];
+	}
+
+	bool isTemp(int slot) const
+	{
+		return slotInfos[slot].type == SlotType::Register;
+	}
+
+	/** Returns the storage of expressions that don't need to be evaluated or -1. */
+	int getSlotForValue(Statement* s)
+	{
+		if (s == nullptr)
+			return addConstant(var::undefined());
+
+		if (auto lv = dynamic_cast<LiteralValue*>(s))
+			return addConstant(lv->value);
+
+		if (typeid(*s) == typeid(Expression))
+			return addConstant(var::undefined());
+
+		if (auto cr = dynamic_cast<ConstReference*>(s))
+		{
+			if (auto ns = cr->ns.get())
+				return addExternal(ns->constObjects.getVarPointerAt(cr->index));
+
+			return -1;
+		}
+
+		if (auto pr = dynamic_cast<CallbackParameterReference*>(s))
+			return addExternal(pr->data);
+
+		return getSlotForAssignableValue(s);
+	}
+
+	/** Returns the storage of variables that can be assigned directly or -1. */
+	int getSlotForAssignableValue(Statement* s)
+	{
+		if (auto rn = dynamic_cast<RegisterName*>(s))
+			return addExternal(rn->data);
+
+		if (auto lr = dynamic_cast<CallbackLocalReference*>(s))
+		{
+			if (lr->parentCallback == &callback)
+			{
+				if (auto data = callback.localProperties.getVarPointer(lr->name))
+					return addExternal(data);
+			}
+		}
+
+		return -1;
+	}
+
+	static bool isValue(Statement* s)
+	{
+		return s == nullptr ||
+			   dynamic_cast<LiteralValue*>(s) != nullptr ||
+			   typeid(*s) == typeid(Expression) ||
+			   dynamic_cast<ConstReference*>(s) != nullptr ||
+			   dynamic_cast<CallbackParameterReference*>(s) != nullptr ||
+			   dynamic_cast<RegisterName*>(s) != nullptr ||
+			   dynamic_cast<CallbackLocalReference*>(s) != nullptr;
+	}
+
+	/** Checks whether the evaluation of the expression can't change any variable. */
+	static bool isPure(Statement* s)
+	{
+		if (isValue(s))
+			return true;
+
+		if (dynamic_cast<BinaryOperatorBase*>(s) != nullptr || dynamic_cast<ConditionalOp*>(s) != nullptr)
+		{
+			int index = 0;
+
+			while (auto child = s->getChildStatement(index++))
+			{
+				if (!isPure(child))
+					return false;
+			}
+
+			return true;
+		}
+
+		return false;
+	}
+
+	static OpCode getOpCode(BinaryOperator* op)
+	{
+		if (dynamic_cast<AdditionOp*>(op) != nullptr)			return OpCode::Add;
+		if (dynamic_cast<SubtractionOp*>(op) != nullptr)		return OpCode::Subtract;
+		if (dynamic_cast<MultiplyOp*>(op) != nullptr)			return OpCode::Multiply;
+		if (dynamic_cast<LessThanOp*>(op) != nullptr)			return OpCode::LessThan;
+		if (dynamic_cast<LessThanOrEqualOp*>(op) != nullptr)	return OpCode::LessThanOrEqual;
+		if (dynamic_cast<GreaterThanOp*>(op) != nullptr)		return OpCode::GreaterThan;
+		if (dynamic_cast<GreaterThanOrEqualOp*>(op) != nullptr) return OpCode::GreaterThanOrEqual;
+		if (dynamic_cast<EqualsOp*>(op) != nullptr)				return OpCode::Equals;
+		if (dynamic_cast<NotEqualsOp*>(op) != nullptr)			return OpCode::NotEquals;
+
+		return OpCode::Binary;
+	}
+
+	/** Compiles the expression and returns the slot that contains the result. */
+	int compileExpression(Expression* e)
+	{
+		auto slot = getSlotForValue(e);
+
+		if (slot != -1)
+			return slot;
+
+		auto dst = allocateTemp();
+		compileExpressionInto(e, dst);
+		return dst;
+	}
+
+	/** Compiles the expression and stores the result in dst.
+
+		If dst is not a register, only a single instruction may write to it after all operands are evaluated.
+	*/
+	void compileExpressionInto(Expression* e, int dst)
+	{
+		if (isValue(e))
+		{
+			auto slot = getSlotForValue(e);
+
+			if (slot != -1)
+			{
+				emit(OpCode::Move, dst, slot);
+				return;
+			}
+		}
+
+		if (!isTemp(dst) && dynamic_cast<BinaryOperator*>(e) == nullptr)
+		{
+			emit(OpCode::Move, dst, compileExpression(e));
+			return;
+		}
+
+		if (auto bo = dynamic_cast<BinaryOperator*>(e))
+		{
+			auto a = compileOperand(bo->lhs, bo->rhs);
+			auto b = compileExpression(bo->rhs);
+			emit(getOpCode(bo), dst, a, b, bo);
+			return;
+		}
+
+		if (auto la = dynamic_cast<LogicalAndOp*>(e))
+		{
+			compileLogicalOp(la, dst, OpCode::JumpIfFalse);
+			return;
+		}
+
+		if (auto lo = dynamic_cast<LogicalOrOp*>(e))
+		{
+			compileLogicalOp(lo, dst, OpCode::JumpIfTrue);
+			return;
+		}
+
+		if (auto te = dynamic_cast<TypeEqualsOp*>(e))
+		{
+			auto a = compileOperand(te->lhs, te->rhs);
+			emit(OpCode::TypeEquals, dst, a, compileExpression(te->rhs), te);
+			return;
+		}
+
+		if (auto tne = dynamic_cast<TypeNotEqualsOp*>(e))
+		{
+			auto a = compileOperand(tne->lhs, tne->rhs);
+			emit(OpCode::TypeNotEquals, dst, a, compileExpression(tne->rhs), tne);
+			return;
+		}
+
+		if (auto co = dynamic_cast<ConditionalOp*>(e))
+		{
+			auto jumpToFalse = emit(OpCode::JumpIfFalse, -1, compileExpression(co->condition));
+			compileExpressionInto(co->trueBranch, dst);
+			auto jumpToEnd = emit(OpCode::Jump);
+			patchTarget(jumpToFalse);
+			compileExpressionInto(co->falseBranch, dst);
+			patchTarget(jumpToEnd);
+			return;
+		}
+
+		if (compileAssignment(e, dst))
+			return;
+
+		emit(OpCode::Evaluate, dst, -1, -1, e);
+	}
+
+	/** Compiles the left operand and makes sure that it isn't changed by the evaluation of the right operand. */
+	int compileOperand(Expression* lhs, Expression* rhs)
+	{
+		auto a = compileExpression(lhs);
+
+		if (!isTemp(a) && !isPure(rhs))
+		{
+			auto copy = allocateTemp();
+			emit(OpCode::Move, copy, a);
+			return copy;
+		}
+
+		return a;
+	}
+
+	void compileLogicalOp(BinaryOperatorBase* op, int dst, OpCode jumpType)
+	{
+		emit(OpCode::ToBool, dst, compileExpression(op->lhs));
+		auto jumpToEnd = emit(jumpType, -1, dst);
+		emit(OpCode::ToBool, dst, compileExpression(op->rhs));
+		patchTarget(jumpToEnd);
+	}
+
+	/** Compiles assignments to a variable slot. If dst is -1, the result value is discarded. */
+	bool compileAssignment(Expression* e, int dst)
+	{
+		if (auto pa = dynamic_cast<PostAssignment*>(e))
+		{
+			auto target = getSlotForAssignableValue(pa->target);
+
+			if (target == -1 || dynamic_cast<BinaryOperator*>(pa->newValue.get()) == nullptr)
+				return false;
+
+			if (dst != -1)
+				emit(OpCode::Move, dst, target);
+
+			compileExpressionInto(pa->newValue, target);
+			return true;
+		}
+
+		if (auto sa = dynamic_cast<SelfAssignment*>(e))
+		{
+			auto target = getSlotForAssignableValue(sa->target);
+
+			if (target == -1 || dynamic_cast<BinaryOperator*>(sa->newValue.get()) == nullptr)
+				return false;
+
+			compileExpressionInto(sa->newValue, target);
+
+			if (dst != -1)
+				emit(OpCode::Move, dst, target);
+
+			return true;
+		}
+
+		if (auto as = dynamic_cast<Assignment*>(e))
+		{
+			auto target = getSlotForAssignableValue(as->target);
+
+			if (target != -1)
+			{
+				compileExpressionInto(as->newValue, target);
+
+				if (dst != -1)
+					emit(OpCode::Move, dst, target);
+			}
+			else
+			{
+				auto value = compileExpression(as->newValue);
+				emit(OpCode::Assign, -1, value, -1, as->target.get());
+
+				if (dst != -1)
+					emit(OpCode::Move, dst, value);
+			}
+
+			return true;
+		}
+
+		return false;
+	}
+
+	void compileDiscardedExpression(Expression* e)
+	{
+		if (isValue(e))
+			return;
+
+		if (compileAssignment(e, -1))
+			return;
+
+		auto isLowered = dynamic_cast<BinaryOperatorBase*>(e) != nullptr ||
+						 dynamic_cast<ConditionalOp*>(e) != nullptr;
+
+		if (isLowered)
+			compileExpression(e);
+		else
+			compileFallbackStatement(e);
+	}
+
+	void compileFallbackStatement(Statement* s)
+	{
+		auto index = emit(OpCode::Perform, -1, -1, -1, s);
+
+		if (!loops.isEmpty())
+			loops.getLast()->performStatements.add(index);
+	}
+
+	void compileStatement(Statement* s)
+	{
+		if (s == nullptr || typeid(*s) == typeid(Statement))
+			return;
+
+		auto numTempsBefore = numTemps;
+
+		if (auto bs = dynamic_cast<BlockStatement*>(s))
+		{
+			if (bs->lockStatements.isEmpty())
+			{
+				for (auto st : bs->statements)
+					compileStatement(st);
+			}
+			else
+				compileFallbackStatement(bs);
+		}
+		else if (auto is = dynamic_cast<IfStatement*>(s))
+		{
+			auto jumpToFalse = emit(OpCode::JumpIfFalse, -1, compileExpression(is->condition));
+			compileStatement(is->trueBranch);
+
+			if (is->falseBranch != nullptr && typeid(*is->falseBranch) != typeid(Statement))
+			{
+				auto jumpToEnd = emit(OpCode::Jump);
+				patchTarget(jumpToFalse);
+				compileStatement(is->falseBranch);
+				patchTarget(jumpToEnd);
+			}
+			else
+				patchTarget(jumpToFalse);
+		}
+		else if (auto ls = dynamic_cast<LoopStatement*>(s))
+		{
+			if (ls->isIterator)
+				compileFallbackStatement(ls);
+			else
+				compileLoop(ls);
+		}
+		else if (auto rs = dynamic_cast<ReturnStatement*>(s))
+		{
+			emit(OpCode::Return, -1, compileExpression(rs->returnValue));
+		}
+		else if (dynamic_cast<BreakStatement*>(s) != nullptr)
+		{
+			if (loops.isEmpty())
+				emit(OpCode::Exit);
+			else
+				loops.getLast()->breakJumps.add(emit(OpCode::Jump));
+		}
+		else if (dynamic_cast<ContinueStatement*>(s) != nullptr)
+		{
+			if (loops.isEmpty())
+				emit(OpCode::Exit);
+			else
+				loops.getLast()->continueJumps.add(emit(OpCode::Jump));
+		}
+		else if (auto cls = dynamic_cast<CallbackLocalStatement*>(s))
+		{
+			auto data = cls->parentCallback == &callback ? callback.localProperties.getVarPointer(cls->name) : nullptr;
+
+			if (data != nullptr)
+				compileExpressionInto(cls->initialiser, addExternal(data));
+			else
+				compileFallbackStatement(cls);
+		}
+		else if (auto e = dynamic_cast<Expression*>(s))
+		{
+			compileDiscardedExpression(e);
+		}
+		else
+		{
+			compileFallbackStatement(s);
+		}
+
+		numTemps = numTempsBefore;
+	}
+
+	void compileLoop(LoopStatement* ls)
+	{
+		compileStatement(ls->initialiser);
+
+		loops.add(new LoopLabels());
+
+		auto loopStart = getCurrentPosition();
+		int jumpToEnd = -1;
+
+		if (!ls->isDoLoop)
+			jumpToEnd = emit(OpCode::JumpIfFalse, -1, compileExpression(ls->condition));
+
+		emit(OpCode::CheckTimeout, -1, -1, -1, ls);
+
+		compileStatement(ls->body);
+
+		int continuePosition = -1;
+
+		if (ls->isDoLoop)
+		{
+			// a continue statement skips the condition check of a do loop
+			compileStatement(ls->iterator);
+			loops.getLast()->breakJumps.add(emit(OpCode::JumpIfFalse, -1, compileExpression(ls->condition)));
+			emitJump(loopStart);
+		}
+
+		continuePosition = getCurrentPosition();
+		compileStatement(ls->iterator);
+		emitJump(loopStart);
+
+		if (jumpToEnd != -1)
+			patchTarget(jumpToEnd);
+
+		ScopedPointer<LoopLabels> labels(loops.removeAndReturn(loops.size() - 1));
+
+		for (auto j : labels->breakJumps)
+			patchTarget(j);
+
+		for (auto j : labels->continueJumps)
+			program.instructions.getReference(j).target = continuePosition;
+
+		for (auto p : labels->performStatements)
+		{
+			auto& i = program.instructions.getReference(p);
+			i.target = getCurrentPosition();
+			i.target2 = continuePosition;
+		}
+	}
+
+	CallbackBytecode& program;
+	Callback& callback;
+
+	Array<SlotInfo> slotInfos;
+	Array<int> tempSlots;
+	int numTemps = 0;
+	int maxNumTemps = 0;
+
+	OwnedArray<LoopLabels> loops;
+};
+
+HiseJavascriptEngine::RootObject::CallbackBytecode* HiseJavascriptEngine::RootObject::CallbackBytecode::compile(Callback& c)
+{
+	if (c.statements == nullptr)
+		return nullptr;
+
+	ScopedPointer<CallbackBytecode> program = new CallbackBytecode();
+	Compiler compiler(*program, c);
+
+	if (!compiler.canCompile(c.statements))
+		return nullptr;
+
+	compiler.compileBody(c.statements);
+	return program.release();
+}
+
+HiseJavascriptEngine::RootObject::Callback::~Callback()
+{
+	bytecode = nullptr;
+	statements = nullptr;
+}
+
+bool HiseJavascriptEngine::RootObject::Callback::compileBytecode()
+{
+	bytecode = nullptr;
+
+	if (isDefined())
+		bytecode = CallbackBytecode::compile(*this);
+
+	return bytecode != nullptr;
+}
+
+void HiseJavascriptEngine::RootObject::Callback::clearBytecodeRegisters()
+{
+	if (bytecode != nullptr)
+		bytecode->clearRegisters();
+}
+
+int HiseJavascriptEngine::RootObject::Callback::getNumBytecodeInstructions() const
+{
+	return bytecode != nullptr ? bytecode->getNumInstructions() : 0;
+}
+
+} // namespace hise
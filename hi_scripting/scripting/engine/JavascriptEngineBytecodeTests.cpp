@@ -0,0 +1,191 @@
+namespace hise { using namespace juce;
+
+/** Compares the bytecode of a callback with the interpreted statement tree and measures the execution time of both. */
+class ScriptBytecodeTest : public UnitTest
+{
+public:
+
+	using RootObject = HiseJavascriptEngine::RootObject;
+
+	ScriptBytecodeTest() :
+		UnitTest("Testing HiseScript callback bytecode")
+	{}
+
+	struct TestEngine
+	{
+		TestEngine(UnitTest& t, const String& code):
+			root(new RootObject())
+		{
+			root->hiseSpecialData.callbackNEW.add(new RootObject::Callback("onTest", 1, 0.01));
+			root->timeout = Time::getCurrentTime() + RelativeTime::minutes(5.0);
+
+			try
+			{
+				root->execute(code, true);
+			}
+			catch (RootObject::Error& e)
+			{
+				t.expect(false, "Compile error: " + e.errorMessage);
+			}
+
+			callback = root->hiseSpecialData.getCallback("onTest");
+		}
+
+		var run(const var& argument)
+		{
+			callback->setParameterValue(0, argument);
+			auto returnValue = callback->perform(root.get());
+			callback->cleanLocalProperties();
+			return returnValue;
+		}
+
+		double measure(const var& argument, int numIterations)
+		{
+			auto start = Time::getMillisecondCounterHiRes();
+
+			for (int i = 0; i < numIterations; i++)
+				run(argument);
+
+			return Time::getMillisecondCounterHiRes() - start;
+		}
+
+		ReferenceCountedObjectPtr<RootObject> root;
+		RootObject::Callback* callback = nullptr;
+	};
+
+	void runTest() override
+	{
+		testResults();
+		runBenchmark();
+	}
+
+private:
+
+	void testResults()
+	{
+		beginTest("Testing bytecode against the interpreter");
+
+		TestEngine e(*this, getTestScript());
+
+		if (e.callback == nullptr || !e.callback->isDefined())
+		{
+			expect(false, "callback not defined");
+			return;
+		}
+
+		try
+		{
+			for (int i = -2; i < 40; i++)
+			{
+				e.callback->bytecode = nullptr;
+				auto expected = JSON::toString(e.run(i), true);
+
+				expect(e.callback->compileBytecode(), "bytecode compilation failed");
+				auto actual = JSON::toString(e.run(i), true);
+
+				expectEquals(actual, expected, "value: " + String(i));
+			}
+		}
+		catch (RootObject::Error& error)
+		{
+			expect(false, "Runtime error: " + error.errorMessage);
+		}
+	}
+
+	void runBenchmark()
+	{
+		beginTest("Benchmarking callback execution");
+
+		TestEngine e(*this, getTestScript());
+
+		if (e.callback == nullptr)
+			return;
+
+		const int numIterations = 2000;
+		const int argument = 200;
+
+		try
+		{
+			e.callback->bytecode = nullptr;
+			e.measure(argument, 10);
+			auto interpreted = e.measure(argument, numIterations);
+
+			e.callback->compileBytecode();
+			e.measure(argument, 10);
+			auto compiled = e.measure(argument, numIterations);
+
+			String s;
+			s << "onTest(" << argument << ") x " << numIterations << ": ";
+			s << "interpreted: " << String(interpreted, 2) << "ms, ";
+			s << "bytecode (" << e.callback->getNumBytecodeInstructions() << " instructions): " << String(compiled, 2) << "ms, ";
+			s << "speedup: " << String(interpreted / jmax(0.001, compiled), 2) << "x";
+
+			logMessage(s);
+		}
+		catch (RootObject::Error& error)
+		{
+			expect(false, "Runtime error: " + error.errorMessage);
+		}
+	}
+
+	static String getTestScript()
+	{
+		return R"(
+reg counter = 0;
+const var OFFSET = 12;
+const var table = [3, 1, 4, 1, 5, 9, 2, 6];
+
+function onTest(value)
+{
+	var sum = 0;
+	var i;
+	var x = 0;
+	var odd = 0;
+
+	for (i = 0; i < value; i++)
+	{
+		if (i % 3 == 0)
+			continue;
+
+		sum += i * OFFSET - table[i % 8];
+		odd = (i & 1) == 1 ? odd + 1 : odd;
+
+		if (sum > 100000)
+			break;
+	}
+
+	do
+	{
+		x++;
+	}
+	while (x < 5);
+
+	while (x < 10)
+		x += 2;
+
+	counter += 1;
+
+	var f = value > 5 ? 1.5 : 2;
+	var b = !(value == 3) && (x >= 10 || value < 0);
+	var s = "v" + value;
+	var list = [0, 0];
+	list[1] = sum / 4;
+
+	switch (value % 3)
+	{
+		case 0: f += 1; break;
+		default: f -= 1;
+	}
+
+	if (value < 0)
+		return -1;
+
+	return [sum, x, f, b, s, list[1], odd, i--, i];
+}
+)";
+	}
+};
+
+static ScriptBytecodeTest scriptBytecodeTest;
+
+} // namespace hise
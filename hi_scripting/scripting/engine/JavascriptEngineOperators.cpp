@@ -41,7 +41,12 @@ struct HiseJavascriptEngine::RootObject::BinaryOperator : public BinaryOperatorB
 	var getResult(const Scope& s) const override
 	{
 		var a(lhs->getResult(s)), b(rhs->getResult(s));
+		return evaluate(a, b);
+	}
 
+	/** Applies the operator to the given values. This is also used by the bytecode of compiled callbacks. */
+	var evaluate(const var& a, const var& b) const
+	{
 		if (isNumericOrUndefined(a) && isNumericOrUndefined(b))
 			return (a.isDouble() || b.isDouble()) ? getWithDoubles(a, b) : getWithInts(a, b);
 
@@ -2427,6 +2427,20 @@ void HiseJavascriptEngine::RootObject::execute(const String& code, bool allowCon
 		if(auto or_ = hiseSpecialData.runOptimisation(o))
 			results.add(or_);
 	}
+
+#if HISE_USE_SCRIPT_BYTECODE
+	OptimizationPass::OptimizationResult bytecodeResult;
+	bytecodeResult.passName = "Bytecode Compiler (callbacks)";
+
+	for (auto c : hiseSpecialData.callbackNEW)
+	{
+		if (c->compileBytecode())
+			bytecodeResult.numOptimizedStatements++;
+	}
+
+	if (bytecodeResult)
+		results.add(bytecodeResult);
+#endif
 	
 	auto after = Time::getMillisecondCounter();
 	
@@ -2441,7 +2455,8 @@ void HiseJavascriptEngine::RootObject::execute(const String& code, bool allowCon
 
 		s << "Optimization Duration: " << String(optimisationTimeMs) << "ms";
 
-		hiseSpecialData.processor->setOptimisationReport(s);
+		if (hiseSpecialData.processor != nullptr)
+			hiseSpecialData.processor->setOptimisationReport(s);
 	}
 }
 
@@ -518,6 +518,19 @@ void DspNetwork::setForwardControlsToParameters(bool shouldForward)
 	forwardControls = shouldForward;
 }
 
+void DspNetwork::setCpuProfilingEnabled(bool shouldBeEnabled)
+{
+	if (shouldBeEnabled && profiler == nullptr)
+	{
+		ScopedPointer<NetworkProfiler> newProfiler = new NetworkProfiler(*this);
+
+		SimpleReadWriteLock::ScopedWriteLock sl(getConnectionLock());
+		profiler.swapWith(newProfiler);
+	}
+
+	enableCpuProfiling = shouldBeEnabled;
+}
+
 void DspNetwork::prepareToPlay(double sampleRate, double blockSize)
 {
 	runPostInitFunctions();
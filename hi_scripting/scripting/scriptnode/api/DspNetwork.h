@@ -984,6 +984,11 @@ public:
 
 	bool& getCpuProfileFlag() { return enableCpuProfiling; };
 
+	/** Enables the CPU profiling and creates the profiler that records the timings of each node. */
+	void setCpuProfilingEnabled(bool shouldBeEnabled);
+
+	NetworkProfiler* getProfiler() const { return profiler.get(); }
+
 	void setVoiceKiller(VoiceResetter* newVoiceKiller)
 	{
 		if (isPolyphonic())
@@ -1067,6 +1072,7 @@ private:
 	ModValue networkModValue;
 
 	bool enableCpuProfiling = false;
+	ScopedPointer<NetworkProfiler> profiler;
 
 	WeakReference<ExternalDataHolder> dataHolder;
 	WeakReference<DspNetwork> parentNetwork;
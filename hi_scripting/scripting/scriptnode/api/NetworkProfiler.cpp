@@ -0,0 +1,274 @@
+/*  ===========================================================================
+ *
+ *   This file is part of HISE.
+ *   Copyright 2016 Christoph Hart
+ *
+ *   HISE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   HISE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Commercial licenses for using HISE in an closed source project are
+ *   available on request. Please visit the project's website to get more
+ *   information about commercial licensing:
+ *
+ *   http://www.hise.audio/
+ *
+ *   HISE is based on the JUCE library,
+ *   which also must be licensed for commercial applications:
+ *
+ *   http://www.juce.com
+ *
+ *   ===========================================================================
+ */
+
+namespace scriptnode
+{
+using namespace juce;
+using namespace hise;
+
+NetworkProfiler::NetworkProfiler(DspNetwork& n) :
+	network(n),
+	slots(MaxNodes, true),
+	usedSlots(MaxNodes),
+	fifo(FifoSize),
+	fifoData(FifoSize)
+{
+	trace.ensureStorageAllocated(MaxTraceSamples);
+	registerNodes();
+}
+
+void NetworkProfiler::exit(NodeBase* n, int64 startTicks, int64 endTicks) noexcept
+{
+	auto index = n->getProfileIndex();
+
+	if (isPositiveAndBelow(index, MaxNodes))
+	{
+		auto& s = slots[index];
+
+		if (s.numCalls++ == 0)
+		{
+			s.startTicks = startTicks;
+			usedSlots[numUsedSlots++] = index;
+		}
+
+		s.durationTicks += endTicks - startTicks;
+	}
+
+	if (--depth <= 0)
+	{
+		depth = 0;
+		flush();
+	}
+}
+
+void NetworkProfiler::flush() noexcept
+{
+	int start1, size1, start2, size2;
+	fifo.prepareToWrite(numUsedSlots, start1, size1, start2, size2);
+
+	auto numToWrite = size1 + size2;
+
+	for (int i = 0; i < numUsedSlots; i++)
+	{
+		auto index = usedSlots[i];
+		auto& s = slots[index];
+
+		if (i < numToWrite)
+		{
+			auto& sample = fifoData[i < size1 ? start1 + i : start2 + i - size1];
+
+			sample.nodeIndex = index;
+			sample.numCalls = s.numCalls;
+			sample.startTicks = s.startTicks;
+			sample.durationTicks = s.durationTicks;
+			sample.blockIndex = blockIndex;
+		}
+
+		s = {};
+	}
+
+	fifo.finishedWrite(numToWrite);
+
+	if (numToWrite < numUsedSlots)
+		numDropped += numUsedSlots - numToWrite;
+
+	numUsedSlots = 0;
+	blockIndex++;
+}
+
+void NetworkProfiler::registerNodes()
+{
+	for (auto n : network.nodes)
+	{
+		if (n->getProfileIndex() != -1 || histories.size() >= MaxNodes)
+			continue;
+
+		auto h = new History();
+		h->node = n;
+		h->durations.calloc(HistorySize);
+
+		n->setProfileIndex(histories.size());
+		histories.add(h);
+	}
+}
+
+void NetworkProfiler::collect()
+{
+	registerNodes();
+
+	int start1, size1, start2, size2;
+	fifo.prepareToRead(fifo.getNumReady(), start1, size1, start2, size2);
+
+	auto process = [&](int start, int size)
+	{
+		for (int i = 0; i < size; i++)
+		{
+			const auto& s = fifoData[start + i];
+
+			if (auto h = histories[s.nodeIndex])
+			{
+				h->durations[h->writeIndex] = (float)(1000.0 * Time::highResolutionTicksToSeconds(s.durationTicks));
+				h->writeIndex = (h->writeIndex + 1) % HistorySize;
+				h->numValues = jmin(HistorySize, h->numValues + 1);
+				h->lastNumCalls = s.numCalls;
+			}
+
+			if (trace.size() < MaxTraceSamples)
+				trace.add(s);
+			else
+			{
+				trace.set(traceWriteIndex, s);
+				traceWriteIndex = (traceWriteIndex + 1) % MaxTraceSamples;
+			}
+		}
+	};
+
+	process(start1, size1);
+	process(start2, size2);
+
+	fifo.finishedRead(size1 + size2);
+}
+
+void NetworkProfiler::clear()
+{
+	collect();
+
+	for (auto h : histories)
+	{
+		h->writeIndex = 0;
+		h->numValues = 0;
+	}
+
+	trace.clearQuick();
+	traceWriteIndex = 0;
+	numDropped = 0;
+}
+
+NetworkProfiler::NodeStatistics NetworkProfiler::getStatistics(NodeBase* n) const
+{
+	NodeStatistics s;
+	s.node = n;
+
+	if (n == nullptr)
+		return s;
+
+	auto h = histories[n->getProfileIndex()];
+
+	if (h == nullptr || h->numValues == 0)
+		return s;
+
+	Array<float> sorted;
+	sorted.addArray(h->durations.get(), h->numValues);
+	sorted.sort();
+
+	double sum = 0.0;
+
+	for (auto v : sorted)
+		sum += (double)v;
+
+	s.numBlocks = h->numValues;
+	s.numCallsPerBlock = h->lastNumCalls;
+	s.minMs = sorted.getFirst();
+	s.maxMs = sorted.getLast();
+	s.averageMs = sum / (double)h->numValues;
+
+	auto p99Index = jlimit(0, h->numValues - 1, roundToInt(std::ceil(0.99 * (double)h->numValues)) - 1);
+	s.p99Ms = sorted[p99Index];
+
+	return s;
+}
+
+double NetworkProfiler::getBlockDurationMs() const
+{
+	auto specs = network.getCurrentSpecs();
+
+	if (specs.sampleRate > 0.0 && specs.blockSize > 0)
+		return 1000.0 * (double)specs.blockSize / specs.sampleRate;
+
+	return 0.0;
+}
+
+var NetworkProfiler::createChromeTrace() const
+{
+	Array<var> events;
+
+	if (trace.isEmpty())
+		return var(events);
+
+	// The oldest sample is at the write index once the trace buffer is full
+	auto firstTicks = trace[traceWriteIndex].startTicks;
+
+	for (int i = 0; i < trace.size(); i++)
+	{
+		const auto& s = trace.getReference((traceWriteIndex + i) % trace.size());
+
+		auto h = histories[s.nodeIndex];
+
+		if (h == nullptr || h->node == nullptr)
+			continue;
+
+		DynamicObject::Ptr args = new DynamicObject();
+		args->setProperty("calls", s.numCalls);
+		args->setProperty("block", (int)s.blockIndex);
+
+		DynamicObject::Ptr e = new DynamicObject();
+		e->setProperty("name", h->node->getId());
+		e->setProperty("cat", h->node->getValueTree()[PropertyIds::FactoryPath].toString());
+		e->setProperty("ph", "X");
+		e->setProperty("ts", 1000000.0 * Time::highResolutionTicksToSeconds(s.startTicks - firstTicks));
+		e->setProperty("dur", 1000000.0 * Time::highResolutionTicksToSeconds(s.durationTicks));
+		e->setProperty("pid", 1);
+		e->setProperty("tid", 1);
+		e->setProperty("args", var(args.get()));
+
+		events.add(var(e.get()));
+	}
+
+	DynamicObject::Ptr obj = new DynamicObject();
+	obj->setProperty("traceEvents", var(events));
+	obj->setProperty("displayTimeUnit", "ms");
+
+	return var(obj.get());
+}
+
+Result NetworkProfiler::exportTrace(const File& f) const
+{
+	if (trace.isEmpty())
+		return Result::fail("No profile data recorded");
+
+	if (!f.replaceWithText(JSON::toString(createChromeTrace(), true)))
+		return Result::fail("Can't write to " + f.getFullPathName());
+
+	return Result::ok();
+}
+
+}
@@ -0,0 +1,166 @@
+/*  ===========================================================================
+ *
+ *   This file is part of HISE.
+ *   Copyright 2016 Christoph Hart
+ *
+ *   HISE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   HISE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Commercial licenses for using HISE in an closed source project are
+ *   available on request. Please visit the project's website to get more
+ *   information about commercial licensing:
+ *
+ *   http://www.hise.audio/
+ *
+ *   HISE is based on the JUCE library,
+ *   which also must be licensed for commercial applications:
+ *
+ *   http://www.juce.com
+ *
+ *   ===========================================================================
+ */
+
+#pragma once
+
+namespace scriptnode
+{
+
+using namespace juce;
+using namespace hise;
+
+/** Records the processing time of every node in a DspNetwork.
+
+	The profiler will be created when the CPU profiling of a network is enabled for the first time.
+	The audio thread sums up the time of each node during one call of the root node (so frame
+	processing and multiple calls of the same node are accumulated) and pushes one sample per node
+	into a lock free FIFO when the root node is done. The message thread then collects these samples
+	with collect() and calculates the statistics for the flame graph or creates a Chrome trace
+	(open it with chrome://tracing or https://ui.perfetto.dev).
+
+	Nodes are registered on the message thread, so a node that was just added will be profiled
+	after the next call to collect().
+*/
+class NetworkProfiler
+{
+public:
+
+	/** The maximum number of nodes that can be profiled. */
+	static constexpr int MaxNodes = 1024;
+
+	/** The number of node samples that can be pending in the FIFO. */
+	static constexpr int FifoSize = 16384;
+
+	/** The number of blocks per node that are used for the statistics. */
+	static constexpr int HistorySize = 512;
+
+	/** The number of samples that are kept for the trace export. */
+	static constexpr int MaxTraceSamples = 65536;
+
+	/** The time that a node spent in one call of the root node. */
+	struct Sample
+	{
+		int nodeIndex = -1;
+		int numCalls = 0;
+		int64 startTicks = 0;
+		int64 durationTicks = 0;
+		uint32 blockIndex = 0;
+	};
+
+	struct NodeStatistics
+	{
+		NodeBase::Ptr node;
+		int numBlocks = 0;
+		int numCallsPerBlock = 0;
+		double minMs = 0.0;
+		double averageMs = 0.0;
+		double p99Ms = 0.0;
+		double maxMs = 0.0;
+	};
+
+	NetworkProfiler(DspNetwork& n);
+
+	// ========================================================= Audio thread
+
+	/** Call this before a node is processed. */
+	void enter() noexcept { ++depth; }
+
+	/** Call this after a node is processed. If the root node is finished, it will push the samples to the FIFO. */
+	void exit(NodeBase* n, int64 startTicks, int64 endTicks) noexcept;
+
+	// ========================================================= Message thread
+
+	/** Registers new nodes and moves the samples from the FIFO to the history. */
+	void collect();
+
+	/** Clears the history and the trace. */
+	void clear();
+
+	/** Calculates the statistics for the given node. */
+	NodeStatistics getStatistics(NodeBase* n) const;
+
+	/** Returns the duration of an audio block with the current processing specs. */
+	double getBlockDurationMs() const;
+
+	/** Returns the amount of samples that were lost because the FIFO was full. */
+	int getNumDroppedSamples() const noexcept { return numDropped.load(); }
+
+	/** Creates a JSON object in the Chrome trace event format. */
+	var createChromeTrace() const;
+
+	/** Writes the trace to the given file. */
+	Result exportTrace(const File& f) const;
+
+private:
+
+	void registerNodes();
+	void flush() noexcept;
+
+	DspNetwork& network;
+
+	// Audio thread data
+	struct Slot
+	{
+		int64 startTicks = 0;
+		int64 durationTicks = 0;
+		int numCalls = 0;
+	};
+
+	HeapBlock<Slot> slots;
+	HeapBlock<int> usedSlots;
+	int numUsedSlots = 0;
+	int depth = 0;
+	uint32 blockIndex = 0;
+	std::atomic<int> numDropped { 0 };
+
+	AbstractFifo fifo;
+	HeapBlock<Sample> fifoData;
+
+	// Message thread data
+	struct History
+	{
+		NodeBase::Ptr node;
+		HeapBlock<float> durations;
+		int writeIndex = 0;
+		int numValues = 0;
+		int lastNumCalls = 0;
+	};
+
+	OwnedArray<History> histories;
+
+	Array<Sample> trace;
+	int traceWriteIndex = 0;
+
+	JUCE_DECLARE_NON_COPYABLE(NetworkProfiler);
+};
+
+}
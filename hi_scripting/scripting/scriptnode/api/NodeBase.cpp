@@ -1467,7 +1467,26 @@ RealNodeProfiler::RealNodeProfiler(NodeBase* n, int numSamples_) :
 	node(n)
 {
 	if (enabled)
-		start = Time::getMillisecondCounterHiRes();
+	{
+		profiler = n->getRootNetwork()->getProfiler();
+
+		if (profiler != nullptr)
+			profiler->enter();
+
+		start = Time::getHighResolutionTicks();
+	}
+}
+
+void RealNodeProfiler::finish()
+{
+	auto end = Time::getHighResolutionTicks();
+	auto delta = 1000.0 * Time::highResolutionTicksToSeconds(end - start);
+	profileFlag = profileFlag * 0.9 + 0.1 * delta;
+
+	node->processProfileInfo(profileFlag, numSamples);
+
+	if (profiler != nullptr)
+		profiler->exit(node, start, end);
 }
 
 Parameter::ScopedAutomationPreserver::ScopedAutomationPreserver(NodeBase* n) :
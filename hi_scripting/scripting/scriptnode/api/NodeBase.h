@@ -523,6 +523,11 @@ public:
     
 	double& getCpuFlag() { return cpuUsage; }
 
+	/** Returns the index of the node in the NetworkProfiler or -1 if it's not registered yet. */
+	int getProfileIndex() const noexcept { return profileIndex.load(std::memory_order_relaxed); }
+
+	void setProfileIndex(int newIndex) noexcept { profileIndex.store(newIndex, std::memory_order_relaxed); }
+
 	String getCpuUsageInPercent() const;
 
 	bool isClone() const;
@@ -596,6 +601,7 @@ private:
 	WeakReference<NodeBase::Holder> subHolder;
 	
 	double cpuUsage = 0.0;
+	std::atomic<int> profileIndex { -1 };
 
 	bool isCurrentlyMoved = false;
 
@@ -646,6 +652,8 @@ struct FrameDataPeakChecker
 	dyn<float> b;
 };
 
+class NetworkProfiler;
+
 struct RealNodeProfiler
 {
 	RealNodeProfiler(NodeBase* n, int numSamples);
@@ -653,19 +661,17 @@ struct RealNodeProfiler
 	~RealNodeProfiler()
 	{
 		if (enabled)
-		{
-			auto delta = Time::getMillisecondCounterHiRes() - start;
-			profileFlag = profileFlag * 0.9 + 0.1 * delta;
-
-			node->processProfileInfo(profileFlag, numSamples);
-		}
+			finish();
 	}
 
+	void finish();
+
 	NodeBase* node;
 	bool enabled;
 	double& profileFlag;
-	double start;
+	int64 start;
 	const int numSamples;
+	NetworkProfiler* profiler = nullptr;
 };
 
 #if ENABLE_NODE_PROFILING
@@ -1523,13 +1523,16 @@ bool DspNetworkGraph::Actions::toggleCableDisplay(DspNetworkGraph& g)
 
 bool DspNetworkGraph::Actions::toggleCpuProfiling(DspNetworkGraph& g)
 {
-	auto& b = g.network->getCpuProfileFlag();
-	b = !b;
+	auto b = !g.network->getCpuProfileFlag();
+	g.network->setCpuProfilingEnabled(b);
 	
 	g.enablePeriodicRepainting(b);
 
 	g.repaint();
 
+	if (b)
+		showProfilerPopup(g);
+
 	return true;
 }
 
@@ -2182,6 +2185,199 @@ struct ParameterPopup: public Component,
 	valuetree::ChildListener updater;
 };
 
+/** Shows the statistics of the NetworkProfiler as flame graph.
+
+	The width of each node is its average time relative to its parent, so a container spans over
+	all of its child nodes and the remaining space is the overhead of the container itself.
+*/
+struct ProfilerPopup : public Component,
+					   public PooledUIUpdater::SimpleTimer
+{
+	static constexpr int RowHeight = 24;
+	static constexpr int HeaderHeight = 32;
+	static constexpr int FooterHeight = 24;
+
+	ProfilerPopup(DspNetwork* n) :
+		SimpleTimer(n->getMainController()->getGlobalUIUpdater()),
+		network(n),
+		exportButton("Export trace"),
+		clearButton("Clear")
+	{
+		setName(n->getId() + " CPU Profile");
+
+		addAndMakeVisible(exportButton);
+		addAndMakeVisible(clearButton);
+
+		exportButton.onClick = [this]()
+		{
+			if (network == nullptr || network->getProfiler() == nullptr)
+				return;
+
+			FileChooser fc("Export Chrome trace", File::getSpecialLocation(File::userDesktopDirectory).getChildFile(network->getId() + "_trace.json"), "*.json");
+
+			if (fc.browseForFileToSave(true))
+			{
+				auto r = network->getProfiler()->exportTrace(fc.getResult());
+
+				if (r.failed())
+					PresetHandler::showMessageWindow("Export failed", r.getErrorMessage(), PresetHandler::IconType::Error);
+			}
+		};
+
+		clearButton.onClick = [this]()
+		{
+			if (network != nullptr && network->getProfiler() != nullptr)
+				network->getProfiler()->clear();
+
+			repaint();
+		};
+
+		setSize(900, HeaderHeight + 6 * RowHeight + FooterHeight);
+		setRepaintsOnMouseActivity(true);
+		start();
+	};
+
+	void timerCallback() override
+	{
+		if (network == nullptr)
+		{
+			stop();
+			repaint();
+			return;
+		}
+
+		if (auto p = network->getProfiler())
+			p->collect();
+
+		repaint();
+	}
+
+	void resized() override
+	{
+		auto b = getLocalBounds().removeFromTop(HeaderHeight).reduced(4);
+		exportButton.setBounds(b.removeFromRight(100));
+		b.removeFromRight(4);
+		clearButton.setBounds(b.removeFromRight(60));
+	}
+
+	void mouseMove(const MouseEvent& e) override
+	{
+		hoverPosition = e.getPosition();
+	}
+
+	void mouseExit(const MouseEvent& ) override
+	{
+		hoverPosition = { -1, -1 };
+	}
+
+	void paint(Graphics& g) override
+	{
+		auto profiler = network != nullptr ? network->getProfiler() : nullptr;
+
+		if (profiler == nullptr || network->getRootNode() == nullptr)
+		{
+			g.setFont(GLOBAL_BOLD_FONT());
+			g.setColour(Colours::white.withAlpha(0.3f));
+			g.drawText("No profile data available", getLocalBounds().toFloat(), Justification::centred);
+			return;
+		}
+
+		auto b = getLocalBounds();
+		auto header = b.removeFromTop(HeaderHeight).reduced(4).toFloat();
+		auto footer = b.removeFromBottom(FooterHeight).reduced(4).toFloat();
+
+		g.setFont(GLOBAL_BOLD_FONT());
+		g.setColour(Colours::white.withAlpha(0.6f));
+
+		String info;
+		info << "Block duration: " << String(profiler->getBlockDurationMs(), 2) << "ms";
+
+		if (auto numDropped = profiler->getNumDroppedSamples())
+			info << ", dropped samples: " << String(numDropped);
+
+		g.drawText(info, header, Justification::centredLeft);
+
+		hoverStatistics = {};
+
+		auto rootStats = profiler->getStatistics(network->getRootNode());
+		paintNode(g, *profiler, rootStats, b.removeFromTop(RowHeight).toFloat(), b);
+
+		g.setColour(Colours::white.withAlpha(0.6f));
+
+		if (auto n = hoverStatistics.node.get())
+		{
+			String s;
+			s << n->getId() << ": " << "min " << String(hoverStatistics.minMs, 3) << "ms, avg " << String(hoverStatistics.averageMs, 3) << "ms, p99 "
+			  << String(hoverStatistics.p99Ms, 3) << "ms, max " << String(hoverStatistics.maxMs, 3) << "ms, " << String(hoverStatistics.numCallsPerBlock) << " calls per block";
+
+			g.drawText(s, footer, Justification::centredLeft);
+		}
+		else
+		{
+			g.drawText("Hover over a node to show its statistics", footer, Justification::centredLeft);
+		}
+	}
+
+	void paintNode(Graphics& g, NetworkProfiler& profiler, const NetworkProfiler::NodeStatistics& s, Rectangle<float> area, Rectangle<int> remaining)
+	{
+		auto n = s.node.get();
+
+		if (n == nullptr || area.getWidth() < 1.0f)
+			return;
+
+		auto blockDuration = profiler.getBlockDurationMs();
+		auto ratio = blockDuration > 0.0 ? jlimit(0.0, 1.0, s.averageMs / blockDuration) : 0.0;
+
+		auto nodeColour = Colour((uint32)(int64)n->getValueTree()[PropertyIds::NodeColour]);
+
+		if (nodeColour.isTransparent())
+			nodeColour = Colour(0xFF666666);
+
+		auto r = area.reduced(0.5f);
+		auto isHovered = r.contains(hoverPosition.toFloat());
+
+		if (isHovered)
+			hoverStatistics = s;
+
+		g.setColour(nodeColour.withMultipliedSaturation(0.6f).interpolatedWith(Colour(0xFFBB3434), (float)ratio).withMultipliedBrightness(isHovered ? 1.2f : 1.0f));
+		g.fillRect(r);
+
+		if (r.getWidth() > 30.0f)
+		{
+			String text;
+			text << n->getId() << " - " << String(ratio * 100.0, 1) << "%";
+
+			g.setColour(Colours::white.withAlpha(0.8f));
+			g.setFont(GLOBAL_FONT());
+			g.drawText(text, r.reduced(3.0f, 0.0f), Justification::centredLeft, true);
+		}
+
+		auto container = dynamic_cast<NodeContainer*>(n);
+
+		if (container == nullptr || remaining.getHeight() < RowHeight || s.averageMs <= 0.0)
+			return;
+
+		auto childRow = remaining.removeFromTop(RowHeight).toFloat();
+		auto x = area.getX();
+
+		for (auto c : container->getNodeList())
+		{
+			auto cs = profiler.getStatistics(c.get());
+			auto w = jmin(area.getRight() - x, area.getWidth() * (float)(cs.averageMs / s.averageMs));
+
+			paintNode(g, profiler, cs, { x, childRow.getY(), w, childRow.getHeight() }, remaining);
+			x += w;
+		}
+	}
+
+	WeakReference<DspNetwork> network;
+	TextButton exportButton;
+	TextButton clearButton;
+
+	Point<int> hoverPosition = { -1, -1 };
+	NetworkProfiler::NodeStatistics hoverStatistics;
+};
+
 bool DspNetworkGraph::Actions::showParameterPopup(DspNetworkGraph& g)
 {
 	auto s = new ParameterPopup(g.network.get());
@@ -2211,6 +2407,36 @@ bool DspNetworkGraph::Actions::showParameterPopup(DspNetworkGraph& g)
 	return true;
 }
 
+bool DspNetworkGraph::Actions::showProfilerPopup(DspNetworkGraph& g)
+{
+	auto ft = g.findParentComponentOfClass<FloatingTile>();
+
+	if (ft == nullptr)
+		return false;
+
+	auto wb = g.findParentComponentOfClass<WrapperWithMenuBar>();
+
+	Component* b = nullptr;
+
+	Component::callRecursive<ActionButton>(wb, [&b](ActionButton* p)
+	{
+		if (p->getName() == "profile")
+		{
+			b = p;
+			return true;
+		}
+
+		return false;
+	});
+
+	if (b == nullptr)
+		b = &g;
+
+	ft->showComponentInRootPopup(new ProfilerPopup(g.network.get()), b, { 12, 24 });
+
+	return true;
+}
+
 bool DspNetworkGraph::Actions::undo(DspNetworkGraph& g)
 {
 	if (auto um = g.network->getUndoManager())
@@ -2713,7 +2939,7 @@ void DspNetworkGraph::WrapperWithMenuBar::addButton(const String& name)
 	{
 		b->actionFunction = Actions::toggleCpuProfiling;
 		b->stateFunction = [](DspNetworkGraph& g) { return g.network->getCpuProfileFlag(); };
-		b->setTooltip("Activate CPU profiling");
+		b->setTooltip("Activate CPU profiling and show the profile of each node");
 	}
 	if (name == "debug")
 	{
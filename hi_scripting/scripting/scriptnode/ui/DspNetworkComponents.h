@@ -783,6 +783,7 @@ public:
 		static bool copyToClipboard(DspNetworkGraph& g);
 		static bool toggleCableDisplay(DspNetworkGraph& g);
 		static bool toggleCpuProfiling(DspNetworkGraph& g);
+		static bool showProfilerPopup(DspNetworkGraph& g);
 		static bool editNodeProperty(DspNetworkGraph& g);
 		static bool foldSelection(DspNetworkGraph& g);
 		static bool foldUnselectedNodes(DspNetworkGraph& g);
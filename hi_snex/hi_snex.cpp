@@ -126,5 +126,6 @@ using String = juce::String;
 #include "snex_library/snex_ExternalObjects.cpp"
 
 #include "snex_public/snex_jit_JitCompiledNode.cpp"
+#include "snex_public/snex_jit_CodeCache.cpp"
 
 #endif
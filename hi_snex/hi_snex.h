@@ -70,6 +70,14 @@ Enables SIMD processing for consecutive float spans (not functional yet).
 #define SNEX_ENABLE_SIMD 0
 #endif
 
+/** Config: SNEX_ENABLE_AVX
+
+Allows the loop vectoriser to use 8-wide AVX lanes if the host CPU supports it (otherwise it falls back to SSE). 
+*/
+#ifndef SNEX_ENABLE_AVX
+#define SNEX_ENABLE_AVX 1
+#endif
+
 
 
 #include "../JUCE/modules/juce_gui_extra/juce_gui_extra.h"
@@ -110,6 +118,16 @@ Set to 1 if you want the memory address to be included in the data dump string.
 #define SNEX_INCLUDE_MEMORY_ADDRESS_IN_DUMP 0
 #endif
 
+/** Config: SNEX_ENABLE_CODE_CACHE
+
+Set to 1 to store the machine code of compiled SNEX classes in the app data directory so that unchanged code
+can be relinked without running the code generator. This is disabled by default until the relinker has been
+tested on more systems.
+*/
+#ifndef SNEX_ENABLE_CODE_CACHE
+#define SNEX_ENABLE_CODE_CACHE 0
+#endif
+
 #include "../hi_lac/hi_lac.h"
 #include "../hi_dsp_library/hi_dsp_library.h"
 
@@ -242,6 +260,7 @@ namespace snex
 #include "snex_core/snex_jit_FunctionClass.h"
 #include "snex_core/snex_jit_NamespaceHandler.h"
 #include "snex_core/snex_jit_BaseScope.h"
+#include "snex_public/snex_jit_CodeCache.h"
 #include "snex_public/snex_jit_GlobalScope.h"
 #include "snex_core/snex_jit_JitCallableObject.h"
 #include "snex_core/snex_jit_JitCompiledFunctionClass.h"
@@ -45,6 +45,7 @@ using String = juce::String;
 #include "unit_test/snex_jit_UnitTestCase.cpp"
 #include "unit_test/snex_jit_IndexTest.cpp"
 #include "unit_test/snex_jit_UnitTests.cpp"
+#include "unit_test/snex_jit_CodeCacheTest.cpp"
 #include "api/SnexApi.cpp"
 
 #include "snex_components/snex_DebugTools.cpp"
@@ -245,6 +245,7 @@ snex::ui::WorkbenchData::Ptr ui::WorkbenchManager::getWorkbenchDataForCodeProvid
 
 	WorkbenchData::Ptr w = new WorkbenchData();
 
+	w->getGlobalScope().setCodeCache(codeCache);
 	w->setCodeProvider(p, dontSendNotification);
 
 	if (ownCodeProvider)
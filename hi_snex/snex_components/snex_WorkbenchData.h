@@ -1407,6 +1407,15 @@ public:
 	
 	WorkbenchData::Ptr getRootWorkbench() { return rootWb; }
 
+	/** Sets the directory for the code cache that is shared between all workbenches. */
+	void setCodeCacheDirectory(const File& directory)
+	{
+		codeCache = new CodeCache(directory);
+
+		for (auto w : data)
+			w->getGlobalScope().setCodeCache(codeCache);
+	}
+
 	void removeWorkbench(WorkbenchData::Ptr p)
 	{
 		data.removeObject(p);
@@ -1425,6 +1434,8 @@ private:
 
 	LogFunction logFunction;
 
+	CodeCache::Ptr codeCache;
+
 	Array<WeakReference<WorkbenchChangeListener>> listeners;
 
 	OwnedArray<WorkbenchData::CodeProvider> codeProviders;
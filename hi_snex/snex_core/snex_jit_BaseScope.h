@@ -306,6 +306,8 @@ public:
 
 	HeapBlock<char> data;
 
+	size_t getDataSize() const { return (size_t)allocatedSize; }
+
 private:
 
 	TableEntry* getTableEntry(const Symbol& s)
@@ -109,7 +109,12 @@ public:
 
 			executePass(ComplexTypeParsing, newScope->pimpl, sTree);
 
-			newScope->pimpl->getRootData()->finalise();
+			auto rootData = newScope->pimpl->getRootData();
+
+			rootData->finalise();
+
+			if (codeCacheUnit != nullptr)
+				codeCacheUnit->setClassData(rootData->data.get(), rootData->getDataSize());
 
 			executePass(DataAllocation, newScope->pimpl, sTree);
 			executePass(DataInitialisation, newScope->pimpl, sTree);
@@ -163,6 +168,8 @@ public:
 
 	asmjit::X86Compiler* asmCompiler;
 
+	ScopedPointer<CodeCache::Unit> codeCacheUnit;
+
 	juce::String assembly;
 
 	Result lastResult;
@@ -75,6 +75,24 @@ bool SpanType::isSimd() const
 	return false;
 }
 
+bool SpanType::isSimd8Type(const TypeInfo& t)
+{
+#if SNEX_ENABLE_SIMD
+	if (auto st = t.getTypedIfComplexType<SpanType>())
+	{
+		return st->isSimd8();
+	}
+#endif
+
+	return false;
+}
+
+bool SpanType::isSimd8() const
+{
+	return getElementType() == Types::ID::Float && getNumElements() == 8 && 
+		   hasAlias() && getAlias() == NamespacedIdentifier("float8");
+}
+
 void SpanType::finaliseAlignment()
 {
 	if (elementType.isComplexType())
@@ -235,6 +253,51 @@ snex::jit::FunctionClass* SpanType::getFunctionClass()
 		};
 	}
 
+	{
+		auto toSimd8Function = new FunctionData();
+		toSimd8Function->id = st->getClassName().getChildId("toSimd8");
+		toSimd8Function->returnType = TypeInfo(Types::ID::Dynamic, false, true);
+		toSimd8Function->inliner = Inliner::createAsmInliner(toSimd8Function->id, [](InlineData* b)
+		{
+			auto d = b->toAsmInlineData();
+
+			if (!d->gen.canVectorize())
+				return Result::fail("Vectorization is deactivated");
+
+			if (!AsmCodeGenerator::canUseAvx())
+				return Result::fail("AVX is not supported on this CPU");
+
+			if (d->object->isMemoryLocation())
+				d->target->setCustomMemoryLocation(d->object->getAsMemoryLocation(), d->object->isGlobalMemory());
+			else
+				d->target->setCustomMemoryLocation(x86::qword_ptr(PTR_REG_R(d->object)), d->object->isGlobalMemory());
+
+			return Result::ok();
+		});
+
+		toSimd8Function->inliner->returnTypeFunction = [this](InlineData* d)
+		{
+			auto rt = dynamic_cast<ReturnTypeInlineData*>(d);
+
+			auto& handler = rt->object->currentCompiler->namespaceHandler;
+
+			if (getNumElements() % 8 != 0)
+				return Result::fail("Can't convert to AVX lanes");
+
+			auto float8Type = new SpanType(TypeInfo(Types::ID::Float), 8);
+			float8Type->setAlias(NamespacedIdentifier("float8"));
+
+			ComplexType::Ptr laneType = handler.registerComplexTypeOrReturnExisting(float8Type);
+			ComplexType::Ptr simdArrayType = new SpanType(TypeInfo(laneType), getNumElements() / 8);
+			simdArrayType = handler.registerComplexTypeOrReturnExisting(simdArrayType);
+			rt->f.returnType = TypeInfo(simdArrayType, false, true);
+
+			return Result::ok();
+		};
+
+		st->addFunction(toSimd8Function);
+	}
+
 	return st;
 }
 
@@ -260,7 +323,8 @@ size_t SpanType::getRequiredAlignment() const
 	if (elementSize == 0)
 		return 1;
 
-	if (isSimd())
+	// float8 lanes are accessed with unaligned loads, so they don't need more than the float4 alignment
+	if (isSimd() || isSimd8())
 	{
 		return 16;
 	}
@@ -108,6 +108,10 @@ struct SpanType : public ArrayTypeBase
 			if (otherSpan->getNumElements() != getNumElements())
 				return false;
 
+			// the AVX lane type must not be mixed up with a plain span<float, 8>
+			if (otherSpan->isSimd8() != isSimd8())
+				return false;
+
 			return true;
 		}
 
@@ -137,6 +141,11 @@ struct SpanType : public ArrayTypeBase
 
 	bool isSimd() const;
 
+	/** Checks whether the type is the 8-wide AVX lane type that is created by the loop vectoriser. */
+	static bool isSimd8Type(const TypeInfo& t);
+
+	bool isSimd8() const;
+
 	size_t getElementSize() const;
 
 private:
@@ -303,7 +303,14 @@ void AssemblyRegister::loadMemoryIntoRegister(asmjit::X86Compiler& cc, bool forc
 	}
 	case Types::ID::Pointer:
 	{
-		if (isSimd4Float())
+		if (isSimd8Float())
+		{
+			auto p = AsmCodeGenerator::createValid64BitPointer(cc, memory, 0, 32);
+
+			cc.vmovups(reg.as<x86::Ymm>(), p);
+			jassert(reg.isYmm());
+		}
+		else if (isSimd4Float())
 		{
             auto p = AsmCodeGenerator::createValid64BitPointer(cc, memory, 0, 16);
             
@@ -473,7 +480,9 @@ void AssemblyRegister::createRegister(asmjit::X86Compiler& cc)
 		reg = cc.newGpq();
 	if (getType() == Types::Pointer)
 	{
-		if (isSimd4Float())
+		if (isSimd8Float())
+			reg = AsmCodeGenerator::newAvxRegister(cc);
+		else if (isSimd4Float())
 			reg = cc.newXmmPs();
 		else
 			reg = cc.newGpq();
@@ -610,6 +619,20 @@ bool AssemblyRegister::isSimd4Float() const
 	return false;
 }
 
+bool AssemblyRegister::isSimd8Float() const
+{
+	if (isReferencingOtherRegister())
+		return getReferenceTargetRegister()->isSimd8Float();
+
+	if (!compiler->getOptimizations().contains(OptimizationIds::AutoVectorisation))
+		return false;
+
+	if (auto st = type.getTypedIfComplexType<SpanType>())
+		return st->isSimd8();
+
+	return false;
+}
+
 void AssemblyRegister::setDirtyFloat4(Ptr source, int byteOffset)
 {
 	if (source->isGlobalMemory())
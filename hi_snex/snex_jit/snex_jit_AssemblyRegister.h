@@ -202,6 +202,8 @@ public:
 
 	bool isSimd4Float() const;
 
+	bool isSimd8Float() const;
+
 	void setDirtyFloat4(Ptr source, int byteOffset);
 
 	void setUndirty();
@@ -110,7 +110,12 @@ void AsmCodeGenerator::emitStore(RegPtr target, RegPtr value)
 			IF_(int)    INT_OP(cc.xor_, target, target);
 			IF_(void*)
 			{
-				if (target->isSimd4Float())
+				if (target->isSimd8Float())
+				{
+					auto r = AVX_REG_W(target);
+					cc.vxorps(r, r, r);
+				}
+				else if (target->isSimd4Float())
 				{
 					FP_OP(cc.xorps, target, target);
 				}
@@ -149,7 +154,33 @@ void AsmCodeGenerator::emitStore(RegPtr target, RegPtr value)
 	
 	IF_(void*)
 	{
-		if (target->isSimd4Float())
+		if (target->isSimd8Float())
+		{
+			x86::Ymm v;
+
+			if (value->isSimd8Float())
+			{
+				value->loadMemoryIntoRegister(cc);
+				v = AVX_REG_R(value);
+			}
+			else
+			{
+				v = newAvxRegister(cc);
+				emitAvxBroadcast(v, value);
+			}
+
+			if (target->hasCustomMemoryLocation())
+			{
+				target->invalidateRegisterForCustomMemory();
+				cc.vmovups(target->getMemoryLocationForReference().cloneResized(32), v);
+			}
+			else
+			{
+				jassert(!target->isMemoryLocation());
+				cc.vmovaps(AVX_REG_W(target), v);
+			}
+		}
+		else if (target->isSimd4Float())
 		{
 			if (value->isSimd4Float())
 			{
@@ -246,7 +277,11 @@ void AsmCodeGenerator::emitMemoryWrite(RegPtr source, void* ptrToUse)
 	IF_(float)	ok = cc.movss(target.cloneResized(4), FP_REG_R(source));
 	IF_(double) ok = cc.movsd(target, FP_REG_R(source));
 	
-	if (source->isSimd4Float())
+	if (source->isSimd8Float())
+	{
+		cc.vmovups(target.cloneResized(32), AVX_REG_R(source));
+	}
+	else if (source->isSimd4Float())
 	{
 		cc.movaps(target, FP_REG_R(source));
 	}
@@ -486,7 +521,11 @@ void AsmCodeGenerator::emitParameter(Operations::Function* f, FuncNode* fn, RegP
 
 AsmCodeGenerator::RegPtr AsmCodeGenerator::emitBinaryOp(OpType op, RegPtr l, RegPtr r)
 {
-	if (l->isSimd4Float())
+	if (l->isSimd8Float())
+	{
+		emitAvxBinaryOp(op, l, r);
+	}
+	else if (l->isSimd4Float())
 	{
 		l->loadMemoryIntoRegister(cc);
 
@@ -612,8 +651,15 @@ AsmCodeGenerator::RegPtr AsmCodeGenerator::emitBinaryOp(OpType op, RegPtr l, Reg
 		IF_(double)		cc.movsd(target, FP_REG_R(l));
 		IF_(void*)
 		{
-			jassert(l->isSimd4Float());
-			cc.movaps(target, FP_REG_R(l));
+			if (l->isSimd8Float())
+			{
+				cc.vmovups(target.cloneResized(32), AVX_REG_R(l));
+			}
+			else
+			{
+				jassert(l->isSimd4Float());
+				cc.movaps(target, FP_REG_R(l));
+			}
 		}
 
 		if (l->isDirtyGlobalMemory())
@@ -623,6 +669,86 @@ AsmCodeGenerator::RegPtr AsmCodeGenerator::emitBinaryOp(OpType op, RegPtr l, Reg
 	return l;
 }
 
+void AsmCodeGenerator::emitAvxBinaryOp(OpType op, RegPtr l, RegPtr r)
+{
+	l->loadMemoryIntoRegister(cc);
+
+	auto lReg = AVX_REG_W(l);
+	x86::Ymm rReg;
+
+	if (r->isSimd8Float())
+	{
+		if (IS_REG(r))
+			rReg = AVX_REG_R(r);
+		else
+		{
+			rReg = newAvxRegister(cc);
+			cc.vmovups(rReg, createValid64BitPointer(cc, FP_MEM(r), 0, 32));
+		}
+	}
+	else
+	{
+		jassert(r->getType() == Types::ID::Float);
+		rReg = newAvxRegister(cc);
+		emitAvxBroadcast(rReg, r);
+	}
+
+	if (op == JitTokens::plus)
+		cc.vaddps(lReg, lReg, rReg);
+	if (op == JitTokens::times)
+		cc.vmulps(lReg, lReg, rReg);
+	if (op == JitTokens::minus)
+		cc.vsubps(lReg, lReg, rReg);
+	if (op == JitTokens::assign_)
+		cc.vmovaps(lReg, rReg);
+}
+
+void AsmCodeGenerator::emitAvxBroadcast(x86::Ymm target, RegPtr scalarValue)
+{
+	jassert(scalarValue->getType() == Types::ID::Float);
+
+	float immValue;
+
+	if (scalarValue->getImmediateValue(immValue))
+	{
+		auto c = cc.newFloatConst(ConstPoolScope::kGlobal, immValue);
+		cc.vbroadcastss(target, c);
+	}
+	else if (scalarValue->isMemoryLocation() || IS_CMEM(scalarValue))
+	{
+		cc.vbroadcastss(target, createValid64BitPointer(cc, FP_MEM(scalarValue), 0, 4));
+	}
+	else
+	{
+		// vbroadcastss with a register source needs AVX2, so we go through the stack
+		auto m = cc.newStack(4, 4);
+		cc.movss(m, FP_REG_R(scalarValue));
+		cc.vbroadcastss(target, m);
+	}
+}
+
+x86::Ymm AsmCodeGenerator::newAvxRegister(X86Compiler& cc)
+{
+	jassert(canUseAvx());
+
+	if (auto f = cc.func())
+	{
+		f->frame().setAvxEnabled();
+		f->frame().setAvxCleanup();
+	}
+
+	return cc.newYmmPs();
+}
+
+bool AsmCodeGenerator::canUseAvx()
+{
+#if SNEX_ENABLE_AVX
+	return SystemStats::hasAVX();
+#else
+	return false;
+#endif
+}
+
 void AsmCodeGenerator::emitLogicOp(Operations::BinaryOp* op)
 {
 	auto lExpr = op->getSubExpr(0);
@@ -675,6 +801,36 @@ void AsmCodeGenerator::emitSpanReference(RegPtr target, RegPtr address, RegPtr i
 {
 	jassert(index->getType() == Types::ID::Integer);
 
+	if (address->isSimd8Float() && !address->isMemoryLocation())
+	{
+		jassert(additionalOffsetInBytes == 0);
+		jassert(target->getType() == Types::ID::Float);
+
+		// Extracting a single lane from a ymm register is not worth the shuffling, 
+		// so we just spill it to the stack and read the float from there
+		address->loadMemoryIntoRegister(cc);
+
+		auto m = cc.newStack(32, 32);
+		cc.vmovups(m, AVX_REG_R(address));
+
+		auto c = cc.newGpq();
+		cc.lea(c, m);
+
+		X86Mem p;
+
+		if (index->isMemoryLocation())
+		{
+			int idx = index->getImmediateIntValue();
+			jassert(isPositiveAndBelow(idx, 8));
+			p = x86::ptr(c, idx * (int)sizeof(float), 4);
+		}
+		else
+			p = x86::ptr(c, INT_REG_R(index), 2, 0, 4);
+
+		target->setCustomMemoryLocation(p, false);
+		return;
+	}
+
 	if (address->isSimd4Float() && !address->isMemoryLocation())
 	{
 		jassert(additionalOffsetInBytes == 0);
@@ -832,7 +988,7 @@ void AsmCodeGenerator::emitSpanReference(RegPtr target, RegPtr address, RegPtr i
 	
 	if (type == Types::ID::Pointer)
 	{
-        if(target->isSimd4Float())
+        if(target->isSimd4Float() || target->isSimd8Float())
         {
 			target->setCustomMemoryLocation(p, address->isGlobalMemory());
         }
@@ -41,6 +41,8 @@ using namespace asmjit;
 #define FP_REG_W(x) x->getRegisterForWriteOp().as<X86Xmm>()
 #define FP_REG_R(x) x->getRegisterForReadOp().as<X86Xmm>()
 #define FP_MEM(x) x->getAsMemoryLocation()
+#define AVX_REG_W(x) x->getRegisterForWriteOp().as<x86::Ymm>()
+#define AVX_REG_R(x) x->getRegisterForReadOp().as<x86::Ymm>()
 #define IS_MEM(x) x->isMemoryLocation()
 #define IS_IMM(x) x->isImmediate()
 #define IS_CMEM(x) x->hasCustomMemoryLocation() && !x->isActive()
@@ -240,6 +242,18 @@ struct AsmCodeGenerator
 
 	RegPtr emitBinaryOp(OpType op, RegPtr l, RegPtr r);
 
+	/** Emits a binary operation on a float8 register using the 256 bit AVX instructions. */
+	void emitAvxBinaryOp(OpType op, RegPtr l, RegPtr r);
+
+	/** Fills all eight lanes of the target with the given scalar float value. */
+	void emitAvxBroadcast(x86::Ymm target, RegPtr scalarValue);
+
+	/** Creates a 256 bit register and tells the function frame to use VEX encoded spills and a vzeroupper on exit. */
+	static x86::Ymm newAvxRegister(X86Compiler& cc);
+
+	/** Checks whether the host CPU supports AVX (and it's enabled with SNEX_ENABLE_AVX). */
+	static bool canUseAvx();
+
 	void emitCompare(bool useAsmFlags, OpType op, RegPtr target, RegPtr l, RegPtr r);
 
 	void emitReturn(BaseCompiler* c, RegPtr target, RegPtr expr);
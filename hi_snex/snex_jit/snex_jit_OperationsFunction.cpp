@@ -503,6 +503,25 @@ void Operations::Function::process(BaseCompiler* compiler, BaseScope* scope)
 
 void* Operations::Function::compileFunction(FunctionCompileData& f, const FunctionCompileData::InnerFunction& func)
 {
+	auto cacheUnit = dynamic_cast<ClassCompiler*>(f.compiler)->codeCacheUnit.get();
+	juce::String cacheId;
+
+	if (cacheUnit != nullptr)
+	{
+		cacheId = cacheUnit->getNextFunctionId(f.data.getSignature());
+
+		if (auto cachedFunction = relinkFromCodeCache(f, *cacheUnit, cacheId))
+		{
+			cacheUnit->addFunction(reinterpret_cast<uint64>(cachedFunction));
+			f.data.function = cachedFunction;
+
+			auto& as = dynamic_cast<ClassCompiler*>(f.compiler)->assembly;
+			as << "; function " << f.data.getSignature() << " (relinked from code cache)\n";
+
+			return f.data.function;
+		}
+	}
+
 	f.assemblyLogger = new asmjit::StringLogger();
 
 	auto runtime = getRuntime(f.compiler);
@@ -535,12 +554,26 @@ void* Operations::Function::compileFunction(FunctionCompileData& f, const Functi
 	if (p != nullptr)
 		f.cc->deletePass(p);
 
+	CodeCache::CompiledCode compiledCode;
+
+	if (cacheUnit != nullptr)
+		collectAbsoluteValues(*f.cc, compiledCode);
+
 	f.cc = nullptr;
 
 	(asmjit::ErrorCode)runtime->add(&f.data.function, ch);
 
 	jassert(f.data.function != nullptr);
 
+	if (cacheUnit != nullptr && f.data.function != nullptr)
+	{
+		auto address = reinterpret_cast<uint64>(f.data.function);
+
+		collectRelocations(*ch, f.data.function, compiledCode);
+		cacheUnit->store(cacheId, compiledCode, address);
+		cacheUnit->addFunction(address);
+	}
+
 	auto& as = dynamic_cast<ClassCompiler*>(f.compiler)->assembly;
 
 	juce::String fName = f.data.getSignature();
@@ -555,6 +588,111 @@ void* Operations::Function::compileFunction(FunctionCompileData& f, const Functi
 	return f.data.function;
 }
 
+void* Operations::Function::relinkFromCodeCache(FunctionCompileData& f, CodeCache::Unit& unit, const juce::String& functionId)
+{
+	auto numBytes = unit.getCachedCodeSize(functionId);
+
+	if (numBytes == 0)
+		return nullptr;
+
+	auto allocator = getRuntime(f.compiler)->allocator();
+
+	void* rx = nullptr;
+	void* rw = nullptr;
+
+	if (allocator->alloc(&rx, &rw, numBytes) != asmjit::kErrorOk)
+		return nullptr;
+
+	bool ok;
+
+	{
+		asmjit::VirtMem::ProtectJitReadWriteScope rwScope(rx, numBytes);
+		ok = unit.relink(functionId, reinterpret_cast<uint64>(rx), static_cast<uint8*>(rw));
+	}
+
+	if (!ok)
+	{
+		allocator->release(rx);
+		return nullptr;
+	}
+
+	return rx;
+}
+
+void Operations::Function::collectAbsoluteValues(asmjit::X86Compiler& cc, CodeCache::CompiledCode& code)
+{
+	for (auto node = cc.firstNode(); node != nullptr; node = node->next())
+	{
+		if (node->isInst())
+		{
+			auto inst = node->as<asmjit::InstNode>();
+
+			for (uint32_t i = 0; i < inst->opCount(); i++)
+			{
+				const auto& op = inst->op(i);
+
+				if (op.isImm())
+				{
+					code.absoluteValues.add(op.as<asmjit::Imm>().valueAs<uint64_t>());
+				}
+				else if (op.isMem())
+				{
+					const auto& m = op.as<X86Mem>();
+
+					if (!m.hasBase() && !m.hasIndex())
+						code.absoluteValues.add((uint64)m.offset());
+				}
+			}
+		}
+	}
+}
+
+void Operations::Function::collectRelocations(asmjit::CodeHolder& ch, void* function, CodeCache::CompiledCode& code)
+{
+	code.data = static_cast<const uint8*>(function);
+	code.size = ch.codeSize();
+
+	for (auto re : ch.relocEntries())
+	{
+		auto type = re->relocType();
+
+		if (type == asmjit::RelocType::kNone)
+			continue;
+
+		if (type != asmjit::RelocType::kAbsToRel && type != asmjit::RelocType::kX64AddressEntry)
+		{
+			// Label addresses & expressions are not supported
+			code.canBeCached = false;
+			return;
+		}
+
+		if (re->format().valueSize() != 4)
+		{
+			code.canBeCached = false;
+			return;
+		}
+
+		auto offset = ch.sectionById(re->sourceSectionId())->offset() + re->sourceOffset() + re->format().valueOffset();
+
+		if (offset < 2 || offset + 4 > code.size)
+		{
+			code.canBeCached = false;
+			return;
+		}
+
+		if (type == asmjit::RelocType::kX64AddressEntry)
+		{
+			auto modByte = code.data[offset - 1];
+
+			// The call was redirected to the address table (which will be picked up as absolute value)
+			if (code.data[offset - 2] == 0xFF && (modByte == 0x15 || modByte == 0x25))
+				continue;
+		}
+
+		code.relativeTargets.add({ (uint32)offset, re->payload() });
+	}
+}
+
 void Operations::Function::compileSyntaxTree(FunctionCompileData& f)
 {
 	auto compiler = f.compiler;
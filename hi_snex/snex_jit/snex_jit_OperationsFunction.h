@@ -139,6 +139,15 @@ private:
 	/** Compiles a function call with a asm inliner. */
 	void compileAsmInlinerBeforeCodegen(FunctionCompileData& f);;
 
+	/** Copies the cached machine code into the runtime and returns the function pointer (or nullptr if it's not cached). */
+	static void* relinkFromCodeCache(FunctionCompileData& f, CodeCache::Unit& unit, const juce::String& functionId);
+
+	/** Collects all absolute values that the instructions of the function compiler refer to. */
+	static void collectAbsoluteValues(asmjit::X86Compiler& cc, CodeCache::CompiledCode& code);
+
+	/** Adds the relocated code and the address targets of the code holder after it was added to the runtime. */
+	static void collectRelocations(asmjit::CodeHolder& ch, void* function, CodeCache::CompiledCode& code);
+
 	// member functions will not be owned by the StructType
 	ScopedPointer<FunctionData> ownedMemberFunction;
 
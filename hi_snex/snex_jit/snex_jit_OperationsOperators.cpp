@@ -175,11 +175,13 @@ void Operations::Assignment::process(BaseCompiler* compiler, BaseScope* scope)
 			setTypeForChild(1, assignedType);
 		}
 
-		auto targetIsSimd = SpanType::isSimdType(getSubExpr(1)->getTypeInfo());
+		auto resolvedTargetType = getSubExpr(1)->getTypeInfo();
+		auto targetIsSimd = SpanType::isSimdType(resolvedTargetType) || SpanType::isSimd8Type(resolvedTargetType);
 
 		if (targetIsSimd)
 		{
-			auto valueIsSimd = SpanType::isSimdType(getSubExpr(0)->getTypeInfo());
+			auto valueType = getSubExpr(0)->getTypeInfo();
+			auto valueIsSimd = SpanType::isSimdType(valueType) || SpanType::isSimd8Type(valueType);
 
 			if (!valueIsSimd)
 				setTypeForChild(0, TypeInfo(Types::ID::Float));
@@ -868,7 +868,10 @@ bool BinaryOpOptimizer::processStatementInternal(BaseCompiler* compiler, BaseSco
 
 				if (auto bOp = as<BinaryOp>(a->getSubExpr(0)))
 				{
-					if (isAssignedVariable(bOp->getSubExpr(0)) && !SpanType::isSimdType(a->getSubExpr(1)->getTypeInfo()))
+					auto targetType = a->getSubExpr(1)->getTypeInfo();
+					auto isSimdTarget = SpanType::isSimdType(targetType) || SpanType::isSimd8Type(targetType);
+
+					if (isAssignedVariable(bOp->getSubExpr(0)) && !isSimdTarget)
 					{
 						a->logOptimisationMessage("Replace " + juce::String(bOp->op) + " with self assignment");
 						a->assignmentType = bOp->op;
@@ -1577,7 +1580,10 @@ bool LoopVectoriser::convertToSimd(BaseCompiler* c, Operations::Loop* l)
 			if (isNonSimdableSpan)
 				return false;
 
-			changeIteratorTargetToSimd(l);
+			// Use 8-wide AVX lanes if the span fits and the CPU supports it, otherwise fall back to SSE
+			auto useAvx = AsmCodeGenerator::canUseAvx() && (asSpan->getNumElements() % 8) == 0;
+
+			changeIteratorTargetToSimd(l, useAvx);
 			
 			return true;
 		}
@@ -1626,11 +1632,13 @@ bool LoopVectoriser::convertToSimd(BaseCompiler* c, Operations::Loop* l)
 	return false;
 }
 
-juce::Result LoopVectoriser::changeIteratorTargetToSimd(Operations::Loop* l)
+juce::Result LoopVectoriser::changeIteratorTargetToSimd(Operations::Loop* l, bool useAvx)
 {
 	auto t = l->getTarget();
 
-	auto newCall = new Operations::FunctionCall(t->location, nullptr, { NamespacedIdentifier("toSimd"), TypeInfo(Types::ID::Dynamic) }, {});
+	NamespacedIdentifier fId(useAvx ? "toSimd8" : "toSimd");
+
+	auto newCall = new Operations::FunctionCall(t->location, nullptr, { fId, TypeInfo(Types::ID::Dynamic) }, {});
 
 	newCall->setObjectExpression(t->clone(t->location));
 	replaceExpression(t, newCall);
@@ -306,7 +306,7 @@ private:
 
 	bool convertToSimd(BaseCompiler* c, Operations::Loop* l);
 
-	Result changeIteratorTargetToSimd(Operations::Loop* l);
+	Result changeIteratorTargetToSimd(Operations::Loop* l, bool useAvx=false);
 
 	static bool isUnSimdableOperation(Ptr s);
 };
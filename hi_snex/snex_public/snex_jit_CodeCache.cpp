@@ -0,0 +1,542 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+#if JUCE_WINDOWS
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+namespace snex {
+namespace jit {
+using namespace juce;
+
+namespace CodeCacheFormat
+{
+	static constexpr int Magic = 0x43584e53;
+	static constexpr int Version = 1;
+	static constexpr int DataAlignment = 16;
+
+	/** The number of bytes of a serialised relocation. */
+	static constexpr int64 RelocationSize = 22;
+
+	/** Symbols in the lower 4GB might be encoded as 32 bit immediate which is not covered by the relocations. */
+	static constexpr uint64 MinAddress = 0xFFFFFFFFull;
+
+	/** Everything above the user space of a 64 bit address space is most likely a double constant. */
+	static constexpr uint64 MaxAddress = 1ull << 47;
+
+	static bool isAddress(uint64 v)
+	{
+		return v > MinAddress && v < MaxAddress;
+	}
+}
+
+CodeCache::Unit::Unit(const juce::String& key_, const GlobalScope& scope) :
+	key(key_)
+{
+	auto gs = reinterpret_cast<uint64>(&scope);
+	globalScope = { gs, gs + sizeof(GlobalScope) };
+	hostBinary = getHostBinaryBase(reinterpret_cast<const void*>(&CodeCache::getHostBinaryBase));
+}
+
+CodeCache::Unit::~Unit()
+{
+}
+
+void CodeCache::Unit::setClassData(const void* start, size_t numBytes)
+{
+	auto s = reinterpret_cast<uint64>(start);
+	classData = { s, s + numBytes };
+
+	auto alignment = (int)(s % CodeCacheFormat::DataAlignment);
+
+	if (cachedDataSize != (int64)numBytes || cachedDataAlignment != alignment)
+	{
+		// The data layout doesn't match the cached code anymore...
+		entries.clear();
+		cachedDataSize = (int64)numBytes;
+		cachedDataAlignment = alignment;
+	}
+}
+
+juce::String CodeCache::Unit::getNextFunctionId(const juce::String& signature) const
+{
+	return juce::String(addresses.size()) + " " + signature;
+}
+
+size_t CodeCache::Unit::getCachedCodeSize(const juce::String& functionId) const
+{
+	if (auto e = getEntry(functionId))
+		return e->code.getSize();
+
+	return 0;
+}
+
+bool CodeCache::Unit::relink(const juce::String& functionId, uint64 baseAddress, uint8* destination)
+{
+	auto e = getEntry(functionId);
+
+	if (e == nullptr)
+		return false;
+
+	memcpy(destination, e->code.getData(), e->code.getSize());
+
+	for (const auto& r : e->relocations)
+	{
+		uint64 target;
+
+		if (!resolve(r, baseAddress, target))
+			return false;
+
+		if (r.type == RelocationType::Absolute64)
+		{
+			memcpy(destination + r.offset, &target, sizeof(uint64));
+		}
+		else
+		{
+			auto rel = (int64)target - (int64)(baseAddress + (uint64)(int64)r.anchor);
+
+			if (rel < (int64)std::numeric_limits<int32>::min() || rel > (int64)std::numeric_limits<int32>::max())
+				return false;
+
+			auto rel32 = (int32)rel;
+			memcpy(destination + r.offset, &rel32, sizeof(int32));
+		}
+	}
+
+	numRelinked++;
+	return true;
+}
+
+void CodeCache::Unit::store(const juce::String& functionId, const CompiledCode& code, uint64 baseAddress)
+{
+	using namespace CodeCacheFormat;
+
+	if (!code.canBeCached || code.data == nullptr || code.size == 0)
+		return;
+
+	if (baseAddress <= MinAddress || globalScope.getStart() <= MinAddress || hostBinary <= MinAddress)
+		return;
+
+	if (!classData.isEmpty() && classData.getStart() <= MinAddress)
+		return;
+
+	for (auto a : addresses)
+	{
+		if (a <= MinAddress)
+			return;
+	}
+
+	ScopedPointer<FunctionEntry> e = new FunctionEntry();
+	e->id = functionId;
+	e->code.append(code.data, code.size);
+
+	Array<uint64> relativeValues;
+	SparseSet<uint32> usedBytes;
+
+	for (const auto& rt : code.relativeTargets)
+	{
+		Relocation r;
+
+		if (!classify(rt.second, baseAddress, code.size, r))
+			return;
+
+		relativeValues.add(rt.second);
+
+		// A displacement into the same code block is position independent
+		if (r.symbol == SymbolType::Code)
+			continue;
+
+		if ((size_t)rt.first + sizeof(int32) > code.size)
+			return;
+
+		int32 rel;
+		memcpy(&rel, code.data + rt.first, sizeof(int32));
+
+		r.offset = rt.first;
+		r.type = RelocationType::Relative32;
+		r.anchor = (int32)((int64)(rt.second - baseAddress) - (int64)rel);
+
+		e->relocations.add(r);
+		usedBytes.addRange({ r.offset, r.offset + (uint32)sizeof(int32) });
+	}
+
+	Array<uint64> absoluteValues;
+
+	for (auto v : code.absoluteValues)
+	{
+		if (isAddress(v))
+			absoluteValues.addIfNotAlreadyThere(v);
+	}
+
+	for (auto v : absoluteValues)
+	{
+		Relocation r;
+
+		if (!classify(v, baseAddress, code.size, r))
+			return;
+
+		bool found = relativeValues.contains(v);
+
+		for (uint32 i = 0; i + sizeof(uint64) <= code.size; i++)
+		{
+			uint64 x;
+			memcpy(&x, code.data + i, sizeof(uint64));
+
+			if (x == v)
+			{
+				if (usedBytes.overlapsRange({ i, i + (uint32)sizeof(uint64) }))
+					return;
+
+				r.offset = i;
+				r.type = RelocationType::Absolute64;
+				r.anchor = 0;
+
+				e->relocations.add(r);
+				usedBytes.addRange({ i, i + (uint32)sizeof(uint64) });
+				found = true;
+			}
+		}
+
+		// The address was encoded in a way that we can't relocate...
+		if (!found)
+			return;
+	}
+
+	for (int i = 0; i < entries.size(); i++)
+	{
+		if (entries[i]->id == functionId)
+			entries.remove(i--);
+	}
+
+	entries.add(e.release());
+	modified = true;
+}
+
+void CodeCache::Unit::addFunction(uint64 address)
+{
+	addresses.add(address);
+}
+
+bool CodeCache::Unit::classify(uint64 value, uint64 baseAddress, size_t codeSize, Relocation& r) const
+{
+	r.symbolIndex = 0;
+	r.anchor = 0;
+
+	auto functionIndex = addresses.indexOf(value);
+
+	if (functionIndex != -1)
+	{
+		r.symbol = SymbolType::Function;
+		r.symbolIndex = functionIndex;
+		r.addend = 0;
+		return true;
+	}
+
+	if (value >= baseAddress && value < baseAddress + codeSize)
+	{
+		r.symbol = SymbolType::Code;
+		r.addend = (int64)(value - baseAddress);
+		return true;
+	}
+
+	if (classData.contains(value))
+	{
+		r.symbol = SymbolType::ClassData;
+		r.addend = (int64)(value - classData.getStart());
+		return true;
+	}
+
+	if (globalScope.contains(value))
+	{
+		r.symbol = SymbolType::GlobalScope;
+		r.addend = (int64)(value - globalScope.getStart());
+		return true;
+	}
+
+	if (hostBinary != 0 && getHostBinaryBase(reinterpret_cast<const void*>(value)) == hostBinary)
+	{
+		r.symbol = SymbolType::HostBinary;
+		r.addend = (int64)(value - hostBinary);
+		return true;
+	}
+
+	return false;
+}
+
+bool CodeCache::Unit::resolve(const Relocation& r, uint64 baseAddress, uint64& value) const
+{
+	switch (r.symbol)
+	{
+	case SymbolType::ClassData:
+		if (classData.isEmpty())
+			return false;
+
+		value = classData.getStart() + (uint64)r.addend;
+		return true;
+	case SymbolType::GlobalScope:
+		value = globalScope.getStart() + (uint64)r.addend;
+		return true;
+	case SymbolType::HostBinary:
+		if (hostBinary == 0)
+			return false;
+
+		value = hostBinary + (uint64)r.addend;
+		return true;
+	case SymbolType::Function:
+		if (!isPositiveAndBelow(r.symbolIndex, addresses.size()))
+			return false;
+
+		value = addresses[r.symbolIndex] + (uint64)r.addend;
+		return true;
+	case SymbolType::Code:
+		value = baseAddress + (uint64)r.addend;
+		return true;
+	default:
+		return false;
+	}
+}
+
+CodeCache::Unit::FunctionEntry* CodeCache::Unit::getEntry(const juce::String& functionId) const
+{
+	for (auto e : entries)
+	{
+		if (e->id == functionId)
+			return e;
+	}
+
+	return nullptr;
+}
+
+void CodeCache::Unit::readFrom(InputStream& input)
+{
+	using namespace CodeCacheFormat;
+
+	if (input.readInt() != CodeCacheFormat::Magic || input.readInt() != CodeCacheFormat::Version)
+		return;
+
+	// Make sure that it's not a hash collision
+	if (input.readString() != key)
+		return;
+
+	cachedDataSize = input.readInt64();
+	cachedDataAlignment = input.readInt();
+
+	auto numEntries = input.readInt();
+
+	for (int i = 0; i < numEntries; i++)
+	{
+		ScopedPointer<FunctionEntry> e = new FunctionEntry();
+
+		e->id = input.readString();
+
+		auto numBytes = input.readInt();
+
+		if (numBytes <= 0 || input.readIntoMemoryBlock(e->code, numBytes) != (size_t)numBytes)
+		{
+			entries.clear();
+			return;
+		}
+
+		auto numRelocations = input.readInt();
+
+		for (int j = 0; j < numRelocations; j++)
+		{
+			if (input.getNumBytesRemaining() < RelocationSize)
+			{
+				entries.clear();
+				return;
+			}
+
+			Relocation r;
+			r.offset = (uint32)input.readInt();
+			r.type = (RelocationType)input.readByte();
+			r.symbol = (SymbolType)input.readByte();
+			r.symbolIndex = input.readInt();
+			r.addend = input.readInt64();
+			r.anchor = input.readInt();
+
+			auto numRelocationBytes = r.type == RelocationType::Absolute64 ? sizeof(uint64) : sizeof(int32);
+
+			auto ok = (uint8)r.type < (uint8)RelocationType::numRelocationTypes &&
+					  (uint8)r.symbol < (uint8)SymbolType::numSymbolTypes &&
+					  (size_t)r.offset + numRelocationBytes <= e->code.getSize();
+
+			if (!ok)
+			{
+				entries.clear();
+				return;
+			}
+
+			e->relocations.add(r);
+		}
+
+		entries.add(e.release());
+	}
+}
+
+void CodeCache::Unit::writeTo(OutputStream& output) const
+{
+	output.writeInt(CodeCacheFormat::Magic);
+	output.writeInt(CodeCacheFormat::Version);
+	output.writeString(key);
+	output.writeInt64(cachedDataSize);
+	output.writeInt(cachedDataAlignment);
+	output.writeInt(entries.size());
+
+	for (auto e : entries)
+	{
+		output.writeString(e->id);
+		output.writeInt((int)e->code.getSize());
+		output.write(e->code.getData(), e->code.getSize());
+		output.writeInt(e->relocations.size());
+
+		for (const auto& r : e->relocations)
+		{
+			output.writeInt((int)r.offset);
+			output.writeByte((char)r.type);
+			output.writeByte((char)r.symbol);
+			output.writeInt(r.symbolIndex);
+			output.writeInt64(r.addend);
+			output.writeInt(r.anchor);
+		}
+	}
+}
+
+CodeCache::CodeCache(const File& directory_) :
+	directory(directory_)
+{
+}
+
+juce::String CodeCache::createKey(const GlobalScope& scope, const juce::String& preprocessedCode, const NamespacedIdentifier& instanceId)
+{
+	auto binary = File::getSpecialLocation(File::currentExecutableFile);
+
+	juce::String key;
+
+	key << "version: " << juce::String(CodeCacheFormat::Version) << "\n";
+	key << "binary: " << binary.getFullPathName() << " " << juce::String(binary.getSize()) << " ";
+	key << juce::String(binary.getLastModificationTime().toMilliseconds()) << "\n";
+	key << "cpu: " << SystemStats::getCpuVendor() << " " << SystemStats::getCpuModel() << "\n";
+	key << "instance: " << instanceId.toString() << "\n";
+	key << "optimizations: " << scope.optimizationPasses.joinIntoString(",") << "\n";
+	key << "polyphonic: " << juce::String((int)scope.polyHandler.isEnabled()) << "\n";
+	key << "debug: " << juce::String((int)scope.isDebugModeEnabled()) << "\n";
+	key << "no inliners: ";
+
+	for (const auto& id : scope.noInliners)
+		key << id.toString() << " ";
+
+	key << "\nobjects: ";
+
+	for (auto o : scope.objectClassesWithJitCallableFunctions)
+		key << o->getClassName().toString() << " ";
+
+	key << "\ncode:\n" << preprocessedCode;
+
+	return key;
+}
+
+CodeCache::Unit* CodeCache::createUnit(const juce::String& key, const GlobalScope& scope)
+{
+	ScopedPointer<Unit> u = new Unit(key, scope);
+
+	ScopedLock sl(lock);
+
+	auto f = getFileForKey(key);
+
+	if (f.existsAsFile())
+	{
+		FileInputStream fis(f);
+
+		if (fis.openedOk())
+			u->readFrom(fis);
+	}
+
+	return u.release();
+}
+
+void CodeCache::writeUnit(const Unit& u)
+{
+	if (!u.modified || u.entries.isEmpty())
+		return;
+
+	MemoryOutputStream mos;
+	u.writeTo(mos);
+
+	ScopedLock sl(lock);
+
+	if (!directory.isDirectory())
+		directory.createDirectory();
+
+	getFileForKey(u.key).replaceWithData(mos.getData(), mos.getDataSize());
+}
+
+void CodeCache::clear()
+{
+	ScopedLock sl(lock);
+
+	for (auto f : directory.findChildFiles(File::findFiles, false, "*.snexcache"))
+		f.deleteFile();
+}
+
+File CodeCache::getFileForKey(const juce::String& key) const
+{
+	return directory.getChildFile(juce::String::toHexString(key.hashCode64())).withFileExtension("snexcache");
+}
+
+uint64 CodeCache::getHostBinaryBase(const void* address)
+{
+#if JUCE_WINDOWS
+	HMODULE m = nullptr;
+
+	if (GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT, (LPCWSTR)address, &m))
+		return reinterpret_cast<uint64>(m);
+
+	return 0;
+#else
+	Dl_info info;
+
+	if (dladdr(address, &info) != 0)
+		return reinterpret_cast<uint64>(info.dli_fbase);
+
+	return 0;
+#endif
+}
+
+}
+}
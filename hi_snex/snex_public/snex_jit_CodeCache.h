@@ -0,0 +1,215 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+#pragma once
+
+namespace snex {
+namespace jit {
+using namespace juce;
+
+class GlobalScope;
+
+/** A persistent cache for the machine code of JIT compiled functions.
+
+	Compiling a SNEX class runs the parser, the optimization passes and the code generator
+	for every function. The parsing and symbol resolving is still required to build the data
+	layout and the type information of the class, but the code generation can be skipped if
+	the same code has been compiled before with the same settings.
+
+	The cache is content addressed: the key of a compile unit is built from the preprocessed
+	code, the settings of the GlobalScope that affect the code generation and a fingerprint
+	of the host binary. For every function it stores the machine code along with a list of
+	relocations that point to one of these symbols:
+
+	- an offset in the data block of the compiled class
+	- an offset in the GlobalScope object (eg. the runtime error flag)
+	- an offset in the host binary (inbuilt functions and static tables)
+	- a function that was compiled before in the same unit
+
+	A function that embeds any other absolute address (eg. a heap allocated object that was
+	registered to the GlobalScope) will not be cached and is compiled normally the next time.
+
+	In order to use it, create a cache with a directory and pass it to GlobalScope::setCodeCache().
+*/
+class CodeCache : public ReferenceCountedObject
+{
+public:
+
+	using Ptr = ReferenceCountedObjectPtr<CodeCache>;
+
+	enum class SymbolType : uint8
+	{
+		ClassData,
+		GlobalScope,
+		HostBinary,
+		Function,
+		Code,
+		numSymbolTypes
+	};
+
+	enum class RelocationType : uint8
+	{
+		Absolute64,
+		Relative32,
+		numRelocationTypes
+	};
+
+	/** The machine code of a function that was just compiled by the code generator. */
+	struct CompiledCode
+	{
+		const uint8* data = nullptr;
+		size_t size = 0;
+
+		/** All values that the instructions use as immediate or absolute memory address. */
+		Array<uint64> absoluteValues;
+
+		/** The offsets of the 32 bit displacements that the assembler has resolved to an absolute target. */
+		Array<std::pair<uint32, uint64>> relativeTargets;
+
+		/** Set this to false if the code contains relocations that can't be expressed by the cache. */
+		bool canBeCached = true;
+	};
+
+	/** A compile unit that holds the cached functions of a single compilation. 
+	
+		The functions must be added in the order of their compilation so that the references
+		to other functions of the same unit can be resolved.
+	*/
+	class Unit
+	{
+	public:
+
+		~Unit();
+
+		/** Sets the data block of the compiled class. Call this after the data has been allocated. */
+		void setClassData(const void* start, size_t numBytes);
+
+		/** Returns the ID that is used to lookup the next compiled function. */
+		juce::String getNextFunctionId(const juce::String& signature) const;
+
+		/** Returns the size of the cached machine code for the given function or 0 if it's not in the cache. */
+		size_t getCachedCodeSize(const juce::String& functionId) const;
+
+		/** Writes the code of the cached function relocated to the given address into the destination buffer.
+
+			Returns false if the function can't be relinked (eg. because a relative call target is out of range).
+		*/
+		bool relink(const juce::String& functionId, uint64 baseAddress, uint8* destination);
+
+		/** Adds the code of a function that was compiled at the given address. */
+		void store(const juce::String& functionId, const CompiledCode& code, uint64 baseAddress);
+
+		/** Call this with the address of every function that is compiled in this unit. */
+		void addFunction(uint64 address);
+
+		int getNumRelinkedFunctions() const { return numRelinked; }
+		int getNumCompiledFunctions() const { return addresses.size(); }
+
+	private:
+
+		friend class CodeCache;
+
+		struct Relocation
+		{
+			uint32 offset;
+			RelocationType type;
+			SymbolType symbol;
+			int32 symbolIndex;
+			int64 addend;
+			int32 anchor;
+		};
+
+		struct FunctionEntry
+		{
+			juce::String id;
+			MemoryBlock code;
+			Array<Relocation> relocations;
+		};
+
+		Unit(const juce::String& key_, const GlobalScope& scope);
+
+		bool classify(uint64 value, uint64 baseAddress, size_t codeSize, Relocation& r) const;
+		bool resolve(const Relocation& r, uint64 baseAddress, uint64& value) const;
+
+		FunctionEntry* getEntry(const juce::String& functionId) const;
+
+		void readFrom(InputStream& input);
+		void writeTo(OutputStream& output) const;
+
+		const juce::String key;
+
+		Range<uint64> classData;
+		Range<uint64> globalScope;
+		uint64 hostBinary = 0;
+
+		int64 cachedDataSize = -1;
+		int cachedDataAlignment = -1;
+
+		Array<uint64> addresses;
+		OwnedArray<FunctionEntry> entries;
+		int numRelinked = 0;
+		bool modified = false;
+
+		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Unit);
+	};
+
+	CodeCache(const File& directory_);
+
+	/** Creates the key for the compilation of the given code with the settings of the GlobalScope. */
+	static juce::String createKey(const GlobalScope& scope, const juce::String& preprocessedCode, const NamespacedIdentifier& instanceId);
+
+	/** Creates a compile unit and loads the cached functions for the given key from the disk. */
+	Unit* createUnit(const juce::String& key, const GlobalScope& scope);
+
+	/** Writes the unit to the disk if it contains newly compiled functions. */
+	void writeUnit(const Unit& u);
+
+	/** Deletes all cache files. */
+	void clear();
+
+	File getDirectory() const { return directory; }
+
+private:
+
+	File getFileForKey(const juce::String& key) const;
+
+	static uint64 getHostBinaryBase(const void* address);
+
+	CriticalSection lock;
+	const File directory;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CodeCache);
+};
+
+}
+}
@@ -583,8 +583,20 @@ public:
 
 	bool isDebugModeEnabled() const { return debugMode; }
 
+	/** Sets a cache that stores the machine code of the compiled functions. 
+	
+		Compilers that use this scope will relink unchanged code from the cache instead of running the code generator. 
+	*/
+	void setCodeCache(CodeCache::Ptr newCache) { codeCache = newCache; }
+
+	CodeCache::Ptr getCodeCache() const { return codeCache; }
+
 private:
 
+	friend class CodeCache;
+
+	CodeCache::Ptr codeCache;
+
 	bool debugMode = false;
 
 	Array<Identifier> noInliners;
@@ -174,7 +174,29 @@ JitObject Compiler::compileJitObject(const juce::String& code)
 		return {};
 	}
 	
-	return JitObject(compiler->compileAndGetScope(preprocessedCode));
+	auto codeCache = memory.getCodeCache();
+
+	if (codeCache != nullptr)
+		compiler->codeCacheUnit = codeCache->createUnit(CodeCache::createKey(memory, preprocessedCode, compiler->instanceId), memory);
+
+	JitObject obj(compiler->compileAndGetScope(preprocessedCode));
+
+	if (auto unit = compiler->codeCacheUnit.get())
+	{
+		if (compiler->getLastResult().wasOk())
+		{
+			codeCache->writeUnit(*unit);
+
+			juce::String m;
+			m << "Relinked " << juce::String(unit->getNumRelinkedFunctions()) << " of ";
+			m << juce::String(unit->getNumCompiledFunctions()) << " functions from the code cache";
+			compiler->logMessage(BaseCompiler::VerboseProcessMessage, m);
+		}
+
+		compiler->codeCacheUnit = nullptr;
+	}
+
+	return obj;
 }
 
 
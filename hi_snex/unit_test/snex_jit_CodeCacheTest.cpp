@@ -0,0 +1,123 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+namespace snex {
+namespace jit {
+using namespace juce;
+
+/** Compiles the same code twice and checks that the second compilation is relinked from the code cache. */
+class CodeCacheTest : public UnitTest
+{
+public:
+
+	CodeCacheTest() : UnitTest("Testing SNEX code cache", "snex") {}
+
+	struct Result
+	{
+		float value = 0.0f;
+		bool relinked = false;
+	};
+
+	Result compileAndRun(CodeCache::Ptr cache, const juce::String& code)
+	{
+		GlobalScope s;
+		s.setCodeCache(cache);
+
+		Compiler c(s);
+		auto obj = c.compileJitObject(code);
+
+		expect(c.getCompileResult().wasOk(), c.getCompileResult().getErrorMessage());
+
+		Result r;
+
+		if (obj)
+		{
+			auto f = obj["test"];
+
+			// call it twice to check that the class data is relocated correctly
+			f.call<float>(0.5f);
+			r.value = f.call<float>(0.5f);
+			r.relinked = c.getAssemblyCode().contains("relinked from code cache");
+		}
+
+		return r;
+	}
+
+	void runTest() override
+	{
+		beginTest("Testing relinking from code cache");
+
+		auto directory = File::getSpecialLocation(File::tempDirectory).getChildFile("SnexCodeCacheTest");
+		directory.deleteRecursively();
+
+		CodeCache::Ptr cache = new CodeCache(directory);
+
+		juce::String code;
+		code << "int counter = 0;\n";
+		code << "span<float, 4> data = { 1.0f, 2.0f, 3.0f, 4.0f };\n";
+		code << "float square(float x) { return x * x; }\n";
+		code << "float test(float input)\n";
+		code << "{\n";
+		code << "    counter += 1;\n";
+		code << "    float sum = 0.0f;\n";
+		code << "    for(auto& s: data)\n";
+		code << "        sum += s;\n";
+		code << "    return square(input) + Math.sin(input) + sum + (float)counter;\n";
+		code << "}\n";
+
+		auto expected = 0.5f * 0.5f + std::sin(0.5f) + 10.0f + 2.0f;
+
+		auto first = compileAndRun(cache, code);
+
+		expect(!first.relinked, "first compilation shouldn't be relinked");
+		expectWithinAbsoluteError(first.value, expected, 0.0001f, "wrong result after compilation");
+
+		auto second = compileAndRun(cache, code);
+
+		expect(second.relinked, "second compilation should be relinked");
+		expectWithinAbsoluteError(second.value, expected, 0.0001f, "wrong result after relinking");
+
+		auto changed = compileAndRun(cache, code.replace("(float)counter", "(float)counter * 2.0f"));
+
+		expect(!changed.relinked, "changed code shouldn't be relinked");
+		expectWithinAbsoluteError(changed.value, expected + 2.0f, 0.0001f, "wrong result after changing the code");
+
+		cache->clear();
+		directory.deleteRecursively();
+	}
+};
+
+static CodeCacheTest codeCacheTest;
+
+}
+}
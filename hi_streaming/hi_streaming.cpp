@@ -2,12 +2,23 @@
 #include "hi_streaming.h"
 
 
+#if JUCE_INTEL
+#include <emmintrin.h>
+#elif JUCE_ARM
+#include "../hi_tools/hi_tools/sse2neon.h"
+#endif
+
 #include "hi_streaming/SampleThreadPool.cpp"
 #include "hi_streaming/MonolithAudioFormat.cpp"
 #include "hi_streaming/StreamingSampler.cpp"
 #include "hi_streaming/StreamingSamplerSound.cpp"
+#include "hi_streaming/SampleInterpolators.cpp"
 #include "hi_streaming/StreamingSamplerVoice.cpp"
 
+#if HI_RUN_UNIT_TESTS
+#include "hi_streaming/SampleInterpolatorTests.cpp"
+#endif
+
 
 
 
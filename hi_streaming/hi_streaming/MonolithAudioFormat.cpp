@@ -207,10 +207,12 @@ HlacMonolithInfo::HlacMonolithInfo(const Array<File>& monolithicFiles_)
 {
 	id = monolithicFiles_.getFirst().getFileNameWithoutExtension().replaceCharacter('_', '/');
 	monolithicFiles.reserve(monolithicFiles_.size());
+	fileIds.reserve(monolithicFiles_.size());
 
 	for (int i = 0; i < monolithicFiles_.size(); i++)
 	{
 		monolithicFiles.push_back(monolithicFiles_[i]);
+		fileIds.push_back(PreloadBufferCache::createFileId(monolithicFiles_[i]));
 
 #if USE_FALLBACK_READERS_FOR_MONOLITH
 		ScopedPointer<FileInputStream> fallbackStream = new FileInputStream(monolithicFiles_[i]);
@@ -221,6 +223,7 @@ HlacMonolithInfo::HlacMonolithInfo(const Array<File>& monolithicFiles_)
 
 HlacMonolithInfo::~HlacMonolithInfo()
 {
+	threadReaders.clear();
 	memoryReaders.clear();
 	fallbackReaders.clear();
 }
@@ -355,6 +358,27 @@ juce::File HlacMonolithInfo::getFile(int channelIndex, int sampleIndex) const
 	return monolithicFiles[fileIndex];
 }
 
+String HlacMonolithInfo::getPreloadCacheId(int channelIndex, int sampleIndex) const
+{
+	if (!isPositiveAndBelow(sampleIndex, sampleInfo.size()))
+		return {};
+
+	auto fileIndex = getFileIndex(channelIndex, sampleIndex);
+
+	if (!isPositiveAndBelow(fileIndex, (int)fileIds.size()))
+		return {};
+
+	return fileIds[fileIndex] + "@" + String(getMonolithOffset(sampleIndex)) + ":" + String(getMonolithLength(sampleIndex));
+}
+
+juce::int64 HlacMonolithInfo::getDeviceKey(int channelIndex, int sampleIndex) const
+{
+	if (isPositiveAndBelow(sampleIndex, sampleInfo.size()))
+		return getFile(channelIndex, sampleIndex).hashCode64();
+
+	return 0;
+}
+
 juce::AudioFormatReader* HlacMonolithInfo::createUserInterfaceReader(int sampleIndex, int channelIndex)
 {
 	if (isPositiveAndBelow(sampleIndex, sampleInfo.size()))
@@ -391,7 +415,11 @@ juce::AudioFormatReader* HlacMonolithInfo::createMonolithicReader(int sampleInde
 
 		auto fileIndex = getFileIndex(channelIndex, sampleIndex);
 
-		if (memoryReaders[fileIndex] != nullptr)
+		if (auto threadReader = getThreadReader(fileIndex))
+		{
+			return new hlac::HlacSubSectionReader(threadReader, start, length);
+		}
+		else if (memoryReaders[fileIndex] != nullptr)
 		{
 			return new hlac::HlacSubSectionReader(memoryReaders[fileIndex], start, length);
 		}
@@ -412,14 +440,108 @@ juce::AudioFormatReader* HlacMonolithInfo::createFallbackReader(int sampleIndex,
 		const int64 length = info.length;
 
 		auto fileIndex = getFileIndex(channelIndex, sampleIndex);
-		fallbackReaders[fileIndex]->sampleRate = info.sampleRate;
 
-		return new hlac::HlacSubSectionReader(fallbackReaders[fileIndex], start, length);
+		AudioFormatReader* r = getThreadReader(fileIndex);
+
+		if (r == nullptr)
+			r = fallbackReaders[fileIndex];
+
+		r->sampleRate = info.sampleRate;
+
+		return new hlac::HlacSubSectionReader(r, start, length);
+	}
+
+	return nullptr;
+}
+
+AudioFormatReader* HlacMonolithInfo::createReaderForFile(int fileIndex) const
+{
+	auto mf = monolithicFiles[fileIndex];
+
+#if USE_FALLBACK_READERS_FOR_MONOLITH
+	ScopedPointer<FileInputStream> fallbackStream = new FileInputStream(mf);
+	return new hlac::HiseLosslessAudioFormatReader(fallbackStream.release());
+#else
+	hlac::HiseLosslessAudioFormat format;
+
+	ScopedPointer<MemoryMappedAudioFormatReader> reader = format.createMemoryMappedReader(mf);
+
+	if (reader == nullptr)
+		return nullptr;
+
+	reader->mapEntireFile();
+
+	auto hmr = dynamic_cast<hlac::HlacMemoryMappedAudioFormatReader*>(reader.get());
+
+	if (hmr == nullptr || hmr->getMappedSection().isEmpty())
+		return nullptr;
+
+	hmr->setTargetAudioDataType(AudioDataConverters::DataFormat::int16BE);
+	return reader.release();
+#endif
+}
+
+AudioFormatReader* HlacMonolithInfo::getThreadReader(int fileIndex)
+{
+	if (numThreadsWithReaders.load() == 0)
+		return nullptr;
+
+	auto threadId = Thread::getCurrentThreadId();
+
+	ScopedLock sl(threadReaderLock);
+
+	for (auto tr : threadReaders)
+	{
+		if (tr->threadId == threadId)
+			return tr->readers[fileIndex];
 	}
 
 	return nullptr;
 }
 
+HlacMonolithInfo::ScopedThreadReaders::ScopedThreadReaders(HlacMonolithInfo* info_) :
+	info(info_)
+{
+	if (info == nullptr)
+		return;
+
+	ScopedLock sl(info->threadReaderLock);
+
+	for (int i = 0; i < info->threadReaders.size(); i++)
+	{
+		if (info->threadReaders[i]->threadId == nullptr)
+		{
+			readerIndex = i;
+			break;
+		}
+	}
+
+	if (readerIndex == -1)
+	{
+		auto tr = new ThreadReaders();
+
+		for (int i = 0; i < (int)info->monolithicFiles.size(); i++)
+			tr->readers.add(info->createReaderForFile(i));
+
+		readerIndex = info->threadReaders.size();
+		info->threadReaders.add(tr);
+	}
+
+	info->threadReaders[readerIndex]->threadId = Thread::getCurrentThreadId();
+	info->numThreadsWithReaders++;
+}
+
+HlacMonolithInfo::ScopedThreadReaders::~ScopedThreadReaders()
+{
+	if (info == nullptr)
+		return;
+
+	ScopedLock sl(info->threadReaderLock);
+
+	info->threadReaders[readerIndex]->threadId = nullptr;
+	info->numThreadsWithReaders--;
+}
+
 
 
 
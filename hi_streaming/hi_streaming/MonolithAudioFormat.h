@@ -138,6 +138,15 @@ public:
 
 	double getMonolithSampleRate(int sampleIndex) const;
 
+	/** Returns the monolith file that contains the given sample. */
+	File getMonolithFile(int channelIndex, int sampleIndex) const { return getFile(channelIndex, sampleIndex); }
+
+	/** Returns an id for the location of the sample in the monolith file that can be used by the PreloadBufferCache. */
+	String getPreloadCacheId(int channelIndex, int sampleIndex) const;
+
+	/** Returns a key for the monolith file that contains the given sample (used for dispatching the streaming jobs). */
+	int64 getDeviceKey(int channelIndex, int sampleIndex) const;
+
 	/** This will create a reader for the given sample and channel. */
 	AudioFormatReader* createReader(int sampleIndex, int channelIndex);
 
@@ -146,8 +155,38 @@ public:
 
 	using Ptr = ReferenceCountedObjectPtr<HlacMonolithInfo>;
 
+	/** Lets the current thread use its own readers for the monolith files.
+
+		All readers that are created with createReader() share the decoder of the monolith file, so a monolith can only be
+		read by one thread at a time. While this object exists, createReader() will use a separate set of readers for the
+		thread that created it, so that multiple threads can preload the samples of the same monolith in parallel.
+
+		Make sure that the readers of this thread are deleted before this object goes out of scope.
+	*/
+	struct ScopedThreadReaders
+	{
+		ScopedThreadReaders(HlacMonolithInfo* info);
+		~ScopedThreadReaders();
+
+	private:
+
+		Ptr info;
+		int readerIndex = -1;
+	};
+
 private:
 
+	struct ThreadReaders
+	{
+		Thread::ThreadID threadId = nullptr;
+		OwnedArray<AudioFormatReader> readers;
+	};
+
+	/** Returns the reader of the current thread for the given monolith file or nullptr if the thread doesn't have its own readers. */
+	AudioFormatReader* getThreadReader(int fileIndex);
+
+	AudioFormatReader* createReaderForFile(int fileIndex) const;
+
 	int getFileIndex(int channelIndex, int sampleIndex) const;
 
 	File getFile(int channelIndex, int sampleIndex) const;
@@ -172,11 +211,19 @@ private:
 
 	std::vector<File> monolithicFiles;
 
+	// The file part of the preload cache ids (created once for each monolith file)
+	std::vector<String> fileIds;
+
 	int numChannels = 0;
 	int numSplitFiles = 0;
 
 	OwnedArray<hlac::HiseLosslessAudioFormatReader> fallbackReaders;
 	OwnedArray<hlac::HlacMemoryMappedAudioFormatReader> memoryReaders;
+
+	// The reader sets are kept until the monolith is deleted (and reused by the next thread)
+	CriticalSection threadReaderLock;
+	OwnedArray<ThreadReaders> threadReaders;
+	std::atomic<int> numThreadsWithReaders { 0 };
 };
 
 
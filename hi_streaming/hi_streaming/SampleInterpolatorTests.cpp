@@ -0,0 +1,209 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise { using namespace juce;
+
+/** Compares the SIMD interpolation kernels against the scalar code and measures their performance. */
+class SampleInterpolatorTest : public UnitTest
+{
+public:
+
+	SampleInterpolatorTest() :
+		UnitTest("Testing sample interpolators")
+	{};
+
+	void runTest() override
+	{
+		testLinearSIMD<float, true>();
+		testLinearSIMD<int16, false>();
+		testCubicWithRamp();
+		runBenchmark<float, true>("float");
+		runBenchmark<int16, false>("int16");
+	}
+
+private:
+
+	static constexpr int BlockSize = 512;
+	static constexpr int NumSourceSamples = BlockSize * 4 + 16;
+
+	template <typename SignalType> void fillRandomData(HeapBlock<SignalType>& d)
+	{
+		Random r;
+
+		d.calloc(NumSourceSamples);
+
+		for (int i = 0; i < NumSourceSamples; i++)
+		{
+			const float v = r.nextFloat() * 2.0f - 1.0f;
+			d[i] = (SignalType)(std::is_same<SignalType, float>() ? v : v * (float)INT16_MAX);
+		}
+	}
+
+	template <typename SignalType, bool isFloat> void testLinearSIMD()
+	{
+		beginTest(String("Testing linear SIMD interpolation with ") + (isFloat ? "float" : "int16") + " data");
+
+		HeapBlock<SignalType> l, r;
+		fillRandomData(l);
+		fillRandomData(r);
+
+		AudioSampleBuffer expected(2, BlockSize);
+		AudioSampleBuffer actual(2, BlockSize);
+
+		HeapBlock<float> pitchData;
+		pitchData.calloc(BlockSize);
+
+		Random rand;
+
+		// Use values that can be summed up without rounding errors so that both kernels calculate the same positions
+		for (int i = 0; i < BlockSize; i++)
+			pitchData[i] = 0.5f + (float)rand.nextInt(96) / 64.0f;
+
+		for (auto usePitchData : { false, true })
+		{
+			for (auto isStereo : { false, true })
+			{
+				SampleInterpolators::Input<SignalType> input;
+				input.data[0] = l.get();
+				input.data[1] = isStereo ? r.get() : nullptr;
+				input.indexInBuffer = 0.375;
+				input.uptimeDelta = 1.75;
+				input.pitchData = usePitchData ? pitchData.get() : nullptr;
+				input.maxIndexInBuffer = isStereo ? NumSourceSamples - 2 : INT_MAX;
+
+				expected.clear();
+				actual.clear();
+
+				SampleInterpolators::process<SignalType, isFloat>(SampleInterpolationMode::Linear, input, expected.getWritePointer(0), expected.getWritePointer(1), BlockSize);
+				SampleInterpolators::process<SignalType, isFloat>(SampleInterpolationMode::LinearSIMD, input, actual.getWritePointer(0), actual.getWritePointer(1), BlockSize);
+
+				float maxError = 0.0f;
+
+				for (int c = 0; c < 2; c++)
+				{
+					for (int i = 0; i < BlockSize; i++)
+						maxError = jmax(maxError, std::abs(expected.getSample(c, i) - actual.getSample(c, i)));
+				}
+
+				expect(maxError < 0.0001f, "Max error: " + String(maxError) + (usePitchData ? " (pitch modulation)" : "") + (isStereo ? " (stereo)" : " (mono)"));
+			}
+		}
+	}
+
+	void testCubicWithRamp()
+	{
+		beginTest("Testing cubic interpolation with a linear ramp");
+
+		// A 4-point Hermite interpolation reproduces a linear function exactly
+		HeapBlock<float> ramp;
+		ramp.calloc(NumSourceSamples);
+
+		for (int i = 0; i < NumSourceSamples; i++)
+			ramp[i] = (float)i * 0.001f;
+
+		SampleInterpolators::Input<float> input;
+		input.data[0] = ramp.get() + 1;
+		input.data[1] = ramp.get() + 1;
+		input.previousSamples[0] = ramp[0];
+		input.previousSamples[1] = ramp[0];
+		input.indexInBuffer = 0.25;
+		input.uptimeDelta = 1.5;
+		input.maxIndexInBuffer = NumSourceSamples - 2;
+
+		AudioSampleBuffer output(2, BlockSize);
+		output.clear();
+
+		SampleInterpolators::process<float, true>(SampleInterpolationMode::CubicSIMD, input, output.getWritePointer(0), output.getWritePointer(1), BlockSize);
+
+		float maxError = 0.0f;
+
+		for (int i = 0; i < BlockSize; i++)
+		{
+			const float expected = (float)(input.indexInBuffer + (double)i * input.uptimeDelta + 1.0) * 0.001f;
+			maxError = jmax(maxError, std::abs(output.getSample(0, i) - expected));
+		}
+
+		expect(maxError < 0.0001f, "Max error: " + String(maxError));
+	}
+
+	template <typename SignalType, bool isFloat> void runBenchmark(const String& typeName)
+	{
+		beginTest("Benchmarking interpolators with " + typeName + " data");
+
+		HeapBlock<SignalType> l, r;
+		fillRandomData(l);
+		fillRandomData(r);
+
+		AudioSampleBuffer output(2, BlockSize);
+
+		HeapBlock<float> pitchData;
+		pitchData.calloc(BlockSize);
+
+		for (int i = 0; i < BlockSize; i++)
+			pitchData[i] = 1.5f;
+
+		static constexpr int NumIterations = 4000;
+
+		for (auto usePitchData : { false, true })
+		{
+			for (int m = 0; m < (int)SampleInterpolationMode::numModes; m++)
+			{
+				auto mode = (SampleInterpolationMode)m;
+
+				SampleInterpolators::Input<SignalType> input;
+				input.data[0] = l.get();
+				input.data[1] = r.get();
+				input.previousSamples[0] = (float)l[0];
+				input.previousSamples[1] = (float)r[0];
+				input.indexInBuffer = 0.5;
+				input.uptimeDelta = 1.5;
+				input.pitchData = usePitchData ? pitchData.get() : nullptr;
+				input.maxIndexInBuffer = NumSourceSamples - 2;
+
+				const double start = Time::getMillisecondCounterHiRes();
+
+				for (int i = 0; i < NumIterations; i++)
+					SampleInterpolators::process<SignalType, isFloat>(mode, input, output.getWritePointer(0), output.getWritePointer(1), BlockSize);
+
+				const double duration = Time::getMillisecondCounterHiRes() - start;
+
+				static const StringArray modeNames = { "Linear", "LinearSIMD", "CubicSIMD" };
+
+				logMessage(modeNames[m] + (usePitchData ? " (pitch modulation): " : ": ") + String(duration, 2) + " ms for " + String(NumIterations) + " blocks");
+			}
+		}
+	}
+};
+
+static SampleInterpolatorTest sampleInterpolatorTest;
+
+} // namespace hise
@@ -0,0 +1,374 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise { using namespace juce;
+
+namespace SampleInterpolatorHelpers
+{
+
+template <typename SignalType> static forcedinline float getPreviousSample(const SignalType* d, int index, float previousSample)
+{
+	return index < 0 ? previousSample : (float)d[index];
+}
+
+static forcedinline int getUpperIndex(int pos, int maxIndex)
+{
+	return jmin(pos + 2, jmax(pos + 1, maxIndex - 1));
+}
+
+static forcedinline float hermite(float xm1, float x0, float x1, float x2, float alpha)
+{
+	const float c1 = 0.5f * (x1 - xm1);
+	const float c2 = xm1 - 2.5f * x0 + 2.0f * x1 - 0.5f * x2;
+	const float c3 = 0.5f * (x2 - xm1) + 1.5f * (x0 - x1);
+
+	return ((c3 * alpha + c2) * alpha + c1) * alpha + x0;
+}
+
+static forcedinline __m128 hermite(__m128 xm1, __m128 x0, __m128 x1, __m128 x2, __m128 alpha)
+{
+	const __m128 half = _mm_set1_ps(0.5f);
+
+	const __m128 c1 = _mm_mul_ps(half, _mm_sub_ps(x1, xm1));
+	const __m128 c2 = _mm_sub_ps(_mm_add_ps(_mm_sub_ps(xm1, _mm_mul_ps(_mm_set1_ps(2.5f), x0)), _mm_add_ps(x1, x1)), _mm_mul_ps(half, x2));
+	const __m128 c3 = _mm_add_ps(_mm_mul_ps(half, _mm_sub_ps(x2, xm1)), _mm_mul_ps(_mm_set1_ps(1.5f), _mm_sub_ps(x0, x1)));
+
+	__m128 v = _mm_add_ps(_mm_mul_ps(c3, alpha), c2);
+	v = _mm_add_ps(_mm_mul_ps(v, alpha), c1);
+	return _mm_add_ps(_mm_mul_ps(v, alpha), x0);
+}
+
+}
+
+template <typename SignalType, bool isFloat>
+void SampleInterpolators::process(SampleInterpolationMode mode, const Input<SignalType>& input, float* outL, float* outR, int numSamples)
+{
+	const bool isStereo = input.data[1] != nullptr;
+	float* out[2] = { outL, outR };
+
+	switch (mode)
+	{
+	case SampleInterpolationMode::LinearSIMD:
+		if (isStereo)
+			processSIMD<SignalType, isFloat, 2, false>(input, out, numSamples);
+		else
+			processSIMD<SignalType, isFloat, 1, false>(input, out, numSamples);
+		break;
+	case SampleInterpolationMode::CubicSIMD:
+		if (isStereo)
+			processSIMD<SignalType, isFloat, 2, true>(input, out, numSamples);
+		else
+			processSIMD<SignalType, isFloat, 1, true>(input, out, numSamples);
+		break;
+	default:
+		if (isStereo)
+			linearStereo<SignalType, isFloat>(input, outL, outR, numSamples);
+		else
+			linearMono<SignalType, isFloat>(input, outL, numSamples);
+		break;
+	}
+}
+
+template <typename SignalType, bool isFloat>
+void SampleInterpolators::linearMono(const Input<SignalType>& input, float* outL, int numSamples)
+{
+	constexpr float gainFactor = isFloat ? 1.0f : (1.0f / (float)INT16_MAX);
+
+	auto inL = input.data[0];
+	auto pitchData = input.pitchData;
+
+	if (pitchData != nullptr)
+	{
+		float indexInBufferFloat = (float)input.indexInBuffer;
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			const int pos = int(indexInBufferFloat);
+			const float alpha = indexInBufferFloat - (float)pos;
+			const float invAlpha = 1.0f - alpha;
+
+			float l = ((float)inL[pos] * invAlpha + (float)inL[pos + 1] * alpha);
+
+			outL[i] = l * gainFactor;
+
+			jassert(*pitchData <= (float)MAX_SAMPLER_PITCH);
+
+			indexInBufferFloat += pitchData[i];
+		}
+	}
+	else
+	{
+		float indexInBufferFloat = (float)input.indexInBuffer;
+		const float uptimeDeltaFloat = (float)input.uptimeDelta;
+
+		while (numSamples > 0)
+		{
+			const int pos = int(indexInBufferFloat);
+			const float alpha = indexInBufferFloat - (float)pos;
+			const float invAlpha = 1.0f - alpha;
+
+			float l = ((float)inL[pos] * invAlpha + (float)inL[pos + 1] * alpha);
+
+			*outL++ = l * gainFactor;
+
+			indexInBufferFloat += uptimeDeltaFloat;
+
+			numSamples--;
+		}
+	}
+}
+
+template <typename SignalType, bool isFloat>
+void SampleInterpolators::linearStereo(const Input<SignalType>& input, float* outL, float* outR, int numSamples)
+{
+	constexpr float gainFactor = isFloat ? 1.0f : (1.0f / (float)INT16_MAX);
+
+	auto inL = input.data[0];
+	auto inR = input.data[1];
+	auto pitchData = input.pitchData;
+	const int maxIndexInBuffer = input.maxIndexInBuffer;
+
+	if (pitchData != nullptr)
+	{
+		float indexInBufferFloat = (float)input.indexInBuffer;
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			const int pos = int(indexInBufferFloat);
+
+			if (pos >= maxIndexInBuffer)
+				return;
+
+			const float alpha = indexInBufferFloat - (float)pos;
+			const float invAlpha = 1.0f - alpha;
+
+			float l = ((float)inL[pos] * invAlpha + (float)inL[pos + 1] * alpha);
+			float r = ((float)inR[pos] * invAlpha + (float)inR[pos + 1] * alpha);
+
+			outL[i] = l * gainFactor;
+			outR[i] = r * gainFactor;
+
+			jassert(*pitchData <= (float)MAX_SAMPLER_PITCH);
+
+			indexInBufferFloat += pitchData[i];
+		}
+	}
+	else
+	{
+		float indexInBufferFloat = (float)input.indexInBuffer;
+		const float uptimeDeltaFloat = (float)input.uptimeDelta;
+
+		auto numTargetSamples = (double)(maxIndexInBuffer - input.indexInBuffer);
+
+		jassert(numTargetSamples > 0.0);
+
+		numSamples = jmin(numSamples, (int)(numTargetSamples / input.uptimeDelta));
+
+		while (numSamples > 0)
+		{
+			const int pos = int(indexInBufferFloat);
+			const float alpha = indexInBufferFloat - (float)pos;
+			const float invAlpha = 1.0f - alpha;
+
+			float l = ((float)inL[pos] * invAlpha + (float)inL[pos + 1] * alpha);
+			float r = ((float)inR[pos] * invAlpha + (float)inR[pos + 1] * alpha);
+
+			*outL++ = l * gainFactor;
+			*outR++ = r * gainFactor;
+
+			indexInBufferFloat += uptimeDeltaFloat;
+
+			numSamples--;
+		}
+	}
+}
+
+template <typename SignalType, bool isFloat, int NumChannels, bool UseCubic>
+void SampleInterpolators::processSIMD(const Input<SignalType>& input, float** out, int numSamples)
+{
+	using namespace SampleInterpolatorHelpers;
+
+	constexpr float gainFactor = isFloat ? 1.0f : (1.0f / (float)INT16_MAX);
+
+	const int maxIndex = input.maxIndexInBuffer;
+	const __m128 gain = _mm_set1_ps(gainFactor);
+	const __m128 one = _mm_set1_ps(1.0f);
+
+	auto renderSingle = [&](float index, int i)
+	{
+		const int pos = (int)index;
+
+		if (pos >= maxIndex)
+			return false;
+
+		const float alpha = index - (float)pos;
+
+		for (int c = 0; c < NumChannels; c++)
+		{
+			auto d = input.data[c];
+			const float x0 = (float)d[pos];
+			const float x1 = (float)d[pos + 1];
+
+			float v;
+
+			if (UseCubic)
+			{
+				const float xm1 = getPreviousSample(d, pos - 1, input.previousSamples[c]);
+				const float x2 = (float)d[getUpperIndex(pos, maxIndex)];
+				v = hermite(xm1, x0, x1, x2, alpha);
+			}
+			else
+			{
+				v = x0 * (1.0f - alpha) + x1 * alpha;
+			}
+
+			out[c][i] = v * gainFactor;
+		}
+
+		return true;
+	};
+
+	auto renderFour = [&](__m128 index, int i)
+	{
+		const __m128i posInt = _mm_cvttps_epi32(index);
+
+		alignas(16) int pos[4];
+		_mm_store_si128((__m128i*)pos, posInt);
+
+		// The positions are ascending so we only need to check the last one
+		if (pos[3] >= maxIndex)
+			return false;
+
+		const __m128 alpha = _mm_sub_ps(index, _mm_cvtepi32_ps(posInt));
+
+		// The cubic interpolation needs to check the boundaries only at the start and end of the buffer
+		const bool isInside = !UseCubic || (pos[0] > 0 && pos[3] + 2 < maxIndex);
+
+		for (int c = 0; c < NumChannels; c++)
+		{
+			auto d = input.data[c];
+
+			const __m128 x0 = _mm_set_ps((float)d[pos[3]], (float)d[pos[2]], (float)d[pos[1]], (float)d[pos[0]]);
+			const __m128 x1 = _mm_set_ps((float)d[pos[3] + 1], (float)d[pos[2] + 1], (float)d[pos[1] + 1], (float)d[pos[0] + 1]);
+
+			__m128 v;
+
+			if (UseCubic)
+			{
+				__m128 xm1, x2;
+
+				if (isInside)
+				{
+					xm1 = _mm_set_ps((float)d[pos[3] - 1], (float)d[pos[2] - 1], (float)d[pos[1] - 1], (float)d[pos[0] - 1]);
+					x2 = _mm_set_ps((float)d[pos[3] + 2], (float)d[pos[2] + 2], (float)d[pos[1] + 2], (float)d[pos[0] + 2]);
+				}
+				else
+				{
+					const float prev = input.previousSamples[c];
+
+					xm1 = _mm_set_ps(getPreviousSample(d, pos[3] - 1, prev), getPreviousSample(d, pos[2] - 1, prev), 
+									 getPreviousSample(d, pos[1] - 1, prev), getPreviousSample(d, pos[0] - 1, prev));
+
+					x2 = _mm_set_ps((float)d[getUpperIndex(pos[3], maxIndex)], (float)d[getUpperIndex(pos[2], maxIndex)],
+									(float)d[getUpperIndex(pos[1], maxIndex)], (float)d[getUpperIndex(pos[0], maxIndex)]);
+				}
+
+				v = hermite(xm1, x0, x1, x2, alpha);
+			}
+			else
+			{
+				v = _mm_add_ps(_mm_mul_ps(x0, _mm_sub_ps(one, alpha)), _mm_mul_ps(x1, alpha));
+			}
+
+			_mm_storeu_ps(out[c] + i, _mm_mul_ps(v, gain));
+		}
+
+		return true;
+	};
+
+	int i = 0;
+
+	if (input.pitchData == nullptr)
+	{
+		const double delta = input.uptimeDelta;
+		const float deltaFloat = (float)delta;
+
+		if (maxIndex != INT_MAX)
+			numSamples = jmin(numSamples, (int)(((double)maxIndex - input.indexInBuffer) / delta));
+
+		const __m128 offsets = _mm_set_ps(3.0f * deltaFloat, 2.0f * deltaFloat, deltaFloat, 0.0f);
+
+		for (; i + 4 <= numSamples; i += 4)
+		{
+			const __m128 index = _mm_add_ps(_mm_set1_ps((float)(input.indexInBuffer + (double)i * delta)), offsets);
+
+			if (!renderFour(index, i))
+				break;
+		}
+
+		for (; i < numSamples; i++)
+		{
+			if (!renderSingle((float)(input.indexInBuffer + (double)i * delta), i))
+				return;
+		}
+	}
+	else
+	{
+		const float* pitchData = input.pitchData;
+		float index = (float)input.indexInBuffer;
+
+		for (; i + 4 <= numSamples; i += 4)
+		{
+			// Calculate the positions from the prefix sum of the pitch values
+			const __m128 p = _mm_loadu_ps(pitchData + i);
+			__m128 sum = _mm_add_ps(p, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(p), 4)));
+			sum = _mm_add_ps(sum, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(sum), 8)));
+
+			const __m128 indexes = _mm_add_ps(_mm_set1_ps(index), _mm_sub_ps(sum, p));
+
+			if (!renderFour(indexes, i))
+				break;
+
+			index += _mm_cvtss_f32(_mm_shuffle_ps(sum, sum, _MM_SHUFFLE(3, 3, 3, 3)));
+		}
+
+		for (; i < numSamples; i++)
+		{
+			if (!renderSingle(index, i))
+				return;
+
+			index += pitchData[i];
+		}
+	}
+}
+
+} // namespace hise
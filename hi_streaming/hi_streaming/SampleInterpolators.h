@@ -0,0 +1,95 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef SAMPLEINTERPOLATORS_H_INCLUDED
+#define SAMPLEINTERPOLATORS_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+/** The algorithm that is used by the StreamingSamplerVoice to resample the audio data. */
+enum class SampleInterpolationMode
+{
+	Linear = 0, ///< the scalar linear interpolation
+	LinearSIMD, ///< linear interpolation that calculates four samples at once
+	CubicSIMD, ///< 4-point Hermite interpolation that calculates four samples at once
+	numModes
+};
+
+/** The resampling kernels of the StreamingSamplerVoice.
+*
+*	The SIMD kernels use SSE2 instructions (or NEON through sse2neon.h on ARM). The reading positions depend on the 
+*	pitch so the samples are fetched with scalar loads and only the position calculation and the interpolation 
+*	are vectorised.
+*/
+struct SampleInterpolators
+{
+	/** The source data for one block. */
+	template <typename SignalType> struct Input
+	{
+		/** The source channels. Set the second channel to nullptr for mono data. */
+		const SignalType* data[2] = { nullptr, nullptr };
+
+		/** The samples before the first sample (for the cubic interpolation). */
+		float previousSamples[2] = { 0.0f, 0.0f };
+
+		/** The pitch values for each sample of the block or nullptr if the pitch is constant. */
+		const float* pitchData = nullptr;
+
+		double indexInBuffer = 0.0;
+		double uptimeDelta = 1.0;
+
+		/** The rendering stops before this index is reached. */
+		int maxIndexInBuffer = INT_MAX;
+	};
+
+	/** Resamples the input into the output buffers using the given algorithm. 
+	*
+	*	The cubic interpolation needs one more sample after the last position than the linear interpolation. 
+	*/
+	template <typename SignalType, bool isFloat> static void process(SampleInterpolationMode mode, const Input<SignalType>& input, float* outL, float* outR, int numSamples);
+
+	/** Returns the number of additional samples that the algorithm reads after the last sample position. */
+	static constexpr int getNumExtraSamples(SampleInterpolationMode mode)
+	{
+		return mode == SampleInterpolationMode::CubicSIMD ? 1 : 0;
+	}
+
+private:
+
+	template <typename SignalType, bool isFloat> static void linearMono(const Input<SignalType>& input, float* outL, int numSamples);
+	template <typename SignalType, bool isFloat> static void linearStereo(const Input<SignalType>& input, float* outL, float* outR, int numSamples);
+	template <typename SignalType, bool isFloat, int NumChannels, bool UseCubic> static void processSIMD(const Input<SignalType>& input, float** out, int numSamples);
+};
+
+} // namespace hise
+
+#endif  // SAMPLEINTERPOLATORS_H_INCLUDED
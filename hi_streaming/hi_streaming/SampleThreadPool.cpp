@@ -30,40 +30,417 @@
 *   ===========================================================================
 */
 
+#if !JUCE_WINDOWS
+#include <sys/stat.h>
+#endif
+
 namespace hise { using namespace juce;
 
 
 struct SampleThreadPool::Pimpl
 {
-	Pimpl() :
-		jobQueue(8192),
-		currentlyExecutedJob(nullptr),
-		diskUsage(0.0)
-	{};
+	struct QueuedJob
+	{
+		/** The heap will pop the job with the least samples left (and the oldest one if they are equal). */
+		bool operator<(const QueuedJob& other) const noexcept
+		{
+			if (samplesBeforeUnderrun != other.samplesBeforeUnderrun)
+				return samplesBeforeUnderrun > other.samplesBeforeUnderrun;
+
+			return index > other.index;
+		}
+
+		WeakReference<Job> job;
+		int samplesBeforeUnderrun = std::numeric_limits<int>::max();
+		int64 index = 0;
+	};
+
+	/** A bounded multi-producer queue that never allocates when a job is added.
+
+		The implicit producers of the moodycamel queue allocate the first time a thread adds a job,
+		which would happen on the audio thread (or the threads that render the child synths in parallel).
+	*/
+	struct JobQueue
+	{
+		struct Cell
+		{
+			std::atomic<size_t> sequence { 0 };
+			QueuedJob data;
+		};
+
+		JobQueue(int initialCapacity)
+		{
+			setCapacity(initialCapacity);
+		}
+
+		/** Grows the queue. This must not be called while jobs are added or removed. */
+		void setCapacity(int newCapacity)
+		{
+			auto newSize = (size_t)nextPowerOfTwo(jmax(2, newCapacity));
+
+			if (newSize <= size)
+				return;
+
+			std::vector<QueuedJob> existingJobs;
+			QueuedJob j;
+
+			while (size > 0 && pop(j))
+				existingJobs.push_back(j);
+
+			cells.reset(new Cell[newSize]);
+			size = newSize;
+
+			for (size_t i = 0; i < size; i++)
+				cells[i].sequence.store(i, std::memory_order_relaxed);
+
+			enqueuePosition.store(0);
+			dequeuePosition.store(0);
+
+			for (const auto& e : existingJobs)
+				push(e);
+		}
+
+		int getCapacity() const noexcept { return (int)size; }
+
+		/** Adds the job and returns false if the queue is full. */
+		bool push(const QueuedJob& j) noexcept
+		{
+			auto pos = enqueuePosition.load(std::memory_order_relaxed);
+			Cell* c;
+
+			for (;;)
+			{
+				c = cells.get() + (pos & (size - 1));
+				auto seq = c->sequence.load(std::memory_order_acquire);
+				auto diff = (intptr_t)seq - (intptr_t)pos;
+
+				if (diff == 0)
+				{
+					if (enqueuePosition.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+						break;
+				}
+				else if (diff < 0)
+					return false;
+				else
+					pos = enqueuePosition.load(std::memory_order_relaxed);
+			}
+
+			c->data = j;
+			c->sequence.store(pos + 1, std::memory_order_release);
+			return true;
+		}
+
+		bool pop(QueuedJob& j) noexcept
+		{
+			auto pos = dequeuePosition.load(std::memory_order_relaxed);
+			Cell* c;
+
+			for (;;)
+			{
+				c = cells.get() + (pos & (size - 1));
+				auto seq = c->sequence.load(std::memory_order_acquire);
+				auto diff = (intptr_t)seq - (intptr_t)(pos + 1);
+
+				if (diff == 0)
+				{
+					if (dequeuePosition.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+						break;
+				}
+				else if (diff < 0)
+					return false;
+				else
+					pos = dequeuePosition.load(std::memory_order_relaxed);
+			}
+
+			j = c->data;
+			c->data = {};
+			c->sequence.store(pos + size, std::memory_order_release);
+			return true;
+		}
+
+	private:
+
+		std::unique_ptr<Cell[]> cells;
+		size_t size = 0;
+
+		std::atomic<size_t> enqueuePosition { 0 };
+		std::atomic<size_t> dequeuePosition { 0 };
+	};
+
+	struct Worker
+	{
+		Worker(Thread* thread_) :
+			thread(thread_),
+			jobQueue(8192)
+		{
+			pendingJobs.reserve(8192);
+		};
+
+		/** Moves the new jobs into the pending list, executes the most urgent job and returns false if there was nothing to do. */
+		bool runNextJob();
+
+		void addPendingJob(const QueuedJob& j)
+		{
+			pendingJobs.push_back(j);
+			pendingJobs.back().index = jobCounter++;
+			std::push_heap(pendingJobs.begin(), pendingJobs.end());
+		}
+
+		/** Moves the jobs that were added since the last call into the pending list. Call this with the clearLock held. */
+		void fetchNewJobs()
+		{
+			QueuedJob next;
+
+			while (jobQueue.pop(next))
+				addPendingJob(next);
+
+			while (overflowQueue.try_dequeue(next))
+				addPendingJob(next);
+		}
+
+		/** Removes all pending jobs and waits until the job that is currently executed has finished. */
+		void clear();
+
+		/** Removes the job from the pending list and returns true if it's currently being executed. */
+		bool remove(Job* j, int64& numFinishedBefore);
+
+		/** Waits until the job that was running when numFinishedJobs had the given value has finished. */
+		void waitForRunningJob(int64 numFinishedBefore)
+		{
+			while (numFinishedJobs.load() == numFinishedBefore)
+				jobFinished.wait(50);
+		}
+
+		Thread* thread;
+
+		CriticalSection clearLock;
+
+		std::atomic<double> diskUsage { 0.0 };
+		int64 startTime = 0, endTime = 0;
+		// Multiple audio threads can add jobs if the child synths are rendered in parallel
+		JobQueue jobQueue;
+
+		// Only used if the job queue is full (this might allocate)
+		moodycamel::ConcurrentQueue<QueuedJob> overflowQueue;
+
+		// Only accessed with the clearLock held
+		std::vector<QueuedJob> pendingJobs;
+		int64 jobCounter = 0;
+		int64 clearCounter = 0;
+
+		std::atomic<Job*> currentlyExecutedJob { nullptr };
+
+		std::atomic<int64> numFinishedJobs { 0 };
+		WaitableEvent jobFinished;
+	};
+
+	struct StreamingThread : public Thread
+	{
+		StreamingThread(int index) :
+			Thread("Sample Streaming Thread " + String(index), HISE_DEFAULT_STACK_SIZE)
+		{};
+
+		void run() override
+		{
+			while (!threadShouldExit())
+			{
+				if (!worker->runNextJob())
+					wait(500);
+			}
+		}
+
+		Worker* worker = nullptr;
+	};
+
+	Pimpl(SampleThreadPool* parent, int numStreamingThreads)
+	{
+		workers.add(new Worker(parent));
+
+		for (int i = 0; i < numStreamingThreads; i++)
+		{
+			auto t = new StreamingThread(i + 1);
+			t->worker = workers.add(new Worker(t));
+			streamingThreads.add(t);
+		}
+	};
 
 	~Pimpl()
 	{
-		if (auto currentJob = currentlyExecutedJob.load())
+		for (auto w : workers)
 		{
-			currentJob->signalJobShouldExit();
+			if (auto currentJob = w->currentlyExecutedJob.load())
+				currentJob->signalJobShouldExit();
 		}
+
+		for (auto t : streamingThreads)
+			t->stopThread(1000);
+
+		streamingThreads.clear();
+	}
+
+	Worker* getWorkerForJob(Job* j) const
+	{
+		const int numStreamingWorkers = workers.size() - 1;
+
+		if (numStreamingWorkers == 0 || !j->isStreamingJob())
+			return workers.getFirst();
+
+		auto key = (uint64)j->getDeviceKey();
+		return workers[1 + (int)(key % (uint64)numStreamingWorkers)];
 	}
 
-	CriticalSection clearLock;
+	OwnedArray<Worker> workers;
+	OwnedArray<StreamingThread> streamingThreads;
 
-	std::atomic<double> diskUsage;
-	int64 startTime, endTime;
-	moodycamel::ReaderWriterQueue<WeakReference<Job>> jobQueue;
-	std::atomic<Job*> currentlyExecutedJob;
 	static const String errorMessage;
 };
 
-SampleThreadPool::SampleThreadPool() :
+bool SampleThreadPool::Pimpl::Worker::runNextJob()
+{
+	QueuedJob next;
+	int64 clearCounterBeforeJob = 0;
+
+	{
+		// The lock is only held while the job is picked so that clear() doesn't have to wait for the job.
+		ScopedLock sl(clearLock);
+
+		fetchNewJobs();
+
+		if (pendingJobs.empty())
+			return false;
+
+		std::pop_heap(pendingJobs.begin(), pendingJobs.end());
+		next = pendingJobs.back();
+		pendingJobs.pop_back();
+
+		clearCounterBeforeJob = clearCounter;
+		currentlyExecutedJob.store(next.job.get());
+	}
+
+#if ENABLE_CPU_MEASUREMENT
+	const int64 lastEndTime = endTime;
+	startTime = Time::getHighResolutionTicks();
+#endif
+
+	bool needsRunningAgain = false;
+
+	if (Job* j = next.job.get())
+	{
+		j->currentThread.store(thread);
+
+		j->running.store(true);
+
+		Job::JobStatus status = j->runJob();
+
+		j->running.store(false);
+
+		if (status == Job::jobHasFinished)
+		{
+			j->queued.store(false);
+		}
+		else if (status == Job::jobNeedsRunningAgain)
+		{
+			ScopedLock sl(clearLock);
+
+			if (clearCounter != clearCounterBeforeJob)
+			{
+				// The pending jobs were cleared while this job was running so it must not be queued again
+				j->queued.store(false);
+			}
+			else
+			{
+				next.samplesBeforeUnderrun = j->getNumSamplesBeforeUnderrun();
+				addPendingJob(next);
+				needsRunningAgain = true;
+			}
+		}
+	}
+
+	currentlyExecutedJob.store(nullptr);
+
+	numFinishedJobs++;
+	jobFinished.signal();
+
+#if ENABLE_CPU_MEASUREMENT
+	endTime = Time::getHighResolutionTicks();
+
+	const int64 idleTime = startTime - lastEndTime;
+	const int64 busyTime = endTime - startTime;
+
+	diskUsage.store((double)busyTime / (double)(idleTime + busyTime));
+#endif
+
+	// Give the thread that blocks the job some time instead of spinning on it
+	// (a new job will wake up the worker immediately).
+	if (needsRunningAgain)
+		thread->wait(1);
+
+	return true;
+}
+
+void SampleThreadPool::Pimpl::Worker::clear()
+{
+	bool jobIsRunning = false;
+	int64 numFinishedBefore = 0;
+
+	{
+		ScopedLock sl(clearLock);
+
+		++clearCounter;
+
+		fetchNewJobs();
+
+		for (auto& p : pendingJobs)
+		{
+			if (auto j = p.job.get())
+			{
+				j->queued.store(false);
+				j->signalJobShouldExit();
+			}
+		}
+
+		pendingJobs.clear();
+
+		jobIsRunning = currentlyExecutedJob.load() != nullptr;
+		numFinishedBefore = numFinishedJobs.load();
+	}
+
+	// The callers rely on no job of this worker running after this method returns
+	// (unless it's called from the job itself).
+	if (jobIsRunning && Thread::getCurrentThread() != thread)
+		waitForRunningJob(numFinishedBefore);
+}
+
+bool SampleThreadPool::Pimpl::Worker::remove(Job* j, int64& numFinishedBefore)
+{
+	ScopedLock sl(clearLock);
+
+	fetchNewJobs();
+
+	auto end = std::remove_if(pendingJobs.begin(), pendingJobs.end(), [j](const QueuedJob& q)
+	{
+		return q.job.get() == j;
+	});
+
+	if (end != pendingJobs.end())
+	{
+		pendingJobs.erase(end, pendingJobs.end());
+		std::make_heap(pendingJobs.begin(), pendingJobs.end());
+	}
+
+	numFinishedBefore = numFinishedJobs.load();
+	return currentlyExecutedJob.load() == j;
+}
+
+SampleThreadPool::SampleThreadPool(int numStreamingThreads) :
 	Thread("Sample Loading Thread", HISE_DEFAULT_STACK_SIZE),
-	pimpl(new Pimpl())
+	pimpl(new Pimpl(this, jmax(0, numStreamingThreads)))
 {
 
 	startThread(9);
+
+	for (auto t : pimpl->streamingThreads)
+		t->startThread(9);
 	
 }
 
@@ -75,22 +452,65 @@ SampleThreadPool::~SampleThreadPool()
 
 double SampleThreadPool::getDiskUsage() const noexcept
 {
-	return pimpl->diskUsage.load();
+	double maxUsage = 0.0;
+
+	for (auto w : pimpl->workers)
+		maxUsage = jmax(maxUsage, w->diskUsage.load());
+
+	return maxUsage;
+}
+
+double SampleThreadPool::getDiskUsage(int workerIndex) const noexcept
+{
+	if (auto w = pimpl->workers[workerIndex])
+		return w->diskUsage.load();
+
+	return 0.0;
+}
+
+int SampleThreadPool::getNumWorkers() const noexcept
+{
+	return pimpl->workers.size();
 }
 
 void SampleThreadPool::clearPendingTasks()
 {
-	ScopedLock sl(pimpl->clearLock);
-		
-	WeakReference<Job> next;
+	for (auto w : pimpl->workers)
+		w->clear();
+}
 
-	while (pimpl->jobQueue.try_dequeue(next))
+void SampleThreadPool::prepareToPlay(int maxNumJobs)
+{
+	for (auto w : pimpl->workers)
 	{
-		next->queued.store(false);
-		next->signalJobShouldExit();
+		ScopedLock sl(w->clearLock);
+		w->jobQueue.setCapacity(maxNumJobs);
+		w->pendingJobs.reserve((size_t)w->jobQueue.getCapacity());
 	}
 }
 
+void SampleThreadPool::removeJob(Job* jobToRemove)
+{
+	auto w = pimpl->getWorkerForJob(jobToRemove);
+
+	int64 numFinishedBefore = 0;
+
+	// A job that is currently running will be removed again if it asks to run again
+	while (w->remove(jobToRemove, numFinishedBefore))
+	{
+		if (Thread::getCurrentThread() == w->thread)
+		{
+			// You can't remove a job from within its own runJob() method
+			jassertfalse;
+			break;
+		}
+
+		w->waitForRunningJob(numFinishedBefore);
+	}
+
+	jobToRemove->queued.store(false);
+}
+
 void SampleThreadPool::addJob(Job* jobToAdd, bool unused)
 {
 	ignoreUnused(unused);
@@ -102,80 +522,57 @@ void SampleThreadPool::addJob(Job* jobToAdd, bool unused)
 	}
 #endif
 
+	auto w = pimpl->getWorkerForJob(jobToAdd);
+
+	Pimpl::QueuedJob j;
+	j.job = jobToAdd;
+	j.samplesBeforeUnderrun = jobToAdd->getNumSamplesBeforeUnderrun();
 
 	jobToAdd->queued.store(true);
-	pimpl->jobQueue.enqueue(jobToAdd);
 
-	notify();
+	if (!w->jobQueue.push(j))
+		w->overflowQueue.enqueue(j);
+
+	w->thread->notify();
+}
+
+void SampleThreadPool::notifyAllWorkers()
+{
+	for (auto w : pimpl->workers)
+		w->thread->notify();
 }
 
 void SampleThreadPool::run()
 {
+	auto w = pimpl->workers.getFirst();
+
 	while (!threadShouldExit())
 	{
-		WeakReference<Job> next;
-
-		if (pimpl->jobQueue.try_dequeue(next))
-		{
-			ScopedLock sl(pimpl->clearLock);
-
-			Job* j = next.get();
-
-#if ENABLE_CPU_MEASUREMENT
-
-			const int64 lastEndTime = pimpl->endTime;
-			pimpl->startTime = Time::getHighResolutionTicks();
-#endif
-
-			if (j != nullptr)
-			{
-				pimpl->currentlyExecutedJob.store(j);
-
-				j->currentThread.store(this);
-
-				j->running.store(true);
-				
-				Job::JobStatus status = j->runJob();
-
-				j->running.store(false);
-
-				if (status == Job::jobHasFinished)
-				{
-					j->queued.store(false);
-				}
-				else if (status == Job::jobNeedsRunningAgain)
-				{
-					pimpl->jobQueue.enqueue(next);
-				}
-
-				pimpl->currentlyExecutedJob.store(nullptr);
-			}
-			else
-			{
-				pimpl->jobQueue.pop();
-			}
-
-#if ENABLE_CPU_MEASUREMENT
-			pimpl->endTime = Time::getHighResolutionTicks();
-
-			const int64 idleTime = pimpl->startTime - lastEndTime;
-			const int64 busyTime = pimpl->endTime - pimpl->startTime;
-
-			pimpl->diskUsage.store((double)busyTime / (double)(idleTime + busyTime));
-#endif
-		}
-
 #if 0 // Set this to true to enable defective threading (for debugging purposes)
+		w->runNextJob();
 		wait(2500);
 #else
-		else
-		{
+		if (!w->runNextJob())
 			wait(500);
-		}
 #endif
+	}
+}
 
+int64 SampleThreadPool::getDeviceKeyForFile(const File& f)
+{
+#if JUCE_WINDOWS
+	if (auto serialNumber = f.getVolumeSerialNumber())
+		return (int64)(uint32)serialNumber;
 
-	}
+	return f.getFullPathName().upToFirstOccurrenceOf(":", true, false).hashCode64();
+#else
+	struct stat info;
+
+	if (stat(f.getFullPathName().toRawUTF8(), &info) == 0)
+		return (int64)info.st_dev;
+
+	return 0;
+#endif
 }
 
 const String SampleThreadPool::Pimpl::errorMessage("HDD overflow");
@@ -35,11 +35,32 @@
 
 namespace hise { using namespace juce;
 
+//=============================================================================
+/** Config: HISE_NUM_STREAMING_THREADS
+
+The number of additional worker threads that refill the streaming buffers.
+If this is zero, all jobs will be executed by the sample loading thread itself.
+*/
+#ifndef HISE_NUM_STREAMING_THREADS
+#define HISE_NUM_STREAMING_THREADS 0
+#endif
+
+/** The background thread pool that performs the sample loading and streaming.
+*
+*	The SampleThreadPool itself is the sample loading thread that executes all preloading and
+*	housekeeping jobs. If you create it with additional streaming threads, every streaming job
+*	(see Job::isStreamingJob()) will be dispatched to one of those threads based on the physical
+*	device or monolith file it reads from, so that one slow disk or decoding operation will not
+*	block the voices that are streaming from another device.
+*
+*	Each worker keeps its pending jobs sorted by the number of samples that are left before the
+*	voice runs out of data, so the most urgent refill operation is always performed first.
+*/
 class SampleThreadPool : public Thread
 {
 public:
 
-	SampleThreadPool();
+	SampleThreadPool(int numStreamingThreads=HISE_NUM_STREAMING_THREADS);
 
 	~SampleThreadPool();
 	
@@ -65,6 +86,21 @@ public:
 
 		virtual JobStatus runJob() = 0;
 
+		/** Override this and return true if the job should be executed by one of the streaming threads. */
+		virtual bool isStreamingJob() const { return false; }
+
+		/** Returns a key that identifies the device or file this job reads from. 
+		
+			All jobs with the same key will be executed on the same streaming thread.
+		*/
+		virtual int64 getDeviceKey() const { return 0; }
+
+		/** Returns the number of samples that can be played back before this job needs to be finished. 
+		
+			This will be called from the thread that adds the job and is used to sort the pending jobs.
+		*/
+		virtual int getNumSamplesBeforeUnderrun() const { return std::numeric_limits<int>::max(); }
+
 		bool shouldExit() const noexcept{ return shouldStop.load(); }
 
 		void signalJobShouldExit() { shouldStop.store(true); }
@@ -93,14 +129,40 @@ public:
 		const String name;
 	};
 
+	/** Returns the highest disk usage of all workers. */
 	double getDiskUsage() const noexcept;
 
+	/** Returns the ratio of busy time of the given worker (0 is the sample loading thread). */
+	double getDiskUsage(int workerIndex) const noexcept;
+
+	/** Returns the number of workers including the sample loading thread. */
+	int getNumWorkers() const noexcept;
+
+	/** Removes all pending jobs and waits until the jobs that are currently running have finished. */
 	void clearPendingTasks();
 
+	/** Resizes the job queues so that adding a job on the audio thread doesn't allocate.
+
+		Call this while the audio thread is suspended (the queues must not be used during the resizing).
+	*/
+	void prepareToPlay(int maxNumJobs);
+
 	void addJob(Job* jobToAdd, bool unused);
 
+	/** Removes the job from the queue and waits until it has finished if it's currently running.
+
+		Call signalJobShouldExit() before this method if the job should stop early.
+	*/
+	void removeJob(Job* jobToRemove);
+
+	/** Wakes up every worker thread. */
+	void notifyAllWorkers();
+
 	void run() override;
 
+	/** Creates a device key for the given file that can be used to dispatch the jobs. */
+	static int64 getDeviceKeyForFile(const File& f);
+
 	struct Pimpl;
 
 	
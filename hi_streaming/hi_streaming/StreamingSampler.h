@@ -85,17 +85,17 @@ public:
 
 	virtual void decreaseNumOpenFileHandles()
 	{
-		--numOpenFileHandles;
-		if (numOpenFileHandles < 0) numOpenFileHandles = 0;
+		if (--numOpenFileHandles < 0) numOpenFileHandles = 0;
 	}
 
 	AudioFormatManager afm;
 
-	int getNumOpenFileHandles() const { return numOpenFileHandles; }
+	int getNumOpenFileHandles() const { return numOpenFileHandles.load(); }
 
 private:
 
-	int numOpenFileHandles = 0;
+	// The file handles might be opened from multiple streaming threads
+	std::atomic<int> numOpenFileHandles { 0 };
 
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StreamingSamplerSoundPool);
 };
@@ -181,6 +181,12 @@ struct StereoChannelData
 #endif
 
 
+// If this is enabled, sounds that read the same data with the same preload settings will share their preload buffer
+// across all plugin instances in the process (so loading the same sample map in multiple instances won't multiply the preload memory).
+#ifndef HISE_SHARE_PRELOAD_BUFFERS
+#define HISE_SHARE_PRELOAD_BUFFERS 1
+#endif
+
 #define NUM_UNMAPPERS 8
 
 
@@ -34,6 +34,136 @@ namespace hise { using namespace juce;
 
 #define MAX_SAMPLE_NUMBER 2147483647
 
+// ==================================================================================================== PreloadBufferCache methods
+
+bool PreloadBufferCache::Key::operator==(const Key& other) const
+{
+	return sampleStart == other.sampleStart &&
+		   sampleEnd == other.sampleEnd &&
+		   numSamplesToRead == other.numSamplesToRead &&
+		   preloadSize == other.preloadSize &&
+		   numChannels == other.numChannels &&
+		   isFloat == other.isFloat &&
+		   reversed == other.reversed &&
+		   id == other.id;
+}
+
+int64 PreloadBufferCache::Key::getHash() const
+{
+	auto h = (uint64)id.hashCode64();
+
+	auto combine = [&h](int64 v)
+	{
+		h ^= (uint64)v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+	};
+
+	combine(sampleStart);
+	combine(sampleEnd);
+	combine(numSamplesToRead);
+	combine(preloadSize);
+	combine(numChannels);
+	combine((isFloat ? 1 : 0) | (reversed ? 2 : 0));
+
+	return (int64)h;
+}
+
+PreloadBufferCache::Entry::Ptr PreloadBufferCache::getEntry(const Key& k) const
+{
+	if (k.id.isEmpty())
+		return nullptr;
+
+	auto hash = k.getHash();
+
+	ScopedLock sl(lock);
+
+	auto range = entries.equal_range(hash);
+
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		if (it->second->key == k)
+			return it->second;
+	}
+
+	return nullptr;
+}
+
+PreloadBufferCache::Entry::Ptr PreloadBufferCache::addEntry(Entry::Ptr newEntry)
+{
+	if (newEntry == nullptr || newEntry->key.id.isEmpty())
+		return newEntry;
+
+	auto hash = newEntry->key.getHash();
+
+	ScopedLock sl(lock);
+
+	auto range = entries.equal_range(hash);
+
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		if (it->second->key == newEntry->key)
+			return it->second;
+	}
+
+	entries.emplace(hash, newEntry);
+	return newEntry;
+}
+
+void PreloadBufferCache::releaseEntry(Entry::Ptr& entry)
+{
+	Entry::Ptr e = entry;
+	entry = nullptr;
+
+	if (e == nullptr)
+		return;
+
+	auto hash = e->key.getHash();
+
+	ScopedLock sl(lock);
+
+	// Only the cache and this function hold a reference, so nobody is using this buffer anymore
+	if (e->getReferenceCount() == 2)
+	{
+		auto range = entries.equal_range(hash);
+
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			if (it->second == e)
+			{
+				entries.erase(it);
+				break;
+			}
+		}
+	}
+}
+
+size_t PreloadBufferCache::getMemoryUsage() const
+{
+	ScopedLock sl(lock);
+
+	size_t numBytes = 0;
+
+	for (const auto& it : entries)
+	{
+		auto e = it.second;
+		auto bytesPerSample = e->buffer.isFloatingPoint() ? sizeof(float) : sizeof(int16);
+		numBytes += (size_t)(e->buffer.getNumSamples() * e->buffer.getNumChannels()) * bytesPerSample;
+	}
+
+	return numBytes;
+}
+
+int PreloadBufferCache::getNumEntries() const
+{
+	ScopedLock sl(lock);
+	return (int)entries.size();
+}
+
+String PreloadBufferCache::createFileId(const File& f)
+{
+	// The modification time and size make sure that a file that was exported again isn't using a stale buffer
+	return f.getFullPathName() + "|" + String(f.getLastModificationTime().toMilliseconds()) + "|" + String(f.getSize());
+}
+
 // ==================================================================================================== StreamingSamplerSound methods
 
 StreamingSamplerSound::StreamingSamplerSound(const String &fileNameToLoad, StreamingSamplerSoundPool *pool) :
@@ -83,6 +213,7 @@ StreamingSamplerSound::StreamingSamplerSound(HlacMonolithInfo::Ptr info, int cha
 StreamingSamplerSound::~StreamingSamplerSound()
 {
 	masterReference.clear();
+	releaseSharedPreloadBuffer();
 	fileReader.closeFileHandles();
 }
 
@@ -169,6 +300,7 @@ void StreamingSamplerSound::setPreloadSize(int newPreloadSize, bool forceReload)
 		internalPreloadSize = 0;
 		preloadSize = 0;
 
+		releaseSharedPreloadBuffer();
 		preloadBuffer = hlac::HiseSampleBuffer(!fileReader.isMonolithic(), fileReader.isStereo() ? 2 : 1, 0);
 
 		return;
@@ -209,27 +341,6 @@ void StreamingSamplerSound::setPreloadSize(int newPreloadSize, bool forceReload)
 
 	auto sampleStartToUse = isReversed() ? 0 : sampleStart;
 
-	preloadBuffer = hlac::HiseSampleBuffer(!fileReader.isMonolithic(), fileReader.isStereo() ? 2 : 1, 0);
-
-	try
-	{
-		preloadBuffer.setSize(fileReader.isStereo() ? 2 : 1, internalPreloadSize);
-	}
-	catch (std::exception e)
-	{
-		preloadBuffer.setSize(fileReader.isStereo() ? 2 : 1, 0);
-
-		throw StreamingSamplerSound::LoadingError(getFileName(), "Preload error (max memory exceeded).");
-	}
-
-	if (preloadBuffer.getNumSamples() == 0)
-	{
-		return;
-	}
-
-	preloadBuffer.clear();
-	preloadBuffer.allocateNormalisationTables(sampleStartToUse);
-
 	if (sampleRate <= 0.0)
 	{
 		if (AudioFormatReader *reader = fileReader.getReader())
@@ -241,8 +352,6 @@ void StreamingSamplerSound::setPreloadSize(int newPreloadSize, bool forceReload)
 		}
 	}
 
-	
-
 	bool applyLoopToPreloadBuffer = (loopEnd - sampleStart) < internalPreloadSize;
 
 	if (isReversed())
@@ -251,56 +360,104 @@ void StreamingSamplerSound::setPreloadSize(int newPreloadSize, bool forceReload)
 	applyLoopToPreloadBuffer &= loopEnabled;
 	applyLoopToPreloadBuffer &= getLoopLength() > 0;
 
-	if (applyLoopToPreloadBuffer)
+	releaseSharedPreloadBuffer();
+	preloadBuffer = hlac::HiseSampleBuffer(!fileReader.isMonolithic(), fileReader.isStereo() ? 2 : 1, 0);
+
+	hlac::HiseSampleBuffer* targetBuffer = &preloadBuffer;
+	PreloadBufferCache::Entry::Ptr newEntry;
+
+#if HISE_SHARE_PRELOAD_BUFFERS
+	// Buffers with a baked in loop are not shared (the loop data is not part of the cache key)
+	if (!applyLoopToPreloadBuffer)
 	{
-		const int samplesPerFillOp = getLoopLength();
+		auto key = createPreloadCacheKey(jmin<int>(sampleLength, internalPreloadSize));
 
-		if (isReversed())
-		{
-			int numToRead = sampleEnd - loopStart;
-			fileReader.readFromDisk(preloadBuffer, 0, numToRead, 0, true);
-			int numTodo = internalPreloadSize - numToRead;
+		sharedPreloadBuffer = preloadCache->getEntry(key);
 
-			int pos = numToRead;
+		if (sharedPreloadBuffer == nullptr)
+		{
+			newEntry = new PreloadBufferCache::Entry(key);
+			targetBuffer = &newEntry->buffer;
+		}
+	}
+#endif
 
-			int thisLoopStart = numToRead - samplesPerFillOp;
+	if (sharedPreloadBuffer == nullptr)
+	{
+		auto& b = *targetBuffer;
 
-			while (numTodo > 0)
-			{
-				int numThisTime = jmin<int>(numTodo, samplesPerFillOp);
+		try
+		{
+			b.setSize(fileReader.isStereo() ? 2 : 1, internalPreloadSize);
+		}
+		catch (std::exception e)
+		{
+			b.setSize(fileReader.isStereo() ? 2 : 1, 0);
 
-				hlac::HiseSampleBuffer::copy(preloadBuffer, preloadBuffer, pos, thisLoopStart, numThisTime);
+			throw StreamingSamplerSound::LoadingError(getFileName(), "Preload error (max memory exceeded).");
+		}
 
-				numTodo -= numThisTime;
-				pos += numThisTime;
-			}
+		if (b.getNumSamples() == 0)
+		{
+			return;
 		}
-		else
+
+		b.clear();
+		b.allocateNormalisationTables(sampleStartToUse);
+
+		if (applyLoopToPreloadBuffer)
 		{
-			int pos = loopEnd - sampleStart;
+			const int samplesPerFillOp = getLoopLength();
 
-			fileReader.readFromDisk(preloadBuffer, 0, pos, sampleStartToUse, true);
-			
+			if (isReversed())
+			{
+				int numToRead = sampleEnd - loopStart;
+				fileReader.readFromDisk(b, 0, numToRead, 0, true);
+				int numTodo = internalPreloadSize - numToRead;
+
+				int pos = numToRead;
+
+				int thisLoopStart = numToRead - samplesPerFillOp;
+
+				while (numTodo > 0)
+				{
+					int numThisTime = jmin<int>(numTodo, samplesPerFillOp);
 
-			int numTodo = internalPreloadSize - (loopEnd - sampleStartToUse);
+					hlac::HiseSampleBuffer::copy(b, b, pos, thisLoopStart, numThisTime);
 
-			while (numTodo > 0)
+					numTodo -= numThisTime;
+					pos += numThisTime;
+				}
+			}
+			else
 			{
-				int numThisTime = jmin<int>(numTodo, samplesPerFillOp);
+				int pos = loopEnd - sampleStart;
+
+				fileReader.readFromDisk(b, 0, pos, sampleStartToUse, true);
 
-				hlac::HiseSampleBuffer::copy(preloadBuffer, preloadBuffer, pos, loopStart - sampleStart, numThisTime);
+				int numTodo = internalPreloadSize - (loopEnd - sampleStartToUse);
 
-				numTodo -= numThisTime;
-				pos += numThisTime;
+				while (numTodo > 0)
+				{
+					int numThisTime = jmin<int>(numTodo, samplesPerFillOp);
+
+					hlac::HiseSampleBuffer::copy(b, b, pos, loopStart - sampleStart, numThisTime);
+
+					numTodo -= numThisTime;
+					pos += numThisTime;
+				}
 			}
 		}
-	}
-	else
-	{
-		auto samplesToRead = jmin<int>(sampleLength, internalPreloadSize);
+		else
+		{
+			auto samplesToRead = jmin<int>(sampleLength, internalPreloadSize);
 
-		if(samplesToRead > 0)
-			fileReader.readFromDisk(preloadBuffer, 0, samplesToRead, sampleStartToUse, true);
+			if(samplesToRead > 0)
+				fileReader.readFromDisk(b, 0, samplesToRead, sampleStartToUse, true);
+		}
+
+		if (newEntry != nullptr)
+			sharedPreloadBuffer = preloadCache->addEntry(newEntry);
 	}
 
 	rebuildCrossfadeBuffer();
@@ -309,13 +466,53 @@ void StreamingSamplerSound::setPreloadSize(int newPreloadSize, bool forceReload)
 
 
 
+void StreamingSamplerSound::releaseSharedPreloadBuffer()
+{
+	if (sharedPreloadBuffer != nullptr)
+		preloadCache->releaseEntry(sharedPreloadBuffer);
+}
+
+void StreamingSamplerSound::detachSharedPreloadBuffer()
+{
+	if (sharedPreloadBuffer == nullptr)
+		return;
+
+	const auto& source = sharedPreloadBuffer->buffer;
+	const int numSamples = source.getNumSamples();
+
+	preloadBuffer = hlac::HiseSampleBuffer(source.isFloatingPoint(), source.getNumChannels(), 0);
+	preloadBuffer.setSize(source.getNumChannels(), numSamples);
+	preloadBuffer.clear();
+	preloadBuffer.allocateNormalisationTables(isReversed() ? 0 : sampleStart);
+
+	hlac::HiseSampleBuffer::copy(preloadBuffer, source, 0, 0, numSamples);
+
+	releaseSharedPreloadBuffer();
+}
+
+PreloadBufferCache::Key StreamingSamplerSound::createPreloadCacheKey(int numSamplesToRead) const
+{
+	PreloadBufferCache::Key k;
+
+	k.id = fileReader.getPreloadCacheId();
+	k.sampleStart = isReversed() ? 0 : sampleStart;
+	k.sampleEnd = sampleEnd;
+	k.numSamplesToRead = numSamplesToRead;
+	k.preloadSize = internalPreloadSize;
+	k.numChannels = fileReader.isStereo() ? 2 : 1;
+	k.isFloat = !fileReader.isMonolithic();
+	k.reversed = isReversed();
+
+	return k;
+}
+
 size_t StreamingSamplerSound::getActualPreloadSize() const
 {
 	auto bytesPerSample = fileReader.isMonolithic() ? sizeof(int16) : sizeof(float);
 
 	auto loopBytes = loopBuffer != nullptr ? loopBuffer->getNumSamples() * loopBuffer->getNumChannels() : 0;
 
-	return hasActiveState() ? (size_t)(internalPreloadSize *preloadBuffer.getNumChannels()) * bytesPerSample + (size_t)(loopBytes) * bytesPerSample : 0;
+	return hasActiveState() ? (size_t)(internalPreloadSize *getPreloadBuffer().getNumChannels()) * bytesPerSample + (size_t)(loopBytes) * bytesPerSample : 0;
 }
 
 void StreamingSamplerSound::loadEntireSample() { setPreloadSize(-1); }
@@ -472,7 +669,7 @@ void StreamingSamplerSound::setSampleStart(int newSampleStart)
 		sampleStart = newSampleStart;
 		lengthChanged();
 
-		Range<int> s(sampleStart, sampleStart + preloadBuffer.getNumSamples());
+		Range<int> s(sampleStart, sampleStart + getPreloadBuffer().getNumSamples());
 
 		if (s.contains(loopStart))
 		{
@@ -595,10 +792,13 @@ void StreamingSamplerSound::applyCrossfadeToInternalBuffers()
 		if (isReversed())
 			fadePos = sampleEnd - loopStart - crossfadeArea.getLength();
 
-		auto numInBuffer = preloadBuffer.getNumSamples();
+		auto numInBuffer = getPreloadBuffer().getNumSamples();
         
 		if (fadePos < numInBuffer)
 		{
+			// the crossfade is written into the preload buffer so we can't share it anymore...
+			detachSharedPreloadBuffer();
+
 			preloadBuffer.burnNormalisation();
 
 			while (fadePos < numInBuffer)
@@ -643,10 +843,10 @@ void StreamingSamplerSound::loopChanged()
 
 	if (loopEnabled)
 	{
-		bool preloadContainsLoop = loopEnd <= preloadBuffer.getNumSamples() - sampleStart;
+		bool preloadContainsLoop = loopEnd <= getPreloadBuffer().getNumSamples() - sampleStart;
 
 		if (isReversed())
-			preloadContainsLoop = getLoopEnd(true) <= preloadBuffer.getNumSamples();
+			preloadContainsLoop = getLoopEnd(true) <= getPreloadBuffer().getNumSamples();
 
 		if (preloadContainsLoop)
 		{
@@ -971,9 +1171,11 @@ void StreamingSamplerSound::fillInternal(hlac::HiseSampleBuffer &sampleBuffer, i
 
 		jassert(!crossfadeArea.contains(indexInPreloadBuffer));
 
-		if (indexInPreloadBuffer + samplesToCopy < preloadBuffer.getNumSamples())
+		const auto& pb = getPreloadBuffer();
+
+		if (indexInPreloadBuffer + samplesToCopy < pb.getNumSamples())
 		{
-			hlac::HiseSampleBuffer::copy(sampleBuffer, preloadBuffer, offsetInBuffer, indexInPreloadBuffer, samplesToCopy);
+			hlac::HiseSampleBuffer::copy(sampleBuffer, pb, offsetInBuffer, indexInPreloadBuffer, samplesToCopy);
 		}
 		else
 		{
@@ -1012,6 +1214,7 @@ StreamingSamplerSound::FileReader::~FileReader()
 void StreamingSamplerSound::FileReader::setFile(const String &fileName)
 {
 	monolithicInfo = nullptr;
+	preloadCacheId = {};
 
 	if (File::isAbsolutePath(fileName))
 	{
@@ -1022,6 +1225,7 @@ void StreamingSamplerSound::FileReader::setFile(const String &fileName)
 		fileFormatSupportsMemoryReading = fileExtension.contains("wav") || fileExtension.contains("aif");// || fileExtension.contains("hlac");
 
 		hashCode = loadedFile.hashCode64();
+		deviceKey = SampleThreadPool::getDeviceKeyForFile(loadedFile);
 	}
 	else
 	{
@@ -1055,6 +1259,20 @@ String StreamingSamplerSound::FileReader::getFileName(bool getFullPath)
 	else return getFullPath ? loadedFile.getFullPathName() : loadedFile.getFileName();
 }
 
+String StreamingSamplerSound::FileReader::getPreloadCacheId() const
+{
+	// The id is only created once per file reader (and for monoliths once per monolith file)
+	if (preloadCacheId.isEmpty())
+	{
+		if (monolithicInfo != nullptr)
+			preloadCacheId = monolithicInfo->getPreloadCacheId(monolithicChannelIndex, monolithicIndex);
+		else if (loadedFile != File())
+			preloadCacheId = PreloadBufferCache::createFileId(loadedFile);
+	}
+
+	return preloadCacheId;
+}
+
 void StreamingSamplerSound::FileReader::checkFileReference()
 {
 	if (monolithicInfo != nullptr) return;
@@ -1075,6 +1293,7 @@ void StreamingSamplerSound::FileReader::refreshFileInformation()
 		fileFormatSupportsMemoryReading = fileExtension.compareIgnoreCase(".wav") || fileExtension.startsWithIgnoreCase(".aif");// || fileExtension.startsWithIgnoreCase("hlac");
 
 		hashCode = loadedFile.hashCode64();
+		deviceKey = SampleThreadPool::getDeviceKeyForFile(loadedFile);
 	}
 }
 
@@ -1337,8 +1556,10 @@ void StreamingSamplerSound::FileReader::setMonolithicInfo(HlacMonolithInfo::Ptr
 	monolithicChannelIndex = channelIndex;
 	missing = (sampleIndex == -1);
 	monolithicName = info->getFileName(channelIndex, sampleIndex);
+	preloadCacheId = {};
 
 	hashCode = monolithicName.hashCode64();
+	deviceKey = info->getDeviceKey(channelIndex, sampleIndex);
 }
 
 } // namespace hise
@@ -38,6 +38,80 @@ namespace hise { using namespace juce;
 
 // ==================================================================================================================================================
 
+/** A process-wide cache for the preload buffers of StreamingSamplerSounds.
+	@ingroup sampler
+
+	Every plugin instance has its own sample pool, so if you load the same sample map in multiple instances, each one
+	would allocate an identical set of preload buffers. This cache is accessed through a SharedResourcePointer and lets
+	sounds that read the same data with the same preload settings share a single read-only buffer.
+
+	The entries are reference counted and will be removed as soon as the last sound releases its buffer. Sounds that need
+	to write into their preload buffer (eg. for a loop crossfade) will detach from the cache and use a private copy.
+*/
+class PreloadBufferCache
+{
+public:
+
+	/** The properties that define the content of a preload buffer. */
+	struct Key
+	{
+		bool operator==(const Key& other) const;
+
+		/** Returns a 64 bit hash of all properties that is used for the lookup. */
+		int64 getHash() const;
+
+		String id;
+		int sampleStart = 0;
+		int sampleEnd = 0;
+		int numSamplesToRead = 0;
+		int preloadSize = 0;
+		int numChannels = 0;
+		bool isFloat = true;
+		bool reversed = false;
+	};
+
+	struct Entry : public ReferenceCountedObject
+	{
+		using Ptr = ReferenceCountedObjectPtr<Entry>;
+
+		Entry(const Key& k) :
+			key(k),
+			buffer(k.isFloat, k.numChannels, 0)
+		{};
+
+		const Key key;
+		hlac::HiseSampleBuffer buffer;
+
+		JUCE_DECLARE_NON_COPYABLE(Entry);
+	};
+
+	/** Returns the entry for the given key or nullptr if there is no buffer with this content yet. */
+	Entry::Ptr getEntry(const Key& k) const;
+
+	/** Adds the (fully loaded) entry to the cache. If another sound has added an entry with the same key in the meantime, it will return this one instead. */
+	Entry::Ptr addEntry(Entry::Ptr newEntry);
+
+	/** Releases the reference to the entry and removes it from the cache if it's not used anymore. */
+	void releaseEntry(Entry::Ptr& entry);
+
+	/** Returns the amount of preload memory that is currently held by the cache. */
+	size_t getMemoryUsage() const;
+
+	int getNumEntries() const;
+
+	/** Creates the part of the cache id that identifies the file (including its modification time and size). */
+	static String createFileId(const File& f);
+
+private:
+
+	CriticalSection lock;
+
+	// The entries are stored with the hash of their key (the key is compared too in case of a collision)
+	std::unordered_multimap<int64, Entry::Ptr> entries;
+};
+
+// ==================================================================================================================================================
+
 /** A SamplerSound which provides buffered disk streaming using memory mapped file access and a preloaded sample start. 
 	@ingroup sampler
 
@@ -219,6 +293,12 @@ public:
 	int64 getMonolithLength() const { return fileReader.getMonolithLength(); }
 	double getMonolithSampleRate() const { return fileReader.getMonolithSampleRate(); }
 
+	/** Returns the monolith that contains this sound or nullptr if the sound is not monolithic. */
+	HlacMonolithInfo* getMonolithInfo() const noexcept { return fileReader.getMonolithInfo(); }
+
+	/** Returns the key that is used to dispatch the streaming jobs for this sound to a thread of the SampleThreadPool. */
+	int64 getDeviceKey() const noexcept { return fileReader.getDeviceKey(); }
+
 	// ==============================================================================================================================================
 
 	String getFileName(bool getFullPath = false) const;
@@ -270,9 +350,15 @@ public:
 		// This should not happen (either its unloaded or it has some samples)...
 		//jassert(preloadBuffer.getNumSamples() != 0);
 
+		if (sharedPreloadBuffer != nullptr)
+			return sharedPreloadBuffer->buffer;
+
 		return preloadBuffer;
 	}
 
+	/** Returns true if the preload buffer is shared with other sounds through the PreloadBufferCache. */
+	bool isUsingSharedPreloadBuffer() const noexcept { return sharedPreloadBuffer != nullptr; }
+
 	// ==============================================================================================================================================
 
 	/** Scans the file for the max level. */
@@ -314,9 +400,19 @@ private:
 		void setMonolithicInfo(HlacMonolithInfo::Ptr info, int channelIndex, int sampleIndex);
 
 		String getFileName(bool getFullPath);
+
+		/** Returns a string that identifies the data source (the file or the location in the monolith) across all sample pools.
+
+			This includes the modification time and size of the file.
+		*/
+		String getPreloadCacheId() const;
+
 		void checkFileReference();
 		int64 getHashCode() { return hashCode; };
 
+		/** Returns the key of the device (or monolith file) that is used to pick the streaming thread. */
+		int64 getDeviceKey() const noexcept { return deviceKey; }
+
 		/** Refreshes the information about the file (if it is missing, if it supports memory-mapping). */
 		void refreshFileInformation();
 
@@ -344,6 +440,7 @@ private:
 		bool isUsed() const noexcept { return voiceCount.get() != 0; }
 		bool isOpened() const noexcept { return fileHandlesOpen; }
 		bool isMonolithic() const noexcept { return monolithicInfo != nullptr; }
+		HlacMonolithInfo* getMonolithInfo() const noexcept { return monolithicInfo.get(); }
 
 		bool isStereo() const noexcept;
 
@@ -424,6 +521,9 @@ private:
 		String faultyFileName;
 
 		int64 hashCode;
+		int64 deviceKey = 0;
+
+		mutable String preloadCacheId;
 
 		StreamingSamplerSound *sound;
 
@@ -490,7 +590,18 @@ private:
     
 	friend class SampleLoader;
 
+	void releaseSharedPreloadBuffer();
+
+	/** Copies the shared preload buffer into the private buffer so that it can be modified. */
+	void detachSharedPreloadBuffer();
+
+	PreloadBufferCache::Key createPreloadCacheKey(int numSamplesToRead) const;
+
 	hlac::HiseSampleBuffer preloadBuffer;
+
+	SharedResourcePointer<PreloadBufferCache> preloadCache;
+	PreloadBufferCache::Entry::Ptr sharedPreloadBuffer;
+
 	double sampleRate;
 
 	int preloadSize;
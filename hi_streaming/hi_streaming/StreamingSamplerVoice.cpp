@@ -111,6 +111,8 @@ void SampleLoader::startNote(StreamingSamplerSound const *s, int startTime)
 	readIndex = startTime;
 	readIndexDouble = (double)startTime;
 
+	updateNumSamplesBeforeUnderrun();
+
 	isReadingFromPreloadBuffer = true;
 
 	// Set the sampleposition to (1 * bufferSize) because the first buffer is the preload buffer
@@ -333,6 +335,7 @@ bool SampleLoader::advanceReadIndex(double uptime)
                 readIndexDouble = uptime - lastSwapPosition;
             }
             
+			updateNumSamplesBeforeUnderrun();
 			return true;
 		}
 		else
@@ -342,15 +345,31 @@ bool SampleLoader::advanceReadIndex(double uptime)
 			readIndexDouble = uptime - lastSwapPosition;
 
 			swapBuffers();
+			updateNumSamplesBeforeUnderrun();
+
 			const bool queueIsFree = requestNewData();
 
 			return queueIsFree;
 		}
 	}
 
+	updateNumSamplesBeforeUnderrun();
 	return true;
 }
 
+void SampleLoader::updateNumSamplesBeforeUnderrun()
+{
+	int numLeft = 0;
+
+	if (auto b = readBuffer.get())
+		numLeft = jmax(0, b->getNumSamples() - (int)readIndexDouble);
+
+	// Convert the samples left in the buffer to output samples so that transposed voices are more urgent
+	auto numOutputSamples = (double)numLeft / jmax(0.001, playbackRate);
+
+	numSamplesBeforeUnderrun.store((int)jmin(numOutputSamples, (double)std::numeric_limits<int>::max()));
+}
+
 int SampleLoader::getNumSamplesForStreamingBuffers() const
 {
 	jassert(b1.getNumSamples() == b2.getNumSamples());
@@ -373,7 +392,7 @@ bool SampleLoader::requestNewData()
 		writeBuffer.get()->clear();
 
 		cancelled = true;
-		backgroundPool->notify();
+		backgroundPool->notifyAllWorkers();
 		return false;
 	}
 	else
@@ -397,13 +416,14 @@ SampleThreadPoolJob::JobStatus SampleLoader::runJob()
 
 	const double readStart = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks());
 
-	if (writeBufferIsBeingFilled)
+	bool notFilled = false;
+
+	// A poor man's mutex but gets the job done (and the job might be executed by another streaming thread).
+	if (!writeBufferIsBeingFilled.compare_exchange_strong(notFilled, true))
 	{
 		return SampleThreadPoolJob::jobNeedsRunningAgain;
 	}
 
-	writeBufferIsBeingFilled = true; // A poor man's mutex but gets the job done.
-
 	const StreamingSamplerSound *localSound = sound.get();
 
 	if (!voiceCounterWasIncreased && localSound != nullptr)
@@ -426,6 +446,19 @@ SampleThreadPoolJob::JobStatus SampleLoader::runJob()
 	return SampleThreadPoolJob::JobStatus::jobHasFinished;
 }
 
+juce::int64 SampleLoader::getDeviceKey() const
+{
+	if (auto s = sound.get())
+		return s->getDeviceKey();
+
+	return 0;
+}
+
+int SampleLoader::getNumSamplesBeforeUnderrun() const
+{
+	return numSamplesBeforeUnderrun.load();
+}
+
 size_t SampleLoader::getActualStreamingBufferSize() const
 {
 	return b1.getNumSamples() * 2 * 2;
@@ -541,9 +574,12 @@ void StreamingSamplerVoice::startNote(int /*midiNoteNumber*/,
 
 	if (sound != nullptr && sound->getSampleLength() > 0)
 	{
+		loader.setPlaybackRate(uptimeDelta * sound->getSampleRate() / getSampleRate());
 		loader.startNote(sound, sampleStartModValue);
 
 		jassert(sound != nullptr);
+
+		hasPreviousSamples = false;
 		
 		voiceUptime = (double)sampleStartModValue;
 
@@ -589,121 +625,37 @@ void StreamingSamplerVoice::setDebugLogger(DebugLogger* newLogger)
 	loader.setLogger(logger);
 }
 
-static int alignedCalls = 0;
-static int unalignedCalls = 0;
-
-template <typename SignalType, bool isFloat> void interpolateMonoSamples(const SignalType* inL, const SignalType* unusedIn, const float* pitchData, float* outL, float* unusedOut, int startSample, double indexInBuffer, double uptimeDelta, int numSamples)
+template <typename SignalType, bool isFloat>
+void StreamingSamplerVoice::interpolateSamples(SampleInterpolators::Input<SignalType>& input, float* outL, float* outR, int startSample, int numSamples, double indexInBuffer, int lastIndex)
 {
-	ignoreUnused(unusedIn, unusedOut);
-
-	constexpr float gainFactor = isFloat ? 1.0f : (1.0f / (float)INT16_MAX);
+	const int numChannels = input.data[1] != nullptr ? 2 : 1;
 
-	if (pitchData != nullptr)
+	// Use the first sample as previous sample for the first block
+	if (!hasPreviousSamples)
 	{
-		pitchData += startSample;
-
-		float indexInBufferFloat = (float)indexInBuffer;
-
-		for (int i = 0; i < numSamples; i++)
-		{
-			const int pos = int(indexInBufferFloat);
-			const float alpha = indexInBufferFloat - (float)pos;
-			const float invAlpha = 1.0f - alpha;
-
-			float l = ((float)inL[pos] * invAlpha + (float)inL[pos + 1] * alpha);
-
-			outL[i] = l * gainFactor;
-
-			jassert(*pitchData <= (float)MAX_SAMPLER_PITCH);
-
-			indexInBufferFloat += pitchData[i];
-		}
+		for (int i = 0; i < numChannels; i++)
+			previousSamples[i] = (float)input.data[i][0];
 	}
-	else
-	{
-		float indexInBufferFloat = (float)indexInBuffer;
-		const float uptimeDeltaFloat = (float)uptimeDelta;
-
-		while (numSamples > 0)
-		{
-			const int pos = int(indexInBufferFloat);
-			const float alpha = indexInBufferFloat - (float)pos;
-			const float invAlpha = 1.0f - alpha;
-
-			float l = ((float)inL[pos] * invAlpha + (float)inL[pos + 1] * alpha);
-
-			*outL++ = l * gainFactor;
 
-			indexInBufferFloat += uptimeDeltaFloat;
+	for (int i = 0; i < numChannels; i++)
+		input.previousSamples[i] = previousSamples[i];
 
-			numSamples--;
-		}
-	}
-}
+	input.pitchData = pitchData != nullptr ? pitchData + startSample : nullptr;
+	input.indexInBuffer = indexInBuffer;
+	input.uptimeDelta = uptimeDelta;
 
-template <typename SignalType, bool isFloat> void interpolateStereoSamples(const SignalType* inL, const SignalType* inR, const float* pitchData, float* outL, float* outR, int startSample, double indexInBuffer, double uptimeDelta, int numSamples, int maxIndexInBuffer)
-{
-	constexpr float gainFactor = isFloat ? 1.0f : (1.0f / (float)INT16_MAX);
+	SampleInterpolators::process<SignalType, isFloat>(interpolationMode, input, outL, outR, numSamples);
 
-	if (pitchData != nullptr)
+	// Store the last sample before the start position of the next block
+	if (lastIndex >= 0)
 	{
-		pitchData += startSample;
-
-		float indexInBufferFloat = (float)indexInBuffer;
-
-		for (int i = 0; i < numSamples; i++)
-		{
-			const int pos = int(indexInBufferFloat);
-
-			if (pos >= maxIndexInBuffer)
-				return;
-
-			const float alpha = indexInBufferFloat - (float)pos;
-			const float invAlpha = 1.0f - alpha;
-
-			float l = ((float)inL[pos] * invAlpha + (float)inL[pos + 1] * alpha);
-			float r = ((float)inR[pos] * invAlpha + (float)inR[pos + 1] * alpha);
-
-			outL[i] = l * gainFactor;
-			outR[i] = r * gainFactor;
-
-			jassert(*pitchData <= (float)MAX_SAMPLER_PITCH);
-
-			indexInBufferFloat += pitchData[i];
-		}
+		for (int i = 0; i < numChannels; i++)
+			previousSamples[i] = (float)input.data[i][lastIndex];
 	}
-	else
-	{
-		float indexInBufferFloat = (float)indexInBuffer;
-		const float uptimeDeltaFloat = (float)uptimeDelta;
-
-		auto numTargetSamples = (double)(maxIndexInBuffer - indexInBuffer);
 
-		jassert(numTargetSamples > 0.0);
-
-		numSamples = jmin(numSamples, (int)(numTargetSamples / uptimeDelta));
-
-		while (numSamples > 0)
-		{
-			const int pos = int(indexInBufferFloat);
-			const float alpha = indexInBufferFloat - (float)pos;
-			const float invAlpha = 1.0f - alpha;
-
-			float l = ((float)inL[pos] * invAlpha + (float)inL[pos + 1] * alpha);
-			float r = ((float)inR[pos] * invAlpha + (float)inR[pos + 1] * alpha);
-
-			*outL++ = l * gainFactor;
-			*outR++ = r * gainFactor;
-
-			indexInBufferFloat += uptimeDeltaFloat;
-
-			numSamples--;
-		}
-	}
+	hasPreviousSamples = true;
 }
 
-
-
 void StreamingSamplerVoice::renderNextBlock(AudioSampleBuffer &outputBuffer, int startSample, int numSamples)
 {
 	const StreamingSamplerSound *sound = loader.getLoadedSound();
@@ -721,15 +673,19 @@ void StreamingSamplerVoice::renderNextBlock(AudioSampleBuffer &outputBuffer, int
 
 		auto tempVoiceBuffer = getTemporaryVoiceBuffer();
 
+		// The cubic interpolation needs one more sample after the last position
+		const int numExtraSamples = SampleInterpolators::getNumExtraSamples(interpolationMode);
+		const double numSamplesToRead = pitchCounter + startAlpha + (double)numExtraSamples;
+
 		jassert(tempVoiceBuffer != nullptr);
-		if (!isPositiveAndBelow(pitchCounter + startAlpha, (double)tempVoiceBuffer->getNumSamples()))
+		if (!isPositiveAndBelow(numSamplesToRead, (double)tempVoiceBuffer->getNumSamples()))
 		{
 			jassertfalse;
-			tempVoiceBuffer->setSize(tempVoiceBuffer->getNumChannels(), roundToInt((pitchCounter + startAlpha) * 1.5));
+			tempVoiceBuffer->setSize(tempVoiceBuffer->getNumChannels(), roundToInt(numSamplesToRead * 1.5));
 		}
 
 		// Copy the not resampled values into the voice buffer.
-		StereoChannelData data = loader.fillVoiceBuffer(*tempVoiceBuffer, pitchCounter + startAlpha);
+		StereoChannelData data = loader.fillVoiceBuffer(*tempVoiceBuffer, numSamplesToRead);
 
 		float* outL = outputBuffer.getWritePointer(0, startSample);
 		float* outR = outputBuffer.getWritePointer(1, startSample);
@@ -744,13 +700,19 @@ void StreamingSamplerVoice::renderNextBlock(AudioSampleBuffer &outputBuffer, int
 #endif
 
 		double indexInBuffer = startAlpha;
+		const int maxIndexInBuffer = (int)(indexInBuffer + samplesAvailable);
+
+		// The index of the sample before the start position of the next block
+		const int lastIndex = (int)(startAlpha + pitchCounter) - 1;
 
 		if (data.b->isFloatingPoint())
 		{
-			const float* const inL = static_cast<const float*>(data.b->getReadPointer(0, data.offsetInBuffer));
-			const float* const inR = static_cast<const float*>(data.b->getReadPointer(1, data.offsetInBuffer));
+			SampleInterpolators::Input<float> input;
+			input.data[0] = static_cast<const float*>(data.b->getReadPointer(0, data.offsetInBuffer));
+			input.data[1] = static_cast<const float*>(data.b->getReadPointer(1, data.offsetInBuffer));
+			input.maxIndexInBuffer = maxIndexInBuffer;
 
-			interpolateStereoSamples<float, true>(inL, inR, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples, indexInBuffer + samplesAvailable);
+			interpolateSamples<float, true>(input, outL, outR, startSample, numSamples, indexInBuffer, lastIndex);
 		}
 		else
 		{
@@ -761,7 +723,7 @@ void StreamingSamplerVoice::renderNextBlock(AudioSampleBuffer &outputBuffer, int
 
 			if (useNormalisation)
 			{
-				const int numSamplesThisTime = (int)(ceil)((pitchCounter + startAlpha)) + 1;
+				const int numSamplesThisTime = (int)(ceil)((pitchCounter + startAlpha)) + 1 + numExtraSamples;
 
 				float* inL_f = (float*)alloca(sizeof(float) * numSamplesThisTime);
 				float* d[2] = { inL_f, nullptr };
@@ -774,20 +736,33 @@ void StreamingSamplerVoice::renderNextBlock(AudioSampleBuffer &outputBuffer, int
 
 					data.b->convertToFloatWithNormalisation(d, data.b->getNumChannels(), data.offsetInBuffer, numSamplesThisTime);
 
-					interpolateStereoSamples<float, true>(inL_f, inR_f, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples, indexInBuffer + samplesAvailable);
+					SampleInterpolators::Input<float> input;
+					input.data[0] = inL_f;
+					input.data[1] = inR_f;
+					input.maxIndexInBuffer = maxIndexInBuffer;
+
+					interpolateSamples<float, true>(input, outL, outR, startSample, numSamples, indexInBuffer, lastIndex);
 				}
 				else
 				{
 					data.b->convertToFloatWithNormalisation(d, 1, data.offsetInBuffer, numSamplesThisTime);
 
-					interpolateMonoSamples<float, true>(inL_f, nullptr, pitchData, outL, nullptr, startSample, indexInBuffer, uptimeDelta, numSamples);
+					SampleInterpolators::Input<float> input;
+					input.data[0] = inL_f;
+
+					interpolateSamples<float, true>(input, outL, nullptr, startSample, numSamples, indexInBuffer, lastIndex);
 
 					memcpy(outR, outL, sizeof(float) * numSamples);
 				}
 			}
 			else
 			{
-				interpolateStereoSamples<int16, false>(inL, inR, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples, indexInBuffer + samplesAvailable);
+				SampleInterpolators::Input<int16> input;
+				input.data[0] = inL;
+				input.data[1] = inR;
+				input.maxIndexInBuffer = maxIndexInBuffer;
+
+				interpolateSamples<int16, false>(input, outL, outR, startSample, numSamples, indexInBuffer, lastIndex);
 			}
 		}
 
@@ -810,6 +785,8 @@ void StreamingSamplerVoice::renderNextBlock(AudioSampleBuffer &outputBuffer, int
 		voiceUptime += pitchCounter;
 #endif
 
+		loader.setPlaybackRate(pitchCounter / (double)jmax(1, numSamples));
+
 		if (!loader.advanceReadIndex(voiceUptime))
 		{
 #if LOG_SAMPLE_RENDERING
@@ -866,6 +843,7 @@ void StreamingSamplerVoice::prepareToPlay(double sampleRate, int samplesPerBlock
 
 void StreamingSamplerVoice::resetVoice()
 {
+	hasPreviousSamples = false;
 	voiceUptime = 0.0;
 	uptimeDelta = 0.0;
 	isActive = false;
@@ -897,7 +875,8 @@ void StreamingSamplerVoice::initTemporaryVoiceBuffer(hlac::HiseSampleBuffer* buf
 	// The channel amount must be set correctly in the constructor
 	jassert(bufferToUse->getNumChannels() > 0);
 
-    auto requiredSampleAmount = roundToInt((double)samplesPerBlock* maxPitchRatio);
+	// Add a few samples for the interpolators that read beyond the last position
+    auto requiredSampleAmount = roundToInt((double)samplesPerBlock* maxPitchRatio) + 4;
     
 	if (bufferToUse->getNumSamples() < requiredSampleAmount)
 	{
@@ -69,6 +69,17 @@ public:
 	*/
 	JobStatus runJob() override;
 
+	bool isStreamingJob() const override { return true; }
+
+	/** Returns the device key of the currently loaded sound. */
+	int64 getDeviceKey() const override;
+
+	/** Returns the number of output samples until the read buffer is exhausted (as published by the audio thread). */
+	int getNumSamplesBeforeUnderrun() const override;
+
+	/** Sets the ratio between the source samples and the output samples that is used to calculate the deadline. */
+	void setPlaybackRate(double newPlaybackRate) noexcept { playbackRate = newPlaybackRate; }
+
 	size_t getActualStreamingBufferSize() const;
 
 	void setStreamingBufferDataType(bool shouldBeFloat);
@@ -103,6 +114,11 @@ public:
 
 		JobStatus runJob() override;
 
+		/** The unmapper uses the same thread as the streaming operations of the sound. */
+		bool isStreamingJob() const override { return true; }
+
+		int64 getDeviceKey() const override { return sound != nullptr ? sound->getDeviceKey() : 0; }
+
 	private:
 
 		StreamingSamplerSound::Ptr sound;
@@ -150,6 +166,9 @@ private:
 
 	bool swapBuffers();
 
+	/** Publishes the deadline for the streaming threads. Call this on the audio thread after the read index has changed. */
+	void updateNumSamplesBeforeUnderrun();
+
 	void fillInactiveBuffer();
 	void refreshBufferSizes();
 	// ============================================================================================ member variables
@@ -163,7 +182,7 @@ private:
 	CriticalSection lock;
 
 	/** A mutex for the buffer that is being used for loading. */
-	bool writeBufferIsBeingFilled;
+	std::atomic<bool> writeBufferIsBeingFilled;
 
 	// variables for handling of the internal buffers
 
@@ -171,6 +190,11 @@ private:
 
 	double lastSwapPosition = 0.0;
 
+	double playbackRate = 1.0;
+
+	// The read index is only used on the audio thread, the streaming threads read this value instead
+	std::atomic<int> numSamplesBeforeUnderrun { std::numeric_limits<int>::max() };
+
 	Atomic<StreamingSamplerSound const *> sound;
 
 	int readIndex;
@@ -297,8 +321,19 @@ public:
 	/** Set this to false if you're using HLAC compressed monoliths. */
 	void setStreamingBufferDataType(bool shouldBeFloat);
 
+	/** Sets the algorithm that is used to resample the audio data. Call this before startNote(). */
+	void setInterpolationMode(SampleInterpolationMode newMode) noexcept { interpolationMode = newMode; }
+
 private:
 
+	template <typename SignalType, bool isFloat> void interpolateSamples(SampleInterpolators::Input<SignalType>& input, float* outL, float* outR, int startSample, int numSamples, double indexInBuffer, int lastIndex);
+
+	SampleInterpolationMode interpolationMode = SampleInterpolationMode::Linear;
+
+	// The samples before the current read position (used by the cubic interpolation)
+	float previousSamples[2] = { 0.0f, 0.0f };
+	bool hasPreviousSamples = false;
+
 	double pitchCounter = 0.0;
 
 	hlac::HiseSampleBuffer* tvb = nullptr;
@@ -361,7 +361,7 @@ juce::String HiseEvent::toDebugString() const
 
 HiseEventBuffer::HiseEventBuffer()
 {
-	numUsed = HISE_EVENT_BUFFER_SIZE;
+	numUsed = BufferCapacity;
 	clear();
 }
 
@@ -375,49 +375,76 @@ void HiseEventBuffer::clear()
 	}
 }
 
-void HiseEventBuffer::addEvent(const HiseEvent& hiseEvent)
+bool HiseEventBuffer::reserveEvent() noexcept
 {
+	if (numUsed >= BufferCapacity)
+	{
+		// Buffer and overflow area full, this will be reported by the DebugLogger...
+		numDropped++;
+		return false;
+	}
+
 	if (numUsed >= HISE_EVENT_BUFFER_SIZE)
+		numOverflowed++;
+
+	return true;
+}
+
+void HiseEventBuffer::addEvent(const HiseEvent& hiseEvent)
+{
+	if (!reserveEvent())
+		return;
+
+	const int messageTimestamp = hiseEvent.getTimeStamp();
+
+	// Most events are added in order so we can skip the search
+	if (numUsed == 0 || buffer[numUsed - 1].getTimeStamp() <= messageTimestamp)
 	{
-		// Buffer full..
-		jassertfalse;
+		insertEventAtPosition(hiseEvent, numUsed);
 		return;
 	}
 
-	if (numUsed == 0)
+	// Find the first event with a bigger timestamp so that events with the same timestamp keep their order
+	auto position = std::upper_bound(buffer, buffer + numUsed, messageTimestamp, [](int t, const HiseEvent& e)
 	{
-		insertEventAtPosition(hiseEvent, 0);
+		return t < e.getTimeStamp();
+	});
+
+	insertEventAtPosition(hiseEvent, (int)(position - buffer));
+
+	jassert(timeStampsAreSorted());
+}
+
+void HiseEventBuffer::mergeEvents(const HiseEvent* events, int numEvents)
+{
+	if (numEvents <= 0)
 		return;
-	}
 
-	jassert(numUsed < HISE_EVENT_BUFFER_SIZE);
+	auto numFree = BufferCapacity - numUsed;
 
-    const int numToLookFor = jmin<int>(numUsed, HISE_EVENT_BUFFER_SIZE);
-    
-	for (int i = 0; i < numToLookFor; i++)
+	if (numEvents > numFree)
 	{
-		const int timestampInBuffer = buffer[i].getTimeStamp();
-		const int messageTimestamp = hiseEvent.getTimeStamp();
+		numDropped += numEvents - numFree;
+		numEvents = numFree;
+	}
 
-		if (timestampInBuffer > messageTimestamp)
-		{
-			insertEventAtPosition(hiseEvent, i);
+	auto newNumUsed = numUsed + numEvents;
+	numOverflowed += jmax(0, newNumUsed - jmax(numUsed, HISE_EVENT_BUFFER_SIZE));
 
-#if JUCE_DEBUG
-			if (!timeStampsAreSorted())
-			{
-				for (int j = 0; j < numToLookFor; j++)
-					DBG(buffer[j].toDebugString());
-			}
-#endif
+	// Merge from the end so that every event is moved only once
+	int i = numUsed - 1;
+	int j = numEvents - 1;
+	int k = newNumUsed - 1;
 
-			jassert(timeStampsAreSorted());
-
-			return;
-		}
+	while (j >= 0)
+	{
+		if (i >= 0 && buffer[i].getTimeStamp() > events[j].getTimeStamp())
+			buffer[k--] = buffer[i--];
+		else
+			buffer[k--] = events[j--];
 	}
 
-	insertEventAtPosition(hiseEvent, numUsed);
+	numUsed = newNumUsed;
 
 	jassert(timeStampsAreSorted());
 }
@@ -444,25 +471,18 @@ void HiseEventBuffer::addEvents(const MidiBuffer& otherBuffer)
 
 	while (it.getNextEvent(m, samplePos))
 	{
-		jassert(index < HISE_EVENT_BUFFER_SIZE);
-
 		HiseEvent e(m);
 
 		if (e.isEmpty()) continue;
 
+		if (!reserveEvent())
+			continue;
+
 		e.swapWith(buffer[index]);
 
 		buffer[index].setTimeStamp(samplePos);
 
 		numUsed++;
-
-		if (numUsed >= HISE_EVENT_BUFFER_SIZE)
-		{
-			// Buffer full..
-			jassertfalse;
-			return;
-		}
-
 		index++;
 	}
 
@@ -472,14 +492,10 @@ void HiseEventBuffer::addEvents(const MidiBuffer& otherBuffer)
 
 void HiseEventBuffer::addEvents(const HiseEventBuffer &otherBuffer)
 {
-	Iterator iter(otherBuffer);
+	jassert(&otherBuffer != this);
+	jassert(otherBuffer.timeStampsAreSorted());
 
-	while (HiseEvent* e = iter.getNextEventPointer(false, false))
-	{
-		addEvent(*e);
-	}
-
-	jassert(timeStampsAreSorted());
+	mergeEvents(otherBuffer.buffer, otherBuffer.numUsed);
 }
 
 void HiseEventBuffer::sortTimestamps()
@@ -545,7 +561,7 @@ int HiseEventBuffer::getMaxTimeStamp() const
 
 HiseEvent HiseEventBuffer::getEvent(int index) const
 {
-	if (index >= 0 && index < HISE_EVENT_BUFFER_SIZE)
+	if (isPositiveAndBelow(index, BufferCapacity))
 	{
 		return buffer[index];
 	}
@@ -559,8 +575,7 @@ hise::HiseEvent HiseEventBuffer::popEvent(int index)
 	{
 		auto e = getEvent(index);
 
-		for (int i = index; i < numUsed; i++)
-			buffer[i] = buffer[i + 1];
+		memmove(buffer + index, buffer + index + 1, sizeof(HiseEvent) * (numUsed - index - 1));
 
 		buffer[numUsed - 1] = {};
 		numUsed--;
@@ -591,30 +606,22 @@ void HiseEventBuffer::moveEventsBelow(HiseEventBuffer& targetBuffer, int highest
 {
 	if (numUsed == 0) return;
 
-	HiseEventBuffer::Iterator iter(*this);
+	jassert(targetBuffer.timeStampsAreSorted());
+	jassert(timeStampsAreSorted());
 
 	int numCopied = 0;
 
-	jassert(targetBuffer.timeStampsAreSorted());
-	jassert(timeStampsAreSorted());
+	while (numCopied < numUsed && buffer[numCopied].getTimeStamp() < highestTimestamp)
+		numCopied++;
 
-	while (HiseEvent* e = iter.getNextEventPointer())
-	{
-		if (e->getTimeStamp() < highestTimestamp)
-		{
-			targetBuffer.addEvent(*e);
-			numCopied++;
-		}
-		else
-		{
-			break;
-		}
-	}
+	if (numCopied == 0)
+		return;
+
+	targetBuffer.mergeEvents(buffer, numCopied);
 
 	const int numRemaining = numUsed - numCopied;
 
-	for (int i = 0; i < numRemaining; i++)
-		buffer[i] = buffer[i + numCopied];
+	memmove(buffer, buffer + numCopied, sizeof(HiseEvent) * numRemaining);
 
 	HiseEvent::clear(buffer + numRemaining, numCopied);
 
@@ -642,10 +649,7 @@ void HiseEventBuffer::moveEventsAbove(HiseEventBuffer& targetBuffer, int lowestT
 
 	if (indexOfFirstElementToMove == -1) return;
 
-	for (int i = indexOfFirstElementToMove; i < numUsed; i++)
-	{
-		targetBuffer.addEvent(buffer[i]);
-	}
+	targetBuffer.mergeEvents(buffer + indexOfFirstElementToMove, numUsed - indexOfFirstElementToMove);
 
 	HiseEvent::clear(buffer + indexOfFirstElementToMove, numUsed - indexOfFirstElementToMove);
 
@@ -654,13 +658,11 @@ void HiseEventBuffer::moveEventsAbove(HiseEventBuffer& targetBuffer, int lowestT
 
 void HiseEventBuffer::copyFrom(const HiseEventBuffer& otherBuffer)
 {
-    const int eventsToCopy = jmin<int>(otherBuffer.numUsed, HISE_EVENT_BUFFER_SIZE);
+    const int eventsToCopy = jmin<int>(otherBuffer.numUsed, BufferCapacity);
     
 	memcpy(buffer, otherBuffer.buffer, sizeof(HiseEvent) * eventsToCopy);
 
-	jassert(otherBuffer.numUsed < HISE_EVENT_BUFFER_SIZE);
-
-	numUsed = otherBuffer.numUsed;
+	numUsed = eventsToCopy;
 }
 
 
@@ -678,7 +680,7 @@ bool HiseEventBuffer::Iterator::getNextEvent(HiseEvent& b, int &samplePosition,
 		  (skipIgnoredEvents && buffer->buffer[index].isIgnored())))
 	{
 		index++;
-		jassert(index < HISE_EVENT_BUFFER_SIZE);
+		jassert(index < BufferCapacity);
 	}
 		
 	if (index < buffer->numUsed)
@@ -709,7 +711,7 @@ const HiseEvent* HiseEventBuffer::Iterator::getNextConstEventPointer(bool skipIg
 		  (skipIgnoredEvents && buffer->buffer[index].isIgnored())))
 	{
 		index++;
-		jassert(index < HISE_EVENT_BUFFER_SIZE);
+		jassert(index < BufferCapacity);
 	}
 
 	if (index < buffer->numUsed)
@@ -725,32 +727,14 @@ const HiseEvent* HiseEventBuffer::Iterator::getNextConstEventPointer(bool skipIg
 
 void HiseEventBuffer::insertEventAtPosition(const HiseEvent& e, int positionInBuffer)
 {
-	if (numUsed == 0)
-	{
-		buffer[0] = HiseEvent(e);
-		numUsed = 1;
-
-		return;
-	}
+	jassert(numUsed < BufferCapacity);
+	jassert(isPositiveAndNotGreaterThan(positionInBuffer, numUsed));
 
 	if (numUsed > positionInBuffer)
-	{
-		for (int i = jmin<int>(numUsed-1, HISE_EVENT_BUFFER_SIZE-2); i >= positionInBuffer; i--)
-		{
-			jassert(i + 1 < HISE_EVENT_BUFFER_SIZE);
-			buffer[i + 1] = buffer[i];
-		}
-	}
+		memmove(buffer + positionInBuffer + 1, buffer + positionInBuffer, sizeof(HiseEvent) * (numUsed - positionInBuffer));
 
-    if(positionInBuffer < HISE_EVENT_BUFFER_SIZE)
-    {
-        buffer[positionInBuffer] = HiseEvent(e);
-        numUsed++;
-    }
-    else
-    {
-        jassertfalse;
-    }
+	buffer[positionInBuffer] = HiseEvent(e);
+	numUsed++;
 }
 
 EventIdHandler::EventIdHandler(HiseEventBuffer& masterBuffer_) :
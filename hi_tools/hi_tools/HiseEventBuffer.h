@@ -498,8 +498,20 @@ private:
 
 #define HISE_EVENT_BUFFER_SIZE 256
 
+/** The amount of additional events that can be stored after HISE_EVENT_BUFFER_SIZE.
+	If a buffer exceeds its regular size, the events will be counted as overflow and
+	if the overflow area is full too, the events will be dropped.
+*/
+#ifndef HISE_EVENT_BUFFER_OVERFLOW_SIZE
+#define HISE_EVENT_BUFFER_OVERFLOW_SIZE 256
+#endif
+
 /** The buffer type for the HiseEvent.
 
+	The events are sorted by their timestamp. The position of a new event is found with a binary
+	search (and events that are added in order are simply appended) so adding many events doesn't
+	get quadratic. The buffer doesn't allocate, but has a preallocated overflow area, and keeps track
+	of events that didn't fit so that they can be reported to the DebugLogger.
 */
 class HiseEventBuffer
 {
@@ -674,6 +686,19 @@ public:
 	}
 
 	bool timeStampsAreSorted() const;
+
+	/** Returns the number of events that were added to the overflow area since the last reset. */
+	int getNumOverflowedEvents() const noexcept { return numOverflowed; }
+
+	/** Returns the number of events that were dropped because the buffer was full since the last reset. */
+	int getNumDroppedEvents() const noexcept { return numDropped; }
+
+	/** Resets the overflow and dropped event counters. This will not be done by clear(). */
+	void resetOverflowCounters() noexcept
+	{
+		numOverflowed = 0;
+		numDropped = 0;
+	}
 	
 	int getMinTimeStamp() const;
 
@@ -738,11 +763,21 @@ private:
 
 	friend class Iterator;
 
+	static constexpr int BufferCapacity = HISE_EVENT_BUFFER_SIZE + HISE_EVENT_BUFFER_OVERFLOW_SIZE;
+
+	/** Checks if there is space for another event and updates the counters. */
+	bool reserveEvent() noexcept;
+
+	/** Merges the sorted events into the buffer. Events with the same timestamp will be added after the existing ones. */
+	void mergeEvents(const HiseEvent* events, int numEvents);
+
 	void insertEventAtPosition(const HiseEvent& e, int positionInBuffer);
 
-	event_alignment HiseEvent buffer[HISE_EVENT_BUFFER_SIZE];
+	event_alignment HiseEvent buffer[BufferCapacity];
 
 	int numUsed = 0;
+	int numOverflowed = 0;
+	int numDropped = 0;
 };
 
 #undef event_alignment
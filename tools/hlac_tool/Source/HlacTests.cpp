@@ -259,6 +259,131 @@ void BitCompressors::UnitTests::testCompressor(Base* compressor)
 	free(decompressedData);
 }
 
+static BitUnpackingTest bitUnpackingTest;
+
+void BitUnpackingTest::runTest()
+{
+	const int bitDepths[] = { 2, 4, 6, 10, 12, 14 };
+
+	const auto previousMode = BitCompressors::getDecodeMode();
+
+	for (auto b : bitDepths)
+		testDecodeModes(b);
+
+	for (auto b : bitDepths)
+		benchmarkDecodeModes(b);
+
+	BitCompressors::setDecodeMode(previousMode);
+}
+
+void BitUnpackingTest::fillWithRandomValues(int16* data, int numValues, int bitDepth, Random& r)
+{
+	const int maxValue = (1 << (bitDepth - 1)) - 1;
+
+	for (int i = 0; i < numValues; i++)
+		data[i] = (int16)r.nextInt(Range<int>(-maxValue, maxValue + 1));
+}
+
+void BitUnpackingTest::testDecodeModes(int bitDepth)
+{
+	beginTest("Testing SIMD unpacking with bit rate " + String(bitDepth));
+
+	BitCompressors::Collection collection;
+	auto compressor = collection.getSuitableCompressorForBitRate((uint8)bitDepth);
+	Random r;
+
+	// Use odd sizes to check the scalar code picks up the remaining values
+	const int sizes[] = { 1, 7, 8, 9, 15, 16, 17, 33, 63, 64, 65, 257, 4095 };
+
+	for (auto numValues : sizes)
+	{
+		HeapBlock<int16> input(numValues, true);
+		HeapBlock<int16> expected(numValues, true);
+		HeapBlock<int16> actual(numValues, true);
+		HeapBlock<uint8> compressed(compressor->getByteAmount(numValues), true);
+
+		fillWithRandomValues(input, numValues, bitDepth, r);
+		compressor->compress(compressed, input, numValues);
+
+		BitCompressors::setDecodeMode(BitCompressors::DecodeMode::Scalar);
+		compressor->decompress(expected, compressed, numValues);
+
+		for (int m = 1; m < (int)BitCompressors::DecodeMode::numDecodeModes; m++)
+		{
+			auto mode = (BitCompressors::DecodeMode)m;
+
+			if (!BitCompressors::setDecodeMode(mode))
+				continue;
+
+			actual.clear(numValues);
+			compressor->decompress(actual, compressed, numValues);
+
+			for (int i = 0; i < numValues; i++)
+			{
+				if (actual[i] != expected[i])
+				{
+					expectEquals<int16>(actual[i], expected[i], BitCompressors::getDecodeModeName(mode) + ": Sample mismatch at position " + String(i) + " of " + String(numValues));
+					break;
+				}
+			}
+		}
+	}
+}
+
+void BitUnpackingTest::benchmarkDecodeModes(int bitDepth)
+{
+	beginTest("Benchmarking unpacking with bit rate " + String(bitDepth));
+
+	BitCompressors::Collection collection;
+	auto compressor = collection.getSuitableCompressorForBitRate((uint8)bitDepth);
+	Random r;
+
+	const int numValues = 65536;
+	const int numIterations = 200;
+
+	HeapBlock<int16> input(numValues, true);
+	HeapBlock<int16> output(numValues, true);
+	HeapBlock<uint8> compressed(compressor->getByteAmount(numValues), true);
+
+	fillWithRandomValues(input, numValues, bitDepth, r);
+	compressor->compress(compressed, input, numValues);
+
+	double scalarTime = 0.0;
+
+	for (int m = 0; m < (int)BitCompressors::DecodeMode::numDecodeModes; m++)
+	{
+		auto mode = (BitCompressors::DecodeMode)m;
+
+		if (!BitCompressors::setDecodeMode(mode))
+			continue;
+
+		compressor->decompress(output, compressed, numValues);
+
+		const double start = Time::getMillisecondCounterHiRes();
+
+		for (int i = 0; i < numIterations; i++)
+			compressor->decompress(output, compressed, numValues);
+
+		const double delta = jmax(0.001, Time::getMillisecondCounterHiRes() - start);
+
+		if (mode == BitCompressors::DecodeMode::Scalar)
+			scalarTime = delta;
+
+		const double samplesPerSecond = (double)numValues * numIterations / (delta * 0.001);
+		const double outputMegaBytes = samplesPerSecond * sizeof(int16) / (1024.0 * 1024.0);
+
+		String s;
+		s << String(bitDepth) << " bit " << BitCompressors::getDecodeModeName(mode) << ": ";
+		s << String(samplesPerSecond / 1000000.0, 1) << " MSamples/s, ";
+		s << String(outputMegaBytes, 1) << " MB/s";
+
+		if (mode != BitCompressors::DecodeMode::Scalar)
+			s << ", speedup: " << String(scalarTime / delta, 2) << "x";
+
+		logMessage(s);
+	}
+}
+
 #endif
 
 CodecTest::CodecTest() :
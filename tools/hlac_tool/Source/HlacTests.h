@@ -51,6 +51,21 @@ struct BitCompressors::UnitTests : public UnitTest
 
 };
 
+/** Checks the SIMD unpacking of every available decode mode against the scalar code and logs the throughput. */
+struct BitUnpackingTest : public UnitTest
+{
+	BitUnpackingTest() :
+		UnitTest("Bit unpacking SIMD tests", "Benchmark")
+	{}
+
+	void runTest() override;
+
+	void testDecodeModes(int bitDepth);
+	void benchmarkDecodeModes(int bitDepth);
+
+	static void fillWithRandomValues(int16* data, int numValues, int bitDepth, Random& r);
+};
+
 struct CodecTest : public UnitTest
 {
 	CodecTest();
@@ -37,7 +37,7 @@ void printHelp()
 	Logger::writeToLog("Usage: hlac_tool [MODE] [INPUT] [OUTPUT]");
 	Logger::writeToLog("");
 	Logger::writeToLog("modes: 'encode' / 'decode'");
-	Logger::writeToLog("test-modes: 'unit_test' / 'test_directory', 'memory_map_directory'");
+	Logger::writeToLog("test-modes: 'unit_test' / 'benchmark' / 'test_directory', 'memory_map_directory', 'monolith_directory'");
 	Logger::writeToLog("(put '_' before filename to skip samples)");
 	Logger::setCurrentLogger(nullptr);
 }
@@ -97,6 +97,124 @@ void testMemoryMapPerformance(Array<File>& files)
 	}
 }
 
+/** Encodes all files into a single monolith and returns the encoding time in seconds. 
+	
+	If numThreads is zero, it uses the same code path as before (one file after another). 
+*/
+double encodeMonolith(const Array<File>& files, int numChannels, double sampleRate, int numThreads, MemoryBlock& result)
+{
+	HiseLosslessAudioFormat hlac;
+	StringPairArray empty;
+
+	auto mos = new MemoryOutputStream();
+
+	ScopedPointer<HiseLosslessAudioFormatWriter> writer = dynamic_cast<HiseLosslessAudioFormatWriter*>(hlac.createWriterFor(mos, sampleRate, numChannels, 16, empty, 5));
+
+	auto option = HlacEncoder::CompressorOptions::getPreset(HlacEncoder::CompressorOptions::Presets::Diff);
+	option.applyDithering = false;
+	writer->setOptions(option);
+
+	auto start = Time::getMillisecondCounterHiRes();
+
+	if (numThreads == 0)
+	{
+		AudioFormatManager afm;
+		afm.registerBasicFormats();
+
+		for (auto f : files)
+		{
+			ScopedPointer<AudioFormatReader> reader = afm.createReaderFor(f);
+			writer->writeFromAudioReader(*reader, 0, -1);
+		}
+	}
+	else
+	{
+		HlacParallelEncoder encoder(files, numChannels, sampleRate, option, numThreads);
+
+		for (int i = 0; i < files.size(); i++)
+			encoder.appendFile(i, *writer);
+	}
+
+	writer->flush();
+
+	auto seconds = (Time::getMillisecondCounterHiRes() - start) / 1000.0;
+
+	result = mos->getMemoryBlock();
+
+	return seconds;
+}
+
+int testMonolithEncoding(const File& root)
+{
+	Array<File> allFiles;
+	root.findChildFiles(allFiles, File::findFiles, true);
+
+	AudioFormatManager afm;
+	afm.registerBasicFormats();
+
+	Array<File> files;
+	int numChannels = 0;
+	double sampleRate = 0.0;
+	int64 numSamples = 0;
+
+	for (auto f : allFiles)
+	{
+		if (f.getFileName().startsWith("_") || f.isHidden())
+			continue;
+
+		ScopedPointer<AudioFormatReader> reader = afm.createReaderFor(f);
+
+		if (reader == nullptr)
+			continue;
+
+		// A monolith needs the same channel amount and samplerate for every file
+		if (numChannels == 0)
+		{
+			numChannels = jmin<int>(2, reader->numChannels);
+			sampleRate = reader->sampleRate;
+		}
+		else if (jmin<int>(2, reader->numChannels) != numChannels || reader->sampleRate != sampleRate)
+		{
+			Logger::writeToLog("Skipping " + f.getFileName());
+			continue;
+		}
+
+		numSamples += reader->lengthInSamples;
+		files.add(f);
+	}
+
+	if (files.isEmpty())
+	{
+		ABORT_WITH_MESSAGE("No audio files found in " + root.getFullPathName());
+	}
+
+	const double megabytes = (double)(numSamples * numChannels * sizeof(int16)) / 1024.0 / 1024.0;
+
+	Logger::writeToLog("Encoding " + String(files.size()) + " files (" + String(megabytes, 1) + " MB)");
+
+	MemoryBlock serialData, parallelData;
+
+	auto serialTime = encodeMonolith(files, numChannels, sampleRate, 0, serialData);
+
+	Logger::writeToLog("Single thread:\t" + String(megabytes / serialTime, 1) + " MB/s");
+
+	for (int numThreads = 1; numThreads <= SystemStats::getNumCpus(); numThreads *= 2)
+	{
+		auto parallelTime = encodeMonolith(files, numChannels, sampleRate, numThreads, parallelData);
+
+		Logger::writeToLog(String(numThreads) + " threads:\t" + String(megabytes / parallelTime, 1) + " MB/s");
+
+		if (parallelData != serialData)
+		{
+			ABORT_WITH_MESSAGE("Parallel encoding result doesn't match the single thread result");
+		}
+	}
+
+	Logger::writeToLog("All results are identical");
+	Logger::setCurrentLogger(nullptr);
+	return 0;
+}
+
 int decode(File input, File output)
 {
 
@@ -245,6 +363,24 @@ int main(int argc, char **argv)
 	}
 
 
+	if (mode == "benchmark")
+	{
+		Logger::writeToLog("Decode mode: " + BitCompressors::getDecodeModeName(BitCompressors::getDecodeMode()));
+
+		UnitTestRunner runner;
+		runner.setAssertOnFailure(false);
+		runner.runTestsInCategory("Benchmark");
+
+		int numFails = 0;
+
+		for (int i = 0; i < runner.getNumResults(); i++)
+			numFails += runner.getResult(i)->failures;
+
+		Logger::setCurrentLogger(nullptr);
+		return numFails > 0 ? 1 : 0;
+	}
+
+
 	if (mode == "memory_map_directory")
 	{
 		File root(argv[2]);
@@ -265,6 +401,17 @@ int main(int argc, char **argv)
 		return 0;
 	}
 
+	if (mode == "monolith_directory")
+	{
+		if (argc < 3)
+		{
+			printHelp();
+			return 1;
+		}
+
+		return testMonolithEncoding(File(argv[2]));
+	}
+
 	if (mode != "test_directory")
 	{
 		Logger::writeToLog("Invalid mode");
@@ -0,0 +1,32 @@
+/*
+BEGIN_TEST_DATA
+  f: main
+  ret: int
+  args: int
+  input: 12
+  output: 48
+  error: ""
+  compile_flags: AutoVectorisation
+  filename: "loop/loop2avx_1"
+END_TEST_DATA
+*/
+
+span<float, 16> data = { 1.0f };
+
+int main(int input)
+{
+	for(auto& s: data)
+    {
+        s += 2.0f;
+    }
+    
+    float x = 0.0f;
+    
+    for(auto& s: data)
+    {
+        x += s;
+    }
+    
+	return (int)x;
+}
+
@@ -0,0 +1,37 @@
+/*
+BEGIN_TEST_DATA
+  f: main
+  ret: int
+  args: float
+  input: 0.5f
+  output: 24
+  error: ""
+  compile_flags: AutoVectorisation
+  filename: "loop/loop2avx_2"
+END_TEST_DATA
+*/
+
+span<float, 24> data = { 4.0f };
+
+int main(float input)
+{
+	for(auto& s: data)
+    {
+        s *= input;
+    }
+    
+    for(auto& s: data)
+    {
+        s -= 1.0f;
+    }
+    
+    float x = 0.0f;
+    
+    for(auto& s: data)
+    {
+        x += s;
+    }
+    
+	return (int)x;
+}
+
@@ -0,0 +1,33 @@
+/*
+BEGIN_TEST_DATA
+  f: main
+  ret: int
+  args: int
+  input: 12
+  output: 72
+  error: ""
+  compile_flags: AutoVectorisation
+  filename: "loop/loop2avx_3"
+END_TEST_DATA
+*/
+
+// 12 elements can't be split into 8-wide lanes, so this uses the SSE path
+span<float, 12> data = { 2.0f };
+
+int main(int input)
+{
+	for(auto& s: data)
+    {
+        s *= 3.0f;
+    }
+    
+    float x = 0.0f;
+    
+    for(auto& s: data)
+    {
+        x += s;
+    }
+    
+	return (int)x;
+}
+